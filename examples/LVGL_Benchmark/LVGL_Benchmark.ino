@@ -0,0 +1,112 @@
+/**
+ * Run LVGL's demos/benchmark and print how long LVGL draws a frame and how long the flush takes.
+ *
+ * Build it with (e.g. in the `build_flags` of platformio.ini):
+ *   -DLV_USE_DEMO_BENCHMARK=1 -DLV_USE_FONT_COMPRESSED=1
+ * and once more with `-DLV_COLOR_16_SWAP=1` to compare rendering native RGB565 and swapping
+ * the bytes in the flush (default) with letting LVGL render byte swapped colors.
+ */
+#include "Arduino.h"
+#include "lvgl.h"
+#include "demos/lv_demos.h"
+#include <TFT_eSPI.h>
+
+#if LV_USE_DEMO_BENCHMARK == 0
+#error "Add -DLV_USE_DEMO_BENCHMARK=1 -DLV_USE_FONT_COMPRESSED=1 to the build flags"
+#endif
+
+#define SCREEN_WIDTH         128
+#define SCREEN_HEIGHT        128
+
+#define REPORT_PERIOD_MS     5000
+
+static lv_disp_draw_buf_t draw_buf;
+static lv_color_t buf[SCREEN_WIDTH * SCREEN_HEIGHT];
+
+TFT_eSPI tft =  TFT_eSPI();
+
+static unsigned long flush_us;
+static unsigned long handler_us;
+static unsigned long frame_cnt;
+static unsigned long total_draw_us;
+static unsigned long total_flush_us;
+static unsigned long total_frame_cnt;
+
+void disp_flush(lv_disp_drv_t *disp, const lv_area_t *area,
+                lv_color_t *color_p)
+{
+    uint32_t start = micros();
+    uint32_t w = ( area->x2 - area->x1 + 1 );
+    uint32_t h = ( area->y2 - area->y1 + 1 );
+
+    tft.startWrite();
+    tft.setAddrWindow( area->x1, area->y1, w, h );
+    tft.pushColors( ( uint16_t * )&color_p->full, w * h, LV_COLOR_16_SWAP == 0 ); /*Swap the bytes here if LVGL renders native RGB565*/
+    tft.endWrite();
+
+    if (lv_disp_flush_is_last(disp)) frame_cnt++;
+    flush_us += micros() - start;
+
+    lv_disp_flush_ready( disp );
+}
+
+static void report(void)
+{
+    /*Everything in `lv_timer_handler` but the flush is drawing*/
+    unsigned long draw_us = handler_us > flush_us ? handler_us - flush_us : 0;
+    total_draw_us += draw_us;
+    total_flush_us += flush_us;
+    total_frame_cnt += frame_cnt;
+
+    if (frame_cnt) {
+        Serial.printf("LV_COLOR_16_SWAP %d: %lu frames, draw: %lu us/frame, flush: %lu us/frame\n",
+                      LV_COLOR_16_SWAP, frame_cnt, draw_us / frame_cnt, flush_us / frame_cnt);
+    }
+    if (total_frame_cnt) {
+        Serial.printf("LV_COLOR_16_SWAP %d: total %lu frames, draw: %lu us/frame, flush: %lu us/frame\n",
+                      LV_COLOR_16_SWAP, total_frame_cnt, total_draw_us / total_frame_cnt,
+                      total_flush_us / total_frame_cnt);
+    }
+
+    handler_us = 0;
+    flush_us = 0;
+    frame_cnt = 0;
+}
+
+void setup()
+{
+    Serial.begin(115200);
+    Serial.println("Hello T-QT LVGL benchmark");
+
+    tft.begin();
+    tft.setRotation(0);
+
+    lv_init();
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, SCREEN_WIDTH * SCREEN_HEIGHT);
+
+    /*Initialize the display*/
+    static lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = SCREEN_WIDTH;
+    disp_drv.ver_res = SCREEN_HEIGHT;
+    disp_drv.flush_cb = disp_flush;
+    disp_drv.draw_buf = &draw_buf;
+    lv_disp_drv_register(&disp_drv);
+
+    lv_demo_benchmark();
+}
+
+void loop()
+{
+    static uint32_t last_report;
+
+    uint32_t start = micros();
+    lv_timer_handler();
+    handler_us += micros() - start;
+
+    if (millis() - last_report >= REPORT_PERIOD_MS) {
+        last_report = millis();
+        report();
+    }
+    delay(1);
+}
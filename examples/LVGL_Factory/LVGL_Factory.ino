@@ -34,12 +34,17 @@ OneButton btn_right(PIN_BTN_R, true);
 
 TFT_eSPI tft =  TFT_eSPI();
 
+#define BTN_POLL_MS          10
+
+// Sleep until the next LVGL timer is due instead of polling every millisecond
 #define LV_DELAY(x)                                                            \
   do {                                                                         \
-    uint32_t t = x;                                                            \
-    while (t--) {                                                              \
-      lv_timer_handler();                                                      \
-      delay(1);                                                                \
+    uint32_t start = millis();                                                 \
+    uint32_t elaps;                                                            \
+    while ((elaps = millis() - start) < (uint32_t)(x)) {                       \
+      uint32_t t = lv_timer_handler();                                         \
+      uint32_t left = (uint32_t)(x) - elaps;                                   \
+      delay(t < left ? t : left);                                              \
     }                                                                          \
   } while (0);
 
@@ -51,7 +56,7 @@ void disp_flush(lv_disp_drv_t *disp, const lv_area_t *area,
 
     tft.startWrite();
     tft.setAddrWindow( area->x1, area->y1, w, h );
-    tft.pushColors( ( uint16_t * )&color_p->full, w * h, false );
+    tft.pushColors( ( uint16_t * )&color_p->full, w * h, LV_COLOR_16_SWAP == 0 ); /*Swap the bytes here if LVGL renders native RGB565*/
     tft.endWrite();
 
     lv_disp_flush_ready( disp );
@@ -255,7 +260,9 @@ void setup()
 
 void loop()
 {
-    lv_timer_handler();
+    uint32_t ms = lv_timer_handler();
     btn_left.tick();
     btn_right.tick();
+    // Let the CPU idle (or light-sleep) until LVGL has work to do, but keep polling the buttons
+    delay(ms < BTN_POLL_MS ? ms : BTN_POLL_MS);
 }
\ No newline at end of file
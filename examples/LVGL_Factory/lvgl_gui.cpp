@@ -4,6 +4,10 @@
 
 #define PIN_BAT_VOLT         4
 
+// The 60 positions of the second hand take about 260 kB in the transformation cache.
+// With a smaller cache every tick would render a new variant and drop an older one, so the hand sweeps instead.
+#define SEC_IMG_CACHED       (LV_IMG_TRANSFORM_CACHE_SIZE >= 300U * 1024U)
+
 LV_IMG_DECLARE(duck_gif);
 LV_IMG_DECLARE(clock_bg_img);
 LV_IMG_DECLARE(clock_hour_img);
@@ -24,30 +28,34 @@ static lv_obj_t *sec_img;
 static lv_obj_t *bat_label;
 
 void update_sensor(lv_timer_t *timer);
-void load_duck_gif(lv_obj_t *src);
-void load_time(lv_obj_t *src);
-void load_debug(lv_obj_t *src);
-void load_logo(lv_obj_t *src);
-void load_test_img(lv_obj_t *src);
+void load_duck_gif(lv_obj_t *src, bool load);
+void load_time(lv_obj_t *src, bool load);
+void load_debug(lv_obj_t *src, bool load);
+void load_logo(lv_obj_t *src, bool load);
+void load_test_img(lv_obj_t *src, bool load);
 
 void gui_init(void)
 {
     lv_obj_clean(lv_scr_act());
     dis = lv_tileview_create(lv_scr_act());
     lv_obj_set_size(dis, 128, 128);
+    /*Move only the snapshots of the tiles while switching pages instead of redrawing the GIF and the clock*/
+    lv_tileview_set_snapshot_anim(dis, true);
     lv_obj_t *tv1 = lv_tileview_add_tile(dis, 0, 0, LV_DIR_HOR);
     lv_obj_t *tv2 = lv_tileview_add_tile(dis, 0, 1, LV_DIR_HOR);
     lv_obj_t *tv3 = lv_tileview_add_tile(dis, 0, 2, LV_DIR_HOR);
     lv_obj_t *tv4 = lv_tileview_add_tile(dis, 0, 3, LV_DIR_HOR);
     lv_obj_t *tv5 = lv_tileview_add_tile(dis, 0, 4, LV_DIR_HOR);
 
-    load_time(tv1);
-    load_duck_gif(tv2);
-    load_debug(tv3);
-    load_logo(tv4);
-    load_test_img(tv5);
-
     timer1 = lv_timer_create(update_sensor, 1000, NULL);
+
+    /*The pages are switched by the button so only the shown tile needs its content (e.g. the GIF decoder)*/
+    lv_tileview_set_load_dist(dis, 0);
+    lv_tileview_tile_set_load_cb(tv1, load_time);
+    lv_tileview_tile_set_load_cb(tv2, load_duck_gif);
+    lv_tileview_tile_set_load_cb(tv3, load_debug);
+    lv_tileview_tile_set_load_cb(tv4, load_logo);
+    lv_tileview_tile_set_load_cb(tv5, load_test_img);
 }
 
 void gui_switch_page(uint8_t num)
@@ -55,28 +63,40 @@ void gui_switch_page(uint8_t num)
     lv_obj_set_tile_id(dis, 0, num, LV_ANIM_ON);
 }
 
-void load_logo(lv_obj_t *src)
+void load_logo(lv_obj_t *src, bool load)
 {
+    if (!load) return;
     lv_obj_t *img = lv_img_create(src);
     lv_obj_center(img);
     lv_img_set_src(img, &LOGO128x128);
 }
-void load_test_img(lv_obj_t *src)
+void load_test_img(lv_obj_t *src, bool load)
 {
+    if (!load) return;
     lv_obj_t *img = lv_img_create(src);
     lv_obj_center(img);
     lv_img_set_src(img, &test_img);
 }
 
-void load_duck_gif(lv_obj_t *src)
+void load_duck_gif(lv_obj_t *src, bool load)
 {
+    if (!load) return;
     lv_obj_t *dock_img = lv_gif_create(src);
     lv_obj_center(dock_img);
+    /*Decode it to an indexed image: 17 KB instead of 64 KB of RAM which matters on the boards without PSRAM*/
+    lv_gif_set_indexed(dock_img, true);
     lv_gif_set_src(dock_img, &duck_gif);
 }
 
-void load_time(lv_obj_t *src)
+void load_time(lv_obj_t *src, bool load)
 {
+    if (!load) {
+        hour_img = NULL;
+        min_img = NULL;
+        sec_img = NULL;
+        return;
+    }
+
     lv_obj_clear_flag(src, LV_OBJ_FLAG_SCROLLABLE);
     lv_obj_t *clock_bg = lv_obj_create(src);
     lv_obj_set_style_bg_img_src(clock_bg, &clock_bg_img, 0);
@@ -87,22 +107,35 @@ void load_time(lv_obj_t *src)
     lv_obj_align(hour_img, LV_ALIGN_CENTER, -1, -15);
     lv_img_set_pivot(hour_img, 2, 29);
     lv_img_set_antialias(hour_img, true);
+    lv_img_set_transform_cache(hour_img, 30, 0);
 
     min_img = lv_img_create(src);
     lv_img_set_src(min_img, &clock_min_img);
     lv_obj_align(min_img, LV_ALIGN_CENTER, 0, -20);
     lv_img_set_pivot(min_img, 3, 36);
     lv_img_set_antialias(min_img, true);
+    lv_img_set_transform_cache(min_img, 60, 0);
 
     sec_img = lv_img_create(src);
     lv_img_set_src(sec_img, &clock_sec_img);
     lv_obj_align(sec_img, LV_ALIGN_CENTER, 0, -26);
     lv_img_set_pivot(sec_img, 4, 55);
     lv_img_set_antialias(sec_img, true);
+#if SEC_IMG_CACHED
+    lv_img_set_transform_cache(sec_img, 60, 0);
+#endif
+
+    /*Set the hands at once*/
+    lv_timer_ready(timer1);
 }
 
-void load_debug(lv_obj_t *src)
+void load_debug(lv_obj_t *src, bool load)
 {
+    if (!load) {
+        bat_label = NULL;
+        return;
+    }
+
     lv_obj_t *debug_label = lv_label_create(src);
     String text;
     esp_chip_info_t t;
@@ -121,6 +154,7 @@ void load_debug(lv_obj_t *src)
     lv_obj_align(debug_label, LV_ALIGN_TOP_LEFT, 0, 0);
     bat_label = lv_label_create(src);
     lv_obj_align_to(bat_label, debug_label, LV_ALIGN_OUT_BOTTOM_LEFT, 0, 0);
+    lv_timer_ready(timer1);
 }
 
 void sec_poin_anim_cb(void *img, int32_t v)
@@ -128,19 +162,15 @@ void sec_poin_anim_cb(void *img, int32_t v)
     lv_img_set_angle((lv_obj_t *)img, v);
 }
 
-void sec_img_cb(void *img, int32_t v)
-{
-    lv_img_set_angle((lv_obj_t *)img, v);
-}
-
 void update_sensor(lv_timer_t *timer)
 {
     float volt = (analogRead(PIN_BAT_VOLT) * 2 * 3.3) / 4096;
     char buf[20];
     snprintf(buf, 20, "bat_volt:%.2f V", volt);
-    lv_label_set_text(bat_label, buf);
+    if (bat_label) lv_label_set_text(bat_label, buf);
 
     struct tm timeinfo;
+    if (!hour_img)return;
     if (!WiFi.isConnected())return;
     if (getLocalTime(&timeinfo, 200)) {
         // The line that fixes the hour hand. by:
@@ -148,13 +178,18 @@ void update_sensor(lv_timer_t *timer)
         lv_img_set_angle(hour_img, ((timeinfo.tm_hour) * 300 + ((timeinfo.tm_min) * 5)) % 3600);
         lv_img_set_angle(min_img, (timeinfo.tm_min) * 60);
 
+#if SEC_IMG_CACHED
+        // The second hand is drawn from the cached rotated images so it ticks
+        lv_img_set_angle(sec_img, (timeinfo.tm_sec * 60) % 3600);
+#else
         lv_anim_t a;
         lv_anim_init(&a);
         lv_anim_set_var(&a, sec_img);
-        lv_anim_set_exec_cb(&a, sec_img_cb);
+        lv_anim_set_exec_cb(&a, sec_poin_anim_cb);
         lv_anim_set_values(&a, (timeinfo.tm_sec * 60) % 3600,
                            (timeinfo.tm_sec + 1) * 60);
         lv_anim_set_time(&a, 1000);
         lv_anim_start(&a);
+#endif
     }
 }
\ No newline at end of file
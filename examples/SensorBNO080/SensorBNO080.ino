@@ -44,7 +44,7 @@ void my_disp_flush( lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *colo
 
     tft.startWrite();
     tft.setAddrWindow( area->x1, area->y1, w, h );
-    tft.pushColors( ( uint16_t * )&color_p->full, w * h, false );
+    tft.pushColors( ( uint16_t * )&color_p->full, w * h, LV_COLOR_16_SWAP == 0 ); /*Swap the bytes here if LVGL renders native RGB565*/
     tft.endWrite();
 
     lv_disp_flush_ready( disp );
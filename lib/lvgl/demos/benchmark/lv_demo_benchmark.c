@@ -70,15 +70,15 @@ typedef struct {
 static lv_style_t style_common;
 static bool opa_mode = true;
 
-LV_IMG_DECLARE(img_benchmark_cogwheel_argb);
-LV_IMG_DECLARE(img_benchmark_cogwheel_rgb);
-LV_IMG_DECLARE(img_benchmark_cogwheel_chroma_keyed);
-LV_IMG_DECLARE(img_benchmark_cogwheel_indexed16);
-LV_IMG_DECLARE(img_benchmark_cogwheel_alpha16);
+LV_IMG_DECLARE(img_benchmark_cogwheel_argb)
+LV_IMG_DECLARE(img_benchmark_cogwheel_rgb)
+LV_IMG_DECLARE(img_benchmark_cogwheel_chroma_keyed)
+LV_IMG_DECLARE(img_benchmark_cogwheel_indexed16)
+LV_IMG_DECLARE(img_benchmark_cogwheel_alpha16)
 
-LV_FONT_DECLARE(lv_font_benchmark_montserrat_12_compr_az);
-LV_FONT_DECLARE(lv_font_benchmark_montserrat_16_compr_az);
-LV_FONT_DECLARE(lv_font_benchmark_montserrat_28_compr_az);
+LV_FONT_DECLARE(lv_font_benchmark_montserrat_12_compr_az)
+LV_FONT_DECLARE(lv_font_benchmark_montserrat_16_compr_az)
+LV_FONT_DECLARE(lv_font_benchmark_montserrat_28_compr_az)
 
 static void monitor_cb(lv_disp_drv_t * drv, uint32_t time, uint32_t px);
 static void scene_next_task_cb(lv_timer_t * timer);
@@ -90,6 +90,8 @@ static void arc_create(lv_style_t * style);
 static void fall_anim(lv_obj_t * obj);
 static void rnd_reset(void);
 static int32_t rnd_next(int32_t min, int32_t max);
+static void set_y_anim(void * obj, int32_t v);
+static void arc_set_end_angle_anim(void * obj, int32_t v);
 
 static void rectangle_cb(void)
 {
@@ -855,6 +857,7 @@ static void generate_report(void)
 
 static void report_cb(lv_timer_t * timer)
 {
+    LV_UNUSED(timer);
     if(opa_mode) {
         if(scene_act >= 0) {
             if(scenes[scene_act].time_sum_opa == 0) scenes[scene_act].time_sum_opa = 1;
@@ -893,7 +896,7 @@ void lv_demo_benchmark_run_scene(int_fast16_t scene_no)
 {
     benchmark_init();
 
-    if(((scene_no >> 1) >= dimof(scenes))) {
+    if(((size_t)(scene_no >> 1) >= dimof(scenes))) {
         /* invalid scene number */
         return ;
     }
@@ -902,7 +905,7 @@ void lv_demo_benchmark_run_scene(int_fast16_t scene_no)
     scene_act = scene_no >> 1;
 
     if(scenes[scene_act].create_cb) {
-        lv_label_set_text_fmt(title, "%"LV_PRId32"/%d: %s%s", scene_act * 2 + (opa_mode ? 1 : 0), (dimof(scenes) * 2) - 2,
+        lv_label_set_text_fmt(title, "%"LV_PRId32"/%d: %s%s", scene_act * 2 + (opa_mode ? 1 : 0), (int)(dimof(scenes) * 2) - 2,
                               scenes[scene_act].name, opa_mode ? " + opa" : "");
         if(opa_mode) {
             lv_label_set_text_fmt(subtitle, "Result of \"%s\": %"LV_PRId32" FPS", scenes[scene_act].name,
@@ -926,6 +929,27 @@ void lv_demo_benchmark_run_scene(int_fast16_t scene_no)
     }
 }
 
+const char * lv_demo_benchmark_load_scene(uint32_t scene_no)
+{
+    if((scene_no >> 1) >= dimof(scenes) - 1) return NULL;
+
+    /*The screen might have been cleaned since the last scene*/
+    if(scene_bg == NULL || !lv_obj_is_valid(scene_bg)) benchmark_init();
+    else lv_obj_clean(scene_bg);
+
+    opa_mode = scene_no & 0x01;
+    scene_act = scene_no >> 1;
+
+    lv_label_set_text_fmt(title, "%"LV_PRId32"/%d: %s%s", scene_act * 2 + (opa_mode ? 1 : 0), (int)(dimof(scenes) * 2) - 2,
+                          scenes[scene_act].name, opa_mode ? " + opa" : "");
+    lv_label_set_text(subtitle, "");
+
+    rnd_reset();
+    scenes[scene_act].create_cb();
+
+    return scenes[scene_act].name;
+}
+
 static void scene_next_task_cb(lv_timer_t * timer)
 {
     LV_UNUSED(timer);
@@ -950,7 +974,7 @@ static void scene_next_task_cb(lv_timer_t * timer)
 
     if(scenes[scene_act].create_cb) {
         lv_label_set_text_fmt(title, "%"LV_PRId32"/%d: %s%s", scene_act * 2 + (opa_mode ? 1 : 0),
-                              (dimof(scenes) * 2) - 2,  scenes[scene_act].name, opa_mode ? " + opa" : "");
+                              (int)(dimof(scenes) * 2) - 2,  scenes[scene_act].name, opa_mode ? " + opa" : "");
         if(opa_mode) {
             lv_label_set_text_fmt(subtitle, "Result of \"%s\": %"LV_PRId32" FPS", scenes[scene_act].name,
                                   scenes[scene_act].fps_normal);
@@ -1076,7 +1100,7 @@ static void arc_create(lv_style_t * style)
         lv_anim_t a;
         lv_anim_init(&a);
         lv_anim_set_var(&a, obj);
-        lv_anim_set_exec_cb(&a, (lv_anim_exec_xcb_t) lv_arc_set_end_angle);
+        lv_anim_set_exec_cb(&a, arc_set_end_angle_anim);
         lv_anim_set_values(&a, 0, 359);
         lv_anim_set_time(&a, t);
         lv_anim_set_playback_time(&a, t);
@@ -1097,7 +1121,7 @@ static void fall_anim(lv_obj_t * obj)
     lv_anim_t a;
     lv_anim_init(&a);
     lv_anim_set_var(&a, obj);
-    lv_anim_set_exec_cb(&a, (lv_anim_exec_xcb_t) lv_obj_set_y);
+    lv_anim_set_exec_cb(&a, set_y_anim);
     lv_anim_set_values(&a, 0, lv_obj_get_height(scene_bg) - lv_obj_get_height(obj));
     lv_anim_set_time(&a, t);
     lv_anim_set_playback_time(&a, t);
@@ -1133,4 +1157,14 @@ static int32_t rnd_next(int32_t min, int32_t max)
 
 }
 
+static void set_y_anim(void * obj, int32_t v)
+{
+    lv_obj_set_y(obj, v);
+}
+
+static void arc_set_end_angle_anim(void * obj, int32_t v)
+{
+    lv_arc_set_end_angle(obj, v);
+}
+
 #endif
@@ -30,6 +30,14 @@ void lv_demo_benchmark(void);
 
 void lv_demo_benchmark_run_scene(int_fast16_t scene_no);
 
+/**
+ * Create a scene without the timers which measure it and switch to the next scene.
+ * Useful to measure the scenes from outside, e.g. in a headless test.
+ * @param scene_no  `2 * i`: the i-th scene, `2 * i + 1`: the "+ opa" variant of the i-th scene
+ * @return          the name of the scene (without " + opa") or NULL if `scene_no` is too large
+ */
+const char * lv_demo_benchmark_load_scene(uint32_t scene_no);
+
 /**********************
  *      MACROS
  **********************/
@@ -26,8 +26,9 @@
 /*Color depth: 1 (1 byte per pixel), 8 (RGB332), 16 (RGB565), 32 (ARGB8888)*/
 #define LV_COLOR_DEPTH 16
 
-/*Swap the 2 bytes of RGB565 color. Useful if the display has an 8-bit interface (e.g. SPI)*/
-#define LV_COLOR_16_SWAP 1
+/*Swap the 2 bytes of RGB565 color. Useful if the display has an 8-bit interface (e.g. SPI).
+ *Rendering native RGB565 and swapping the bytes in the flush callback is faster.*/
+#define LV_COLOR_16_SWAP 0
 
 /*Enable more complex drawing routines to manage screens transparency.
  *Can be used if the UI is above another layer, e.g. an OSD menu or video player.
@@ -127,6 +128,22 @@
  *0: to disable caching*/
 #define LV_IMG_CACHE_DEF_SIZE   0
 
+/*Size of the buffer (in bytes) to read several lines at once from the images which are not decoded entirely,
+ *e.g. the images from files. Fewer, bigger reads are faster, especially with the decoders supporting `read_area_cb`.
+ *The lines are read one by one if a line is bigger. 0: to read line by line*/
+#define LV_IMG_READ_AREA_BUF_SIZE 4096
+
+/*Size of the cache (in bytes) of the rotated and zoomed variants of the images
+ *which are drawn with `lv_img_set_transform_cache()` enabled.
+ *0: to disable the transformation cache*/
+#define LV_IMG_TRANSFORM_CACHE_SIZE 0
+#if LV_IMG_TRANSFORM_CACHE_SIZE
+    /*Allocate the cached variants with these functions, e.g. to store them in external RAM*/
+    #define LV_IMG_TRANSFORM_CACHE_INCLUDE "../misc/lv_mem.h"
+    #define LV_IMG_TRANSFORM_CACHE_ALLOC   lv_mem_alloc
+    #define LV_IMG_TRANSFORM_CACHE_FREE    lv_mem_free
+#endif
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #define LV_GRADIENT_MAX_STOPS       2
@@ -153,6 +170,29 @@
  *Only used if software rotation is enabled in the display driver.*/
 #define LV_DISP_ROT_MAX_BUF (10*1024)
 
+/*Use the PIE (SIMD) instructions of the ESP32-S3 to fill and copy opaque areas.
+ *Only used with LV_COLOR_DEPTH 16.*/
+#define LV_DRAW_SW_ESP32S3_PIE 0
+
+/*Render the large refreshed areas in horizontal bands on more threads in parallel.
+ *E.g. the second core of a dual core MCU can render the lower half of the area while the first renders the upper half.
+ *It requires thread local storage support (`__thread`) from the compiler.
+ *Can be disabled per display with `disp_drv.parallel_render = 0`*/
+#define LV_USE_PARALLEL_RENDER 0
+#if LV_USE_PARALLEL_RENDER
+    /*Number of worker threads besides the thread calling `lv_timer_handler()`*/
+    #define LV_PARALLEL_RENDER_WORKERS 1
+
+    /*1: Create FreeRTOS tasks; 0: Create POSIX threads*/
+    #define LV_PARALLEL_RENDER_FREERTOS 0
+
+    /*Stack size of the FreeRTOS tasks in bytes*/
+    #define LV_PARALLEL_RENDER_STACK_SIZE (8 * 1024)
+
+    /*Pin the FreeRTOS tasks to this core on ESP32. -1: no affinity*/
+    #define LV_PARALLEL_RENDER_CORE -1
+#endif
+
 /*-------------
  * GPU
  *-----------*/
@@ -261,6 +301,37 @@
 /*1: Draw random colored rectangles over the redrawn areas*/
 #define LV_USE_REFR_DEBUG 0
 
+/*1: Tag the allocations of `lv_mem` with the class of the object being created or else their call site,
+ *and measure the live size, peak size and allocation rate per tag. Print them with `lv_mem_track_dump()`.
+ *Works with `LV_MEM_CUSTOM` too. Adds a small header to every allocation.*/
+#define LV_USE_MEM_TRACK 0
+#if LV_USE_MEM_TRACK
+    /*Max number of different tags. The rest is counted as "other"*/
+    #define LV_MEM_TRACK_TAG_MAX 128
+
+    /*Header and expression to tell if a memory is in the external RAM (e.g. PSRAM). 0: no external RAM*/
+    #define LV_MEM_TRACK_EXT_INCLUDE <stdint.h>
+    #define LV_MEM_TRACK_IS_EXT(p) 0
+#endif
+
+/*1: Record the drawing time of the objects and the flushing, and dump them with `lv_profiler_dump()`
+ *in Chrome's trace event format. Open the result in `chrome://tracing` or https://ui.perfetto.dev*/
+#define LV_USE_PROFILER 0
+#if LV_USE_PROFILER
+    /*Number of events to keep. The oldest events are overwritten*/
+    #define LV_PROFILER_BUF_SIZE 4096
+
+    /*Header and expression for the current time in microseconds*/
+    #define LV_PROFILER_TIME_INCLUDE <stdint.h>
+    #define LV_PROFILER_TIME_US_EXPR (lv_tick_get() * 1000)
+#endif
+
+/*1: Prefetch the next part of the files in the background after the decoders tell how they read them with
+ *`lv_fs_set_read_ahead()`. It needs drivers with `cache_size > 0` and doubles their cache memory.
+ *With `LV_USE_PARALLEL_RENDER` a thread reads ahead (so the driver needs to be thread safe),
+ *else it's done by a timer in `lv_timer_handler()`.*/
+#define LV_USE_FS_READ_AHEAD 0
+
 /*Change the built in (v)snprintf functions*/
 #define LV_SPRINTF_CUSTOM 0
 #if LV_SPRINTF_CUSTOM
@@ -373,8 +444,16 @@
  *Compiler error will be triggered if a font needs it.*/
 #define LV_FONT_FMT_TXT_LARGE 0
 
+/*Number of slots in the per-font glyph id and kerning caches (power of 2, 0 to disable).
+ *Saves searching the sparse character maps and kerning pairs for every letter.*/
+#define LV_FONT_FMT_TXT_CACHE_SIZE 32
+
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 0
+#if LV_USE_FONT_COMPRESSED
+    /*Number of decompressed glyph bitmaps kept between refreshes (0: decompress the letters on every refresh)*/
+    #define LV_FONT_COMPRESSED_CACHE_CNT 32
+#endif
 
 /*Enable subpixel rendering*/
 #define LV_USE_FONT_SUBPX 0
@@ -457,6 +536,7 @@
 #if LV_USE_LABEL
     #define LV_LABEL_TEXT_SELECTION 1 /*Enable selecting text of the label*/
     #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
+    #define LV_LABEL_LAYOUT_CACHE 1   /*Cache the line breaks of the labels to speed up drawing and hit-testing of multi-line texts*/
 #endif
 
 #define LV_USE_LINE       1
@@ -603,8 +683,25 @@
     #define LV_FS_FATFS_CACHE_SIZE 0    /*>0 to cache this number of bytes in lv_fs_read()*/
 #endif
 
+/*Read only, memory mapped files. Uses `mmap()` or `esp_partition_mmap()` on ESP32 where a file is a data partition.
+ *The decoders and the font loader use the content of these files directly instead of copying it to RAM.*/
+#define LV_USE_FS_MMAP 0
+#if LV_USE_FS_MMAP
+    #define LV_FS_MMAP_LETTER '\0'      /*Set an upper cased letter on which the drive will accessible (e.g. 'A')*/
+    #define LV_FS_MMAP_PATH ""          /*Set the working directory. File/directory paths will be appended to it.*/
+#endif
+
 /*PNG decoder library*/
 #define LV_USE_PNG 0
+#if LV_USE_PNG
+    /*Decode the images row by row while they are drawn if their decoded size is at least this many bytes.
+     *It needs only the inflate window (32 kB at most) and the cached rows instead of the whole image,
+     *but the image is decoded again when it's redrawn and it can't be zoomed or rotated.
+     *Interlaced images are always decoded at once. 0: disable*/
+    #define LV_PNG_STREAM_MIN_SIZE 0
+    /*Number of decoded rows to keep for the streamed images*/
+    #define LV_PNG_STREAM_CACHE_ROWS 8
+#endif
 
 /*BMP decoder library*/
 #define LV_USE_BMP 0
@@ -612,6 +709,13 @@
 /* JPG + split JPG decoder library.
  * Split JPG is a custom format optimized for embedded systems. */
 #define LV_USE_SJPG 0
+#if LV_USE_SJPG
+    /*Number of decoded fragments of an SJPG image to keep. Each needs `width x fragment height x 3` bytes*/
+    #define LV_SJPG_CACHE_FRAGMENTS 2
+    /*1: Decode the next fragment in the scroll direction in the next `lv_timer_handler()`.
+     *The decoders need to be kept open between the refreshes with `LV_IMG_CACHE_DEF_SIZE > 0`*/
+    #define LV_SJPG_DECODE_AHEAD 0
+#endif
 
 /*GIF decoder library*/
 #define LV_USE_GIF 1
@@ -64,6 +64,7 @@ static void lv_obj_set_state(lv_obj_t * obj, lv_state_t new_state);
  **********************/
 static bool lv_initialized = false;
 const lv_obj_class_t lv_obj_class = {
+    .name = "lv_obj",
     .constructor_cb = lv_obj_constructor,
     .destructor_cb = lv_obj_destructor,
     .event_cb = lv_obj_event,
@@ -133,6 +134,9 @@ void lv_init(void)
     _lv_img_decoder_init();
 #if LV_IMG_CACHE_DEF_SIZE
     lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
+#endif
+#if LV_IMG_TRANSFORM_CACHE_SIZE
+    _lv_img_transform_cache_init();
 #endif
     /*Test if the IDE has UTF-8 encoding*/
     char * txt = "Á";
@@ -472,7 +476,7 @@ static void lv_obj_draw(lv_event_t * e)
         lv_coord_t w = lv_obj_get_style_transform_width(obj, LV_PART_MAIN);
         lv_coord_t h = lv_obj_get_style_transform_height(obj, LV_PART_MAIN);
         lv_area_t coords;
-        lv_area_copy(&coords, &obj->coords);
+        lv_area_copy(&coords, _lv_obj_get_draw_coords(obj));
         coords.x1 -= w;
         coords.x2 += w;
         coords.y1 -= h;
@@ -515,7 +519,7 @@ static void lv_obj_draw(lv_event_t * e)
         lv_coord_t w = lv_obj_get_style_transform_width(obj, LV_PART_MAIN);
         lv_coord_t h = lv_obj_get_style_transform_height(obj, LV_PART_MAIN);
         lv_area_t coords;
-        lv_area_copy(&coords, &obj->coords);
+        lv_area_copy(&coords, _lv_obj_get_draw_coords(obj));
         coords.x1 -= w;
         coords.x2 += w;
         coords.y1 -= h;
@@ -546,7 +550,7 @@ static void lv_obj_draw(lv_event_t * e)
 #if LV_DRAW_COMPLEX
         if(clip_corner) {
             lv_draw_mask_radius_param_t * mp = lv_mem_buf_get(sizeof(lv_draw_mask_radius_param_t));
-            lv_draw_mask_radius_init(mp, &obj->coords, draw_dsc.radius, false);
+            lv_draw_mask_radius_init(mp, _lv_obj_get_draw_coords(obj), draw_dsc.radius, false);
             /*Add the mask and use `obj+8` as custom id. Don't use `obj` directly because it might be used by the user*/
             lv_draw_mask_add(mp, obj + 8);
 
@@ -590,7 +594,7 @@ static void lv_obj_draw(lv_event_t * e)
             lv_coord_t w = lv_obj_get_style_transform_width(obj, LV_PART_MAIN);
             lv_coord_t h = lv_obj_get_style_transform_height(obj, LV_PART_MAIN);
             lv_area_t coords;
-            lv_area_copy(&coords, &obj->coords);
+            lv_area_copy(&coords, _lv_obj_get_draw_coords(obj));
             coords.x1 -= w;
             coords.x2 += w;
             coords.y1 -= h;
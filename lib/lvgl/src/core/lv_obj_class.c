@@ -44,7 +44,13 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
 {
     LV_TRACE_OBJ_CREATE("Creating object with %p class on %p parent", (void *)class_p, (void *)parent);
     uint32_t s = get_instance_size(class_p);
+#if LV_USE_MEM_TRACK
+    const char * track_prev = _lv_mem_track_set_class(class_p->name);
     lv_obj_t * obj = lv_mem_alloc(s);
+    _lv_mem_track_set_class(track_prev);
+#else
+    lv_obj_t * obj = lv_mem_alloc(s);
+#endif
     if(obj == NULL) return NULL;
     lv_memset_00(obj, s);
     obj->class_p = class_p;
@@ -103,6 +109,11 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
 
 void lv_obj_class_init_obj(lv_obj_t * obj)
 {
+#if LV_USE_MEM_TRACK
+    /*Tag the styles, the attributes, etc. created by the theme and the constructors with the object's class*/
+    const char * track_prev = _lv_mem_track_set_class(obj->class_p->name);
+#endif
+
     lv_obj_mark_layout_as_dirty(obj);
     lv_obj_enable_style_refresh(false);
 
@@ -129,6 +140,10 @@ void lv_obj_class_init_obj(lv_obj_t * obj)
         /*Invalidate the area if not screen created*/
         lv_obj_invalidate(obj);
     }
+
+#if LV_USE_MEM_TRACK
+    _lv_mem_track_set_class(track_prev);
+#endif
 }
 
 void _lv_obj_destruct(lv_obj_t * obj)
@@ -48,6 +48,7 @@ typedef void (*lv_obj_class_event_cb_t)(struct _lv_obj_class_t * class_p, struct
  */
 typedef struct _lv_obj_class_t {
     const struct _lv_obj_class_t * base_class;
+    const char * name;                 /**< Name of the class, e.g. to show it in the profiler*/
     void (*constructor_cb)(const struct _lv_obj_class_t * class_p, struct _lv_obj_t * obj);
     void (*destructor_cb)(const struct _lv_obj_class_t * class_p, struct _lv_obj_t * obj);
 #if LV_USE_USER_DATA
@@ -10,6 +10,7 @@
 #include "lv_obj.h"
 #include "lv_disp.h"
 #include "lv_indev.h"
+#include "../misc/lv_thread.h"
 
 /*********************
  *      DEFINES
@@ -27,6 +28,8 @@
 /**********************
  *  STATIC VARIABLES
  **********************/
+static LV_THREAD_LOCAL const lv_obj_t * draw_coords_obj;
+static LV_THREAD_LOCAL lv_area_t draw_coords;
 
 /**********************
  *      MACROS
@@ -373,6 +376,22 @@ lv_coord_t _lv_obj_get_ext_draw_size(const lv_obj_t * obj)
     else return 0;
 }
 
+void _lv_obj_set_draw_coords(const lv_obj_t * obj, const lv_area_t * coords)
+{
+    draw_coords_obj = obj;
+    lv_area_copy(&draw_coords, coords);
+}
+
+void _lv_obj_reset_draw_coords(void)
+{
+    draw_coords_obj = NULL;
+}
+
+const lv_area_t * _lv_obj_get_draw_coords(const lv_obj_t * obj)
+{
+    return obj == draw_coords_obj ? &draw_coords : &obj->coords;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
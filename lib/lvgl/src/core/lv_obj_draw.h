@@ -152,6 +152,27 @@ void lv_obj_refresh_ext_draw_size(struct _lv_obj_t * obj);
  */
 lv_coord_t _lv_obj_get_ext_draw_size(const struct _lv_obj_t * obj);
 
+/**
+ * Draw an object as if it had other coordinates without changing `obj->coords`.
+ * It affects only the calling thread until `_lv_obj_reset_draw_coords()`,
+ * so the other rendering threads still see the real coordinates.
+ * @param obj       pointer to an object
+ * @param coords    the coordinates to use while drawing `obj`
+ */
+void _lv_obj_set_draw_coords(const struct _lv_obj_t * obj, const lv_area_t * coords);
+
+/**
+ * Stop overriding the coordinates set by `_lv_obj_set_draw_coords()`.
+ */
+void _lv_obj_reset_draw_coords(void);
+
+/**
+ * Get the coordinates to draw an object with.
+ * @param obj       pointer to an object
+ * @return          the coordinates set by `_lv_obj_set_draw_coords()` or `obj->coords`
+ */
+const lv_area_t * _lv_obj_get_draw_coords(const struct _lv_obj_t * obj);
+
 /**********************
  *      MACROS
  **********************/
@@ -10,6 +10,7 @@
 #include "lv_disp.h"
 #include "lv_refr.h"
 #include "../misc/lv_gc.h"
+#include "../misc/lv_profiler.h"
 
 /*********************
  *      DEFINES
@@ -307,11 +308,15 @@ void lv_obj_update_layout(const lv_obj_t * obj)
     lv_obj_t * scr = lv_obj_get_screen(obj);
 
     /*Repeat until there where layout invalidations*/
-    while(scr->scr_layout_inv) {
-        LV_LOG_INFO("Layout update begin");
-        scr->scr_layout_inv = 0;
-        layout_update_core(scr);
-        LV_LOG_TRACE("Layout update end");
+    if(scr->scr_layout_inv) {
+        LV_PROFILER_BEGIN("layout", "layout", &scr->coords);
+        while(scr->scr_layout_inv) {
+            LV_LOG_INFO("Layout update begin");
+            scr->scr_layout_inv = 0;
+            layout_update_core(scr);
+            LV_LOG_TRACE("Layout update end");
+        }
+        LV_PROFILER_END("layout", "layout");
     }
 
     mutex = false;
@@ -9,6 +9,7 @@
 #include "lv_obj.h"
 #include "lv_disp.h"
 #include "../misc/lv_gc.h"
+#include "../misc/lv_thread.h"
 
 /*********************
  *      DEFINES
@@ -59,6 +60,11 @@ static void fade_in_anim_ready(lv_anim_t * a);
  **********************/
 static bool style_refr = true;
 
+/*Get the styles of this object in an other state without transitions while drawing it.
+ *Per thread because more rendering threads might draw the same object.*/
+static LV_THREAD_LOCAL const lv_obj_t * draw_state_obj;
+static LV_THREAD_LOCAL lv_state_t draw_state;
+
 /**********************
  *      MACROS
  **********************/
@@ -427,6 +433,17 @@ _lv_style_state_cmp_t _lv_obj_style_state_compare(lv_obj_t * obj, lv_state_t sta
     return res;
 }
 
+void _lv_obj_style_set_draw_state(const lv_obj_t * obj, lv_state_t state)
+{
+    draw_state_obj = obj;
+    draw_state = state;
+}
+
+void _lv_obj_style_reset_draw_state(void)
+{
+    draw_state_obj = NULL;
+}
+
 void lv_obj_fade_in(lv_obj_t * obj, uint32_t time, uint32_t delay)
 {
     lv_anim_t a;
@@ -548,10 +565,11 @@ static bool get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t
 {
     uint8_t group = 1 << _lv_style_get_prop_group(prop);
     int32_t weight = -1;
-    lv_state_t state = obj->state;
+    bool draw_state_act = obj == draw_state_obj;
+    lv_state_t state = draw_state_act ? draw_state : obj->state;
     lv_state_t state_inv = ~state;
     lv_style_value_t value_tmp;
-    bool skip_trans = obj->skip_trans;
+    bool skip_trans = draw_state_act || obj->skip_trans;
     uint32_t i;
     bool found;
     for(i = 0; i < obj->style_cnt; i++) {
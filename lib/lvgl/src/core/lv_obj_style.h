@@ -177,6 +177,20 @@ void _lv_obj_style_create_transition(struct _lv_obj_t * obj, lv_part_t part, lv_
  */
 _lv_style_state_cmp_t _lv_obj_style_state_compare(struct _lv_obj_t * obj, lv_state_t state1, lv_state_t state2);
 
+/**
+ * Used internally to get the styles of an object in an other state while drawing it (e.g. a button of a button matrix).
+ * The transitions are skipped. Unlike setting `obj->state` it doesn't modify the object,
+ * so it's safe if more rendering threads draw the object.
+ * @param obj       pointer to an object
+ * @param state     get the styles of `obj` in this state on the calling thread
+ */
+void _lv_obj_style_set_draw_state(const struct _lv_obj_t * obj, lv_state_t state);
+
+/**
+ * Get the styles with the real state of the object again.
+ */
+void _lv_obj_style_reset_draw_state(void);
+
 /**
  * Fade in an an object and all its children.
  * @param obj       the object to fade in
@@ -17,6 +17,12 @@
 #include "../misc/lv_gc.h"
 #include "../draw/lv_draw.h"
 #include "../font/lv_font_fmt_txt.h"
+#include "../misc/lv_thread.h"
+#include "../misc/lv_profiler.h"
+
+#if LV_USE_PARALLEL_RENDER
+    #include "../draw/sw/lv_draw_sw.h"
+#endif
 
 #if LV_USE_PERF_MONITOR || LV_USE_MEM_MONITOR
     #include "../widgets/lv_label.h"
@@ -25,10 +31,21 @@
 /*********************
  *      DEFINES
  *********************/
+/*Don't split smaller areas to bands because starting the workers would cost more than the gain*/
+#define PARALLEL_RENDER_MIN_BAND_PX    2048
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_PARALLEL_RENDER
+typedef struct {
+    lv_thread_sync_t * start;
+    lv_thread_sync_t * done;
+    lv_draw_sw_ctx_t draw_ctx;  /*Copy of the display's draw_ctx with the band as clip area*/
+    lv_area_t clip_area;
+} render_worker_t;
+#endif
+
 typedef struct {
     uint32_t    perf_last_time;
     uint32_t    elaps_sum;
@@ -54,6 +71,12 @@ static void lv_refr_join_area(void);
 static void lv_refr_areas(void);
 static void lv_refr_area(const lv_area_t * area_p);
 static void lv_refr_area_part(lv_draw_ctx_t * draw_ctx);
+static void refr_draw_part(lv_draw_ctx_t * draw_ctx);
+#if LV_USE_PARALLEL_RENDER
+    static bool refr_draw_part_parallel(lv_draw_ctx_t * draw_ctx);
+    static bool render_workers_init(void);
+    static void render_worker_cb(void * user_data);
+#endif
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void lv_refr_obj_and_children(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_obj);
 static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area_h);
@@ -73,6 +96,12 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
 static uint32_t px_num;
 static lv_disp_t * disp_refr; /*Display being refreshed*/
 
+#if LV_USE_PARALLEL_RENDER
+    static render_worker_t render_workers[LV_PARALLEL_RENDER_WORKERS];
+    static bool render_workers_inited;
+    static bool render_workers_ok;
+#endif
+
 #if LV_USE_PERF_MONITOR
     static perf_monitor_t   perf_monitor;
 #endif
@@ -144,6 +173,7 @@ void lv_refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
     bool should_draw = com_clip_res || lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
     if(should_draw) {
         draw_ctx->clip_area = &clip_coords_for_obj;
+        LV_PROFILER_BEGIN(obj->class_p->name, "obj", &obj->coords);
 
         /*Draw the object*/
         lv_event_send(obj, LV_EVENT_DRAW_MAIN_BEGIN, draw_ctx);
@@ -194,6 +224,7 @@ void lv_refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
         lv_event_send(obj, LV_EVENT_DRAW_POST_BEGIN, draw_ctx);
         lv_event_send(obj, LV_EVENT_DRAW_POST, draw_ctx);
         lv_event_send(obj, LV_EVENT_DRAW_POST_END, draw_ctx);
+        LV_PROFILER_END(obj->class_p->name, "obj");
     }
 
     draw_ctx->clip_area = clip_area_ori;
@@ -621,11 +652,32 @@ static void lv_refr_area_part(lv_draw_ctx_t * draw_ctx)
     /* Below the `area_p` area will be redrawn into the draw buffer.
      * In single buffered mode wait here until the buffer is freed.*/
     if(draw_buf->buf1 && !draw_buf->buf2) {
+        LV_PROFILER_BEGIN("flush_wait", "flush", NULL);
         while(draw_buf->flushing) {
             if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
         }
+        LV_PROFILER_END("flush_wait", "flush");
     }
 
+#if LV_USE_PARALLEL_RENDER
+    if(!refr_draw_part_parallel(draw_ctx)) refr_draw_part(draw_ctx);
+#else
+    refr_draw_part(draw_ctx);
+#endif
+
+    /*In true double buffered mode flush only once when all areas were rendered.
+     *In normal mode flush after every area*/
+    if(disp_refr->driver->full_refresh == false) {
+        draw_buf_flush(disp_refr);
+    }
+}
+
+/**
+ * Draw the screens and the layers to the clip area of a draw_ctx.
+ * @param draw_ctx  pointer to a draw context
+ */
+static void refr_draw_part(lv_draw_ctx_t * draw_ctx)
+{
     lv_obj_t * top_act_scr = NULL;
     lv_obj_t * top_prev_scr = NULL;
 
@@ -695,14 +747,112 @@ static void lv_refr_area_part(lv_draw_ctx_t * draw_ctx)
     /*Also refresh top and sys layer unconditionally*/
     lv_refr_obj_and_children(draw_ctx, lv_disp_get_layer_top(disp_refr));
     lv_refr_obj_and_children(draw_ctx, lv_disp_get_layer_sys(disp_refr));
+}
 
-    /*In true double buffered mode flush only once when all areas were rendered.
-     *In normal mode flush after every area*/
-    if(disp_refr->driver->full_refresh == false) {
-        draw_buf_flush(disp_refr);
+#if LV_USE_PARALLEL_RENDER
+
+/**
+ * Split the clip area of a draw_ctx to horizontal bands and render them on the workers and the calling thread.
+ * The bands are disjoint rows of the same draw buffer, so the result is the same as rendering the whole area at once.
+ * @param draw_ctx  pointer to the display's draw context
+ * @return          true: the area is rendered; false: it wasn't worth or possible to render it in parallel
+ */
+static bool refr_draw_part_parallel(lv_draw_ctx_t * draw_ctx)
+{
+    lv_disp_drv_t * driver = disp_refr->driver;
+    if(!driver->parallel_render || driver->draw_ctx_size != sizeof(lv_draw_sw_ctx_t)) return false;
+
+    const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+    int32_t h = lv_area_get_height(clip_area_ori);
+    uint32_t size = lv_area_get_size(clip_area_ori);
+    int32_t band_cnt = LV_PARALLEL_RENDER_WORKERS + 1;
+    while(band_cnt > 1 && (size / band_cnt < PARALLEL_RENDER_MIN_BAND_PX || h < band_cnt)) band_cnt--;
+    if(band_cnt < 2) return false;
+
+    if(!render_workers_init()) return false;
+
+    int32_t i;
+    for(i = 1; i < band_cnt; i++) {
+        render_worker_t * worker = &render_workers[i - 1];
+        lv_memcpy(&worker->draw_ctx, draw_ctx, sizeof(lv_draw_sw_ctx_t));
+        lv_area_copy(&worker->clip_area, clip_area_ori);
+        worker->clip_area.y1 = clip_area_ori->y1 + (h * i) / band_cnt;
+        worker->clip_area.y2 = clip_area_ori->y1 + (h * (i + 1)) / band_cnt - 1;
+        worker->draw_ctx.base_draw.clip_area = &worker->clip_area;
+    }
+
+    _lv_render_set_parallel(true);
+    for(i = 1; i < band_cnt; i++) {
+        _lv_thread_sync_signal(render_workers[i - 1].start);
+    }
+
+    /*Render the first band on this thread*/
+    lv_area_t band_area;
+    lv_area_copy(&band_area, clip_area_ori);
+    band_area.y2 = clip_area_ori->y1 + h / band_cnt - 1;
+    draw_ctx->clip_area = &band_area;
+    refr_draw_part(draw_ctx);
+    if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
+    draw_ctx->clip_area = clip_area_ori;
+
+    for(i = 1; i < band_cnt; i++) {
+        _lv_thread_sync_wait(render_workers[i - 1].done);
     }
+    _lv_render_set_parallel(false);
+
+    return true;
 }
 
+/**
+ * Start the rendering workers on the first call.
+ * @return true: the workers are running
+ */
+static bool render_workers_init(void)
+{
+    if(render_workers_inited) return render_workers_ok;
+    render_workers_inited = true;
+
+    uint32_t i;
+    for(i = 0; i < LV_PARALLEL_RENDER_WORKERS; i++) {
+        render_worker_t * worker = &render_workers[i];
+        worker->start = _lv_thread_sync_create();
+        worker->done = _lv_thread_sync_create();
+        if(worker->start == NULL || worker->done == NULL ||
+           _lv_thread_create(render_worker_cb, worker) == NULL) {
+            LV_LOG_WARN("couldn't start the rendering workers. Render on a single thread.");
+            return false;
+        }
+    }
+
+    render_workers_ok = true;
+    return true;
+}
+
+static void render_worker_cb(void * user_data)
+{
+    render_worker_t * worker = user_data;
+    lv_draw_ctx_t * draw_ctx = &worker->draw_ctx.base_draw;
+
+#if LV_USE_PROFILER
+    /*Show the bands of the workers below the calling thread's*/
+    _lv_profiler_set_tid((uint8_t)(worker - render_workers) + 1);
+#endif
+
+    while(1) {
+        _lv_thread_sync_wait(worker->start);
+
+        refr_draw_part(draw_ctx);
+        if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
+
+        /*The main thread does the same after every refresh*/
+        lv_mem_buf_free_all();
+
+        _lv_thread_sync_signal(worker->done);
+    }
+}
+
+#endif /*LV_USE_PARALLEL_RENDER*/
+
 /**
  * Search the most top object which fully covers an area
  * @param area_p pointer to an area
@@ -1024,9 +1174,11 @@ static void draw_buf_flush(lv_disp_t * disp)
     /* In double buffered mode wait until the other buffer is freed
      * and driver is ready to receive the new buffer */
     if(draw_buf->buf1 && draw_buf->buf2) {
+        LV_PROFILER_BEGIN("flush_wait", "flush", NULL);
         while(draw_buf->flushing) {
             if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
         }
+        LV_PROFILER_END("flush_wait", "flush");
     }
 
     draw_buf->flushing = 1;
@@ -1066,7 +1218,9 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
         .y2 = area->y2 + drv->offset_y
     };
 
+    LV_PROFILER_BEGIN("flush_cb", "flush", &offset_area);
     drv->flush_cb(drv, &offset_area, color_p);
+    LV_PROFILER_END("flush_cb", "flush");
 }
 
 #if LV_USE_PERF_MONITOR
@@ -9,6 +9,7 @@ CSRCS += lv_draw_triangle.c
 CSRCS += lv_img_buf.c
 CSRCS += lv_img_cache.c
 CSRCS += lv_img_decoder.c
+CSRCS += lv_img_transform_cache.c
 
 DEPPATH += --dep-path $(LVGL_DIR)/$(LVGL_DIR_NAME)/src/draw
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/draw
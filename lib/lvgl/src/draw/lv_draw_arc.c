@@ -8,6 +8,7 @@
  *********************/
 #include "lv_draw.h"
 #include "lv_draw_arc.h"
+#include "../misc/lv_profiler.h"
 
 /*********************
  *      DEFINES
@@ -48,7 +49,9 @@ void lv_draw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const
     if(dsc->width == 0) return;
     if(start_angle == end_angle) return;
 
+    LV_PROFILER_BEGIN("arc", "draw", NULL);
     draw_ctx->draw_arc(draw_ctx, dsc, center, radius, start_angle, end_angle);
+    LV_PROFILER_END("arc", "draw");
 
     //    const lv_draw_backend_t * backend = lv_draw_backend_get();
     //    backend->draw_arc(center_x, center_y, radius, start_angle, end_angle, clip_area, dsc);
@@ -13,6 +13,8 @@
 #include "../core/lv_refr.h"
 #include "../misc/lv_mem.h"
 #include "../misc/lv_math.h"
+#include "../misc/lv_thread.h"
+#include "../misc/lv_profiler.h"
 
 /*********************
  *      DEFINES
@@ -69,14 +71,22 @@ void lv_draw_img(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const
 
     if(dsc->opa <= LV_OPA_MIN) return;
 
+    LV_PROFILER_BEGIN("img", "draw", coords);
+
     lv_res_t res;
     if(draw_ctx->draw_img) {
         res = draw_ctx->draw_img(draw_ctx, dsc, coords, src);
     }
     else {
+        /*The cached images, the file system drivers and the decoders of the files are shared by the rendering threads*/
+        bool lock = LV_IMG_CACHE_DEF_SIZE || lv_img_src_get_type(src) == LV_IMG_SRC_FILE;
+        if(lock) _lv_render_lock();
         res = decode_and_draw(draw_ctx, dsc, coords, src);
+        if(lock) _lv_render_unlock();
     }
 
+    LV_PROFILER_END("img", "draw");
+
     if(res == LV_RES_INV) {
         LV_LOG_WARN("Image draw error");
         show_error(draw_ctx, coords, "No\ndata");
@@ -278,7 +288,7 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t decode_and_draw(lv_draw_ctx_t * draw_ctx,
         lv_draw_img_decoded(draw_ctx, draw_dsc, coords, cdsc->dec_dsc.img_data, cf);
         draw_ctx->clip_area = clip_area_ori;
     }
-    /*The whole uncompressed image is not available. Try to read it line-by-line*/
+    /*The whole uncompressed image is not available. Try to read it in strips of lines*/
     else {
         lv_area_t mask_com; /*Common area of mask and coords*/
         bool union_ok;
@@ -289,39 +299,41 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t decode_and_draw(lv_draw_ctx_t * draw_ctx,
             return LV_RES_OK;
         }
 
-        int32_t width = lv_area_get_width(&mask_com);
+        /*+1 because of the possible alpha byte*/
+        uint32_t line_size = lv_area_get_width(&mask_com) * LV_IMG_PX_SIZE_ALPHA_BYTE;
 
-        uint8_t  * buf = lv_mem_buf_get(lv_area_get_width(&mask_com) *
-                                        LV_IMG_PX_SIZE_ALPHA_BYTE);  /*+1 because of the possible alpha byte*/
+        /*Always ask for the same size (if a line fits) to get the same `lv_mem_buf` every time*/
+        uint32_t buf_size = LV_IMG_READ_AREA_BUF_SIZE;
+        if(buf_size < line_size) buf_size = line_size;
+        int32_t strip_h = buf_size / line_size;
+        strip_h = LV_MIN(strip_h, lv_area_get_height(&mask_com));
+
+        uint8_t  * buf = lv_mem_buf_get(buf_size);
 
         const lv_area_t * clip_area_ori = draw_ctx->clip_area;
-        lv_area_t line;
-        lv_area_copy(&line, &mask_com);
-        lv_area_set_height(&line, 1);
-        int32_t x = mask_com.x1 - coords->x1;
-        int32_t y = mask_com.y1 - coords->y1;
-        int32_t row;
+        lv_area_t strip;
+        lv_area_copy(&strip, &mask_com);
         lv_res_t read_res;
-        for(row = mask_com.y1; row <= mask_com.y2; row++) {
-            lv_area_t mask_line;
-            union_ok = _lv_area_intersect(&mask_line, clip_area_ori, &line);
-            if(union_ok == false) continue;
-
-            read_res = lv_img_decoder_read_line(&cdsc->dec_dsc, x, y, width, buf);
+        for(strip.y1 = mask_com.y1; strip.y1 <= mask_com.y2; strip.y1 += strip_h) {
+            strip.y2 = LV_MIN(strip.y1 + strip_h - 1, mask_com.y2);
+
+            /*The area to read relative to the image*/
+            lv_area_t read_area;
+            lv_area_copy(&read_area, &strip);
+            lv_area_move(&read_area, -coords->x1, -coords->y1);
+            read_res = lv_img_decoder_read_area(&cdsc->dec_dsc, &read_area, buf);
             if(read_res != LV_RES_OK) {
                 lv_img_decoder_close(&cdsc->dec_dsc);
-                LV_LOG_WARN("Image draw can't read the line");
+                LV_LOG_WARN("Image draw can't read the lines");
                 lv_mem_buf_release(buf);
                 draw_cleanup(cdsc);
                 draw_ctx->clip_area = clip_area_ori;
                 return LV_RES_INV;
             }
 
-            draw_ctx->clip_area = &mask_line;
-            lv_draw_img_decoded(draw_ctx, draw_dsc, &line, buf, cf);
-            line.y1++;
-            line.y2++;
-            y++;
+            /*The strip is inside the original clip area*/
+            draw_ctx->clip_area = &strip;
+            lv_draw_img_decoded(draw_ctx, draw_dsc, &strip, buf, cf);
         }
         draw_ctx->clip_area = clip_area_ori;
         lv_mem_buf_release(buf);
@@ -13,6 +13,7 @@
 #include "../core/lv_refr.h"
 #include "../misc/lv_bidi.h"
 #include "../misc/lv_assert.h"
+#include "../misc/lv_profiler.h"
 
 /*********************
  *      DEFINES
@@ -35,6 +36,10 @@ typedef uint8_t cmd_state_t;
  **********************/
 
 static uint8_t hex_char_to_num(char hex);
+static uint32_t get_line_end(const char * txt, uint32_t line_start, uint32_t line_idx, lv_coord_t w,
+                             const lv_draw_label_dsc_t * dsc, const lv_txt_layout_t * layout);
+static lv_coord_t get_line_width(const char * txt, uint32_t line_start, uint32_t line_end, uint32_t line_idx,
+                                 const lv_draw_label_dsc_t * dsc, const lv_txt_layout_t * layout);
 
 /**********************
  *  STATIC VARIABLES
@@ -101,15 +106,29 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
     bool clip_ok = _lv_area_intersect(&clipped_area, coords, draw_ctx->clip_area);
     if(!clip_ok) return;
 
+    LV_PROFILER_BEGIN("label", "draw", &clipped_area);
+
     lv_text_align_t align = dsc->align;
     lv_base_dir_t base_dir = dsc->bidi_dir;
 
     lv_bidi_calculate_align(&align, &base_dir, txt);
 
+    /*Use the cached line breaks if they were made with the same parameters*/
+    const lv_txt_layout_t * layout = hint ? hint->layout : NULL;
+    if(layout && !_lv_txt_layout_match(layout, txt, font, dsc->letter_space, lv_area_get_width(coords), dsc->flag)) {
+        layout = NULL;
+    }
+
+    /*The layout makes it cheap to find the first visible line so the hint is not required*/
+    if(layout) hint = NULL;
+
     if((dsc->flag & LV_TEXT_FLAG_EXPAND) == 0) {
         /*Normally use the label's width as width*/
         w = lv_area_get_width(coords);
     }
+    else if(layout) {
+        w = layout->width;
+    }
     else {
         /*If EXPAND is enabled then not limit the text's width to the object's width*/
         lv_point_t p;
@@ -134,6 +153,7 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
     pos.y += y_ofs;
 
     uint32_t line_start     = 0;
+    uint32_t line_idx       = 0;
     int32_t last_line_start = -1;
 
     /*Check the hint to use the cached info*/
@@ -151,13 +171,14 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
         pos.y += hint->y;
     }
 
-    uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+    uint32_t line_end = get_line_end(txt, line_start, line_idx, w, dsc, layout);
 
     /*Go the first visible line*/
     while(pos.y + line_height_font < draw_ctx->clip_area->y1) {
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_idx++;
+        line_end = get_line_end(txt, line_start, line_idx, w, dsc, layout);
         pos.y += line_height;
 
         /*Save at the threshold coordinate*/
@@ -167,19 +188,22 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
             hint->coord_y    = coords->y1;
         }
 
-        if(txt[line_start] == '\0') return;
+        if(txt[line_start] == '\0') {
+            LV_PROFILER_END("label", "draw");
+            return;
+        }
     }
 
     /*Align to middle*/
     if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        line_width = get_line_width(txt, line_start, line_end, line_idx, dsc, layout);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        line_width = get_line_width(txt, line_start, line_end, line_idx, dsc, layout);
         pos.x += lv_area_get_width(coords) - line_width;
     }
     uint32_t sel_start = dsc->sel_start;
@@ -334,30 +358,33 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_idx++;
+        line_end = get_line_end(txt, line_start, line_idx, w, dsc, layout);
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = get_line_width(txt, line_start, line_end, line_idx, dsc, layout);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
         }
         /*Align to the right*/
         else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = get_line_width(txt, line_start, line_end, line_idx, dsc, layout);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
         /*Go the next line position*/
         pos.y += line_height;
 
-        if(pos.y > draw_ctx->clip_area->y2) return;
+        if(pos.y > draw_ctx->clip_area->y2) {
+            LV_PROFILER_END("label", "draw");
+            return;
+        }
     }
 
+    LV_PROFILER_END("label", "draw");
     LV_ASSERT_MEM_INTEGRITY();
 }
 
@@ -372,6 +399,42 @@ void lv_draw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get the end of a line from the layout cache or by breaking the text
+ * @param txt the text
+ * @param line_start byte index of the start of the line
+ * @param line_idx index of the line
+ * @param w max width of the lines
+ * @param dsc pointer to draw descriptor
+ * @param layout cached line breaks of `txt` or NULL
+ * @return byte index of the start of the next line
+ */
+static uint32_t get_line_end(const char * txt, uint32_t line_start, uint32_t line_idx, lv_coord_t w,
+                             const lv_draw_label_dsc_t * dsc, const lv_txt_layout_t * layout)
+{
+    if(layout) return line_idx < layout->line_cnt ? layout->line_start[line_idx + 1] : line_start;
+
+    return line_start + _lv_txt_get_next_line(&txt[line_start], dsc->font, dsc->letter_space, w, NULL, dsc->flag);
+}
+
+/**
+ * Get the width of a line from the layout cache or by measuring the letters
+ * @param txt the text
+ * @param line_start byte index of the start of the line
+ * @param line_end byte index of the start of the next line
+ * @param line_idx index of the line
+ * @param dsc pointer to draw descriptor
+ * @param layout cached line breaks of `txt` or NULL
+ * @return width of the line
+ */
+static lv_coord_t get_line_width(const char * txt, uint32_t line_start, uint32_t line_end, uint32_t line_idx,
+                                 const lv_draw_label_dsc_t * dsc, const lv_txt_layout_t * layout)
+{
+    if(layout) return line_idx < layout->line_cnt ? layout->line_width[line_idx] : 0;
+
+    return lv_txt_get_width(&txt[line_start], line_end - line_start, dsc->font, dsc->letter_space, dsc->flag);
+}
+
 /**
  * Convert a hexadecimal characters to a number (0..15)
  * @param hex Pointer to a hexadecimal character (0..9, A..F)
@@ -61,6 +61,10 @@ typedef struct _lv_draw_label_hint_t {
     /** The 'y1' coordinate of the label when the hint was saved.
      * Used to invalidate the hint if the label has moved too much.*/
     int32_t coord_y;
+
+    /** Cached line breaks of the text or NULL.
+     * Used instead of breaking the lines again if it was made with the same text and parameters.*/
+    const lv_txt_layout_t * layout;
 } lv_draw_label_hint_t;
 
 struct _lv_draw_ctx_t;
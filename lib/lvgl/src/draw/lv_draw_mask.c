@@ -213,6 +213,7 @@ void lv_draw_mask_free_param(void * p)
     if(pdsc->type == LV_DRAW_MASK_TYPE_RADIUS) {
         lv_draw_mask_radius_param_t * radius_p = (lv_draw_mask_radius_param_t *) p;
         if(radius_p->circle) {
+            _lv_render_lock();
             if(radius_p->circle->life < 0) {
                 lv_mem_free(radius_p->circle->cir_opa);
                 lv_mem_free(radius_p->circle);
@@ -220,6 +221,7 @@ void lv_draw_mask_free_param(void * p)
             else {
                 radius_p->circle->used_cnt--;
             }
+            _lv_render_unlock();
         }
     }
     else if(pdsc->type == LV_DRAW_MASK_TYPE_POLYGON) {
@@ -492,12 +494,17 @@ void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area
 
     uint32_t i;
 
+    /*The cache is shared by the rendering threads. Keep it locked until the new entry is calculated
+     *to not let the others use it before that*/
+    _lv_render_lock();
+
     /*Try to reuse a circle cache entry*/
     for(i = 0; i < LV_CIRCLE_CACHE_SIZE; i++) {
         if(LV_GC_ROOT(_lv_circle_cache[i]).radius == radius) {
             LV_GC_ROOT(_lv_circle_cache[i]).used_cnt++;
             CIRCLE_CACHE_AGING(LV_GC_ROOT(_lv_circle_cache[i]).life, radius);
             param->circle = &LV_GC_ROOT(_lv_circle_cache[i]);
+            _lv_render_unlock();
             return;
         }
     }
@@ -526,6 +533,8 @@ void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area
     param->circle = entry;
 
     circ_calc_aa4(param->circle, radius);
+
+    _lv_render_unlock();
 }
 
 /**
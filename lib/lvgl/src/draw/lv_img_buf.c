@@ -25,6 +25,12 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_DRAW_COMPLEX
+static inline void transform_point(const lv_img_transform_dsc_t * dsc, int32_t xt, int32_t yt, int32_t * xs,
+                                   int32_t * ys);
+static int32_t transform_side(const lv_img_transform_dsc_t * dsc, int32_t x, int32_t y, bool hor);
+static bool transform_clip_span(const lv_img_transform_dsc_t * dsc, int32_t y, int32_t * x1, int32_t * x2, bool hor);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -571,28 +577,9 @@ bool _lv_img_buf_transform(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_
     const uint8_t * src_u8 = (const uint8_t *)dsc->cfg.src;
 
     /*Get the target point relative coordinates to the pivot*/
-    int32_t xt = x - dsc->cfg.pivot_x;
-    int32_t yt = y - dsc->cfg.pivot_y;
-
     int32_t xs;
     int32_t ys;
-    if(dsc->cfg.zoom == LV_IMG_ZOOM_NONE) {
-        /*Get the source pixel from the upscaled image*/
-        xs = ((dsc->tmp.cosma * xt - dsc->tmp.sinma * yt) >> (_LV_TRANSFORM_TRIGO_SHIFT - 8)) + dsc->tmp.pivot_x_256;
-        ys = ((dsc->tmp.sinma * xt + dsc->tmp.cosma * yt) >> (_LV_TRANSFORM_TRIGO_SHIFT - 8)) + dsc->tmp.pivot_y_256;
-    }
-    else if(dsc->cfg.angle == 0) {
-        xt = (int32_t)((int32_t)xt * dsc->tmp.zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
-        yt = (int32_t)((int32_t)yt * dsc->tmp.zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
-        xs = xt + dsc->tmp.pivot_x_256;
-        ys = yt + dsc->tmp.pivot_y_256;
-    }
-    else {
-        xt = (int32_t)((int32_t)xt * dsc->tmp.zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
-        yt = (int32_t)((int32_t)yt * dsc->tmp.zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
-        xs = ((dsc->tmp.cosma * xt - dsc->tmp.sinma * yt) >> (_LV_TRANSFORM_TRIGO_SHIFT)) + dsc->tmp.pivot_x_256;
-        ys = ((dsc->tmp.sinma * xt + dsc->tmp.cosma * yt) >> (_LV_TRANSFORM_TRIGO_SHIFT)) + dsc->tmp.pivot_y_256;
-    }
+    transform_point(dsc, x - dsc->cfg.pivot_x, y - dsc->cfg.pivot_y, &xs, &ys);
 
     /*Get the integer part of the source pixel*/
     int32_t xs_int = xs >> 8;
@@ -707,10 +694,6 @@ bool _lv_img_buf_transform_anti_alias(lv_img_transform_dsc_t * dsc)
     lv_opa_t a11 = 0;
 
     if(dsc->tmp.native_color) {
-        lv_memcpy_small(&c01, &src_u8[dsc->tmp.pxi + dsc->tmp.px_size * xn], sizeof(lv_color_t));
-        lv_memcpy_small(&c10, &src_u8[dsc->tmp.pxi + dsc->cfg.src_w * dsc->tmp.px_size * yn], sizeof(lv_color_t));
-        lv_memcpy_small(&c11, &src_u8[dsc->tmp.pxi + dsc->cfg.src_w * dsc->tmp.px_size * yn + dsc->tmp.px_size * xn],
-                        sizeof(lv_color_t));
         if(dsc->tmp.has_alpha) {
             a10 = src_u8[dsc->tmp.pxi + dsc->tmp.px_size * xn + dsc->tmp.px_size - 1];
             a01 = src_u8[dsc->tmp.pxi + dsc->cfg.src_w * dsc->tmp.px_size * yn + dsc->tmp.px_size - 1];
@@ -718,10 +701,6 @@ bool _lv_img_buf_transform_anti_alias(lv_img_transform_dsc_t * dsc)
         }
     }
     else {
-        c01 = lv_img_buf_get_px_color(&dsc->tmp.img_dsc, dsc->tmp.xs_int + xn, dsc->tmp.ys_int, dsc->cfg.color);
-        c10 = lv_img_buf_get_px_color(&dsc->tmp.img_dsc, dsc->tmp.xs_int, dsc->tmp.ys_int + yn, dsc->cfg.color);
-        c11 = lv_img_buf_get_px_color(&dsc->tmp.img_dsc, dsc->tmp.xs_int + xn, dsc->tmp.ys_int + yn, dsc->cfg.color);
-
         if(dsc->tmp.has_alpha) {
             a10 = lv_img_buf_get_px_alpha(&dsc->tmp.img_dsc, dsc->tmp.xs_int + xn, dsc->tmp.ys_int);
             a01 = lv_img_buf_get_px_alpha(&dsc->tmp.img_dsc, dsc->tmp.xs_int, dsc->tmp.ys_int + yn);
@@ -729,6 +708,23 @@ bool _lv_img_buf_transform_anti_alias(lv_img_transform_dsc_t * dsc)
         }
     }
 
+    /*Nothing to mix if all the 4 pixels are transparent*/
+    if(dsc->tmp.has_alpha && a00 <= LV_OPA_MIN && a10 <= LV_OPA_MIN && a01 <= LV_OPA_MIN && a11 <= LV_OPA_MIN) {
+        return false;
+    }
+
+    if(dsc->tmp.native_color) {
+        lv_memcpy_small(&c01, &src_u8[dsc->tmp.pxi + dsc->tmp.px_size * xn], sizeof(lv_color_t));
+        lv_memcpy_small(&c10, &src_u8[dsc->tmp.pxi + dsc->cfg.src_w * dsc->tmp.px_size * yn], sizeof(lv_color_t));
+        lv_memcpy_small(&c11, &src_u8[dsc->tmp.pxi + dsc->cfg.src_w * dsc->tmp.px_size * yn + dsc->tmp.px_size * xn],
+                        sizeof(lv_color_t));
+    }
+    else {
+        c01 = lv_img_buf_get_px_color(&dsc->tmp.img_dsc, dsc->tmp.xs_int + xn, dsc->tmp.ys_int, dsc->cfg.color);
+        c10 = lv_img_buf_get_px_color(&dsc->tmp.img_dsc, dsc->tmp.xs_int, dsc->tmp.ys_int + yn, dsc->cfg.color);
+        c11 = lv_img_buf_get_px_color(&dsc->tmp.img_dsc, dsc->tmp.xs_int + xn, dsc->tmp.ys_int + yn, dsc->cfg.color);
+    }
+
     lv_opa_t xr0 = xr;
     lv_opa_t xr1 = xr;
     if(dsc->tmp.has_alpha) {
@@ -766,7 +762,237 @@ bool _lv_img_buf_transform_anti_alias(lv_img_transform_dsc_t * dsc)
 
     return true;
 }
+
+/**
+ * Transform a row of pixels. Gives the same result as calling `_lv_img_buf_transform` for every pixel
+ * but only the pixels whose source is inside the image are visited and
+ * `LV_IMG_CF_TRUE_COLOR` and `LV_IMG_CF_TRUE_COLOR_ALPHA` images are read directly.
+ * @param dsc a descriptor initialized by `_lv_img_buf_transform_init`
+ * @param x the x coordinate of the first pixel of the row
+ * @param y the y coordinate of the row
+ * @param len the number of pixels in the row
+ * @param cbuf store the colors here. Not written where the opacity is 0.
+ * @param abuf store the opacities here. 0 where there is no valid pixel.
+ */
+void _lv_img_buf_transform_row(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                               lv_color_t * cbuf, lv_opa_t * abuf)
+{
+    lv_memset_00(abuf, len);
+
+    /*The source coordinates change monotonically along the row so the pixels from the image form one span*/
+    int32_t x1 = x;
+    int32_t x2 = x + len - 1;
+    if(!transform_clip_span(dsc, y, &x1, &x2, true)) return;
+    if(!transform_clip_span(dsc, y, &x1, &x2, false)) return;
+
+    cbuf += x1 - x;
+    abuf += x1 - x;
+
+    int32_t xi;
+    if(!dsc->tmp.native_color || dsc->tmp.chroma_keyed) {
+        for(xi = x1; xi <= x2; xi++, cbuf++, abuf++) {
+            if(_lv_img_buf_transform(dsc, xi, y)) {
+                *cbuf = dsc->res.color;
+                *abuf = dsc->res.opa;
+            }
+        }
+        return;
+    }
+
+    const uint8_t * src_u8 = (const uint8_t *)dsc->cfg.src;
+    uint8_t px_size = dsc->tmp.has_alpha ? LV_IMG_PX_SIZE_ALPHA_BYTE : LV_COLOR_SIZE >> 3;
+    int32_t xt = x1 - dsc->cfg.pivot_x;
+    int32_t yt = y - dsc->cfg.pivot_y;
+
+    /*Step the source coordinates from pixel to pixel in the same fixed-point format
+     *`transform_point` uses to get exactly the same result*/
+    int32_t xs;
+    int32_t ys;
+    int32_t acc_x = 0;
+    int32_t acc_y = 0;
+    uint32_t acc_zoom = 0;
+    int32_t yt_zoom = 0;
+    if(dsc->cfg.zoom == LV_IMG_ZOOM_NONE) {
+        acc_x = dsc->tmp.cosma * xt - dsc->tmp.sinma * yt;
+        acc_y = dsc->tmp.sinma * xt + dsc->tmp.cosma * yt;
+    }
+    else {
+        acc_zoom = (uint32_t)xt * dsc->tmp.zoom_inv;
+        yt_zoom = (int32_t)((uint32_t)yt * dsc->tmp.zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
+    }
+
+    for(xi = x1; xi <= x2; xi++, cbuf++, abuf++) {
+        if(dsc->cfg.zoom == LV_IMG_ZOOM_NONE) {
+            xs = (acc_x >> (_LV_TRANSFORM_TRIGO_SHIFT - 8)) + dsc->tmp.pivot_x_256;
+            ys = (acc_y >> (_LV_TRANSFORM_TRIGO_SHIFT - 8)) + dsc->tmp.pivot_y_256;
+            acc_x += dsc->tmp.cosma;
+            acc_y += dsc->tmp.sinma;
+        }
+        else {
+            int32_t xt_zoom = (int32_t)acc_zoom >> _LV_ZOOM_INV_UPSCALE;
+            acc_zoom += dsc->tmp.zoom_inv;
+            if(dsc->cfg.angle == 0) {
+                xs = xt_zoom + dsc->tmp.pivot_x_256;
+                ys = yt_zoom + dsc->tmp.pivot_y_256;
+            }
+            else {
+                xs = ((dsc->tmp.cosma * xt_zoom - dsc->tmp.sinma * yt_zoom) >> _LV_TRANSFORM_TRIGO_SHIFT) + dsc->tmp.pivot_x_256;
+                ys = ((dsc->tmp.sinma * xt_zoom + dsc->tmp.cosma * yt_zoom) >> _LV_TRANSFORM_TRIGO_SHIFT) + dsc->tmp.pivot_y_256;
+            }
+        }
+
+        int32_t xs_int = xs >> 8;
+        int32_t ys_int = ys >> 8;
+        uint32_t pxi = (dsc->cfg.src_w * ys_int + xs_int) * px_size;
+        const uint8_t * px = &src_u8[pxi];
+
+        lv_opa_t opa = LV_OPA_COVER;
+        if(dsc->tmp.has_alpha) {
+            opa = px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+            /*Skip the transparent pixels. With anti-aliasing the neighbors can still make it visible.*/
+            if(opa == LV_OPA_TRANSP && dsc->cfg.antialias == false) continue;
+        }
+
+        lv_color_t c;
+#if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8
+        c.full = px[0];
+#elif LV_COLOR_DEPTH == 16
+        c.full = px[0] + (px[1] << 8);
+#elif LV_COLOR_DEPTH == 32
+        c.full = px[0] + (px[1] << 8) + (px[2] << 16);
+        c.ch.alpha = 0xFF;
+#endif
+
+        if(dsc->cfg.antialias) {
+            dsc->res.color = c;
+            dsc->res.opa = opa;
+            dsc->tmp.xs = xs;
+            dsc->tmp.ys = ys;
+            dsc->tmp.xs_int = xs_int;
+            dsc->tmp.ys_int = ys_int;
+            dsc->tmp.pxi = pxi;
+            dsc->tmp.px_size = px_size;
+            if(_lv_img_buf_transform_anti_alias(dsc) == false) continue;
+            c = dsc->res.color;
+            opa = dsc->res.opa;
+        }
+
+        *cbuf = c;
+        *abuf = opa;
+    }
+}
 #endif
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+#if LV_DRAW_COMPLEX
+/**
+ * Get the source coordinates of a point, in 1/256 pixel units
+ * @param dsc a descriptor initialized by `_lv_img_buf_transform_init`
+ * @param xt the x coordinate relative to the pivot
+ * @param yt the y coordinate relative to the pivot
+ * @param xs store the x coordinate on the source image here
+ * @param ys store the y coordinate on the source image here
+ */
+static inline void transform_point(const lv_img_transform_dsc_t * dsc, int32_t xt, int32_t yt, int32_t * xs,
+                                   int32_t * ys)
+{
+    if(dsc->cfg.zoom == LV_IMG_ZOOM_NONE) {
+        /*Get the source pixel from the upscaled image*/
+        *xs = ((dsc->tmp.cosma * xt - dsc->tmp.sinma * yt) >> (_LV_TRANSFORM_TRIGO_SHIFT - 8)) + dsc->tmp.pivot_x_256;
+        *ys = ((dsc->tmp.sinma * xt + dsc->tmp.cosma * yt) >> (_LV_TRANSFORM_TRIGO_SHIFT - 8)) + dsc->tmp.pivot_y_256;
+    }
+    else if(dsc->cfg.angle == 0) {
+        xt = (int32_t)((int32_t)xt * dsc->tmp.zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
+        yt = (int32_t)((int32_t)yt * dsc->tmp.zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
+        *xs = xt + dsc->tmp.pivot_x_256;
+        *ys = yt + dsc->tmp.pivot_y_256;
+    }
+    else {
+        xt = (int32_t)((int32_t)xt * dsc->tmp.zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
+        yt = (int32_t)((int32_t)yt * dsc->tmp.zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
+        *xs = ((dsc->tmp.cosma * xt - dsc->tmp.sinma * yt) >> (_LV_TRANSFORM_TRIGO_SHIFT)) + dsc->tmp.pivot_x_256;
+        *ys = ((dsc->tmp.sinma * xt + dsc->tmp.cosma * yt) >> (_LV_TRANSFORM_TRIGO_SHIFT)) + dsc->tmp.pivot_y_256;
+    }
+}
+
+/**
+ * Tell on which side of the image a pixel's source is along one axis
+ * @return -1: before the image, 0: on the image, 1: after the image
+ */
+static int32_t transform_side(const lv_img_transform_dsc_t * dsc, int32_t x, int32_t y, bool hor)
+{
+    int32_t xs;
+    int32_t ys;
+    transform_point(dsc, x - dsc->cfg.pivot_x, y - dsc->cfg.pivot_y, &xs, &ys);
+    int32_t v = hor ? xs >> 8 : ys >> 8;
+    int32_t max = hor ? dsc->cfg.src_w : dsc->cfg.src_h;
+    if(v < 0) return -1;
+    if(v >= max) return 1;
+    return 0;
+}
+
+/**
+ * Limit a row to the pixels whose source is inside the image along one axis.
+ * The source coordinate changes monotonically along the row so the limits are interpolated
+ * from the two ends of the row and corrected with a few steps.
+ * @param dsc a descriptor initialized by `_lv_img_buf_transform_init`
+ * @param y the y coordinate of the row
+ * @param x1 the first pixel of the row. Updated to the first valid pixel.
+ * @param x2 the last pixel of the row. Updated to the last valid pixel.
+ * @param hor true: check the source's x coordinates; false: check the y coordinates
+ * @return false: no valid pixels in the row
+ */
+static bool transform_clip_span(const lv_img_transform_dsc_t * dsc, int32_t y, int32_t * x1, int32_t * x2, bool hor)
+{
+    int32_t side1 = transform_side(dsc, *x1, y, hor);
+    int32_t side2 = transform_side(dsc, *x2, y, hor);
+    if(side1 == 0 && side2 == 0) return true;
+    if(side1 == side2) return false;
+
+    /*Get the source coordinates of the ends to interpolate*/
+    int32_t xs1;
+    int32_t ys1;
+    int32_t xs2;
+    int32_t ys2;
+    transform_point(dsc, *x1 - dsc->cfg.pivot_x, y - dsc->cfg.pivot_y, &xs1, &ys1);
+    transform_point(dsc, *x2 - dsc->cfg.pivot_x, y - dsc->cfg.pivot_y, &xs2, &ys2);
+    int64_t v1 = hor ? xs1 : ys1;
+    int64_t v2 = hor ? xs2 : ys2;
+    int64_t max = (hor ? dsc->cfg.src_w : dsc->cfg.src_h) * 256;
+
+    int32_t start = *x1;
+    int32_t end = *x2;
+    if(side1 != 0) {
+        int64_t target = side1 < 0 ? 0 : max;
+        start = *x1 + (int32_t)(((target - v1) * (*x2 - *x1)) / (v2 - v1));
+        start = LV_CLAMP(*x1, start, *x2);
+        if(transform_side(dsc, start, y, hor) == side1) {
+            while(start < *x2 && transform_side(dsc, start, y, hor) == side1) start++;
+        }
+        else {
+            while(start > *x1 && transform_side(dsc, start - 1, y, hor) != side1) start--;
+        }
+        /*The image might be stepped over if it's zoomed out*/
+        if(transform_side(dsc, start, y, hor) != 0) return false;
+    }
+
+    if(side2 != 0) {
+        int64_t target = side2 < 0 ? 0 : max;
+        end = *x1 + (int32_t)(((target - v1) * (*x2 - *x1)) / (v2 - v1));
+        end = LV_CLAMP(start, end, *x2);
+        if(transform_side(dsc, end, y, hor) == side2) {
+            while(end > start && transform_side(dsc, end, y, hor) == side2) end--;
+        }
+        else {
+            while(end < *x2 && transform_side(dsc, end + 1, y, hor) != side2) end++;
+        }
+        if(transform_side(dsc, end, y, hor) != 0) return false;
+    }
+
+    *x1 = start;
+    *x2 = end;
+    return true;
+}
+#endif
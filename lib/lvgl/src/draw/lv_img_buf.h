@@ -286,6 +286,20 @@ bool _lv_img_buf_transform_anti_alias(lv_img_transform_dsc_t * dsc);
  */
 bool _lv_img_buf_transform(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y);
 
+/**
+ * Transform a row of pixels. Gives the same result as calling `_lv_img_buf_transform` for every pixel
+ * but only the pixels whose source is inside the image are visited and
+ * `LV_IMG_CF_TRUE_COLOR` and `LV_IMG_CF_TRUE_COLOR_ALPHA` images are read directly.
+ * @param dsc a descriptor initialized by `_lv_img_buf_transform_init`
+ * @param x the x coordinate of the first pixel of the row
+ * @param y the y coordinate of the row
+ * @param len the number of pixels in the row
+ * @param cbuf store the colors here. Not written where the opacity is 0.
+ * @param abuf store the opacities here. 0 where there is no valid pixel.
+ */
+void _lv_img_buf_transform_row(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                               lv_color_t * cbuf, lv_opa_t * abuf);
+
 #endif
 /**
  * Get the area of a rectangle if its rotated and scaled
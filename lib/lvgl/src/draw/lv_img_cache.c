@@ -8,6 +8,7 @@
  *********************/
 #include "../misc/lv_assert.h"
 #include "lv_img_cache.h"
+#include "lv_img_transform_cache.h"
 #include "lv_img_decoder.h"
 #include "lv_draw_img.h"
 #include "../hal/lv_hal_tick.h"
@@ -180,6 +181,8 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
 void lv_img_cache_invalidate_src(const void * src)
 {
     LV_UNUSED(src);
+    lv_img_transform_cache_invalidate_src(src);
+
 #if LV_IMG_CACHE_DEF_SIZE
     _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
 
@@ -24,6 +24,7 @@
 
 typedef struct {
     lv_fs_file_t f;
+    const uint8_t * map;    /*The content of the file if the driver could map it to the memory*/
     lv_color_t * palette;
     lv_opa_t * opa;
 } lv_img_decoder_built_in_data_t;
@@ -37,6 +38,10 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
                                                    lv_coord_t len, uint8_t * buf);
 static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
                                                      lv_coord_t len, uint8_t * buf);
+static lv_res_t lv_img_decoder_built_in_area_true_color(lv_img_decoder_dsc_t * dsc, const lv_area_t * area,
+                                                        uint8_t * buf);
+static const uint8_t * get_data(lv_img_decoder_dsc_t * dsc);
+static uint32_t get_line_size(lv_img_decoder_dsc_t * dsc, lv_coord_t len);
 
 /**********************
  *  STATIC VARIABLES
@@ -70,6 +75,7 @@ void _lv_img_decoder_init(void)
     lv_img_decoder_set_info_cb(decoder, lv_img_decoder_built_in_info);
     lv_img_decoder_set_open_cb(decoder, lv_img_decoder_built_in_open);
     lv_img_decoder_set_read_line_cb(decoder, lv_img_decoder_built_in_read_line);
+    lv_img_decoder_set_read_area_cb(decoder, lv_img_decoder_built_in_read_area);
     lv_img_decoder_set_close_cb(decoder, lv_img_decoder_built_in_close);
 }
 
@@ -181,6 +187,29 @@ lv_res_t lv_img_decoder_read_line(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_c
     return res;
 }
 
+/**
+ * Read an area from an opened image
+ * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
+ * @param area the area to read relative to the image
+ * @param buf store the data here
+ * @return LV_RES_OK: success; LV_RES_INV: an error occurred
+ */
+lv_res_t lv_img_decoder_read_area(lv_img_decoder_dsc_t * dsc, const lv_area_t * area, uint8_t * buf)
+{
+    if(dsc->decoder->read_area_cb) return dsc->decoder->read_area_cb(dsc->decoder, dsc, area, buf);
+
+    lv_coord_t len = lv_area_get_width(area);
+    uint32_t line_size = get_line_size(dsc, len);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_res_t res = lv_img_decoder_read_line(dsc, area->x1, y, len, buf);
+        if(res != LV_RES_OK) return res;
+        buf += line_size;
+    }
+
+    return LV_RES_OK;
+}
+
 /**
  * Close a decoding session
  * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
@@ -253,6 +282,16 @@ void lv_img_decoder_set_read_line_cb(lv_img_decoder_t * decoder, lv_img_decoder_
     decoder->read_line_cb = read_line_cb;
 }
 
+/**
+ * Set a callback to read several decoded lines of an image at once
+ * @param decoder pointer to an image decoder
+ * @param read_area_cb a function to read an area of an image
+ */
+void lv_img_decoder_set_read_area_cb(lv_img_decoder_t * decoder, lv_img_decoder_read_area_f_t read_area_cb)
+{
+    decoder->read_area_cb = read_area_cb;
+}
+
 /**
  * Set a callback to close a decoding session. E.g. close files and free other resources.
  * @param decoder pointer to an image decoder
@@ -351,6 +390,14 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
 
         lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
         lv_memcpy_small(&user_data->f, &f, sizeof(f));
+
+        /*Use the content of the file directly if it's in the memory and has all the pixels*/
+        const void * map;
+        uint32_t map_size;
+        if(lv_fs_map(&user_data->f, &map, &map_size) == LV_FS_RES_OK &&
+           map_size >= sizeof(lv_img_header_t) + lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, dsc->header.cf)) {
+            user_data->map = (const uint8_t *)map + sizeof(lv_img_header_t);
+        }
     }
     else if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
         /*The variables should have valid data*/
@@ -369,7 +416,8 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
             return LV_RES_OK;
         }
         else {
-            /*If it's a file it need to be read line by line later*/
+            /*If it's a mapped file use it like a variable, else it need to be read line by line later*/
+            dsc->img_data = get_data(dsc);
             return LV_RES_OK;
         }
     }
@@ -401,7 +449,7 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
             return LV_RES_INV;
         }
 
-        if(dsc->src_type == LV_IMG_SRC_FILE) {
+        if(dsc->src_type == LV_IMG_SRC_FILE && user_data->map == NULL) {
             /*Read the palette from file*/
             lv_fs_seek(&user_data->f, 4, LV_FS_SEEK_SET); /*Skip the header*/
             lv_color32_t cur_color;
@@ -414,7 +462,7 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
         }
         else {
             /*The palette begins in the beginning of the image data. Just point to it.*/
-            lv_color32_t * palette_p = (lv_color32_t *)((lv_img_dsc_t *)dsc->src)->data;
+            const lv_color32_t * palette_p = (const lv_color32_t *)get_data(dsc);
 
             uint32_t i;
             for(i = 0; i < palette_size; i++) {
@@ -482,6 +530,36 @@ lv_res_t lv_img_decoder_built_in_read_line(lv_img_decoder_t * decoder, lv_img_de
     return res;
 }
 
+/**
+ * Decode the pixels of an area and store them in `buf` line by line.
+ * @param decoder pointer to the decoder the function associated with
+ * @param dsc pointer to decoder descriptor
+ * @param area the area to decode relative to the image
+ * @param buf a buffer to store the decoded pixels
+ * @return LV_RES_OK: ok; LV_RES_INV: failed
+ */
+lv_res_t lv_img_decoder_built_in_read_area(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc,
+                                           const lv_area_t * area, uint8_t * buf)
+{
+    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR || dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA ||
+       dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
+        if(dsc->src_type != LV_IMG_SRC_FILE) return LV_RES_INV;
+        return lv_img_decoder_built_in_area_true_color(dsc, area, buf);
+    }
+
+    /*The other formats are converted line by line anyway*/
+    lv_coord_t len = lv_area_get_width(area);
+    uint32_t line_size = get_line_size(dsc, len);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_res_t res = lv_img_decoder_built_in_read_line(decoder, dsc, area->x1, y, len, buf);
+        if(res != LV_RES_OK) return res;
+        buf += line_size;
+    }
+
+    return LV_RES_OK;
+}
+
 /**
  * Close the pending decoding. Free resources etc.
  * @param decoder pointer to the decoder the function associated with
@@ -533,6 +611,44 @@ static lv_res_t lv_img_decoder_built_in_line_true_color(lv_img_decoder_dsc_t * d
     return LV_RES_OK;
 }
 
+static lv_res_t lv_img_decoder_built_in_area_true_color(lv_img_decoder_dsc_t * dsc, const lv_area_t * area,
+                                                        uint8_t * buf)
+{
+    lv_coord_t len = lv_area_get_width(area);
+
+    /*Whole lines follow each other in the file so they can be read at once*/
+    if(area->x1 == 0 && len == dsc->header.w) {
+        lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+        uint8_t px_size = lv_img_cf_get_px_size(dsc->header.cf);
+
+        uint32_t pos = ((area->y1 * dsc->header.w) * px_size) >> 3;
+        pos += 4; /*Skip the header*/
+        lv_fs_res_t res = lv_fs_seek(&user_data->f, pos, LV_FS_SEEK_SET);
+        if(res != LV_FS_RES_OK) {
+            LV_LOG_WARN("Built-in image decoder seek failed");
+            return LV_RES_INV;
+        }
+        uint32_t btr = lv_area_get_size(area) * (px_size >> 3);
+        uint32_t br  = 0;
+        res = lv_fs_read(&user_data->f, buf, btr, &br);
+        if(res != LV_FS_RES_OK || btr != br) {
+            LV_LOG_WARN("Built-in image decoder read failed");
+            return LV_RES_INV;
+        }
+        return LV_RES_OK;
+    }
+
+    uint32_t line_size = get_line_size(dsc, len);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_res_t res = lv_img_decoder_built_in_line_true_color(dsc, area->x1, y, len, buf);
+        if(res != LV_RES_OK) return res;
+        buf += line_size;
+    }
+
+    return LV_RES_OK;
+}
+
 static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
                                                    lv_coord_t len, uint8_t * buf)
 {
@@ -593,16 +709,15 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
     }
 
     lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
-    uint8_t * fs_buf = lv_mem_buf_get(w);
-    if(fs_buf == NULL) return LV_RES_INV;
-
-    const uint8_t * data_tmp = NULL;
-    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
-        const lv_img_dsc_t * img_dsc = dsc->src;
+    uint8_t * fs_buf = NULL;    /*Needed only to read a file (not for variables and mapped files)*/
 
-        data_tmp = img_dsc->data + ofs;
+    const uint8_t * data_tmp = get_data(dsc);
+    if(data_tmp) {
+        data_tmp += ofs;
     }
     else {
+        fs_buf = lv_mem_buf_get(w);
+        if(fs_buf == NULL) return LV_RES_INV;
         lv_fs_seek(&user_data->f, ofs + 4, LV_FS_SEEK_SET); /*+4 to skip the header*/
         lv_fs_read(&user_data->f, fs_buf, w, NULL);
         data_tmp = fs_buf;
@@ -620,7 +735,7 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
             data_tmp++;
         }
     }
-    lv_mem_buf_release(fs_buf);
+    if(fs_buf) lv_mem_buf_release(fs_buf);
     return LV_RES_OK;
 }
 
@@ -662,14 +777,14 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
 
     lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
 
-    uint8_t * fs_buf = lv_mem_buf_get(w);
-    if(fs_buf == NULL) return LV_RES_INV;
-    const uint8_t * data_tmp = NULL;
-    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
-        const lv_img_dsc_t * img_dsc = dsc->src;
-        data_tmp                     = img_dsc->data + ofs;
+    uint8_t * fs_buf = NULL;    /*Needed only to read a file (not for variables and mapped files)*/
+    const uint8_t * data_tmp = get_data(dsc);
+    if(data_tmp) {
+        data_tmp += ofs;
     }
     else {
+        fs_buf = lv_mem_buf_get(w);
+        if(fs_buf == NULL) return LV_RES_INV;
         lv_fs_seek(&user_data->f, ofs + 4, LV_FS_SEEK_SET); /*+4 to skip the header*/
         lv_fs_read(&user_data->f, fs_buf, w, NULL);
         data_tmp = fs_buf;
@@ -699,6 +814,31 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
             data_tmp++;
         }
     }
-    lv_mem_buf_release(fs_buf);
+    if(fs_buf) lv_mem_buf_release(fs_buf);
     return LV_RES_OK;
 }
+
+/**
+ * Get the pixels of a variable or a mapped file (after the header)
+ * @param dsc   pointer to decoder descriptor
+ * @return      pointer to the image data or NULL if it needs to be read from a file
+ */
+static const uint8_t * get_data(lv_img_decoder_dsc_t * dsc)
+{
+    if(dsc->src_type == LV_IMG_SRC_VARIABLE) return ((const lv_img_dsc_t *)dsc->src)->data;
+
+    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+    return user_data ? user_data->map : NULL;
+}
+
+/**
+ * Get the size of a decoded line as it's stored by `read_line_cb`
+ * @param dsc   pointer to decoder descriptor
+ * @param len   number of pixels in the line
+ * @return      size of the line in bytes
+ */
+static uint32_t get_line_size(lv_img_decoder_dsc_t * dsc, lv_coord_t len)
+{
+    if(lv_img_cf_has_alpha(dsc->header.cf)) return len * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    else return len * sizeof(lv_color_t);
+}
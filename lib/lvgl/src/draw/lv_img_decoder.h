@@ -75,6 +75,18 @@ typedef lv_res_t (*lv_img_decoder_open_f_t)(struct _lv_img_decoder_t * decoder,
 typedef lv_res_t (*lv_img_decoder_read_line_f_t)(struct _lv_img_decoder_t * decoder, struct _lv_img_decoder_dsc_t * dsc,
                                                  lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf);
 
+/**
+ * Decode the pixels of an area and store them in `buf` line by line, in the same format as `read_line_cb`.
+ * Optional. It's faster than reading the lines one by one if e.g. the lines can be read from a file at once.
+ * @param decoder pointer to the decoder the function associated with
+ * @param dsc pointer to decoder descriptor
+ * @param area the area to decode relative to the image
+ * @param buf a buffer to store the decoded pixels. The lines follow each other without padding.
+ * @return LV_RES_OK: ok; LV_RES_INV: failed
+ */
+typedef lv_res_t (*lv_img_decoder_read_area_f_t)(struct _lv_img_decoder_t * decoder, struct _lv_img_decoder_dsc_t * dsc,
+                                                 const lv_area_t * area, uint8_t * buf);
+
 /**
  * Close the pending decoding. Free resources etc.
  * @param decoder pointer to the decoder the function associated with
@@ -87,6 +99,7 @@ typedef struct _lv_img_decoder_t {
     lv_img_decoder_info_f_t info_cb;
     lv_img_decoder_open_f_t open_cb;
     lv_img_decoder_read_line_f_t read_line_cb;
+    lv_img_decoder_read_area_f_t read_area_cb;
     lv_img_decoder_close_f_t close_cb;
 
 #if LV_USE_USER_DATA
@@ -179,6 +192,17 @@ lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t * dsc, const void * src, lv_co
 lv_res_t lv_img_decoder_read_line(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
                                   uint8_t * buf);
 
+/**
+ * Read an area from an opened image. The lines are read one by one if the decoder has no `read_area_cb`.
+ * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
+ * @param area the area to read relative to the image
+ * @param buf store the data here. The lines follow each other and a pixel needs
+ *            `LV_IMG_PX_SIZE_ALPHA_BYTE` bytes if the color format has alpha (`lv_img_cf_has_alpha`),
+ *            else `sizeof(lv_color_t)` bytes
+ * @return LV_RES_OK: success; LV_RES_INV: an error occurred
+ */
+lv_res_t lv_img_decoder_read_area(lv_img_decoder_dsc_t * dsc, const lv_area_t * area, uint8_t * buf);
+
 /**
  * Close a decoding session
  * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
@@ -218,6 +242,13 @@ void lv_img_decoder_set_open_cb(lv_img_decoder_t * decoder, lv_img_decoder_open_
  */
 void lv_img_decoder_set_read_line_cb(lv_img_decoder_t * decoder, lv_img_decoder_read_line_f_t read_line_cb);
 
+/**
+ * Set a callback to read several decoded lines of an image at once
+ * @param decoder pointer to an image decoder
+ * @param read_area_cb a function to read an area of an image
+ */
+void lv_img_decoder_set_read_area_cb(lv_img_decoder_t * decoder, lv_img_decoder_read_area_f_t read_area_cb);
+
 /**
  * Set a callback to close a decoding session. E.g. close files and free other resources.
  * @param decoder pointer to an image decoder
@@ -256,6 +287,18 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
 lv_res_t lv_img_decoder_built_in_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x,
                                            lv_coord_t y, lv_coord_t len, uint8_t * buf);
 
+/**
+ * Decode the pixels of an area and store them in `buf` line by line.
+ * The lines of true color images are read from the file at once if possible.
+ * @param decoder pointer to the decoder the function associated with
+ * @param dsc pointer to decoder descriptor
+ * @param area the area to decode relative to the image
+ * @param buf a buffer to store the decoded pixels
+ * @return LV_RES_OK: ok; LV_RES_INV: failed
+ */
+lv_res_t lv_img_decoder_built_in_read_area(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc,
+                                           const lv_area_t * area, uint8_t * buf);
+
 /**
  * Close the pending decoding. Free resources etc.
  * @param decoder pointer to the decoder the function associated with
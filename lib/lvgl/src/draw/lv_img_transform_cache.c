@@ -0,0 +1,307 @@
+/**
+ * @file lv_img_transform_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_img_transform_cache.h"
+#include "lv_img_cache.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_gc.h"
+#include "../misc/lv_thread.h"
+
+#include <stddef.h>
+
+#if LV_IMG_TRANSFORM_CACHE_SIZE
+#include LV_IMG_TRANSFORM_CACHE_INCLUDE
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static _lv_img_transform_cache_entry_t * find_entry(const void * src, const lv_draw_img_dsc_t * draw_dsc);
+static _lv_img_transform_cache_entry_t * render_entry(const void * src, const lv_draw_img_dsc_t * draw_dsc);
+static _lv_img_transform_cache_entry_t * create_entry(const void * src, const lv_draw_img_dsc_t * draw_dsc,
+                                                       const lv_img_decoder_dsc_t * dec_dsc);
+static bool get_visible_area(lv_img_transform_dsc_t * trans_dsc, const lv_area_t * full_area, lv_area_t * area);
+static bool make_room(uint32_t data_size);
+static void free_entry(_lv_img_transform_cache_entry_t * entry);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t used_size;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void _lv_img_transform_cache_init(void)
+{
+    _lv_ll_init(&LV_GC_ROOT(_lv_img_transform_cache_ll), sizeof(_lv_img_transform_cache_entry_t));
+    used_size = 0;
+}
+
+const lv_img_dsc_t * _lv_img_transform_cache_get(const void * src, const lv_draw_img_dsc_t * draw_dsc,
+                                                 lv_area_t * area)
+{
+    if(lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE) return NULL;
+
+    /*The cache is shared by the rendering threads but it's locked only until the variant is found or rendered*/
+    _lv_render_lock();
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_img_transform_cache_ll);
+    _lv_img_transform_cache_entry_t * entry = find_entry(src, draw_dsc);
+    if(entry) {
+        /*Keep the recently used entries at the head, the tail will be dropped first*/
+        _lv_ll_move_before(ll, entry, _lv_ll_get_head(ll));
+    }
+    else {
+        entry = render_entry(src, draw_dsc);
+    }
+
+    if(entry) {
+        entry->ref_cnt++;
+        lv_area_copy(area, &entry->area);
+    }
+    _lv_render_unlock();
+
+    return entry ? &entry->img : NULL;
+}
+
+void _lv_img_transform_cache_release(const lv_img_dsc_t * variant)
+{
+    _lv_img_transform_cache_entry_t * entry = (_lv_img_transform_cache_entry_t *)((uint8_t *)variant -
+                                                                                  offsetof(_lv_img_transform_cache_entry_t, img));
+    _lv_render_lock();
+    LV_ASSERT(entry->ref_cnt > 0);
+    entry->ref_cnt--;
+    /*It was invalidated while it was drawn*/
+    if(entry->ref_cnt == 0 && entry->src == NULL) free_entry(entry);
+    _lv_render_unlock();
+}
+
+#endif /*LV_IMG_TRANSFORM_CACHE_SIZE*/
+
+void lv_img_transform_cache_invalidate_src(const void * src)
+{
+    LV_UNUSED(src);
+#if LV_IMG_TRANSFORM_CACHE_SIZE
+    _lv_render_lock();
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_img_transform_cache_ll);
+    _lv_img_transform_cache_entry_t * entry = _lv_ll_get_head(ll);
+    while(entry) {
+        _lv_img_transform_cache_entry_t * entry_next = _lv_ll_get_next(ll, entry);
+        if(src == NULL || entry->src == src) {
+            /*Not found anymore and freed when released*/
+            if(entry->ref_cnt) entry->src = NULL;
+            else free_entry(entry);
+        }
+        entry = entry_next;
+    }
+    _lv_render_unlock();
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_IMG_TRANSFORM_CACHE_SIZE
+
+static _lv_img_transform_cache_entry_t * find_entry(const void * src, const lv_draw_img_dsc_t * draw_dsc)
+{
+    _lv_img_transform_cache_entry_t * entry;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_img_transform_cache_ll), entry) {
+        if(entry->src != src) continue;
+        if(entry->angle != draw_dsc->angle || entry->zoom != draw_dsc->zoom) continue;
+        if(entry->pivot.x != draw_dsc->pivot.x || entry->pivot.y != draw_dsc->pivot.y) continue;
+        if(entry->antialias != draw_dsc->antialias || entry->frame_id != draw_dsc->frame_id) continue;
+        if(entry->recolor.full != draw_dsc->recolor.full) continue;
+        return entry;
+    }
+
+    return NULL;
+}
+
+static _lv_img_transform_cache_entry_t * render_entry(const void * src, const lv_draw_img_dsc_t * draw_dsc)
+{
+    _lv_img_cache_entry_t * cdsc = _lv_img_cache_open(src, draw_dsc->recolor, draw_dsc->frame_id);
+    if(cdsc == NULL) return NULL;
+
+    _lv_img_transform_cache_entry_t * entry = NULL;
+    /*Only the fully decoded images can be transformed in one go*/
+    if(cdsc->dec_dsc.error_msg == NULL && cdsc->dec_dsc.img_data != NULL) {
+        entry = create_entry(src, draw_dsc, &cdsc->dec_dsc);
+    }
+
+    /*Automatically close images with no caching*/
+#if LV_IMG_CACHE_DEF_SIZE == 0
+    lv_img_decoder_close(&cdsc->dec_dsc);
+#endif
+
+    return entry;
+}
+
+static _lv_img_transform_cache_entry_t * create_entry(const void * src, const lv_draw_img_dsc_t * draw_dsc,
+                                                       const lv_img_decoder_dsc_t * dec_dsc)
+{
+    lv_img_cf_t cf;
+    if(lv_img_cf_is_chroma_keyed(dec_dsc->header.cf)) cf = LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED;
+    else if(lv_img_cf_has_alpha(dec_dsc->header.cf)) cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    else cf = LV_IMG_CF_TRUE_COLOR;
+
+    lv_img_transform_dsc_t trans_dsc;
+    lv_memset_00(&trans_dsc, sizeof(lv_img_transform_dsc_t));
+    trans_dsc.cfg.angle = draw_dsc->angle;
+    trans_dsc.cfg.zoom = draw_dsc->zoom;
+    trans_dsc.cfg.src = dec_dsc->img_data;
+    trans_dsc.cfg.src_w = dec_dsc->header.w;
+    trans_dsc.cfg.src_h = dec_dsc->header.h;
+    trans_dsc.cfg.cf = cf;
+    trans_dsc.cfg.pivot_x = draw_dsc->pivot.x;
+    trans_dsc.cfg.pivot_y = draw_dsc->pivot.y;
+    trans_dsc.cfg.color = draw_dsc->recolor;
+    trans_dsc.cfg.antialias = draw_dsc->antialias;
+    _lv_img_buf_transform_init(&trans_dsc);
+
+    lv_area_t full_area;
+    _lv_img_buf_get_transformed_area(&full_area, dec_dsc->header.w, dec_dsc->header.h, draw_dsc->angle,
+                                     draw_dsc->zoom, &draw_dsc->pivot);
+
+    /*Store only the visible pixels, usually much less than the bounding box of a rotated image*/
+    lv_area_t area;
+    if(!get_visible_area(&trans_dsc, &full_area, &area)) return NULL;
+
+    lv_coord_t w = lv_area_get_width(&area);
+    lv_coord_t h = lv_area_get_height(&area);
+    uint32_t data_size = (uint32_t)w * h * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    if(data_size > LV_IMG_TRANSFORM_CACHE_SIZE) return NULL;
+
+    if(!make_room(data_size)) return NULL;
+
+    uint8_t * data = LV_IMG_TRANSFORM_CACHE_ALLOC(data_size);
+    LV_ASSERT_MALLOC(data);
+    if(data == NULL) return NULL;
+
+    _lv_img_transform_cache_entry_t * entry = _lv_ll_ins_head(&LV_GC_ROOT(_lv_img_transform_cache_ll));
+    LV_ASSERT_MALLOC(entry);
+    if(entry == NULL) {
+        LV_IMG_TRANSFORM_CACHE_FREE(data);
+        return NULL;
+    }
+
+    lv_memset_00(entry, sizeof(_lv_img_transform_cache_entry_t));
+    entry->src = src;
+    entry->recolor = draw_dsc->recolor;
+    entry->frame_id = draw_dsc->frame_id;
+    entry->angle = draw_dsc->angle;
+    entry->zoom = draw_dsc->zoom;
+    entry->pivot = draw_dsc->pivot;
+    entry->antialias = draw_dsc->antialias;
+    entry->area = area;
+    entry->img.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    entry->img.header.w = w;
+    entry->img.header.h = h;
+    entry->img.data_size = data_size;
+    entry->img.data = data;
+    used_size += data_size;
+
+    lv_color_t * cbuf = lv_mem_buf_get(w * sizeof(lv_color_t));
+    lv_opa_t * abuf = lv_mem_buf_get(w);
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = area.y1; y <= area.y2; y++) {
+        _lv_img_buf_transform_row(&trans_dsc, area.x1, y, w, cbuf, abuf);
+        for(x = 0; x < w; x++) {
+            lv_memcpy_small(data, &cbuf[x], LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+            data[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = abuf[x];
+            data += LV_IMG_PX_SIZE_ALPHA_BYTE;
+        }
+    }
+    lv_mem_buf_release(abuf);
+    lv_mem_buf_release(cbuf);
+
+    return entry;
+}
+
+/**
+ * Get the bounding box of the not fully transparent pixels of a transformed image.
+ * @param trans_dsc     an initialized transformation descriptor
+ * @param full_area     the bounding box of the whole transformed image
+ * @param area          store the bounding box of the visible pixels here
+ * @return              false: no visible pixels at all
+ */
+static bool get_visible_area(lv_img_transform_dsc_t * trans_dsc, const lv_area_t * full_area, lv_area_t * area)
+{
+    lv_coord_t w = lv_area_get_width(full_area);
+    lv_color_t * cbuf = lv_mem_buf_get(w * sizeof(lv_color_t));
+    lv_opa_t * abuf = lv_mem_buf_get(w);
+
+    area->x1 = LV_COORD_MAX;
+    area->y1 = LV_COORD_MAX;
+    area->x2 = LV_COORD_MIN;
+    area->y2 = LV_COORD_MIN;
+
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = full_area->y1; y <= full_area->y2; y++) {
+        _lv_img_buf_transform_row(trans_dsc, full_area->x1, y, w, cbuf, abuf);
+        for(x = 0; x < w; x++) {
+            if(abuf[x] == LV_OPA_TRANSP) continue;
+            area->x1 = LV_MIN(area->x1, full_area->x1 + x);
+            area->x2 = LV_MAX(area->x2, full_area->x1 + x);
+            area->y1 = LV_MIN(area->y1, y);
+            area->y2 = y;
+        }
+    }
+
+    lv_mem_buf_release(abuf);
+    lv_mem_buf_release(cbuf);
+
+    return area->x1 <= area->x2;
+}
+
+/**
+ * Drop the least recently used variants which are not drawn right now until a new variant fits.
+ * @param data_size     size of the new variant
+ * @return              false: the variants being drawn leave no room for it
+ */
+static bool make_room(uint32_t data_size)
+{
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_img_transform_cache_ll);
+    _lv_img_transform_cache_entry_t * entry = _lv_ll_get_tail(ll);
+    while(entry && used_size + data_size > LV_IMG_TRANSFORM_CACHE_SIZE) {
+        _lv_img_transform_cache_entry_t * entry_prev = _lv_ll_get_prev(ll, entry);
+        if(entry->ref_cnt == 0) free_entry(entry);
+        entry = entry_prev;
+    }
+
+    return used_size + data_size <= LV_IMG_TRANSFORM_CACHE_SIZE;
+}
+
+static void free_entry(_lv_img_transform_cache_entry_t * entry)
+{
+    _lv_ll_remove(&LV_GC_ROOT(_lv_img_transform_cache_ll), entry);
+
+    /*The variant might be opened by the image cache as a normal image*/
+    lv_img_cache_invalidate_src(&entry->img);
+
+    used_size -= entry->img.data_size;
+    LV_IMG_TRANSFORM_CACHE_FREE((void *)entry->img.data);
+    lv_mem_free(entry);
+}
+
+#endif /*LV_IMG_TRANSFORM_CACHE_SIZE*/
@@ -0,0 +1,100 @@
+/**
+ * @file lv_img_transform_cache.h
+ *
+ */
+
+#ifndef LV_IMG_TRANSFORM_CACHE_H
+#define LV_IMG_TRANSFORM_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "lv_draw_img.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#if LV_IMG_TRANSFORM_CACHE_SIZE && LV_DRAW_COMPLEX == 0
+#error "lv_img_transform_cache: transforming images requires LV_DRAW_COMPLEX. Enable it in lv_conf.h (LV_DRAW_COMPLEX 1)"
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * A rotated and/or zoomed variant of an image.
+ *
+ * Rotating the same small images to a few angles again and again (e.g. the hands of a clock)
+ * is much cheaper if the transformed pixels are rendered only once and later simply blended.
+ */
+typedef struct {
+    const void * src;       /**< The original image source*/
+    lv_color_t recolor;     /**< The color of the `LV_IMG_CF_ALPHA_...` images*/
+    int32_t frame_id;
+    int16_t angle;
+    uint16_t zoom;
+    lv_point_t pivot;
+    uint8_t antialias : 1;
+    uint16_t ref_cnt;       /**< Number of draws using the variant right now. It's not dropped meanwhile.*/
+    lv_area_t area;         /**< The visible part of the variant relative to the original image*/
+    lv_img_dsc_t img;       /**< The variant in `LV_IMG_CF_TRUE_COLOR_ALPHA` format*/
+} _lv_img_transform_cache_entry_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LV_IMG_TRANSFORM_CACHE_SIZE
+
+/**
+ * Initialize the image transformation cache. Called by LVGL in `lv_init()`.
+ */
+void _lv_img_transform_cache_init(void);
+
+/**
+ * Get the rotated and zoomed variant of an image. It's rendered and cached on the first use.
+ * Only images with `LV_IMG_SRC_VARIABLE` source are cached.
+ * The variant is kept in the cache until `_lv_img_transform_cache_release()` is called,
+ * so it can be drawn without locking the cache.
+ * @param src       pointer to an `lv_img_dsc_t` variable
+ * @param draw_dsc  the transformation is taken from its `angle`, `zoom`, `pivot`, `antialias`,
+ *                  `recolor` and `frame_id` fields
+ * @param area      store the area of the variant relative to the top left corner of the original image here
+ * @return          the variant in `LV_IMG_CF_TRUE_COLOR_ALPHA` format which can be drawn without transformation
+ *                  or NULL if the image can't be cached (e.g. it's fully transparent or larger than the cache)
+ */
+const lv_img_dsc_t * _lv_img_transform_cache_get(const void * src, const lv_draw_img_dsc_t * draw_dsc,
+                                                 lv_area_t * area);
+
+/**
+ * Tell that a variant returned by `_lv_img_transform_cache_get()` is not used anymore.
+ * @param variant   pointer to the variant
+ */
+void _lv_img_transform_cache_release(const lv_img_dsc_t * variant);
+
+#endif /*LV_IMG_TRANSFORM_CACHE_SIZE*/
+
+/**
+ * Drop the cached variants of an image source.
+ * Useful if the image source is updated therefore its variants need to be rendered again.
+ * The variants which are being drawn are dropped when they are released.
+ * Called by `lv_img_cache_invalidate_src()` too.
+ * @param src an image source or NULL to drop all variants
+ */
+void lv_img_transform_cache_invalidate_src(const void * src);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_IMG_TRANSFORM_CACHE_H*/
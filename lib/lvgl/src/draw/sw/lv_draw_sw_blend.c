@@ -14,6 +14,16 @@
 /*********************
  *      DEFINES
  *********************/
+#if LV_DRAW_SW_ESP32S3_PIE && LV_COLOR_DEPTH == 16 && !defined(__XTENSA__)
+    #error "LV_DRAW_SW_ESP32S3_PIE can be used only on ESP32-S3"
+#endif
+
+/*Pixels can be copied 2 at a time from a source which is aligned differently than the destination*/
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    #define COPY_COLOR16_SHIFT 1
+#else
+    #define COPY_COLOR16_SHIFT 0
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -38,6 +48,11 @@ static void map_set_px(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_co
 LV_ATTRIBUTE_FAST_MEM static void map_normal(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
                                              const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride);
 
+#if LV_COLOR_DEPTH == 16
+LV_ATTRIBUTE_FAST_MEM static void fill_color16(lv_color_t * dest_buf, lv_color_t color, int32_t px_num);
+LV_ATTRIBUTE_FAST_MEM static void copy_color16(lv_color_t * dest_buf, const lv_color_t * src_buf, int32_t px_num);
+#endif
+
 #if LV_DRAW_COMPLEX
 static void map_blended(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
                         const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa,
@@ -225,8 +240,18 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(lv_color_t * dest_buf, const lv_ar
     /*No mask*/
     if(mask == NULL) {
         if(opa >= LV_OPA_MAX) {
+            /*Fill full width areas in one step*/
+            if(w == dest_stride) {
+                w *= h;
+                h = 1;
+            }
+
             for(y = 0; y < h; y++) {
+#if LV_COLOR_DEPTH == 16
+                fill_color16(dest_buf, color, w);
+#else
                 lv_color_fill(dest_buf, color, w);
+#endif
                 dest_buf += dest_stride;
             }
         }
@@ -484,8 +509,18 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(lv_color_t * dest_buf, const lv_are
     /*Simple fill (maybe with opacity), no masking*/
     if(mask == NULL) {
         if(opa >= LV_OPA_MAX) {
+            /*Copy full width areas in one step*/
+            if(w == dest_stride && w == src_stride) {
+                w *= h;
+                h = 1;
+            }
+
             for(y = 0; y < h; y++) {
+#if LV_COLOR_DEPTH == 16
+                copy_color16(dest_buf, src_buf, w);
+#else
                 lv_memcpy(dest_buf, src_buf, w * sizeof(lv_color_t));
+#endif
                 dest_buf += dest_stride;
                 src_buf += src_stride;
             }
@@ -596,6 +631,201 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(lv_color_t * dest_buf, const lv_are
         }
     }
 }
+
+#if LV_COLOR_DEPTH == 16
+
+#if LV_DRAW_SW_ESP32S3_PIE
+/**
+ * Fill 16 byte blocks with the 128 bit stores of the ESP32-S3's PIE.
+ * @param d32       pointer to the first block, must be 16 byte aligned
+ * @param color     the color to set
+ * @param block_num number of 16 byte (8 pixel) blocks
+ */
+LV_ATTRIBUTE_FAST_MEM static inline void fill_color16_pie(uint32_t * d32, lv_color_t color, int32_t block_num)
+{
+    /*Broadcast the color to the 8 lanes of q0*/
+    __asm__ volatile("ee.vldbc.16 q0, %0" : : "r"(&color.full) : "memory");
+    while(block_num) {
+        __asm__ volatile("ee.vst.128.ip q0, %0, 16" : "+r"(d32) : : "memory");
+        block_num--;
+    }
+}
+
+/**
+ * Copy 16 byte blocks with the 128 bit loads and stores of the ESP32-S3's PIE.
+ * @param d32       pointer to the first destination block, must be 16 byte aligned
+ * @param s32       pointer to the first source block, must be 16 byte aligned
+ * @param block_num number of 16 byte (8 pixel) blocks
+ */
+LV_ATTRIBUTE_FAST_MEM static inline void copy_color16_pie(uint32_t * d32, const uint32_t * s32, int32_t block_num)
+{
+    while(block_num) {
+        __asm__ volatile("ee.vld.128.ip q0, %0, 16" : "+r"(s32) : : "memory");
+        __asm__ volatile("ee.vst.128.ip q0, %0, 16" : "+r"(d32) : : "memory");
+        block_num--;
+    }
+}
+#endif /*LV_DRAW_SW_ESP32S3_PIE*/
+
+/**
+ * Fill pixels with a color writing 2 pixels at once with aligned 32 bit stores.
+ * The color is replicated as it is so `LV_COLOR_16_SWAP` needs no special handling.
+ * @param dest_buf  pointer to the first pixel
+ * @param color     the color to set
+ * @param px_num    number of pixels to fill
+ */
+LV_ATTRIBUTE_FAST_MEM static void fill_color16(lv_color_t * dest_buf, lv_color_t color, int32_t px_num)
+{
+    if(px_num <= 0) return;
+
+    /*Head: align to 4 bytes*/
+    if((lv_uintptr_t)dest_buf & 0x3) {
+        *dest_buf = color;
+        dest_buf++;
+        px_num--;
+    }
+
+    uint32_t c32 = (uint32_t)color.full + ((uint32_t)color.full << 16);
+    uint32_t * d32 = (uint32_t *)dest_buf;
+
+#if LV_DRAW_SW_ESP32S3_PIE
+    while(((lv_uintptr_t)d32 & 0xF) && px_num >= 2) {
+        *d32 = c32;
+        d32++;
+        px_num -= 2;
+    }
+
+    int32_t block_num = px_num >> 3;
+    if(block_num) {
+        fill_color16_pie(d32, color, block_num);
+        d32 += block_num * 4;
+        px_num -= block_num * 8;
+    }
+#endif
+
+    while(px_num >= 16) {
+        d32[0] = c32;
+        d32[1] = c32;
+        d32[2] = c32;
+        d32[3] = c32;
+        d32[4] = c32;
+        d32[5] = c32;
+        d32[6] = c32;
+        d32[7] = c32;
+        d32 += 8;
+        px_num -= 16;
+    }
+
+    while(px_num >= 2) {
+        *d32 = c32;
+        d32++;
+        px_num -= 2;
+    }
+
+    /*Tail: the last odd pixel*/
+    if(px_num) *((lv_color_t *)d32) = color;
+}
+
+/**
+ * Copy pixels 2 at a time with aligned 32 bit loads and stores,
+ * even if the source and destination are not aligned the same way.
+ * @param dest_buf  pointer to the first destination pixel
+ * @param src_buf   pointer to the first source pixel
+ * @param px_num    number of pixels to copy
+ */
+LV_ATTRIBUTE_FAST_MEM static void copy_color16(lv_color_t * dest_buf, const lv_color_t * src_buf, int32_t px_num)
+{
+    if(px_num <= 0) return;
+
+    /*Head: align the destination to 4 bytes*/
+    if((lv_uintptr_t)dest_buf & 0x3) {
+        *dest_buf = *src_buf;
+        dest_buf++;
+        src_buf++;
+        px_num--;
+        if(px_num == 0) return;
+    }
+
+    uint32_t * d32 = (uint32_t *)dest_buf;
+
+    if(((lv_uintptr_t)src_buf & 0x3) == 0) {
+        const uint32_t * s32 = (const uint32_t *)src_buf;
+
+#if LV_DRAW_SW_ESP32S3_PIE
+        while(((lv_uintptr_t)d32 & 0xF) && px_num >= 2) {
+            *d32 = *s32;
+            d32++;
+            s32++;
+            px_num -= 2;
+        }
+
+        int32_t block_num = px_num >> 3;
+        if(block_num && ((lv_uintptr_t)s32 & 0xF) == 0) {
+            copy_color16_pie(d32, s32, block_num);
+            d32 += block_num * 4;
+            s32 += block_num * 4;
+            px_num -= block_num * 8;
+        }
+#endif
+
+        while(px_num >= 16) {
+            d32[0] = s32[0];
+            d32[1] = s32[1];
+            d32[2] = s32[2];
+            d32[3] = s32[3];
+            d32[4] = s32[4];
+            d32[5] = s32[5];
+            d32[6] = s32[6];
+            d32[7] = s32[7];
+            d32 += 8;
+            s32 += 8;
+            px_num -= 16;
+        }
+
+        while(px_num >= 2) {
+            *d32 = *s32;
+            d32++;
+            s32++;
+            px_num -= 2;
+        }
+
+        dest_buf = (lv_color_t *)d32;
+        src_buf = (const lv_color_t *)s32;
+    }
+#if COPY_COLOR16_SHIFT
+    else {
+        /*The source is 2 bytes off: read aligned words and combine the upper half of the previous
+         *word with the lower half of the next one. `cur` is the pixel to write next.
+         *Stop 1 pixel earlier to not read after the last source pixel.*/
+        uint32_t cur = src_buf->full;
+        const uint32_t * s32 = (const uint32_t *)(src_buf + 1);
+        while(px_num >= 3) {
+            uint32_t next = *s32;
+            *d32 = cur | (next << 16);
+            cur = next >> 16;
+            d32++;
+            s32++;
+            px_num -= 2;
+        }
+
+        /*1 or 2 pixels are left and the first is in `cur`*/
+        dest_buf = (lv_color_t *)d32;
+        dest_buf->full = (uint16_t)cur;
+        dest_buf++;
+        px_num--;
+        src_buf = (const lv_color_t *)s32;
+    }
+#endif
+
+    /*Tail*/
+    while(px_num) {
+        *dest_buf = *src_buf;
+        dest_buf++;
+        src_buf++;
+        px_num--;
+    }
+}
+#endif /*LV_COLOR_DEPTH == 16*/
 #if LV_DRAW_COMPLEX
 static void map_blended(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
                         const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa,
@@ -39,7 +39,7 @@ static lv_grad_t * next_in_cache(lv_grad_t * item);
 typedef lv_res_t (*op_cache_t)(lv_grad_t * c, void * ctx);
 static lv_res_t iterate_cache(op_cache_t func, void * ctx, lv_grad_t ** out);
 static size_t get_cache_item_size(lv_grad_t * c);
-static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h);
+static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h, bool use_cache);
 static lv_res_t find_oldest_item_life(lv_grad_t * c, void * ctx);
 static lv_res_t kill_oldest_item(lv_grad_t * c, void * ctx);
 static lv_res_t find_item(lv_grad_t * c, void * ctx);
@@ -56,16 +56,18 @@ static uint8_t * grad_cache_end = 0;
 /**********************
  *   STATIC FUNCTIONS
  **********************/
-union void_cast {
-    const void * ptr;
-    const uint32_t value;
-};
-
 static uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t size, lv_coord_t w)
 {
-    union void_cast v;
-    v.ptr = g;
-    return (v.value ^ size ^ (w >> 1)); /*Yes, this is correct, it's like a hash that changes if the width changes*/
+    /*Hash the content of the descriptor and not its address,
+     *because the draw descriptors are usually on the stack and have the same address for every object*/
+    uint32_t key = 2166136261u;
+    uint8_t i;
+    for(i = 0; i < g->stops_count; i++) {
+        key = (key ^ lv_color_to32(g->stops[i].color)) * 16777619u;
+        key = (key ^ g->stops[i].frac) * 16777619u;
+    }
+    key = (key ^ g->dir) * 16777619u;
+    return (key ^ size ^ (w >> 1)); /*Yes, this is correct, it's like a hash that changes if the width changes*/
 }
 
 static size_t get_cache_item_size(lv_grad_t * c)
@@ -154,7 +156,7 @@ static lv_res_t find_item(lv_grad_t * c, void * ctx)
     return LV_RES_INV;
 }
 
-static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
+static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h, bool use_cache)
 {
     lv_coord_t size = g->dir == LV_GRAD_DIR_HOR ? w : h;
     lv_coord_t map_size = LV_MAX(w, h); /* The map is being used horizontally (width) unless
@@ -170,13 +172,13 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord
 
     size_t act_size = (size_t)(grad_cache_end - LV_GC_ROOT(_lv_grad_cache_mem));
     lv_grad_t * item = NULL;
-    if(req_size + act_size < grad_cache_size) {
+    if(use_cache && req_size + act_size < grad_cache_size) {
         item = (lv_grad_t *)grad_cache_end;
         item->not_cached = 0;
     }
     else {
         /*Need to evict items from cache until we find enough space to allocate this one */
-        if(req_size <= grad_cache_size) {
+        if(use_cache && req_size <= grad_cache_size) {
             while(act_size + req_size > grad_cache_size) {
                 uint32_t oldest_life = UINT32_MAX;
                 iterate_cache(&find_oldest_item_life, &oldest_life, NULL);
@@ -254,22 +256,28 @@ lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
 
     /* Step 0: Check if the cache exist (else create it) */
     static bool inited = false;
+    _lv_render_lock();
     if(!inited) {
         lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
         inited = true;
     }
+    _lv_render_unlock();
+
+    /* The cached items are modified while they are drawn (e.g. dithered), so the rendering threads
+     * can't share them. Use a private map while they are running. */
+    bool use_cache = !_lv_render_is_parallel();
 
     /* Step 1: Search cache for the given key */
     lv_coord_t size = g->dir == LV_GRAD_DIR_HOR ? w : h;
     uint32_t key = compute_key(g, size, w);
     lv_grad_t * item = NULL;
-    if(iterate_cache(&find_item, &key, &item) == LV_RES_OK) {
+    if(use_cache && iterate_cache(&find_item, &key, &item) == LV_RES_OK) {
         item->life++; /* Don't forget to bump the counter */
         return item;
     }
 
     /* Step 2: Need to allocate an item for it */
-    item = allocate_item(g, w, h);
+    item = allocate_item(g, w, h, use_cache);
     if(item == NULL) {
         LV_LOG_WARN("Faild to allcoate item for teh gradient");
         return item;
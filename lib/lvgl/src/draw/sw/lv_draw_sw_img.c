@@ -207,62 +207,56 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_img_decoded(struct _lv_draw_ctx_t * draw_c
                 int32_t rot_x = blend_area.x1 - coords->x1;
 #endif
 
-                for(x = 0; x < draw_area_w; x++, px_i++, map_px += px_size_byte) {
-
 #if LV_DRAW_COMPLEX
-                    if(transform) {
-
-                        /*Transform*/
-                        bool ret;
-                        ret = _lv_img_buf_transform(&trans_dsc, rot_x + x, rot_y + y);
-                        if(ret == false) {
-                            mask_buf[px_i] = LV_OPA_TRANSP;
-                            continue;
-                        }
-                        else {
-                            mask_buf[px_i] = trans_dsc.res.opa;
-                            c.full = trans_dsc.res.color.full;
+                if(transform) {
+                    /*Transform the whole row at once*/
+                    _lv_img_buf_transform_row(&trans_dsc, rot_x, rot_y + y, draw_area_w, &src_buf_rgb[px_i], &mask_buf[px_i]);
+                    if(draw_dsc->recolor_opa != 0) {
+                        for(x = 0; x < draw_area_w; x++) {
+                            if(mask_buf[px_i + x] == LV_OPA_TRANSP) continue;
+                            src_buf_rgb[px_i + x] = lv_color_mix_premult(recolor_premult, src_buf_rgb[px_i + x], recolor_opa_inv);
                         }
                     }
-                    /*No transform*/
-                    else
+                    px_i += draw_area_w;
+                }
+                /*No transform*/
+                else
 #endif
-                    {
-                        if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
-                            lv_opa_t px_opa = map_px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
-                            mask_buf[px_i] = px_opa;
-                            if(px_opa == 0) {
+                for(x = 0; x < draw_area_w; x++, px_i++, map_px += px_size_byte) {
+                    if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+                        lv_opa_t px_opa = map_px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+                        mask_buf[px_i] = px_opa;
+                        if(px_opa == 0) {
 #if  LV_COLOR_DEPTH == 32
-                                src_buf_rgb[px_i].full = 0;
+                            src_buf_rgb[px_i].full = 0;
 #endif
-                                continue;
-                            }
-                        }
-                        else {
-                            mask_buf[px_i] = 0xFF;
+                            continue;
                         }
+                    }
+                    else {
+                        mask_buf[px_i] = 0xFF;
+                    }
 
 #if LV_COLOR_DEPTH == 1
-                        c.full = map_px[0];
+                    c.full = map_px[0];
 #elif LV_COLOR_DEPTH == 8
-                        c.full = map_px[0];
+                    c.full = map_px[0];
 #elif LV_COLOR_DEPTH == 16
-                        c.full = map_px[0] + (map_px[1] << 8);
+                    c.full = map_px[0] + (map_px[1] << 8);
 #elif LV_COLOR_DEPTH == 32
-                        c.full = *((uint32_t *)map_px);
-                        c.ch.alpha = 0xFF;
+                    c.full = *((uint32_t *)map_px);
+                    c.ch.alpha = 0xFF;
 #endif
-                        if(cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
-                            if(c.full == chroma_keyed_color.full) {
-                                mask_buf[px_i] = LV_OPA_TRANSP;
+                    if(cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
+                        if(c.full == chroma_keyed_color.full) {
+                            mask_buf[px_i] = LV_OPA_TRANSP;
 #if  LV_COLOR_DEPTH == 32
-                                src_buf_rgb[px_i].full = 0;
+                            src_buf_rgb[px_i].full = 0;
 #endif
-                                continue;
-                            }
+                            continue;
                         }
-
                     }
+
                     if(draw_dsc->recolor_opa != 0) {
                         c = lv_color_mix_premult(recolor_premult, c, recolor_opa_inv);
                     }
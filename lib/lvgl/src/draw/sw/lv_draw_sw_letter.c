@@ -12,6 +12,7 @@
 #include "../../misc/lv_assert.h"
 #include "../../misc/lv_area.h"
 #include "../../misc/lv_style.h"
+#include "../../misc/lv_thread.h"
 #include "../../font/lv_font.h"
 #include "../../core/lv_refr.h"
 
@@ -138,7 +139,21 @@ void lv_draw_sw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc
         return;
     }
 
+    _lv_render_lock();
     const uint8_t * map_p = lv_font_get_glyph_bitmap(g.resolved_font, letter);
+
+    /*With parallel rendering an other thread might overwrite the bitmap in the font's cache.
+     *So draw a copy of it made while the font is still locked.*/
+    uint8_t * map_copy = NULL;
+    if(map_p && _lv_render_is_parallel() && g.bpp != LV_IMGFONT_BPP) {
+        uint32_t map_bpp = g.bpp == 3 ? 4 : g.bpp;
+        uint32_t map_size = ((uint32_t)g.box_w * g.box_h * map_bpp + 7) >> 3;
+        map_copy = lv_mem_buf_get(map_size);
+        if(map_copy) lv_memcpy(map_copy, map_p, map_size);
+        map_p = map_copy;
+    }
+    _lv_render_unlock();
+
     if(map_p == NULL) {
         LV_LOG_WARN("lv_draw_letter: character's bitmap not found");
         return;
@@ -154,6 +169,8 @@ void lv_draw_sw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc
     else {
         draw_letter_normal(draw_ctx, dsc, &gpos, &g, map_p);
     }
+
+    if(map_copy) lv_mem_buf_release(map_copy);
 }
 
 /**********************
@@ -216,9 +233,9 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
             return; /*Invalid bpp. Can't render the letter*/
     }
 
-    static lv_opa_t opa_table[256];
-    static lv_opa_t prev_opa = LV_OPA_TRANSP;
-    static uint32_t prev_bpp = 0;
+    static LV_THREAD_LOCAL lv_opa_t opa_table[256];
+    static LV_THREAD_LOCAL lv_opa_t prev_opa = LV_OPA_TRANSP;
+    static LV_THREAD_LOCAL uint32_t prev_bpp = 0;
     if(opa < LV_OPA_MAX) {
         if(prev_opa != opa || prev_bpp != bpp) {
             uint32_t i;
@@ -11,6 +11,7 @@
 #include "../../misc/lv_txt_ap.h"
 #include "../../core/lv_refr.h"
 #include "../../misc/lv_assert.h"
+#include "../../misc/lv_thread.h"
 #include "lv_draw_sw_dither.h"
 
 /*********************
@@ -477,21 +478,28 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(lv_draw_ctx_t * draw_ctx, const lv
     lv_opa_t * sh_buf;
 
 #if LV_SHADOW_CACHE_SIZE
-    if(sh_cache_size == corner_size && sh_cache_r == r_sh) {
+    /*The cache is shared by the rendering threads*/
+    _lv_render_lock();
+    bool cached = sh_cache_size == corner_size && sh_cache_r == r_sh;
+    if(cached) {
         /*Use the cache if available*/
         sh_buf = lv_mem_buf_get(corner_size * corner_size);
         lv_memcpy(sh_buf, sh_cache, corner_size * corner_size);
     }
-    else {
+    _lv_render_unlock();
+
+    if(!cached) {
         /*A larger buffer is required for calculation*/
         sh_buf = lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
         shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
 
         /*Cache the corner if it fits into the cache size*/
         if((uint32_t)corner_size * corner_size < sizeof(sh_cache)) {
+            _lv_render_lock();
             lv_memcpy(sh_cache, sh_buf, corner_size * corner_size);
             sh_cache_size = corner_size;
             sh_cache_r = r_sh;
+            _lv_render_unlock();
         }
     }
 #else
@@ -38,6 +38,11 @@ static lv_res_t decoder_open(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc)
 static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc,
                                   lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf);
 
+static lv_res_t decoder_read_area(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc,
+                                  const lv_area_t * area, uint8_t * buf);
+
+static void convert_line(bmp_dsc_t * b, lv_coord_t len, uint8_t * buf);
+
 static void decoder_close(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
 
 /**********************
@@ -57,6 +62,7 @@ void lv_bmp_init(void)
     lv_img_decoder_set_info_cb(dec, decoder_info);
     lv_img_decoder_set_open_cb(dec, decoder_open);
     lv_img_decoder_set_read_line_cb(dec, decoder_read_line);
+    lv_img_decoder_set_read_area_cb(dec, decoder_read_area);
     lv_img_decoder_set_close_cb(dec, decoder_close);
 }
 
@@ -178,6 +184,10 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
         if(dsc->user_data == NULL) return LV_RES_INV;
         memcpy(dsc->user_data, &b, sizeof(b));
 
+        /*The rows are read from the bottom of the file to the top*/
+        bmp_dsc_t * b_saved = dsc->user_data;
+        lv_fs_set_read_ahead(&b_saved->f, LV_FS_READ_AHEAD_BACKWARD);
+
         dsc->img_data = NULL;
         return LV_RES_OK;
     }
@@ -203,6 +213,47 @@ static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc
     lv_fs_seek(&b->f, p, LV_FS_SEEK_SET);
     lv_fs_read(&b->f, buf, len * (b->bpp / 8), NULL);
 
+    convert_line(b, len, buf);
+
+    return LV_RES_OK;
+}
+
+static lv_res_t decoder_read_area(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc,
+                                  const lv_area_t * area, uint8_t * buf)
+{
+    LV_UNUSED(decoder);
+
+    bmp_dsc_t * b = dsc->user_data;
+    lv_coord_t len = lv_area_get_width(area);
+    uint32_t line_size = len * sizeof(lv_color_t);
+
+    /*BMP images are stored upside down, so read the lines from the bottom to read the file forward.
+     *The lines follow each other without seeking if they are whole and not padded.*/
+    uint32_t p = b->px_offset + b->row_size_bytes * ((b->px_height - 1) - area->y2);
+    p += area->x1 * (b->bpp / 8);
+    lv_fs_seek(&b->f, p, LV_FS_SEEK_SET);
+
+    lv_coord_t y;
+    for(y = area->y2; y >= area->y1; y--) {
+        uint8_t * line = buf + (y - area->y1) * line_size;
+        lv_fs_read(&b->f, line, len * (b->bpp / 8), NULL);
+        convert_line(b, len, line);
+
+        p += b->row_size_bytes;
+        if(len * (b->bpp / 8) != (uint32_t)b->row_size_bytes) lv_fs_seek(&b->f, p, LV_FS_SEEK_SET);
+    }
+
+    return LV_RES_OK;
+}
+
+/**
+ * Convert the pixels of a line read from the file to the LVGL color format
+ * @param b     pointer to the opened BMP
+ * @param len   number of pixels in the line
+ * @param buf   the read pixels, it needs to be `len * sizeof(lv_color_t)` bytes
+ */
+static void convert_line(bmp_dsc_t * b, lv_coord_t len, uint8_t * buf)
+{
 #if LV_COLOR_DEPTH == 32
     if(b->bpp == 32) {
         lv_coord_t i;
@@ -230,9 +281,11 @@ static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc
             c->ch.alpha = 0xff;
         }
     }
+#else
+    LV_UNUSED(b);
+    LV_UNUSED(len);
+    LV_UNUSED(buf);
 #endif
-
-    return LV_RES_OK;
 }
 
 
@@ -0,0 +1,309 @@
+/**
+ * @file lv_fs_mmap.c
+ *
+ */
+
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+
+#if LV_USE_FS_MMAP
+
+#ifdef ESP_PLATFORM
+    #include "esp_partition.h"
+    #include "esp_idf_version.h"
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#if LV_FS_MMAP_LETTER == '\0'
+    #error "LV_FS_MMAP_LETTER must be an upper case ASCII letter"
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    const uint8_t * data;
+    uint32_t size;
+    uint32_t pos;
+#ifdef ESP_PLATFORM
+#if ESP_IDF_VERSION_MAJOR >= 5
+    esp_partition_mmap_handle_t handle;
+#else
+    spi_flash_mmap_handle_t handle;
+#endif
+#endif
+} mmap_file_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void * fs_open(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode);
+static lv_fs_res_t fs_close(lv_fs_drv_t * drv, void * file_p);
+static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
+static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+static lv_fs_res_t fs_map(lv_fs_drv_t * drv, void * file_p, const void ** ptr, uint32_t * size);
+static bool map_file(mmap_file_t * f, const char * path);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Register a driver for the File system interface
+ */
+void lv_fs_mmap_init(void)
+{
+    /*---------------------------------------------------
+     * Register the file system interface in LVGL
+     *--------------------------------------------------*/
+
+    /*Add a simple drive to open images*/
+    static lv_fs_drv_t fs_drv; /*A driver descriptor*/
+    lv_fs_drv_init(&fs_drv);
+
+    /*Set up fields...*/
+    fs_drv.letter = LV_FS_MMAP_LETTER;
+    fs_drv.cache_size = 0;  /*The data is already in the memory*/
+
+    fs_drv.open_cb = fs_open;
+    fs_drv.close_cb = fs_close;
+    fs_drv.read_cb = fs_read;
+    fs_drv.seek_cb = fs_seek;
+    fs_drv.tell_cb = fs_tell;
+    fs_drv.map_cb = fs_map;
+
+    lv_fs_drv_register(&fs_drv);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Open a file and map its content to the memory
+ * @param drv pointer to a driver where this function belongs
+ * @param path path to the file beginning with the driver letter (e.g. S:/folder/file.txt).
+ *             On ESP32 the label of a data partition (e.g. S:/images)
+ * @param mode only FS_MODE_RD is supported
+ * @return a file handle or NULL in case of fail
+ */
+static void * fs_open(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode)
+{
+    LV_UNUSED(drv);
+
+    if(mode != LV_FS_MODE_RD) return NULL;
+
+    mmap_file_t * f = lv_mem_alloc(sizeof(mmap_file_t));
+    if(f == NULL) return NULL;
+    lv_memset_00(f, sizeof(mmap_file_t));
+
+    if(!map_file(f, path)) {
+        lv_mem_free(f);
+        return NULL;
+    }
+
+    return f;
+}
+
+/**
+ * Close an opened file and unmap its content
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p a file handle. (opened with fs_open)
+ * @return LV_FS_RES_OK: no error, the file is read
+ *         any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_close(lv_fs_drv_t * drv, void * file_p)
+{
+    LV_UNUSED(drv);
+    mmap_file_t * f = file_p;
+#ifdef ESP_PLATFORM
+#if ESP_IDF_VERSION_MAJOR >= 5
+    esp_partition_munmap(f->handle);
+#else
+    spi_flash_munmap(f->handle);
+#endif
+#else
+    if(f->data) munmap((void *)f->data, f->size);
+#endif
+    lv_mem_free(f);
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Read data from an opened file
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p a file handle variable.
+ * @param buf pointer to a memory block where to store the read data
+ * @param btr number of Bytes To Read
+ * @param br the real number of read bytes (Byte Read)
+ * @return LV_FS_RES_OK: no error, the file is read
+ *         any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    LV_UNUSED(drv);
+    mmap_file_t * f = file_p;
+    uint32_t left = f->pos < f->size ? f->size - f->pos : 0;
+    *br = LV_MIN(btr, left);
+    if(*br) lv_memcpy(buf, f->data + f->pos, *br);
+    f->pos += *br;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Set the read pointer.
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p a file handle variable. (opened with fs_open )
+ * @param pos the new position of read pointer
+ * @param whence tells from where set the position. See @lv_fs_whence_t
+ * @return LV_FS_RES_OK: no error, the file is read
+ *         any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence)
+{
+    LV_UNUSED(drv);
+    mmap_file_t * f = file_p;
+    switch(whence) {
+        case LV_FS_SEEK_SET:
+            f->pos = pos;
+            break;
+        case LV_FS_SEEK_CUR:
+            f->pos += pos;
+            break;
+        case LV_FS_SEEK_END:
+            f->pos = f->size + pos;
+            break;
+        default:
+            return LV_FS_RES_INV_PARAM;
+    }
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Give the position of the read pointer
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p a file handle variable.
+ * @param pos_p pointer to to store the result
+ * @return LV_FS_RES_OK: no error, the file is read
+ *         any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    LV_UNUSED(drv);
+    mmap_file_t * f = file_p;
+    *pos_p = f->pos;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Give the address of the mapped content of the file
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p a file handle variable.
+ * @param ptr store the address of the content here
+ * @param size store the size of the file here
+ * @return LV_FS_RES_OK: no error, the file is read
+ *         any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_map(lv_fs_drv_t * drv, void * file_p, const void ** ptr, uint32_t * size)
+{
+    LV_UNUSED(drv);
+    mmap_file_t * f = file_p;
+    if(f->data == NULL) return LV_FS_RES_NOT_IMP;   /*Empty file*/
+
+    *ptr = f->data;
+    *size = f->size;
+    return LV_FS_RES_OK;
+}
+
+#ifdef ESP_PLATFORM
+
+static bool map_file(mmap_file_t * f, const char * path)
+{
+    /*The file is a data partition, the path is its label*/
+    char label[32];
+    lv_snprintf(label, sizeof(label), LV_FS_MMAP_PATH "%s", path[0] == '/' ? path + 1 : path);
+
+    const esp_partition_t * part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if(part == NULL) return false;
+
+    const void * data;
+#if ESP_IDF_VERSION_MAJOR >= 5
+    esp_err_t err = esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA, &data, &f->handle);
+#else
+    esp_err_t err = esp_partition_mmap(part, 0, part->size, SPI_FLASH_MMAP_DATA, &data, &f->handle);
+#endif
+    if(err != ESP_OK) {
+        LV_LOG_WARN("Couldn't map the %s partition (error %d)", label, (int)err);
+        return false;
+    }
+
+    f->data = data;
+    f->size = part->size;
+    return true;
+}
+
+#else
+
+static bool map_file(mmap_file_t * f, const char * path)
+{
+    /*Make the path relative to the current directory (the projects root folder)*/
+    char buf[256];
+    lv_snprintf(buf, sizeof(buf), LV_FS_MMAP_PATH "%s", path);
+
+    int fd = open(buf, O_RDONLY);
+    if(fd < 0) return false;
+
+    struct stat st;
+    if(fstat(fd, &st) != 0 || st.st_size > UINT32_MAX) {
+        close(fd);
+        return false;
+    }
+
+    /*Empty files can't be mapped but they can be opened*/
+    void * data = NULL;
+    if(st.st_size > 0) {
+        data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(data == MAP_FAILED) {
+            close(fd);
+            return false;
+        }
+    }
+
+    /*The mapping stays valid after closing the file*/
+    close(fd);
+
+    f->data = data;
+    f->size = st.st_size;
+    return true;
+}
+
+#endif /*ESP_PLATFORM*/
+
+#else /*LV_USE_FS_MMAP == 0*/
+
+#if defined(LV_FS_MMAP_LETTER) && LV_FS_MMAP_LETTER != '\0'
+    #warning "LV_USE_FS_MMAP is not enabled but LV_FS_MMAP_LETTER is set"
+#endif
+
+#endif /*LV_USE_FS_MMAP*/
@@ -9,21 +9,12 @@
 #include <stdbool.h>
 
 #define MIN(A, B) ((A) < (B) ? (A) : (B))
-#define MAX(A, B) ((A) > (B) ? (A) : (B))
 
-typedef struct Entry {
-    uint16_t length;
-    uint16_t prefix;
-    uint8_t  suffix;
-} Entry;
+/* Size of the palette in the beginning of an indexed canvas */
+#define PALETTE_SIZE (0x100 * sizeof(lv_color32_t))
 
-typedef struct Table {
-    int bulk;
-    int nentries;
-    Entry *entries;
-} Table;
-
-static gd_GIF *  gif_open(gd_GIF * gif);
+static gd_GIF *  gif_open(gd_GIF * gif, bool indexed);
+static void discard_sub_blocks(gd_GIF *gif);
 static bool f_gif_open(gd_GIF * gif, const void * path, bool is_file);
 static void f_gif_read(gd_GIF * gif, void * buf, size_t len);
 static int f_gif_seek(gd_GIF * gif, size_t pos, int k);
@@ -49,7 +40,19 @@ gd_open_gif_file(const char *fname)
     bool res = f_gif_open(&gif_base, fname, true);
     if(!res) return NULL;
 
-    return gif_open(&gif_base);
+    return gif_open(&gif_base, false);
+}
+
+gd_GIF *
+gd_open_gif_file_indexed(const char *fname)
+{
+    gd_GIF gif_base;
+    memset(&gif_base, 0, sizeof(gif_base));
+
+    bool res = f_gif_open(&gif_base, fname, true);
+    if(!res) return NULL;
+
+    return gif_open(&gif_base, true);
 }
 
 
@@ -62,10 +65,84 @@ gd_open_gif_data(const void *data)
     bool res = f_gif_open(&gif_base, data, false);
     if(!res) return NULL;
 
-    return gif_open(&gif_base);
+    return gif_open(&gif_base, false);
 }
 
-static gd_GIF * gif_open(gd_GIF * gif_base)
+gd_GIF *
+gd_open_gif_data_indexed(const void *data)
+{
+    gd_GIF gif_base;
+    memset(&gif_base, 0, sizeof(gif_base));
+
+    bool res = f_gif_open(&gif_base, data, false);
+    if(!res) return NULL;
+
+    return gif_open(&gif_base, true);
+}
+
+/* Check if all the frames can be decoded into one indexed canvas.
+ * It's possible only if every frame uses the global palette. If a frame is
+ * restored to a transparent background, a palette entry is needed for the
+ * transparent pixels too: the first unused entry, or the transparent index if
+ * all the frames have the same one (so it's never drawn).
+ * Return the transparent entry, 0x100 if there is none or -1 if not possible. */
+static int
+scan_indexed(gd_GIF *gif)
+{
+    char sep;
+    uint8_t label, rdit, tindex, fisrz;
+    int disposal = 0, transparency = 0;
+    int first_tindex = -1, same_tindex = 1, all_transparent = 1, need_tindex = 0;
+
+    tindex = 0;
+    for (;;) {
+        sep = 0;
+        f_gif_read(gif, &sep, 1);
+        if (sep == ';') {
+            break;
+        } else if (sep == '!') {
+            f_gif_read(gif, &label, 1);
+            if (label == 0xF9) {
+                /* Discard block size (always 0x04). */
+                f_gif_seek(gif, 1, LV_FS_SEEK_CUR);
+                f_gif_read(gif, &rdit, 1);
+                disposal = (rdit >> 2) & 3;
+                transparency = rdit & 1;
+                /* Discard delay. */
+                f_gif_seek(gif, 2, LV_FS_SEEK_CUR);
+                f_gif_read(gif, &tindex, 1);
+                /* Skip block terminator. */
+                f_gif_seek(gif, 1, LV_FS_SEEK_CUR);
+            } else {
+                discard_sub_blocks(gif);
+            }
+        } else if (sep == ',') {
+            /* Discard position and size. */
+            f_gif_seek(gif, 8, LV_FS_SEEK_CUR);
+            f_gif_read(gif, &fisrz, 1);
+            if (fisrz & 0x80) return -1;
+            /* Discard LZW code size and image data. */
+            f_gif_seek(gif, 1, LV_FS_SEEK_CUR);
+            discard_sub_blocks(gif);
+            if (transparency) {
+                if (first_tindex < 0) first_tindex = tindex;
+                else if (first_tindex != tindex) same_tindex = 0;
+                if (disposal == 2) need_tindex = 1;
+            } else {
+                all_transparent = 0;
+            }
+        } else {
+            return -1;
+        }
+    }
+
+    if (!need_tindex) return 0x100;
+    if (gif->gct.size < 0x100) return gif->gct.size;
+    if (all_transparent && same_tindex && first_tindex != gif->bgindex) return first_tindex;
+    return -1;
+}
+
+static gd_GIF * gif_open(gd_GIF * gif_base, bool indexed)
 {
     uint8_t sigver[3];
     uint16_t width, height, depth;
@@ -107,6 +184,10 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
     /* Aspect Ratio */
     f_gif_read(gif_base, &aspect, 1);
     /* Create gd_GIF Structure. */
+    if (indexed) {
+        /* The canvas is the palette and the indices, the frame is decoded into the indices */
+        gif = lv_mem_alloc(sizeof(gd_GIF) + PALETTE_SIZE + width * height);
+    } else {
 #if LV_COLOR_DEPTH == 32
     gif = lv_mem_alloc(sizeof(gd_GIF) + 5 * width * height);
 #elif LV_COLOR_DEPTH == 16
@@ -114,9 +195,16 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
 #elif LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
     gif = lv_mem_alloc(sizeof(gd_GIF) + 3 * width * height);
 #endif
+    }
 
     if (!gif) goto fail;
     memcpy(gif, gif_base, sizeof(gd_GIF));
+    gif->lzw = lv_mem_alloc(sizeof(gd_LZW));
+    if (!gif->lzw) {
+        lv_mem_free(gif);
+        gif = NULL;
+        goto fail;
+    }
     gif->width  = width;
     gif->height = height;
     gif->depth  = depth;
@@ -126,6 +214,32 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
     gif->palette = &gif->gct;
     gif->bgindex = bgidx;
     gif->canvas = (uint8_t *) &gif[1];
+    gif->anim_start = f_gif_seek(gif, 0, LV_FS_SEEK_CUR);
+    if (indexed) {
+        int tindex = scan_indexed(gif);
+        if (tindex < 0) {
+            LV_LOG_INFO("the GIF can't be decoded to an indexed image\n");
+            lv_mem_free(gif->lzw);
+            lv_mem_free(gif);
+            gif = NULL;
+            goto fail;
+        }
+        f_gif_seek(gif, gif->anim_start, LV_FS_SEEK_SET);
+
+        lv_color32_t *palette = (lv_color32_t *) gif->canvas;
+        for (i = 0; i < 0x100; i++) {
+            uint8_t *color = &gif->gct.colors[MIN(i, gif->gct.size - 1) * 3];
+            palette[i].ch.red = color[0];
+            palette[i].ch.green = color[1];
+            palette[i].ch.blue = color[2];
+            palette[i].ch.alpha = i == tindex ? 0x00 : 0xFF;
+        }
+        gif->indexed = 1;
+        gif->canvas_tindex = (uint8_t) tindex;
+        gif->frame = &gif->canvas[PALETTE_SIZE];
+        memset(gif->frame, gif->bgindex, gif->width * gif->height);
+        goto ok;
+    }
 #if LV_COLOR_DEPTH == 32
     gif->frame = &gif->canvas[4 * width * height];
 #elif LV_COLOR_DEPTH == 16
@@ -159,7 +273,6 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
         gif->canvas[i*2 + 1] = 0xff;
 #endif
     }
-    gif->anim_start = f_gif_seek(gif, 0, LV_FS_SEEK_CUR);
     goto ok;
 fail:
     f_gif_close(gif_base);
@@ -286,44 +399,6 @@ read_ext(gd_GIF *gif)
     }
 }
 
-static Table *
-new_table(int key_size)
-{
-    int key;
-    int init_bulk = MAX(1 << (key_size + 1), 0x100);
-    Table *table = lv_mem_alloc(sizeof(*table) + sizeof(Entry) * init_bulk);
-    if (table) {
-        table->bulk = init_bulk;
-        table->nentries = (1 << key_size) + 2;
-        table->entries = (Entry *) &table[1];
-        for (key = 0; key < (1 << key_size); key++)
-            table->entries[key] = (Entry) {1, 0xFFF, key};
-    }
-    return table;
-}
-
-/* Add table entry. Return value:
- *  0 on success
- *  +1 if key size must be incremented after this addition
- *  -1 if could not realloc table */
-static int
-add_entry(Table **tablep, uint16_t length, uint16_t prefix, uint8_t suffix)
-{
-    Table *table = *tablep;
-    if (table->nentries == table->bulk) {
-        table->bulk *= 2;
-        table = lv_mem_realloc(table, sizeof(*table) + sizeof(Entry) * table->bulk);
-        if (!table) return -1;
-        table->entries = (Entry *) &table[1];
-        *tablep = table;
-    }
-    table->entries[table->nentries] = (Entry) {length, prefix, suffix};
-    table->nentries++;
-    if ((table->nentries & (table->nentries - 1)) == 0)
-        return 1;
-    return 0;
-}
-
 static uint16_t
 get_key(gd_GIF *gif, int key_size, uint8_t *sub_len, uint8_t *shift, uint8_t *byte)
 {
@@ -376,74 +451,106 @@ interlaced_line_index(int h, int y)
 }
 
 /* Decompress image pixels.
- * Return 0 on success or -1 on out-of-memory (w.r.t. LZW code table). */
+ * Every code is expanded to its whole string on the stack of `gif->lzw` which is then copied into the frame
+ * row by row.
+ * Return 0 on success or -1 on error. */
 static int
 read_image_data(gd_GIF *gif, int interlace)
 {
     uint8_t sub_len, shift, byte;
-    int init_key_size, key_size, table_is_full=0;
-    int frm_off, frm_size, str_len=0, i, p, x, y;
-    uint16_t key, clear, stop;
-    int ret;
-    Table *table;
-    Entry entry = {0};
-    size_t start, end;
+    int init_key_size, key_size;
+    int x, y, line;
+    uint16_t key, clear, stop, next, prev, code;
+    uint8_t first;
+    gd_LZW *lzw = gif->lzw;
+    uint8_t *stack_end = &lzw->stack[sizeof(lzw->stack)];
+    uint8_t *sp, *row;
+    size_t start, end, run, i;
+    /* The frame is decoded directly into an indexed canvas so keep the pixels under the transparent ones */
+    int skip_transparent = gif->indexed && gif->gce.transparency;
 
     f_gif_read(gif, &byte, 1);
     key_size = (int) byte;
+    if (key_size < 1 || key_size > 11) {
+        LV_LOG_WARN("invalid LZW code size\n");
+        return -1;
+    }
     start = f_gif_seek(gif, 0, LV_FS_SEEK_CUR);
     discard_sub_blocks(gif);
     end = f_gif_seek(gif, 0, LV_FS_SEEK_CUR);
     f_gif_seek(gif, start, LV_FS_SEEK_SET);
     clear = 1 << key_size;
     stop = clear + 1;
-    table = new_table(key_size);
     key_size++;
     init_key_size = key_size;
+    next = clear + 2;
+    prev = 0xFFFF;
+    first = 0;
     sub_len = shift = 0;
-    key = get_key(gif, key_size, &sub_len, &shift, &byte); /* clear code */
-    frm_off = 0;
-    ret = 0;
-    frm_size = gif->fw*gif->fh;
-    while (frm_off < frm_size) {
+    x = y = 0;
+    row = &gif->frame[gif->fy * gif->width + gif->fx];
+    key = 0;
+    while (y < gif->fh) {
+        key = get_key(gif, key_size, &sub_len, &shift, &byte);
         if (key == clear) {
             key_size = init_key_size;
-            table->nentries = (1 << (key_size - 1)) + 2;
-            table_is_full = 0;
-        } else if (!table_is_full) {
-            ret = add_entry(&table, str_len + 1, key, entry.suffix);
-            if (ret == -1) {
-                lv_mem_free(table);
-                return -1;
+            next = clear + 2;
+            prev = 0xFFFF;
+            continue;
+        }
+        if (key == stop || key == 0x1000) break;
+
+        /* Expand the code to the stack backwards. */
+        sp = stack_end;
+        if (prev == 0xFFFF) {
+            if (key >= clear) break; /* The first code after a clear must be a root. */
+            first = (uint8_t) key;
+            *--sp = first;
+        } else {
+            code = key;
+            if (code > next || (code == next && next == 0x1000)) break; /* Corrupt data. */
+            if (code == next) {
+                /* The string of the previous code and its first byte. */
+                *--sp = first;
+                code = prev;
             }
-            if (table->nentries == 0x1000) {
-                ret = 0;
-                table_is_full = 1;
+            while (code >= clear) {
+                *--sp = lzw->suffix[code];
+                code = lzw->prefix[code];
+            }
+            first = (uint8_t) code;
+            *--sp = first;
+            if (next < 0x1000) {
+                lzw->prefix[next] = prev;
+                lzw->suffix[next] = first;
+                next++;
+                if (next == (1 << key_size) && key_size < 12) key_size++;
             }
         }
-        key = get_key(gif, key_size, &sub_len, &shift, &byte);
-        if (key == clear) continue;
-        if (key == stop || key == 0x1000) break;
-        if (ret == 1) key_size++;
-        entry = table->entries[key];
-        str_len = entry.length;
-        for (i = 0; i < str_len; i++) {
-            p = frm_off + entry.length - 1;
-            x = p % gif->fw;
-            y = p / gif->fw;
-            if (interlace)
-                y = interlaced_line_index((int) gif->fh, y);
-            gif->frame[(gif->fy + y) * gif->width + gif->fx + x] = entry.suffix;
-            if (entry.prefix == 0xFFF)
-                break;
-            else
-                entry = table->entries[entry.prefix];
+        prev = key;
+
+        /* Copy the whole string into the rows of the frame. */
+        while (sp < stack_end && y < gif->fh) {
+            run = MIN((size_t)(stack_end - sp), (size_t)(gif->fw - x));
+            if (skip_transparent) {
+                for (i = 0; i < run; i++) {
+                    if (sp[i] != gif->gce.tindex) row[x + i] = sp[i];
+                }
+            } else {
+                memcpy(&row[x], sp, run);
+            }
+            sp += run;
+            x += run;
+            if (x == gif->fw) {
+                x = 0;
+                y++;
+                if (y < gif->fh) {
+                    line = interlace ? interlaced_line_index((int) gif->fh, y) : y;
+                    row = &gif->frame[(gif->fy + line) * gif->width + gif->fx];
+                }
+            }
         }
-        frm_off += str_len;
-        if (key < table->nentries - 1 && !table_is_full)
-            table->entries[table->nentries - 1].suffix = entry.suffix;
     }
-    lv_mem_free(table);
     if (key == stop) f_gif_read(gif, &sub_len, 1); /* Must be zero! */
     f_gif_seek(gif, end, LV_FS_SEEK_SET);
     return 0;
@@ -520,6 +627,13 @@ dispose(gd_GIF *gif)
     uint8_t *bgcolor;
     switch (gif->gce.disposal) {
     case 2: /* Restore to background color. */
+        if (gif->indexed) {
+            uint8_t index = gif->gce.transparency ? gif->canvas_tindex : gif->bgindex;
+            for (j = 0; j < gif->fh; j++) {
+                memset(&gif->frame[(gif->fy + j) * gif->width + gif->fx], index, gif->fw);
+            }
+            break;
+        }
         bgcolor = &gif->palette->colors[gif->bgindex*3];
 
         uint8_t opa = 0xff;
@@ -554,8 +668,8 @@ dispose(gd_GIF *gif)
     case 3: /* Restore to previous, i.e., don't update canvas.*/
         break;
     default:
-        /* Add frame non-transparent pixels to canvas. */
-        render_frame_rect(gif, gif->canvas);
+        /* The non-transparent pixels of the frame are already added to the canvas by gd_render_frame(). */
+        break;
     }
 }
 
@@ -592,6 +706,8 @@ gd_render_frame(gd_GIF *gif, uint8_t *buffer)
 //        buffer[j + 3] = 0xFF;
 //    }
 //    memcpy(buffer, gif->canvas, gif->width * gif->height * 3);
+    /* The indexed canvas is updated by gd_get_frame() already */
+    if (gif->indexed) return;
     render_frame_rect(gif, buffer);
 }
 
@@ -605,6 +721,7 @@ void
 gd_close_gif(gd_GIF *gif)
 {
     f_gif_close(gif);
+    lv_mem_free(gif->lzw);
     lv_mem_free(gif);
 }
 
@@ -612,12 +729,22 @@ static bool f_gif_open(gd_GIF * gif, const void * path, bool is_file)
 {
     gif->f_rw_p = 0;
     gif->data = NULL;
+    gif->data_size = 0;
     gif->is_file = is_file;
 
     if(is_file) {
         lv_fs_res_t res = lv_fs_open(&gif->fd, path, LV_FS_MODE_RD);
         if(res != LV_FS_RES_OK) return false;
-        else return true;
+
+        /* Read a memory mapped file like data, the file stays open until closing the GIF */
+        const void * map;
+        uint32_t map_size;
+        if(lv_fs_map(&gif->fd, &map, &map_size) == LV_FS_RES_OK) {
+            gif->data = map;
+            gif->data_size = map_size;
+            gif->is_file = false;
+        }
+        return true;
     } else {
         gif->data = path;
         return true;
@@ -630,7 +757,14 @@ static void f_gif_read(gd_GIF * gif, void * buf, size_t len)
         lv_fs_read(&gif->fd, buf, len, NULL);
     } else
     {
-        memcpy(buf, &gif->data[gif->f_rw_p], len);
+        size_t n = len;
+        if (gif->data_size) {
+            /* Don't read after the end of a truncated file */
+            n = gif->f_rw_p < gif->data_size ? gif->data_size - gif->f_rw_p : 0;
+            if (n > len) n = len;
+            memset((uint8_t *)buf + n, 0, len - n);
+        }
+        memcpy(buf, &gif->data[gif->f_rw_p], n);
         gif->f_rw_p += len;
     }
 }
@@ -651,7 +785,8 @@ static int f_gif_seek(gd_GIF * gif, size_t pos, int k)
 
 static void f_gif_close(gd_GIF * gif)
 {
-    if(gif->is_file) {
+    /* Mapped files are open too */
+    if(gif->fd.drv) {
         lv_fs_close(&gif->fd);
     }
 }
@@ -21,9 +21,18 @@ typedef struct gd_GCE {
 
 
 
+/* The LZW code table and the stack of the decoded string.
+ * It's allocated once and reused by every frame. */
+typedef struct gd_LZW {
+    uint16_t prefix[0x1000];
+    uint8_t suffix[0x1000];
+    uint8_t stack[0x1000];
+} gd_LZW;
+
 typedef struct gd_GIF {
     lv_fs_file_t fd;
     const char * data;
+    uint32_t data_size;     /* 0 if unknown */
     uint8_t is_file;
     uint32_t f_rw_p;
     int32_t anim_start;
@@ -43,12 +52,25 @@ typedef struct gd_GIF {
     uint16_t fx, fy, fw, fh;
     uint8_t bgindex;
     uint8_t *canvas, *frame;
+    gd_LZW *lzw;
+    uint8_t indexed;
+    uint8_t canvas_tindex;
 } gd_GIF;
 
 gd_GIF * gd_open_gif_file(const char *fname);
 
 gd_GIF * gd_open_gif_data(const void *data);
 
+/* Open the GIF to decode it into an `LV_IMG_CF_INDEXED_8BIT` canvas: a palette
+ * of 256 `lv_color32_t` followed by 1 byte per pixel. The frames are decoded
+ * directly into the canvas.
+ * Return NULL if the GIF can't be opened or it has local palettes. */
+gd_GIF * gd_open_gif_file_indexed(const char *fname);
+
+gd_GIF * gd_open_gif_data_indexed(const void *data);
+
+/* Convert the area of the current frame into `buffer`. It must be `gif->canvas`
+ * because the next frames are drawn on the previous ones there. */
 void gd_render_frame(gd_GIF *gif, uint8_t *buffer);
 
 int gd_get_frame(gd_GIF *gif);
@@ -27,11 +27,13 @@
 static void lv_gif_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void next_frame_task_cb(lv_timer_t * t);
+static void invalidate_frame_area(lv_obj_t * obj, const lv_area_t * area);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_gif_class = {
+    .name = "lv_gif",
     .constructor_cb = lv_gif_constructor,
     .destructor_cb = lv_gif_destructor,
     .instance_size = sizeof(lv_gif_t),
@@ -69,10 +71,12 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
 
     if(lv_img_src_get_type(src) == LV_IMG_SRC_VARIABLE) {
         const lv_img_dsc_t * img_dsc = src;
-        gifobj->gif = gd_open_gif_data(img_dsc->data);
+        if(gifobj->indexed) gifobj->gif = gd_open_gif_data_indexed(img_dsc->data);
+        if(gifobj->gif == NULL) gifobj->gif = gd_open_gif_data(img_dsc->data);
     }
     else if(lv_img_src_get_type(src) == LV_IMG_SRC_FILE) {
-        gifobj->gif = gd_open_gif_file(src);
+        if(gifobj->indexed) gifobj->gif = gd_open_gif_file_indexed(src);
+        if(gifobj->gif == NULL) gifobj->gif = gd_open_gif_file(src);
     }
     if(gifobj->gif == NULL) {
         LV_LOG_WARN("Could't load the source");
@@ -81,7 +85,7 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
 
     gifobj->imgdsc.data = gifobj->gif->canvas;
     gifobj->imgdsc.header.always_zero = 0;
-    gifobj->imgdsc.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    gifobj->imgdsc.header.cf = gifobj->gif->indexed ? LV_IMG_CF_INDEXED_8BIT : LV_IMG_CF_TRUE_COLOR_ALPHA;
     gifobj->imgdsc.header.h = gifobj->gif->height;
     gifobj->imgdsc.header.w = gifobj->gif->width;
     gifobj->last_call = lv_tick_get();
@@ -101,6 +105,18 @@ void lv_gif_restart(lv_obj_t * obj)
     gd_rewind(gifobj->gif);
 }
 
+void lv_gif_set_indexed(lv_obj_t * obj, bool en)
+{
+    lv_gif_t * gifobj = (lv_gif_t *) obj;
+    gifobj->indexed = en;
+}
+
+bool lv_gif_is_indexed(lv_obj_t * obj)
+{
+    lv_gif_t * gifobj = (lv_gif_t *) obj;
+    return gifobj->gif && gifobj->gif->indexed;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -120,7 +136,7 @@ static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     LV_UNUSED(class_p);
     lv_gif_t * gifobj = (lv_gif_t *) obj;
     lv_img_cache_invalidate_src(&gifobj->imgdsc);
-    gd_close_gif(gifobj->gif);
+    if(gifobj->gif) gd_close_gif(gifobj->gif);
     lv_timer_del(gifobj->timer);
 }
 
@@ -133,6 +149,15 @@ static void next_frame_task_cb(lv_timer_t * t)
 
     gifobj->last_call = lv_tick_get();
 
+    /*Disposing the previous frame changes its area on the canvas too*/
+    gd_GIF * gif = gifobj->gif;
+    lv_area_t inv_area;
+    bool inv = false;
+    if(gif->fw > 0 && gif->fh > 0 && (gif->gce.disposal == 2 || gif->gce.disposal == 3)) {
+        lv_area_set(&inv_area, gif->fx, gif->fy, gif->fx + gif->fw - 1, gif->fy + gif->fh - 1);
+        inv = true;
+    }
+
     int has_next = gd_get_frame(gifobj->gif);
     if(has_next == 0) {
         /*It was the last repeat*/
@@ -146,10 +171,48 @@ static void next_frame_task_cb(lv_timer_t * t)
         }
     }
 
+    /*Only the area of the new frame is converted to the canvas*/
     gd_render_frame(gifobj->gif, (uint8_t *)gifobj->imgdsc.data);
 
+    if(has_next == 1 && gif->fw > 0 && gif->fh > 0) {
+        lv_area_t frame_area;
+        lv_area_set(&frame_area, gif->fx, gif->fy, gif->fx + gif->fw - 1, gif->fy + gif->fh - 1);
+        if(inv) _lv_area_join(&inv_area, &inv_area, &frame_area);
+        else lv_area_copy(&inv_area, &frame_area);
+        inv = true;
+    }
+
     lv_img_cache_invalidate_src(lv_img_get_src(obj));
-    lv_obj_invalidate(obj);
+    if(inv) invalidate_frame_area(obj, &inv_area);
+}
+
+/**
+ * Invalidate the changed part of the canvas.
+ * @param obj       pointer to a GIF object
+ * @param area      the changed area in the coordinates of the canvas
+ */
+static void invalidate_frame_area(lv_obj_t * obj, const lv_area_t * area)
+{
+    lv_img_t * img = (lv_img_t *) obj;
+
+    /*Map the area to the screen only if the canvas is drawn once without transformation*/
+    bool simple = img->angle == 0 && img->zoom == LV_IMG_ZOOM_NONE &&
+                  img->offset.x == 0 && img->offset.y == 0 &&
+                  lv_obj_get_style_transform_angle(obj, LV_PART_MAIN) == 0 &&
+                  lv_obj_get_style_transform_zoom(obj, LV_PART_MAIN) == LV_IMG_ZOOM_NONE &&
+                  lv_obj_get_content_width(obj) == img->w && lv_obj_get_content_height(obj) == img->h;
+    if(!simple) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    lv_area_t content;
+    lv_obj_get_content_coords(obj, &content);
+
+    lv_area_t inv_area;
+    lv_area_copy(&inv_area, area);
+    lv_area_move(&inv_area, content.x1, content.y1);
+    lv_obj_invalidate_area(obj, &inv_area);
 }
 
 #endif /*LV_USE_GIF*/
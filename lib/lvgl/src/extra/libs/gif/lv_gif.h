@@ -33,6 +33,7 @@ typedef struct {
     lv_timer_t * timer;
     lv_img_dsc_t imgdsc;
     uint32_t last_call;
+    uint8_t indexed : 1;
 } lv_gif_t;
 
 extern const lv_obj_class_t lv_gif_class;
@@ -45,6 +46,22 @@ lv_obj_t * lv_gif_create(lv_obj_t * parent);
 void lv_gif_set_src(lv_obj_t * obj, const void * src);
 void lv_gif_restart(lv_obj_t * gif);
 
+/**
+ * Decode the next sources into an `LV_IMG_CF_INDEXED_8BIT` image instead of `LV_IMG_CF_TRUE_COLOR_ALPHA`.
+ * It needs only 1 byte/pixel instead of 3..5 but it's slower to draw.
+ * GIFs with local palettes are still decoded to true color images.
+ * @param obj       pointer to a GIF object
+ * @param en        true: decode to indexed images; false: decode to true color images
+ */
+void lv_gif_set_indexed(lv_obj_t * obj, bool en);
+
+/**
+ * Check if the current source is decoded into an indexed image.
+ * @param obj       pointer to a GIF object
+ * @return          true: the image is `LV_IMG_CF_INDEXED_8BIT`
+ */
+bool lv_gif_is_indexed(lv_obj_t * obj);
+
 /**********************
  *      MACROS
  **********************/
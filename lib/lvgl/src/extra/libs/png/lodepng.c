@@ -4757,16 +4757,15 @@ unsigned lodepng_inspect_chunk(LodePNGState* state, size_t pos,
 }
 
 /*read a PNG, the result will be in the same color type as the PNG (hence "generic")*/
-static void decodeGeneric(unsigned char** out, unsigned* w, unsigned* h,
-                          LodePNGState* state,
-                          const unsigned char* in, size_t insize) {
+/*read the chunks and decompress the IDAT data into the filtered-padded-interlaced scanlines*/
+static void decodeScanlines(unsigned char** scanlines, unsigned* w, unsigned* h,
+                            LodePNGState* state,
+                            const unsigned char* in, size_t insize) {
   unsigned char IEND = 0;
   const unsigned char* chunk;
   unsigned char* idat; /*the data from idat chunks, zlib compressed*/
   size_t idatsize = 0;
-  unsigned char* scanlines = 0;
   size_t scanlines_size = 0, expected_size = 0;
-  size_t outsize = 0;
 
   /*for unknown chunk order*/
   unsigned unknown = 0;
@@ -4776,7 +4775,7 @@ static void decodeGeneric(unsigned char** out, unsigned* w, unsigned* h,
 
 
   /* safe output values in case error happens */
-  *out = 0;
+  *scanlines = 0;
   *w = *h = 0;
 
   state->error = lodepng_inspect(w, h, state, in, insize); /*reads header and resets other parameters in state->info_png*/
@@ -4934,10 +4933,20 @@ static void decodeGeneric(unsigned char** out, unsigned* w, unsigned* h,
       expected_size += lodepng_get_raw_size_idat((*w + 0), (*h + 0) >> 1, bpp);
     }
 
-    state->error = zlib_decompress(&scanlines, &scanlines_size, expected_size, idat, idatsize, &state->decoder.zlibsettings);
+    state->error = zlib_decompress(scanlines, &scanlines_size, expected_size, idat, idatsize, &state->decoder.zlibsettings);
   }
   if(!state->error && scanlines_size != expected_size) state->error = 91; /*decompressed size doesn't match prediction*/
   lodepng_free(idat);
+}
+
+static void decodeGeneric(unsigned char** out, unsigned* w, unsigned* h,
+                          LodePNGState* state,
+                          const unsigned char* in, size_t insize) {
+  unsigned char* scanlines = 0;
+  size_t outsize = 0;
+
+  *out = 0;
+  decodeScanlines(&scanlines, w, h, state, in, insize);
 
   if(!state->error) {
     outsize = lodepng_get_raw_size(*w, *h, &state->info_png.color);
@@ -4988,6 +4997,449 @@ unsigned lodepng_decode(unsigned char** out, unsigned* w, unsigned* h,
   return state->error;
 }
 
+unsigned lodepng_decode_rows(unsigned* w, unsigned* h, const unsigned char* in, size_t insize,
+                             LodePNGRowCallback row_cb, void* user_data) {
+  unsigned error;
+  unsigned y;
+  unsigned char* scanlines = 0;
+  unsigned char* raw = 0;
+  unsigned char* rgba = 0;
+  LodePNGState state;
+  lodepng_state_init(&state);
+#ifdef LODEPNG_COMPILE_ANCILLARY_CHUNKS
+  state.decoder.read_text_chunks = 0;
+  state.decoder.remember_unknown_chunks = 0;
+#endif /*LODEPNG_COMPILE_ANCILLARY_CHUNKS*/
+
+  decodeScanlines(&scanlines, w, h, &state, in, insize);
+  error = state.error;
+
+  if(!error) {
+    rgba = (unsigned char*)lodepng_malloc((size_t)*w * 4u);
+    if(!rgba) error = 83; /*alloc fail*/
+  }
+
+  if(!error && state.info_png.interlace_method == 0) {
+    /*unfilter each scanline in place after its filter type byte and convert it at once*/
+    const LodePNGColorMode* color = &state.info_png.color;
+    unsigned bpp = lodepng_get_bpp(color);
+    size_t bytewidth = (bpp + 7u) / 8u;
+    size_t linebytes = lodepng_get_raw_size_idat(*w, 1, bpp) - 1u;
+    const unsigned char* prevline = 0;
+    for(y = 0; y < *h && !error; ++y) {
+      unsigned char* line = &scanlines[(1 + linebytes) * y];
+      error = unfilterScanline(line + 1, line + 1, prevline, bytewidth, line[0], linebytes);
+      if(error) break;
+      getPixelColorsRGBA8(rgba, *w, line + 1, color);
+      error = row_cb(user_data, rgba, y, *w, *h, color);
+      prevline = line + 1;
+    }
+  } else if(!error) {
+    /*Adam7 needs the whole raw image to put the passes together*/
+    const LodePNGColorMode* color = &state.info_png.color;
+    size_t rawsize = lodepng_get_raw_size(*w, *h, color);
+    raw = (unsigned char*)lodepng_malloc(rawsize);
+    if(!raw) error = 83; /*alloc fail*/
+    if(!error) {
+      lodepng_memset(raw, 0, rawsize);
+      error = postProcessScanlines(raw, scanlines, *w, *h, &state.info_png);
+    }
+    lodepng_free(scanlines);
+    scanlines = 0;
+    for(y = 0; y < *h && !error; ++y) {
+      unsigned x;
+      for(x = 0; x < *w; ++x) {
+        getPixelColorRGBA8(&rgba[x * 4u + 0u], &rgba[x * 4u + 1u], &rgba[x * 4u + 2u], &rgba[x * 4u + 3u],
+                           raw, (size_t)y * *w + x, color);
+      }
+      error = row_cb(user_data, rgba, y, *w, *h, color);
+    }
+  }
+
+  lodepng_free(scanlines);
+  lodepng_free(raw);
+  lodepng_free(rgba);
+  lodepng_state_cleanup(&state);
+  return error;
+}
+
+/*the input buffer of the streaming decoder, refilled from the IDAT chunks*/
+#define STREAM_IN_SIZE 1024u
+/*a dynamic Huffman block header is at most 553 bytes, keep this much buffered before it*/
+#define STREAM_BLOCK_HEADER_SIZE 640u
+
+typedef enum {
+  STREAM_BLOCK_HEADER, /*a new deflate block starts*/
+  STREAM_BLOCK_STORED, /*in an uncompressed block*/
+  STREAM_BLOCK_HUFFMAN /*in a block with fixed or dynamic Huffman codes*/
+} StreamBlock;
+
+struct LodePNGStream {
+  LodePNGState state;
+  LodePNGStreamReadCallback read_cb;
+  LodePNGStreamSeekCallback seek_cb;
+  void* user_data;
+
+  /*the compressed data in the IDAT chunks*/
+  size_t idat_pos; /*position of the first IDAT chunk in the file*/
+  size_t idat_left; /*bytes left in the current IDAT chunk*/
+  unsigned idat_end; /*there are no more IDAT chunks*/
+  unsigned char in[STREAM_IN_SIZE];
+  LodePNGBitReader reader; /*reads from `in`*/
+
+  /*the state of inflate so it can stop at any byte*/
+  unsigned char* window; /*the last window_size decompressed bytes for the back references*/
+  size_t window_size; /*from the zlib header, power of two*/
+  size_t out_cnt; /*number of decompressed bytes*/
+  StreamBlock block;
+  unsigned bfinal;
+  size_t stored_left; /*bytes left in the uncompressed block*/
+  size_t copy_len; /*bytes left to copy from the back reference*/
+  size_t copy_dist;
+  HuffmanTree tree_ll;
+  HuffmanTree tree_d;
+
+  /*the scanlines*/
+  unsigned w, h, y;
+  size_t bytewidth;
+  size_t linebytes;
+  unsigned char* line; /*the filter type byte and the current scanline*/
+  unsigned char* prevline; /*the filter type byte and the previous unfiltered scanline*/
+};
+
+/*read the next bytes of the IDAT chunks. Returns less than size only at the end of the image data*/
+static size_t stream_read_idat(LodePNGStream* s, unsigned char* buf, size_t size) {
+  size_t n = 0;
+  while(n < size && !s->idat_end) {
+    size_t chunk_n, rn;
+    if(s->idat_left == 0) {
+      /*skip the CRC and continue if the next chunk is an IDAT too*/
+      unsigned char header[12];
+      if(s->read_cb(s->user_data, header, 12) != 12 || !lodepng_chunk_type_equals(header + 4, "IDAT")) {
+        s->idat_end = 1;
+        break;
+      }
+      s->idat_left = lodepng_chunk_length(header + 4);
+      continue;
+    }
+    chunk_n = size - n < s->idat_left ? size - n : s->idat_left;
+    rn = s->read_cb(s->user_data, buf + n, chunk_n);
+    n += rn;
+    s->idat_left -= rn;
+    if(rn != chunk_n) s->idat_end = 1;
+  }
+  return n;
+}
+
+/*make sure at least min bytes are buffered after the bit pointer unless the image data ends*/
+static void stream_fill(LodePNGStream* s, size_t min) {
+  LodePNGBitReader* reader = &s->reader;
+  size_t start = reader->bp >> 3u;
+  size_t left, i;
+  if(s->idat_end || start > reader->size || reader->size - start >= min) return;
+  /*keep the not yet read bytes and append new ones*/
+  left = reader->size - start;
+  for(i = 0; i < left; ++i) s->in[i] = s->in[start + i];
+  reader->size = left + stream_read_idat(s, s->in + left, STREAM_IN_SIZE - left);
+  reader->bitsize = reader->size * 8u;
+  reader->bp &= 7u;
+}
+
+static unsigned stream_zlib_header(LodePNGStream* s) {
+  unsigned CM, CINFO, FDICT;
+  stream_fill(s, 2);
+  if(s->reader.size < 2) return 53; /*error, size of zlib data too small*/
+  if((s->in[0] * 256u + s->in[1]) % 31u != 0) return 24;
+  CM = s->in[0] & 15u;
+  CINFO = (s->in[0] >> 4u) & 15u;
+  FDICT = (s->in[1] >> 5u) & 1u;
+  if(CM != 8 || CINFO > 7) return 25;
+  if(FDICT != 0) return 26;
+  s->reader.bp = 16;
+
+  if(!s->window) {
+    s->window_size = (size_t)1u << (CINFO + 8u);
+    s->window = (unsigned char*)lodepng_malloc(s->window_size);
+    if(!s->window) return 83; /*alloc fail*/
+  }
+  return 0;
+}
+
+/*start to decode from the beginning of the image data*/
+static unsigned stream_start(LodePNGStream* s) {
+  unsigned char header[8];
+  if(s->seek_cb(s->user_data, s->idat_pos) || s->read_cb(s->user_data, header, 8) != 8) {
+    return 78; /*failed to read the file*/
+  }
+  s->idat_left = lodepng_chunk_length(header);
+  s->idat_end = 0;
+  s->reader.data = s->in;
+  s->reader.size = 0;
+  s->reader.bitsize = 0;
+  s->reader.bp = 0;
+  s->reader.buffer = 0;
+  s->out_cnt = 0;
+  s->block = STREAM_BLOCK_HEADER;
+  s->bfinal = 0;
+  s->stored_left = 0;
+  s->copy_len = 0;
+  s->y = 0;
+  return stream_zlib_header(s);
+}
+
+static unsigned stream_block_header(LodePNGStream* s) {
+  LodePNGBitReader* reader = &s->reader;
+  unsigned btype, error;
+  if(s->bfinal) return 91; /*the image data ended before the last scanline*/
+  stream_fill(s, STREAM_BLOCK_HEADER_SIZE);
+  if(!ensureBits9(reader, 3)) return 52;
+  s->bfinal = readBits(reader, 1);
+  btype = readBits(reader, 2);
+
+  if(btype == 3) return 20; /*error: invalid BTYPE*/
+  if(btype == 0) {
+    /*go to first boundary of byte and read LEN and NLEN*/
+    size_t pos;
+    unsigned LEN, NLEN;
+    reader->bp = (reader->bp + 7u) & ~(size_t)7u;
+    pos = reader->bp / 8u;
+    if(pos + 4u > reader->size) return 52; /*error, bit pointer will jump past memory*/
+    LEN = (unsigned)s->in[pos] + ((unsigned)s->in[pos + 1] << 8u);
+    NLEN = (unsigned)s->in[pos + 2] + ((unsigned)s->in[pos + 3] << 8u);
+    if(LEN + NLEN != 65535) return 21; /*error: NLEN is not one's complement of LEN*/
+    reader->bp += 32u;
+    s->stored_left = LEN;
+    s->block = STREAM_BLOCK_STORED;
+    return 0;
+  }
+
+  HuffmanTree_cleanup(&s->tree_ll);
+  HuffmanTree_cleanup(&s->tree_d);
+  HuffmanTree_init(&s->tree_ll);
+  HuffmanTree_init(&s->tree_d);
+  if(btype == 1) error = getTreeInflateFixed(&s->tree_ll, &s->tree_d);
+  else error = getTreeInflateDynamic(&s->tree_ll, &s->tree_d, reader);
+  if(error) return error;
+  if(reader->bp > reader->bitsize) return 50;
+  s->block = STREAM_BLOCK_HUFFMAN;
+  return 0;
+}
+
+/*decompress the next size bytes. The last window_size bytes are kept for the back references*/
+static unsigned stream_inflate(LodePNGStream* s, unsigned char* out, size_t size) {
+  LodePNGBitReader* reader = &s->reader;
+  size_t mask = s->window_size - 1u;
+  size_t n = 0;
+  unsigned error = 0;
+  while(n < size && !error) {
+    if(s->copy_len) {
+      /*the rest of a back reference*/
+      while(s->copy_len && n < size) {
+        unsigned char c = s->window[(s->out_cnt - s->copy_dist) & mask];
+        s->window[s->out_cnt & mask] = c;
+        s->out_cnt++;
+        out[n++] = c;
+        s->copy_len--;
+      }
+    } else if(s->block == STREAM_BLOCK_HEADER) {
+      error = stream_block_header(s);
+    } else if(s->block == STREAM_BLOCK_STORED) {
+      size_t pos, cnt, i;
+      if(s->stored_left == 0) {
+        s->block = STREAM_BLOCK_HEADER;
+        continue;
+      }
+      stream_fill(s, 1);
+      pos = reader->bp / 8u;
+      if(pos >= reader->size) {
+        error = 23; /*error: reading outside of in buffer*/
+        break;
+      }
+      cnt = reader->size - pos;
+      if(cnt > s->stored_left) cnt = s->stored_left;
+      if(cnt > size - n) cnt = size - n;
+      for(i = 0; i < cnt; ++i) {
+        s->window[s->out_cnt & mask] = s->in[pos + i];
+        s->out_cnt++;
+        out[n++] = s->in[pos + i];
+      }
+      reader->bp += cnt * 8u;
+      s->stored_left -= cnt;
+    } else {
+      /*a Huffman symbol and its extra bits need at most 48 bits*/
+      unsigned code_ll;
+      stream_fill(s, 8);
+      ensureBits25(reader, 20);
+      code_ll = huffmanDecodeSymbol(reader, &s->tree_ll);
+      if(code_ll <= 255) {
+        s->window[s->out_cnt & mask] = (unsigned char)code_ll;
+        s->out_cnt++;
+        out[n++] = (unsigned char)code_ll;
+      } else if(code_ll >= FIRST_LENGTH_CODE_INDEX && code_ll <= LAST_LENGTH_CODE_INDEX) {
+        unsigned code_d, numextrabits_l, numextrabits_d;
+        size_t length, distance;
+        length = LENGTHBASE[code_ll - FIRST_LENGTH_CODE_INDEX];
+        numextrabits_l = LENGTHEXTRA[code_ll - FIRST_LENGTH_CODE_INDEX];
+        if(numextrabits_l != 0) length += readBits(reader, numextrabits_l);
+
+        ensureBits32(reader, 28);
+        code_d = huffmanDecodeSymbol(reader, &s->tree_d);
+        if(code_d > 29) {
+          error = code_d <= 31 ? 18 : 16;
+          break;
+        }
+        distance = DISTANCEBASE[code_d];
+        numextrabits_d = DISTANCEEXTRA[code_d];
+        if(numextrabits_d != 0) distance += readBits(reader, numextrabits_d);
+
+        /*the back reference can't point before the start or the window*/
+        if(distance > s->out_cnt || distance > s->window_size) {
+          error = 52;
+          break;
+        }
+        s->copy_len = length;
+        s->copy_dist = distance;
+      } else if(code_ll == 256) {
+        s->block = STREAM_BLOCK_HEADER;
+      } else {
+        error = 16; /*error: tried to read disallowed huffman symbol*/
+        break;
+      }
+      if(reader->bp > reader->bitsize) error = 51; /*error, bit pointer jumps past memory*/
+    }
+  }
+  return error;
+}
+
+unsigned lodepng_stream_open(LodePNGStream** stream, unsigned* w, unsigned* h,
+                             LodePNGStreamReadCallback read_cb, LodePNGStreamSeekCallback seek_cb,
+                             void* user_data) {
+  unsigned char header[33];
+  size_t pos = 33;
+  unsigned error = 0;
+  LodePNGStream* s;
+
+  *stream = 0;
+  s = (LodePNGStream*)lodepng_malloc(sizeof(LodePNGStream));
+  if(!s) return 83; /*alloc fail*/
+  lodepng_memset(s, 0, sizeof(LodePNGStream));
+  lodepng_state_init(&s->state);
+  HuffmanTree_init(&s->tree_ll);
+  HuffmanTree_init(&s->tree_d);
+  s->read_cb = read_cb;
+  s->seek_cb = seek_cb;
+  s->user_data = user_data;
+
+  if(read_cb(user_data, header, 33) != 33) error = 27; /*error: the data length is smaller than the length of a PNG header*/
+  if(!error) error = lodepng_inspect(w, h, &s->state, header, 33);
+  if(!error && s->state.info_png.interlace_method != 0) error = 114;
+  if(!error && lodepng_pixel_overflow(*w, *h, &s->state.info_png.color, &s->state.info_raw)) error = 92;
+
+  /*read the palette and skip the other chunks before the image data*/
+  while(!error) {
+    unsigned char chunk[8];
+    unsigned length;
+    if(read_cb(user_data, chunk, 8) != 8) {
+      error = 30; /*error: size of the in buffer too small to contain next chunk*/
+      break;
+    }
+    length = lodepng_chunk_length(chunk);
+    if(length > 2147483647) {
+      error = 63; /*error: chunk length larger than the max PNG chunk size*/
+      break;
+    }
+    if(lodepng_chunk_type_equals(chunk, "IDAT")) {
+      s->idat_pos = pos;
+      break;
+    }
+    if(lodepng_chunk_type_equals(chunk, "IEND")) {
+      error = 53; /*error: no image data*/
+      break;
+    }
+    if(lodepng_chunk_type_equals(chunk, "PLTE") || lodepng_chunk_type_equals(chunk, "tRNS")) {
+      unsigned char* data;
+      unsigned plte = lodepng_chunk_type_equals(chunk, "PLTE");
+      if(length > 3u * 256u) {
+        error = plte ? 38 : 39; /*error: palette too big*/
+        break;
+      }
+      data = (unsigned char*)lodepng_malloc(length ? length : 1u);
+      if(!data) {
+        error = 83; /*alloc fail*/
+        break;
+      }
+      if(read_cb(user_data, data, length) != length) error = 30;
+      else if(plte) error = readChunk_PLTE(&s->state.info_png.color, data, length);
+      else error = readChunk_tRNS(&s->state.info_png.color, data, length);
+      lodepng_free(data);
+      if(error) break;
+    }
+    pos += 12u + length;
+    if(seek_cb(user_data, pos)) error = 78; /*failed to read the file*/
+  }
+  if(!error && s->state.info_png.color.colortype == LCT_PALETTE && s->state.info_png.color.palette == 0) {
+    error = 106; /*error: PNG file must have PLTE chunk if color type is palette*/
+  }
+
+  if(!error) {
+    unsigned bpp = lodepng_get_bpp(&s->state.info_png.color);
+    s->w = *w;
+    s->h = *h;
+    s->bytewidth = (bpp + 7u) / 8u;
+    s->linebytes = lodepng_get_raw_size_idat(*w, 1, bpp) - 1u;
+    s->line = (unsigned char*)lodepng_malloc(s->linebytes + 1u);
+    s->prevline = (unsigned char*)lodepng_malloc(s->linebytes + 1u);
+    if(!s->line || !s->prevline) error = 83; /*alloc fail*/
+  }
+  if(!error) error = stream_start(s);
+
+  if(error) {
+    lodepng_stream_close(s);
+    return error;
+  }
+  *stream = s;
+  return 0;
+}
+
+const LodePNGColorMode* lodepng_stream_color(const LodePNGStream* stream) {
+  return &stream->state.info_png.color;
+}
+
+unsigned lodepng_stream_read_row(LodePNGStream* stream, unsigned char* rgba) {
+  unsigned error;
+  unsigned char* tmp;
+  if(stream->y >= stream->h) return 91; /*there are no more scanlines*/
+
+  error = stream_inflate(stream, stream->line, stream->linebytes + 1u);
+  if(!error) {
+    error = unfilterScanline(stream->line + 1, stream->line + 1, stream->y ? stream->prevline + 1 : 0,
+                             stream->bytewidth, stream->line[0], stream->linebytes);
+  }
+  if(error) return error;
+
+  getPixelColorsRGBA8(rgba, stream->w, stream->line + 1, &stream->state.info_png.color);
+  tmp = stream->prevline;
+  stream->prevline = stream->line;
+  stream->line = tmp;
+  stream->y++;
+  return 0;
+}
+
+unsigned lodepng_stream_rewind(LodePNGStream* stream) {
+  return stream_start(stream);
+}
+
+void lodepng_stream_close(LodePNGStream* stream) {
+  if(!stream) return;
+  HuffmanTree_cleanup(&stream->tree_ll);
+  HuffmanTree_cleanup(&stream->tree_d);
+  lodepng_state_cleanup(&stream->state);
+  lodepng_free(stream->window);
+  lodepng_free(stream->line);
+  lodepng_free(stream->prevline);
+  lodepng_free(stream);
+}
+
 unsigned lodepng_decode_memory(unsigned char** out, unsigned* w, unsigned* h, const unsigned char* in,
                                size_t insize, LodePNGColorType colortype, unsigned bitdepth) {
   unsigned error;
@@ -6261,6 +6713,7 @@ const char* lodepng_error_text(unsigned code) {
     /*max ICC size limit can be configured in LodePNGDecoderSettings. This error prevents
     unreasonable memory consumption when decoding due to impossibly large ICC profile*/
     case 113: return "ICC profile unreasonably large";
+    case 114: return "interlaced PNGs can't be decoded row by row";
   }
   return "unknown error code";
 }
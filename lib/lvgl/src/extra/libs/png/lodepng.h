@@ -799,6 +799,69 @@ information is placed in the info_png field of the LodePNGState.
 unsigned lodepng_inspect(unsigned* w, unsigned* h,
                          LodePNGState* state,
                          const unsigned char* in, size_t insize);
+
+/*
+Called by lodepng_decode_rows for each row of the image from top to bottom.
+rgba: the pixels of the row in 8-bit RGBA. Valid only during the call.
+color: the color mode of the PNG image, e.g. to check if it can have alpha.
+Return value: 0 to continue or an error code to stop decoding.
+*/
+typedef unsigned (*LodePNGRowCallback)(void* user_data, const unsigned char* rgba, unsigned y,
+                                       unsigned w, unsigned h, const LodePNGColorMode* color);
+
+/*
+Decode the PNG image without assembling a raw image in a requested color type.
+Each scanline is unfiltered in the decompressed data and given to row_cb in 8-bit RGBA,
+so the caller can convert it directly to its own format.
+Only Adam7 interlaced images need a raw image (in the PNG's color type) to put the passes together.
+Return value: LodePNG error code (0 means no error).
+*/
+unsigned lodepng_decode_rows(unsigned* w, unsigned* h, const unsigned char* in, size_t insize,
+                             LodePNGRowCallback row_cb, void* user_data);
+
+/*
+Read up to size bytes of the PNG file to buf for the streaming decoder.
+Return value: the number of bytes read, less than size only at the end of the file.
+*/
+typedef size_t (*LodePNGStreamReadCallback)(void* user_data, unsigned char* buf, size_t size);
+
+/*
+Set the read position of the PNG file to pos bytes from its start.
+Return value: 0 on success.
+*/
+typedef unsigned (*LodePNGStreamSeekCallback)(void* user_data, size_t pos);
+
+/*A PNG image being decoded row by row*/
+typedef struct LodePNGStream LodePNGStream;
+
+/*
+Open a PNG image to decode it row by row, reading the file through the callbacks.
+Only the inflate window (32 KB at most), two scanlines and a 1 KB input buffer are allocated,
+so any size of image can be decoded with little memory.
+Interlaced images are not supported (error 114), decode them with lodepng_decode_rows.
+stream: the opened stream is stored here. Close it with lodepng_stream_close.
+w, h: the size of the image.
+Return value: LodePNG error code (0 means no error).
+*/
+unsigned lodepng_stream_open(LodePNGStream** stream, unsigned* w, unsigned* h,
+                             LodePNGStreamReadCallback read_cb, LodePNGStreamSeekCallback seek_cb,
+                             void* user_data);
+
+/*The color mode of the PNG image, e.g. to check if it can have alpha.*/
+const LodePNGColorMode* lodepng_stream_color(const LodePNGStream* stream);
+
+/*
+Decode the next row of the image from top to bottom.
+rgba: store the pixels of the row here in 8-bit RGBA, 4 * w bytes.
+Return value: LodePNG error code (0 means no error).
+*/
+unsigned lodepng_stream_read_row(LodePNGStream* stream, unsigned char* rgba);
+
+/*Start to decode again from the first row. Returns LodePNG error code (0 means no error).*/
+unsigned lodepng_stream_rewind(LodePNGStream* stream);
+
+/*Free the stream. The file is not closed, it belongs to the caller.*/
+void lodepng_stream_close(LodePNGStream* stream);
 #endif /*LODEPNG_COMPILE_DECODER*/
 
 /*
@@ -20,6 +20,23 @@
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_PNG_STREAM_MIN_SIZE
+typedef struct {
+    LodePNGStream * stream;
+    lv_fs_file_t f;             /*The opened PNG file*/
+    bool has_file;
+    const uint8_t * data;       /*The content of the PNG file if it's in the memory*/
+    uint32_t data_size;
+    uint32_t data_pos;
+    uint32_t w;
+    uint32_t h;
+    uint8_t * rgba;             /*A decoded row in RGBA8888*/
+    uint8_t * rows;             /*The last decoded rows in the system's color format*/
+    uint32_t row_size;
+    uint32_t next_y;            /*The row to decode next*/
+    uint32_t row_cnt;           /*Number of rows in `rows` before `next_y`*/
+} png_stream_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -27,7 +44,17 @@
 static lv_res_t decoder_info(struct _lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header);
 static lv_res_t decoder_open(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
 static void decoder_close(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
-static void convert_color_depth(uint8_t * img, uint32_t px_cnt);
+static lv_res_t decode_png(lv_img_decoder_dsc_t * dsc, const uint8_t * data, uint32_t data_size);
+static unsigned decode_row_cb(void * user_data, const unsigned char * rgba, unsigned y, unsigned w, unsigned h,
+                              const LodePNGColorMode * color);
+static void convert_row(uint8_t * out, const uint8_t * rgba, uint32_t px_cnt, bool alpha);
+#if LV_PNG_STREAM_MIN_SIZE
+static lv_res_t open_stream(lv_img_decoder_dsc_t * dsc, lv_fs_file_t * f, const uint8_t * data, uint32_t data_size);
+static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x,
+                                  lv_coord_t y, lv_coord_t len, uint8_t * buf);
+static size_t stream_read_cb(void * user_data, unsigned char * buf, size_t size);
+static unsigned stream_seek_cb(void * user_data, size_t pos);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -50,6 +77,9 @@ void lv_png_init(void)
     lv_img_decoder_set_info_cb(dec, decoder_info);
     lv_img_decoder_set_open_cb(dec, decoder_open);
     lv_img_decoder_set_close_cb(dec, decoder_close);
+#if LV_PNG_STREAM_MIN_SIZE
+    lv_img_decoder_set_read_line_cb(dec, decoder_read_line);
+#endif
 }
 
 /**********************
@@ -129,65 +159,61 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
     (void) decoder; /*Unused*/
     uint32_t error;                 /*For the return values of PNG decoder functions*/
 
-    uint8_t * img_data = NULL;
-
     /*If it's a PNG file...*/
     if(dsc->src_type == LV_IMG_SRC_FILE) {
         const char * fn = dsc->src;
         if(strcmp(lv_fs_get_ext(fn), "png") == 0) {              /*Check the extension*/
 
-            /*Load the PNG file into buffer. It's still compressed (not decoded)*/
-            unsigned char * png_data;      /*Pointer to the loaded data. Same as the original file just loaded into the RAM*/
-            size_t png_data_size;          /*Size of `png_data` in bytes*/
+            /*Decode a memory mapped file directly*/
+            const void * png_map = NULL;
+            uint32_t png_map_size = 0;
+            lv_fs_file_t f;
+            bool opened = lv_fs_open(&f, fn, LV_FS_MODE_RD) == LV_FS_RES_OK;
+            bool mapped = opened && lv_fs_map(&f, &png_map, &png_map_size) == LV_FS_RES_OK;
 
-            error = lodepng_load_file(&png_data, &png_data_size, fn);   /*Load the file*/
-            if(error) {
-                LV_LOG_WARN("error %u: %s\n", error, lodepng_error_text(error));
-                return LV_RES_INV;
+#if LV_PNG_STREAM_MIN_SIZE
+            /*Big images are decoded row by row when they are drawn. The file remains open for it.*/
+            if(opened && (uint32_t)dsc->header.w * dsc->header.h * LV_IMG_PX_SIZE_ALPHA_BYTE >= LV_PNG_STREAM_MIN_SIZE) {
+                if(open_stream(dsc, &f, png_map, png_map_size) == LV_RES_OK) return LV_RES_OK;
             }
+#endif
+            if(opened && !mapped) lv_fs_close(&f);
 
-            /*Decode the PNG image*/
-            uint32_t png_width;             /*Will be the width of the decoded image*/
-            uint32_t png_height;            /*Will be the width of the decoded image*/
+            /*Else load the PNG file into buffer. It's still compressed (not decoded)*/
+            unsigned char * png_data = NULL; /*Pointer to the loaded data. Same as the original file just loaded into the RAM*/
+            size_t png_data_size;          /*Size of `png_data` in bytes*/
 
-            /*Decode the loaded image in ARGB8888 */
-            error = lodepng_decode32(&img_data, &png_width, &png_height, png_data, png_data_size);
-            lv_mem_free(png_data); /*Free the loaded file*/
-            if(error) {
-                if(img_data != NULL) {
-                    lv_mem_free(img_data);
+            if(!mapped) {
+                error = lodepng_load_file(&png_data, &png_data_size, fn);   /*Load the file*/
+                if(error) {
+                    LV_LOG_WARN("error %u: %s\n", error, lodepng_error_text(error));
+                    return LV_RES_INV;
                 }
-                LV_LOG_WARN("error %u: %s\n", error, lodepng_error_text(error));
-                return LV_RES_INV;
             }
 
-            /*Convert the image to the system's color depth*/
-            convert_color_depth(img_data,  png_width * png_height);
-            dsc->img_data = img_data;
-            return LV_RES_OK;     /*The image is fully decoded. Return with its pointer*/
+            /*Decode the PNG image directly to the system's color format*/
+            lv_res_t res;
+            if(mapped) {
+                res = decode_png(dsc, png_map, png_map_size);
+                lv_fs_close(&f);
+            }
+            else {
+                res = decode_png(dsc, png_data, png_data_size);
+                lv_mem_free(png_data); /*Free the loaded file*/
+            }
+
+            return res;     /*The image is fully decoded*/
         }
     }
     /*If it's a PNG file in a  C array...*/
     else if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
         const lv_img_dsc_t * img_dsc = dsc->src;
-        uint32_t png_width;             /*No used, just required by he decoder*/
-        uint32_t png_height;            /*No used, just required by he decoder*/
-
-        /*Decode the image in ARGB8888 */
-        error = lodepng_decode32(&img_data, &png_width, &png_height, img_dsc->data, img_dsc->data_size);
-
-        if(error) {
-            if(img_data != NULL) {
-                lv_mem_free(img_data);
-            }
-            return LV_RES_INV;
+#if LV_PNG_STREAM_MIN_SIZE
+        if((uint32_t)dsc->header.w * dsc->header.h * LV_IMG_PX_SIZE_ALPHA_BYTE >= LV_PNG_STREAM_MIN_SIZE) {
+            if(open_stream(dsc, NULL, img_dsc->data, img_dsc->data_size) == LV_RES_OK) return LV_RES_OK;
         }
-
-        /*Convert the image to the system's color depth*/
-        convert_color_depth(img_data,  png_width * png_height);
-
-        dsc->img_data = img_data;
-        return LV_RES_OK;     /*Return with its pointer*/
+#endif
+        return decode_png(dsc, img_dsc->data, img_dsc->data_size);
     }
 
     return LV_RES_INV;    /*If not returned earlier then it failed*/
@@ -203,56 +229,229 @@ static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc
         lv_mem_free((uint8_t *)dsc->img_data);
         dsc->img_data = NULL;
     }
+
+#if LV_PNG_STREAM_MIN_SIZE
+    png_stream_t * ps = dsc->user_data;
+    if(ps) {
+        lodepng_stream_close(ps->stream);
+        if(ps->has_file) lv_fs_close(&ps->f);
+        lv_mem_free(ps->rgba);
+        lv_mem_free(ps->rows);
+        lv_mem_free(ps);
+        dsc->user_data = NULL;
+    }
+#endif
 }
 
 /**
- * If the display is not in 32 bit format (ARGB888) then covert the image to the current color depth
- * @param img the ARGB888 image
- * @param px_cnt number of pixels in `img`
+ * Decode a PNG image from the memory to the system's color format
+ * @param dsc the decoder descriptor. Its `img_data` and `header.cf` are set.
+ * @param data the content of the PNG file
+ * @param data_size size of `data` in bytes
+ * @return LV_RES_OK: no error; LV_RES_INV: the image couldn't be decoded
  */
-static void convert_color_depth(uint8_t * img, uint32_t px_cnt)
+static lv_res_t decode_png(lv_img_decoder_dsc_t * dsc, const uint8_t * data, uint32_t data_size)
+{
+    unsigned png_width;
+    unsigned png_height;
+    unsigned error = lodepng_decode_rows(&png_width, &png_height, data, data_size, decode_row_cb, dsc);
+    if(error) {
+        if(dsc->img_data) {
+            lv_mem_free((uint8_t *)dsc->img_data);
+            dsc->img_data = NULL;
+        }
+        LV_LOG_WARN("error %u: %s\n", error, lodepng_error_text(error));
+        return LV_RES_INV;
+    }
+
+    return LV_RES_OK;
+}
+
+/**
+ * Convert a decoded row of the PNG image to the system's color format.
+ * The image is allocated with the first row when it's known whether it has alpha.
+ */
+static unsigned decode_row_cb(void * user_data, const unsigned char * rgba, unsigned y, unsigned w, unsigned h,
+                              const LodePNGColorMode * color)
+{
+    lv_img_decoder_dsc_t * dsc = user_data;
+    if(y == 0) {
+        /*The opaque images don't need to store the alpha channel*/
+        dsc->header.cf = lodepng_can_have_alpha(color) ? LV_IMG_CF_TRUE_COLOR_ALPHA : LV_IMG_CF_TRUE_COLOR;
+        dsc->img_data = lv_mem_alloc(lv_img_buf_get_img_size(w, h, dsc->header.cf));
+        if(dsc->img_data == NULL) return 83;  /*The alloc fail error of lodepng*/
+    }
+
+    uint32_t row_size = lv_img_buf_get_img_size(w, 1, dsc->header.cf);
+    convert_row((uint8_t *)dsc->img_data + y * row_size, rgba, w, dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA);
+    return 0;
+}
+
+/**
+ * Convert RGBA8888 pixels to the system's color depth
+ * @param out store the converted pixels here
+ * @param rgba the pixels in R, G, B, A byte order
+ * @param px_cnt number of pixels
+ * @param alpha true: `LV_IMG_CF_TRUE_COLOR_ALPHA` format; false: `LV_IMG_CF_TRUE_COLOR` format
+ */
+static void convert_row(uint8_t * out, const uint8_t * rgba, uint32_t px_cnt, bool alpha)
 {
-#if LV_COLOR_DEPTH == 32
-    lv_color32_t * img_argb = (lv_color32_t *)img;
-    lv_color_t c;
-    lv_color_t * img_c = (lv_color_t *) img;
     uint32_t i;
+#if LV_COLOR_DEPTH == 32
+    lv_color_t * out_c = (lv_color_t *)out;
     for(i = 0; i < px_cnt; i++) {
-        c = lv_color_make(img_argb[i].ch.red, img_argb[i].ch.green, img_argb[i].ch.blue);
-        img_c[i].ch.red = c.ch.blue;
-        img_c[i].ch.blue = c.ch.red;
+        out_c[i] = lv_color_make(rgba[0], rgba[1], rgba[2]);
+        out_c[i].ch.alpha = alpha ? rgba[3] : 0xFF;
+        rgba += 4;
     }
 #elif LV_COLOR_DEPTH == 16
-    lv_color32_t * img_argb = (lv_color32_t *)img;
     lv_color_t c;
-    uint32_t i;
     for(i = 0; i < px_cnt; i++) {
-        c = lv_color_make(img_argb[i].ch.blue, img_argb[i].ch.green, img_argb[i].ch.red);
-        img[i * 3 + 2] = img_argb[i].ch.alpha;
-        img[i * 3 + 1] = c.full >> 8;
-        img[i * 3 + 0] = c.full & 0xFF;
+        c = lv_color_make(rgba[0], rgba[1], rgba[2]);
+        *out++ = c.full & 0xFF;
+        *out++ = c.full >> 8;
+        if(alpha) *out++ = rgba[3];
+        rgba += 4;
     }
 #elif LV_COLOR_DEPTH == 8
-    lv_color32_t * img_argb = (lv_color32_t *)img;
     lv_color_t c;
-    uint32_t i;
     for(i = 0; i < px_cnt; i++) {
-        c = lv_color_make(img_argb[i].ch.red, img_argb[i].ch.green, img_argb[i].ch.blue);
-        img[i * 2 + 1] = img_argb[i].ch.alpha;
-        img[i * 2 + 0] = c.full;
+        c = lv_color_make(rgba[0], rgba[1], rgba[2]);
+        *out++ = c.full;
+        if(alpha) *out++ = rgba[3];
+        rgba += 4;
     }
 #elif LV_COLOR_DEPTH == 1
-    lv_color32_t * img_argb = (lv_color32_t *)img;
     uint8_t b;
-    uint32_t i;
     for(i = 0; i < px_cnt; i++) {
-        b = img_argb[i].ch.red | img_argb[i].ch.green | img_argb[i].ch.blue;
-        img[i * 2 + 1] = img_argb[i].ch.alpha;
-        img[i * 2 + 0] = b > 128 ? 1 : 0;
+        b = rgba[0] | rgba[1] | rgba[2];
+        *out++ = b > 128 ? 1 : 0;
+        if(alpha) *out++ = rgba[3];
+        rgba += 4;
     }
 #endif
 }
 
+#if LV_PNG_STREAM_MIN_SIZE
+
+/**
+ * Prepare to decode a PNG image row by row in `decoder_read_line`.
+ * Interlaced images can't be streamed, they need to be decoded at once.
+ * @param dsc the decoder descriptor. Its `user_data` and `header.cf` are set.
+ * @param f the opened PNG file or NULL if the PNG is in the memory. It's closed with the stream.
+ * @param data the content of the PNG file if it's in the memory (e.g. mapped), else NULL
+ * @param data_size size of `data` in bytes
+ * @return LV_RES_OK: the stream is opened; LV_RES_INV: it can't be streamed
+ */
+static lv_res_t open_stream(lv_img_decoder_dsc_t * dsc, lv_fs_file_t * f, const uint8_t * data, uint32_t data_size)
+{
+    png_stream_t * ps = lv_mem_alloc(sizeof(png_stream_t));
+    if(ps == NULL) return LV_RES_INV;
+    lv_memset_00(ps, sizeof(png_stream_t));
+    if(f) ps->f = *f;
+    ps->data = data;
+    ps->data_size = data_size;
+
+    unsigned w;
+    unsigned h;
+    unsigned error = lodepng_stream_open(&ps->stream, &w, &h, stream_read_cb, stream_seek_cb, ps);
+    if(!error) {
+        /*The opaque images don't need to store the alpha channel*/
+        dsc->header.cf = lodepng_can_have_alpha(lodepng_stream_color(ps->stream)) ?
+                         LV_IMG_CF_TRUE_COLOR_ALPHA : LV_IMG_CF_TRUE_COLOR;
+        ps->w = w;
+        ps->h = h;
+        ps->row_size = lv_img_buf_get_img_size(w, 1, dsc->header.cf);
+        ps->rgba = lv_mem_alloc(w * 4);
+        ps->rows = lv_mem_alloc(ps->row_size * LV_PNG_STREAM_CACHE_ROWS);
+        if(ps->rgba == NULL || ps->rows == NULL) error = 83;  /*The alloc fail error of lodepng*/
+    }
+
+    if(error) {
+        if(error != 114) LV_LOG_WARN("error %u: %s\n", error, lodepng_error_text(error));
+        lodepng_stream_close(ps->stream);
+        if(ps->rgba) lv_mem_free(ps->rgba);
+        if(ps->rows) lv_mem_free(ps->rows);
+        lv_mem_free(ps);
+        return LV_RES_INV;
+    }
+
+    /*The file belongs to the stream from now*/
+    ps->has_file = f != NULL;
+    dsc->user_data = ps;
+    return LV_RES_OK;
+}
+
+/**
+ * Decode a part of a row of a streamed PNG image.
+ * The last `LV_PNG_STREAM_CACHE_ROWS` rows are kept, the earlier rows can be decoded only from the beginning again.
+ */
+static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x,
+                                  lv_coord_t y, lv_coord_t len, uint8_t * buf)
+{
+    LV_UNUSED(decoder);
+    png_stream_t * ps = dsc->user_data;
+    if(ps == NULL || y < 0 || (uint32_t)y >= ps->h) return LV_RES_INV;
+
+    /*Start again if the row is not cached anymore*/
+    if((uint32_t)y + ps->row_cnt < ps->next_y) {
+        unsigned error = lodepng_stream_rewind(ps->stream);
+        if(error) {
+            LV_LOG_WARN("error %u: %s\n", error, lodepng_error_text(error));
+            return LV_RES_INV;
+        }
+        ps->next_y = 0;
+        ps->row_cnt = 0;
+    }
+
+    while(ps->next_y <= (uint32_t)y) {
+        unsigned error = lodepng_stream_read_row(ps->stream, ps->rgba);
+        if(error) {
+            LV_LOG_WARN("error %u: %s\n", error, lodepng_error_text(error));
+            /*Rewind next time*/
+            ps->next_y = ps->h + 1;
+            ps->row_cnt = 0;
+            return LV_RES_INV;
+        }
+        convert_row(ps->rows + (ps->next_y % LV_PNG_STREAM_CACHE_ROWS) * ps->row_size, ps->rgba, ps->w,
+                    dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA);
+        ps->next_y++;
+        if(ps->row_cnt < LV_PNG_STREAM_CACHE_ROWS) ps->row_cnt++;
+    }
+
+    uint32_t px_size = ps->row_size / ps->w;
+    const uint8_t * row = ps->rows + (y % LV_PNG_STREAM_CACHE_ROWS) * ps->row_size;
+    lv_memcpy(buf, row + x * px_size, len * px_size);
+    return LV_RES_OK;
+}
+
+static size_t stream_read_cb(void * user_data, unsigned char * buf, size_t size)
+{
+    png_stream_t * ps = user_data;
+    if(ps->data == NULL) {
+        uint32_t br = 0;
+        lv_fs_read(&ps->f, buf, size, &br);
+        return br;
+    }
+
+    uint32_t left = ps->data_pos < ps->data_size ? ps->data_size - ps->data_pos : 0;
+    uint32_t n = LV_MIN(size, left);
+    lv_memcpy(buf, ps->data + ps->data_pos, n);
+    ps->data_pos += n;
+    return n;
+}
+
+static unsigned stream_seek_cb(void * user_data, size_t pos)
+{
+    png_stream_t * ps = user_data;
+    if(ps->data == NULL) return lv_fs_seek(&ps->f, pos, LV_FS_SEEK_SET) == LV_FS_RES_OK ? 0 : 1;
+
+    ps->data_pos = pos;
+    return 0;
+}
+
+#endif /*LV_PNG_STREAM_MIN_SIZE*/
+
 #endif /*LV_USE_PNG*/
 
 
@@ -31,6 +31,7 @@ static void lv_qrcode_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
  **********************/
 
 const lv_obj_class_t lv_qrcode_class = {
+    .name = "lv_qrcode",
     .constructor_cb = lv_qrcode_constructor,
     .destructor_cb = lv_qrcode_destructor,
     .base_class = &lv_canvas_class
@@ -80,11 +80,19 @@ typedef struct {
     uint8_t * img_cache_buff;
     int img_cache_x_res;
     int img_cache_y_res;
-    uint8_t * raw_sjpg_data;              //Used when type==SJPEG_IO_SOURCE_C_ARRAY.
+    uint8_t * raw_sjpg_data;              //Used when type==SJPEG_IO_SOURCE_C_ARRAY or the file is memory mapped.
     uint32_t raw_sjpg_data_size;          //Num bytes pointed to by raw_sjpg_data.
     uint32_t raw_sjpg_data_next_read_pos; //Used for all types.
 } io_source_t;
 
+typedef struct {
+    uint8_t * data;                     //Decoded RGB888 pixels of a fragment
+    int frame_index;                    //-1: the slot is not used
+    uint32_t life;                      //Value of `frame_cache_life` when it was used last time
+#if LV_SJPG_DECODE_AHEAD
+    bool ahead;                         //Decoded ahead and not used yet
+#endif
+} frame_cache_t;
 
 typedef struct {
     uint8_t * sjpeg_data;
@@ -93,10 +101,17 @@ typedef struct {
     int sjpeg_y_res;
     int sjpeg_total_frames;
     int sjpeg_single_frame_height;
-    int sjpeg_cache_frame_index;
+    uint8_t scale;                      //Decode at 1 / 2^scale size. The resolutions above are the scaled ones.
     uint8_t ** frame_base_array;        //to save base address of each split frames upto sjpeg_total_frames.
     int * frame_base_offset;            //to save base offset for fseek
-    uint8_t * frame_cache;
+    frame_cache_t frame_cache[LV_SJPG_CACHE_FRAGMENTS];  //The most recently used decoded fragments
+    int frame_cache_cnt;                //Number of usable slots, at most the number of fragments
+    uint32_t frame_cache_life;          //Incremented on every use of a fragment
+#if LV_SJPG_DECODE_AHEAD
+    lv_timer_t * ahead_timer;           //Decodes `ahead_frame_index` in the next `lv_timer_handler()`
+    int ahead_frame_index;
+    int last_frame_index;               //The last newly needed fragment to know the scroll direction
+#endif
     uint8_t * workb;                    //JPG work buffer for jpeg library
     JDEC * tjpeg_jd;
     io_source_t io;
@@ -109,15 +124,33 @@ static lv_res_t decoder_info(lv_img_decoder_t * decoder, const void * src, lv_im
 static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
 static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
                                   lv_coord_t len, uint8_t * buf);
+static lv_res_t decoder_read_area(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, const lv_area_t * area,
+                                  uint8_t * buf);
 static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
 static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata);
+static void io_map_file(io_source_t * io);
 static int is_jpg(const uint8_t * raw_data, size_t len);
 static void lv_sjpg_cleanup(SJPEG * sjpeg);
 static void lv_sjpg_free(SJPEG * sjpeg);
+static uint8_t get_scale(int x_res, int y_res, int frame_height);
+static void set_scale(SJPEG * sjpeg);
+static bool init_frame_cache(SJPEG * sjpeg);
+static frame_cache_t * find_frame(SJPEG * sjpeg, int frame_index);
+static frame_cache_t * decode_frame(SJPEG * sjpeg, int frame_index);
+static frame_cache_t * get_frame(SJPEG * sjpeg, int frame_index);
+static void convert_line(SJPEG * sjpeg, frame_cache_t * frame, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                         uint8_t * buf);
+#if LV_SJPG_DECODE_AHEAD
+    static void decode_ahead(SJPEG * sjpeg, int frame_index);
+    static void ahead_timer_cb(lv_timer_t * t);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static lv_coord_t max_w;
+static lv_coord_t max_h;
+static lv_split_jpeg_cache_stat_t cache_stat;
 
 /**********************
  *      MACROS
@@ -133,6 +166,23 @@ void lv_split_jpeg_init(void)
     lv_img_decoder_set_open_cb(dec, decoder_open);
     lv_img_decoder_set_close_cb(dec, decoder_close);
     lv_img_decoder_set_read_line_cb(dec, decoder_read_line);
+    lv_img_decoder_set_read_area_cb(dec, decoder_read_area);
+}
+
+void lv_split_jpeg_set_max_size(lv_coord_t w, lv_coord_t h)
+{
+    max_w = w;
+    max_h = h;
+}
+
+void lv_split_jpeg_get_cache_stat(lv_split_jpeg_cache_stat_t * stat)
+{
+    *stat = cache_stat;
+}
+
+void lv_split_jpeg_reset_cache_stat(void)
+{
+    lv_memset_00(&cache_stat, sizeof(cache_stat));
 }
 
 /**********************
@@ -173,6 +223,13 @@ static lv_res_t decoder_info(lv_img_decoder_t * decoder, const void * src, lv_im
             header->h = *raw_sjpeg_data++;
             header->h |= *raw_sjpeg_data++ << 8;
 
+            raw_sjpeg_data += 2; //skip the number of frames
+            int frame_height = *raw_sjpeg_data++;
+            frame_height |= *raw_sjpeg_data++ << 8;
+
+            uint8_t scale = get_scale(header->w, header->h, frame_height);
+            header->w >>= scale;
+            header->h >>= scale;
             return ret;
 
         }
@@ -193,8 +250,9 @@ static lv_res_t decoder_info(lv_img_decoder_t * decoder, const void * src, lv_im
 
             JRESULT rc = jd_prepare(&jd_tmp, input_func, workb_temp, (size_t)TJPGD_WORKBUFF_SIZE, &io_source_temp);
             if(rc == JDR_OK) {
-                header->w = jd_tmp.width;
-                header->h = jd_tmp.height;
+                uint8_t scale = get_scale(jd_tmp.width, jd_tmp.height, 0);
+                header->w = jd_tmp.width >> scale;
+                header->h = jd_tmp.height >> scale;
 
             }
             else {
@@ -229,8 +287,8 @@ end:
 
             if(strcmp((char *)buff, "_SJPG__") == 0) {
                 lv_fs_seek(&file, 14, LV_FS_SEEK_SET);
-                res = lv_fs_read(&file, buff, 4, &rn);
-                if(res != LV_FS_RES_OK || rn != 4) {
+                res = lv_fs_read(&file, buff, 8, &rn);
+                if(res != LV_FS_RES_OK || rn != 8) {
                     lv_fs_close(&file);
                     return LV_RES_INV;
                 }
@@ -241,6 +299,12 @@ end:
                 header->w |= *raw_sjpeg_data++ << 8;
                 header->h = *raw_sjpeg_data++;
                 header->h |= *raw_sjpeg_data++ << 8;
+                raw_sjpeg_data += 2; //skip the number of frames
+                int frame_height = *raw_sjpeg_data++;
+                frame_height |= *raw_sjpeg_data++ << 8;
+                uint8_t scale = get_scale(header->w, header->h, frame_height);
+                header->w >>= scale;
+                header->h >>= scale;
                 lv_fs_close(&file);
                 return LV_RES_OK;
 
@@ -262,6 +326,7 @@ end:
             io_source_temp.raw_sjpg_data_next_read_pos = 0;
             io_source_temp.img_cache_buff = NULL;
             io_source_temp.lv_file = file;
+            io_source_temp.raw_sjpg_data = NULL;
             JDEC jd_tmp;
 
             JRESULT rc = jd_prepare(&jd_tmp, input_func, workb_temp, (size_t)TJPGD_WORKBUFF_SIZE, &io_source_temp);
@@ -269,10 +334,11 @@ end:
             lv_fs_close(&file);
 
             if(rc == JDR_OK) {
+                uint8_t scale = get_scale(jd_tmp.width, jd_tmp.height, 0);
                 header->always_zero = 0;
                 header->cf = LV_IMG_CF_RAW;
-                header->w = jd_tmp.width;
-                header->h = jd_tmp.height;
+                header->w = jd_tmp.width >> scale;
+                header->h = jd_tmp.height >> scale;
                 return LV_RES_OK;
             }
         }
@@ -305,7 +371,7 @@ static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata)
 
     if(!io) return 0;
 
-    if(io->type == SJPEG_IO_SOURCE_C_ARRAY) {
+    if(io->type == SJPEG_IO_SOURCE_C_ARRAY || io->raw_sjpg_data) {
         const uint32_t bytes_left = io->raw_sjpg_data_size - io->raw_sjpg_data_next_read_pos;
         const uint32_t to_read = ndata <= bytes_left ? (uint32_t)ndata : bytes_left;
         if(to_read == 0)
@@ -335,6 +401,20 @@ static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata)
     return 0;
 }
 
+/*Read a memory mapped file like a C array*/
+static void io_map_file(io_source_t * io)
+{
+    const void * map;
+    uint32_t map_size;
+    if(lv_fs_map(&io->lv_file, &map, &map_size) == LV_FS_RES_OK) {
+        io->raw_sjpg_data = (uint8_t *)map;
+        io->raw_sjpg_data_size = map_size;
+    }
+    else {
+        io->raw_sjpg_data = NULL;
+    }
+}
+
 /**
  * Open SJPG image and return the decided image
  * @param decoder pointer to the decoder where this function belongs
@@ -395,14 +475,12 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
                 offset |= *data++ << 8;
                 sjpeg->frame_base_array[i] = sjpeg->frame_base_array[i - 1] + offset;
             }
-            sjpeg->sjpeg_cache_frame_index = -1;
-            sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3/*2*/);
-            if(! sjpeg->frame_cache) {
+            set_scale(sjpeg);
+            if(!init_frame_cache(sjpeg)) {
                 lv_sjpg_cleanup(sjpeg);
                 sjpeg = NULL;
                 return LV_RES_INV;
             }
-            sjpeg->io.img_cache_buff = sjpeg->frame_cache;
             sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
             sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
             if(! sjpeg->workb) {
@@ -458,15 +536,13 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
                 uint8_t * img_frame_base = sjpeg->sjpeg_data;
                 sjpeg->frame_base_array[0] = img_frame_base;
 
-                sjpeg->sjpeg_cache_frame_index = -1;
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
+                set_scale(sjpeg);
+                if(!init_frame_cache(sjpeg)) {
                     lv_sjpg_cleanup(sjpeg);
                     sjpeg = NULL;
                     return LV_RES_INV;
                 }
 
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
                 sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
                 sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
@@ -577,14 +653,12 @@ end:
                     sjpeg->frame_base_offset[i] = sjpeg->frame_base_offset[i - 1] + offset;
                 }
 
-                sjpeg->sjpeg_cache_frame_index = -1; //INVALID AT BEGINNING for a forced compare mismatch at first time.
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
+                set_scale(sjpeg);
+                if(!init_frame_cache(sjpeg)) {
                     lv_fs_close(&lv_file);
                     lv_sjpg_cleanup(sjpeg);
                     return LV_RES_INV;
                 }
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
                 sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
                 sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
@@ -602,6 +676,8 @@ end:
 
                 sjpeg->io.type = SJPEG_IO_SOURCE_DISK;
                 sjpeg->io.lv_file = lv_file;
+                io_map_file(&sjpeg->io);
+                if(sjpeg->io.raw_sjpg_data == NULL) lv_fs_set_read_ahead(&sjpeg->io.lv_file, LV_FS_READ_AHEAD_FORWARD);
                 dsc->img_data = NULL;
                 return LV_RES_OK;
             }
@@ -640,6 +716,7 @@ end:
             io_source_temp.raw_sjpg_data_next_read_pos = 0;
             io_source_temp.img_cache_buff = NULL;
             io_source_temp.lv_file = lv_file;
+            io_map_file(&io_source_temp);
 
             JDEC jd_tmp;
 
@@ -665,15 +742,13 @@ end:
                 int img_frame_start_offset = 0;
                 sjpeg->frame_base_offset[0] = img_frame_start_offset;
 
-                sjpeg->sjpeg_cache_frame_index = -1;
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
+                set_scale(sjpeg);
+                if(!init_frame_cache(sjpeg)) {
                     lv_fs_close(&lv_file);
                     lv_sjpg_cleanup(sjpeg);
                     return LV_RES_INV;
                 }
 
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
                 sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
                 sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
@@ -691,6 +766,8 @@ end:
 
                 sjpeg->io.type = SJPEG_IO_SOURCE_DISK;
                 sjpeg->io.lv_file = lv_file;
+                io_map_file(&sjpeg->io);
+                if(sjpeg->io.raw_sjpg_data == NULL) lv_fs_set_read_ahead(&sjpeg->io.lv_file, LV_FS_READ_AHEAD_FORWARD);
                 dsc->img_data = NULL;
                 return LV_RES_OK;
 
@@ -722,143 +799,135 @@ static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc
                                   lv_coord_t len, uint8_t * buf)
 {
     LV_UNUSED(decoder);
-    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
-        SJPEG * sjpeg = (SJPEG *) dsc->user_data;
-        JRESULT rc;
-
-        int sjpeg_req_frame_index = y / sjpeg->sjpeg_single_frame_height;
-
-        /*If line not from cache, refresh cache */
-        if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
-            sjpeg->io.raw_sjpg_data = sjpeg->frame_base_array[ sjpeg_req_frame_index ];
-            if(sjpeg_req_frame_index == (sjpeg->sjpeg_total_frames - 1)) {
-                /*This is the last frame. */
-                const uint32_t frame_offset = (uint32_t)(sjpeg->io.raw_sjpg_data - sjpeg->sjpeg_data);
-                sjpeg->io.raw_sjpg_data_size = sjpeg->sjpeg_data_size - frame_offset;
-            }
-            else {
-                sjpeg->io.raw_sjpg_data_size =
-                    (uint32_t)(sjpeg->frame_base_array[sjpeg_req_frame_index + 1] - sjpeg->io.raw_sjpg_data);
-            }
-            sjpeg->io.raw_sjpg_data_next_read_pos = 0;
-            rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
-            if(rc != JDR_OK) return LV_RES_INV;
-            rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, 0);
-            if(rc != JDR_OK) return LV_RES_INV;
-            sjpeg->sjpeg_cache_frame_index = sjpeg_req_frame_index;
-        }
-
-        int offset = 0;
-        uint8_t * cache = (uint8_t *)sjpeg->frame_cache + x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res *
-                          3;
+    SJPEG * sjpeg = (SJPEG *) dsc->user_data;
+    if(sjpeg == NULL) return LV_RES_INV;
 
-#if  LV_COLOR_DEPTH == 32
-        for(int i = 0; i < len; i++) {
-            buf[offset + 3] = 0xff;
-            buf[offset + 2] = *cache++;
-            buf[offset + 1] = *cache++;
-            buf[offset + 0] = *cache++;
-            offset += 4;
-        }
+    frame_cache_t * frame = get_frame(sjpeg, y / sjpeg->sjpeg_single_frame_height);
+    if(frame == NULL) return LV_RES_INV;
 
-#elif  LV_COLOR_DEPTH == 16
+    convert_line(sjpeg, frame, x, y, len, buf);
+    return LV_RES_OK;
+}
 
-        for(int i = 0; i < len; i++) {
-            uint16_t col_16bit = (*cache++ & 0xf8) << 8;
-            col_16bit |= (*cache++ & 0xFC) << 3;
-            col_16bit |= (*cache++ >> 3);
-#if  LV_BIG_ENDIAN_SYSTEM == 1 || LV_COLOR_16_SWAP == 1
-            buf[offset++] = col_16bit >> 8;
-            buf[offset++] = col_16bit & 0xff;
-#else
-            buf[offset++] = col_16bit & 0xff;
-            buf[offset++] = col_16bit >> 8;
-#endif // LV_BIG_ENDIAN_SYSTEM
+/**
+ * Decode the pixels of an area and store them in `buf` line by line.
+ * The fragments are looked up or decoded only once for all of their lines.
+ * @param decoder pointer to the decoder the function associated with
+ * @param dsc pointer to decoder descriptor
+ * @param area the area to decode relative to the image
+ * @param buf a buffer to store the decoded pixels
+ * @return LV_RES_OK: ok; LV_RES_INV: failed
+ */
+static lv_res_t decoder_read_area(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, const lv_area_t * area,
+                                  uint8_t * buf)
+{
+    LV_UNUSED(decoder);
+    SJPEG * sjpeg = (SJPEG *) dsc->user_data;
+    if(sjpeg == NULL) return LV_RES_INV;
+
+    lv_coord_t len = lv_area_get_width(area);
+    lv_coord_t y = area->y1;
+    while(y <= area->y2) {
+        int frame_index = y / sjpeg->sjpeg_single_frame_height;
+        frame_cache_t * frame = get_frame(sjpeg, frame_index);
+        if(frame == NULL) return LV_RES_INV;
+
+        /*The other lines of the fragment are hits as if they were read one by one*/
+        lv_coord_t y_end = LV_MIN(area->y2, (frame_index + 1) * sjpeg->sjpeg_single_frame_height - 1);
+        cache_stat.hit += y_end - y;
+
+        for(; y <= y_end; y++) {
+            convert_line(sjpeg, frame, area->x1, y, len, buf);
+            buf += len * (LV_COLOR_DEPTH / 8);
         }
+    }
 
-#elif  LV_COLOR_DEPTH == 8
+    return LV_RES_OK;
+}
 
-        for(int i = 0; i < len; i++) {
-            uint8_t col_8bit = (*cache++ & 0xC0);
-            col_8bit |= (*cache++ & 0xe0) >> 2;
-            col_8bit |= (*cache++ & 0xe0) >> 5;
-            buf[offset++] = col_8bit;
+/**
+ * Get a decoded fragment from the cache or decode it in place of the least recently used one
+ * @param sjpeg pointer to the opened image
+ * @param frame_index index of the fragment
+ * @return the cache slot of the fragment or NULL on error
+ */
+static frame_cache_t * get_frame(SJPEG * sjpeg, int frame_index)
+{
+    frame_cache_t * frame = find_frame(sjpeg, frame_index);
+    if(frame) {
+        cache_stat.hit++;
+#if LV_SJPG_DECODE_AHEAD
+        /*Keep decoding ahead while the scrolling goes on*/
+        if(frame->ahead) {
+            frame->ahead = false;
+            decode_ahead(sjpeg, frame_index);
         }
-#else
-#error Unsupported LV_COLOR_DEPTH
-
-
-#endif // LV_COLOR_DEPTH
-        return LV_RES_OK;
+#endif
     }
-    else if(dsc->src_type == LV_IMG_SRC_FILE) {
-        SJPEG * sjpeg = (SJPEG *) dsc->user_data;
-        JRESULT rc;
-        int sjpeg_req_frame_index = y / sjpeg->sjpeg_single_frame_height;
-
-        lv_fs_file_t * lv_file_p = &(sjpeg->io.lv_file);
-        if(!lv_file_p) goto end;
-
-        /*If line not from cache, refresh cache */
-        if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
-            sjpeg->io.raw_sjpg_data_next_read_pos = (int)(sjpeg->frame_base_offset [ sjpeg_req_frame_index ]);
-            lv_fs_seek(&(sjpeg->io.lv_file), sjpeg->io.raw_sjpg_data_next_read_pos, LV_FS_SEEK_SET);
-
-            rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
-            if(rc != JDR_OK) return LV_RES_INV;
+    else {
+        frame = decode_frame(sjpeg, frame_index);
+        if(frame == NULL) return NULL;
+        cache_stat.miss++;
+#if LV_SJPG_DECODE_AHEAD
+        decode_ahead(sjpeg, frame_index);
+#endif
+    }
+    frame->life = ++sjpeg->frame_cache_life;
+    return frame;
+}
 
-            rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, 0);
-            if(rc != JDR_OK) return LV_RES_INV;
+/**
+ * Convert a line of a decoded fragment to the LVGL color format
+ * @param sjpeg pointer to the opened image
+ * @param frame the decoded fragment containing the line
+ * @param x start x coordinate
+ * @param y y coordinate in the image
+ * @param len number of pixels to convert
+ * @param buf a buffer to store the pixels
+ */
+static void convert_line(SJPEG * sjpeg, frame_cache_t * frame, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                         uint8_t * buf)
+{
+    int offset = 0;
+    uint8_t * cache = frame->data + x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res * 3;
 
-            sjpeg->sjpeg_cache_frame_index = sjpeg_req_frame_index;
-        }
+#if  LV_COLOR_DEPTH == 32
+    for(int i = 0; i < len; i++) {
+        buf[offset + 3] = 0xff;
+        buf[offset + 2] = *cache++;
+        buf[offset + 1] = *cache++;
+        buf[offset + 0] = *cache++;
+        offset += 4;
+    }
 
-        int offset = 0;
-        uint8_t * cache = (uint8_t *)sjpeg->frame_cache + x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res *
-                          3;
-
-#if LV_COLOR_DEPTH == 32
-        for(int i = 0; i < len; i++) {
-            buf[offset + 3] = 0xff;
-            buf[offset + 2] = *cache++;
-            buf[offset + 1] = *cache++;
-            buf[offset + 0] = *cache++;
-            offset += 4;
-        }
 #elif  LV_COLOR_DEPTH == 16
 
-        for(int i = 0; i < len; i++) {
-            uint16_t col_8bit = (*cache++ & 0xf8) << 8;
-            col_8bit |= (*cache++ & 0xFC) << 3;
-            col_8bit |= (*cache++ >> 3);
+    for(int i = 0; i < len; i++) {
+        uint16_t col_16bit = (*cache++ & 0xf8) << 8;
+        col_16bit |= (*cache++ & 0xFC) << 3;
+        col_16bit |= (*cache++ >> 3);
 #if  LV_BIG_ENDIAN_SYSTEM == 1 || LV_COLOR_16_SWAP == 1
-            buf[offset++] = col_8bit >> 8;
-            buf[offset++] = col_8bit & 0xff;
+        buf[offset++] = col_16bit >> 8;
+        buf[offset++] = col_16bit & 0xff;
 #else
-            buf[offset++] = col_8bit & 0xff;
-            buf[offset++] = col_8bit >> 8;
+        buf[offset++] = col_16bit & 0xff;
+        buf[offset++] = col_16bit >> 8;
 #endif // LV_BIG_ENDIAN_SYSTEM
-        }
+    }
 
 #elif  LV_COLOR_DEPTH == 8
 
-        for(int i = 0; i < len; i++) {
-            uint8_t col_8bit = (*cache++ & 0xC0);
-            col_8bit |= (*cache++ & 0xe0) >> 2;
-            col_8bit |= (*cache++ & 0xe0) >> 5;
-            buf[offset++] = col_8bit;
-        }
-
+    for(int i = 0; i < len; i++) {
+        uint8_t col_8bit = (*cache++ & 0xC0);
+        col_8bit |= (*cache++ & 0xe0) >> 2;
+        col_8bit |= (*cache++ & 0xe0) >> 5;
+        buf[offset++] = col_8bit;
+    }
 #else
 #error Unsupported LV_COLOR_DEPTH
 
 
 #endif // LV_COLOR_DEPTH
-
-        return LV_RES_OK;
-    }
-end:
-    return LV_RES_INV;
 }
 
 /**
@@ -897,9 +966,190 @@ static int is_jpg(const uint8_t * raw_data, size_t len)
     return memcmp(jpg_signature, raw_data, sizeof(jpg_signature)) == 0;
 }
 
+/**
+ * Get the scale to decode the image to fit into the size set by `lv_split_jpeg_set_max_size`
+ * @param x_res width of the image
+ * @param y_res height of the image
+ * @param frame_height height of the fragments of SJPG, 0 for JPG
+ * @return 0..3 for 1, 1/2, 1/4 and 1/8 scale
+ */
+static uint8_t get_scale(int x_res, int y_res, int frame_height)
+{
+    uint8_t scale = 0;
+    while(scale < 3 && ((max_w > 0 && (x_res >> scale) > max_w) || (max_h > 0 && (y_res >> scale) > max_h))) {
+        /*The fragments need to be scaled to whole rows to join them*/
+        if(frame_height % (2 << scale)) break;
+        if((x_res >> (scale + 1)) == 0 || (y_res >> (scale + 1)) == 0) break;
+        scale++;
+    }
+    return scale;
+}
+
+/**
+ * Prepare the fragment cache of an opened image. The slots are allocated when they are used first.
+ * @param sjpeg pointer to the opened image
+ * @return true: ok; false: out of memory
+ */
+static bool init_frame_cache(SJPEG * sjpeg)
+{
+    sjpeg->frame_cache_cnt = LV_MIN(LV_SJPG_CACHE_FRAGMENTS, sjpeg->sjpeg_total_frames);
+    sjpeg->frame_cache_life = 0;
+    int i;
+    for(i = 0; i < sjpeg->frame_cache_cnt; i++) {
+        sjpeg->frame_cache[i].data = NULL;
+        sjpeg->frame_cache[i].frame_index = -1;
+        sjpeg->frame_cache[i].life = 0;
+    }
+    sjpeg->io.img_cache_buff = NULL;
+
+#if LV_SJPG_DECODE_AHEAD
+    sjpeg->ahead_timer = NULL;
+    sjpeg->ahead_frame_index = -1;
+    sjpeg->last_frame_index = -1;
+    /*One slot is needed for the fragment being drawn and one for the next one*/
+    if(sjpeg->frame_cache_cnt >= 2) {
+        sjpeg->ahead_timer = lv_timer_create(ahead_timer_cb, 0, sjpeg);
+        if(sjpeg->ahead_timer == NULL) return false;
+        lv_timer_pause(sjpeg->ahead_timer);
+    }
+#endif
+
+    return true;
+}
+
+/**
+ * Find an already decoded fragment
+ * @param sjpeg pointer to the opened image
+ * @param frame_index index of the fragment
+ * @return the cache slot of the fragment or NULL if it's not cached
+ */
+static frame_cache_t * find_frame(SJPEG * sjpeg, int frame_index)
+{
+    int i;
+    for(i = 0; i < sjpeg->frame_cache_cnt; i++) {
+        if(sjpeg->frame_cache[i].frame_index == frame_index) return &sjpeg->frame_cache[i];
+    }
+    return NULL;
+}
+
+/**
+ * Decode a fragment into an unused or the least recently used cache slot
+ * @param sjpeg pointer to the opened image
+ * @param frame_index index of the fragment
+ * @return the cache slot of the fragment or NULL on error
+ */
+static frame_cache_t * decode_frame(SJPEG * sjpeg, int frame_index)
+{
+    frame_cache_t * frame = &sjpeg->frame_cache[0];
+    int i;
+    for(i = 1; i < sjpeg->frame_cache_cnt && frame->data; i++) {
+        frame_cache_t * f = &sjpeg->frame_cache[i];
+        if(f->data == NULL || f->life < frame->life) frame = f;
+    }
+
+    if(frame->data == NULL) {
+        frame->data = lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
+        if(frame->data == NULL) {
+            /*Reuse the least recently used decoded fragment instead*/
+            frame = NULL;
+            for(i = 0; i < sjpeg->frame_cache_cnt; i++) {
+                frame_cache_t * f = &sjpeg->frame_cache[i];
+                if(f->data && (frame == NULL || f->life < frame->life)) frame = f;
+            }
+            if(frame == NULL) return NULL;
+        }
+    }
+
+    if(sjpeg->frame_base_array) {
+        sjpeg->io.raw_sjpg_data = sjpeg->frame_base_array[frame_index];
+        if(frame_index == (sjpeg->sjpeg_total_frames - 1)) {
+            /*This is the last frame. */
+            const uint32_t frame_offset = (uint32_t)(sjpeg->io.raw_sjpg_data - sjpeg->sjpeg_data);
+            sjpeg->io.raw_sjpg_data_size = sjpeg->sjpeg_data_size - frame_offset;
+        }
+        else {
+            sjpeg->io.raw_sjpg_data_size =
+                (uint32_t)(sjpeg->frame_base_array[frame_index + 1] - sjpeg->io.raw_sjpg_data);
+        }
+        sjpeg->io.raw_sjpg_data_next_read_pos = 0;
+    }
+    else {
+        sjpeg->io.raw_sjpg_data_next_read_pos = (int)(sjpeg->frame_base_offset[frame_index]);
+        lv_fs_seek(&(sjpeg->io.lv_file), sjpeg->io.raw_sjpg_data_next_read_pos, LV_FS_SEEK_SET);
+    }
+
+    /*The slot is invalid until the fragment is decoded completely*/
+    frame->frame_index = -1;
+#if LV_SJPG_DECODE_AHEAD
+    frame->ahead = false;
+#endif
+    sjpeg->io.img_cache_buff = frame->data;
+    JRESULT rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
+    if(rc != JDR_OK) return NULL;
+    rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, sjpeg->scale);
+    if(rc != JDR_OK) return NULL;
+
+    frame->frame_index = frame_index;
+    return frame;
+}
+
+#if LV_SJPG_DECODE_AHEAD
+
+/**
+ * Schedule the decoding of the fragment after a newly needed one in the scroll direction.
+ * The fragments are always read from top to bottom while drawing, so the direction
+ * comes from the order of the newly needed fragments, i.e. which side the image appears from.
+ * @param sjpeg pointer to the opened image
+ * @param frame_index index of the fragment which was just decoded or first used after decoded ahead
+ */
+static void decode_ahead(SJPEG * sjpeg, int frame_index)
+{
+    if(sjpeg->ahead_timer == NULL) return;
+
+    int next = frame_index >= sjpeg->last_frame_index ? frame_index + 1 : frame_index - 1;
+    sjpeg->last_frame_index = frame_index;
+    if(next < 0 || next >= sjpeg->sjpeg_total_frames) return;
+    if(find_frame(sjpeg, next)) return;
+
+    sjpeg->ahead_frame_index = next;
+    lv_timer_resume(sjpeg->ahead_timer);
+}
+
+static void ahead_timer_cb(lv_timer_t * t)
+{
+    SJPEG * sjpeg = t->user_data;
+    lv_timer_pause(t);
+
+    if(find_frame(sjpeg, sjpeg->ahead_frame_index)) return;
+
+    frame_cache_t * frame = decode_frame(sjpeg, sjpeg->ahead_frame_index);
+    if(frame == NULL) return;
+    frame->life = ++sjpeg->frame_cache_life;
+    frame->ahead = true;
+    cache_stat.ahead++;
+}
+
+#endif /*LV_SJPG_DECODE_AHEAD*/
+
+/*Scale down the resolutions of the opened image for the frame cache and the lines*/
+static void set_scale(SJPEG * sjpeg)
+{
+    sjpeg->scale = get_scale(sjpeg->sjpeg_x_res, sjpeg->sjpeg_y_res,
+                             sjpeg->sjpeg_total_frames > 1 ? sjpeg->sjpeg_single_frame_height : 0);
+    sjpeg->sjpeg_x_res >>= sjpeg->scale;
+    sjpeg->sjpeg_y_res >>= sjpeg->scale;
+    sjpeg->sjpeg_single_frame_height >>= sjpeg->scale;
+}
+
 static void lv_sjpg_free(SJPEG * sjpeg)
 {
-    if(sjpeg->frame_cache) lv_mem_free(sjpeg->frame_cache);
+#if LV_SJPG_DECODE_AHEAD
+    if(sjpeg->ahead_timer) lv_timer_del(sjpeg->ahead_timer);
+#endif
+    int i;
+    for(i = 0; i < sjpeg->frame_cache_cnt; i++) {
+        if(sjpeg->frame_cache[i].data) lv_mem_free(sjpeg->frame_cache[i].data);
+    }
     if(sjpeg->frame_base_array) lv_mem_free(sjpeg->frame_base_array);
     if(sjpeg->frame_base_offset) lv_mem_free(sjpeg->frame_base_offset);
     if(sjpeg->tjpeg_jd) lv_mem_free(sjpeg->tjpeg_jd);
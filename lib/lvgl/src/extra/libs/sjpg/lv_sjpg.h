@@ -24,12 +24,41 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/*Statistics of the decoded fragment cache of the SJPG images*/
+typedef struct {
+    uint32_t hit;       /*Lines read from an already decoded fragment*/
+    uint32_t miss;      /*Fragments decoded to read a line*/
+    uint32_t ahead;     /*Fragments decoded ahead in the scroll direction (`LV_SJPG_DECODE_AHEAD`)*/
+} lv_split_jpeg_cache_stat_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
 void lv_split_jpeg_init(void);
 
+/**
+ * Decode the JPG and SJPG images which are bigger than the given size at 1/2, 1/4 or 1/8 scale to fit into it.
+ * It's up to 64 times faster and needs less memory than decoding them at full size,
+ * e.g. to show photos on a small display or as thumbnails.
+ * The images have the scaled size. Call `lv_img_cache_invalidate_src(NULL)` after changing it.
+ * @param w     max. width of the images, 0: no limit
+ * @param h     max. height of the images, 0: no limit
+ */
+void lv_split_jpeg_set_max_size(lv_coord_t w, lv_coord_t h);
+
+/**
+ * Get the statistics of the fragment cache of all the opened images, e.g. to tune `LV_SJPG_CACHE_FRAGMENTS`.
+ * Many misses compared to the hits mean the fragments are decoded again and again.
+ * @param stat  store the statistics here
+ */
+void lv_split_jpeg_get_cache_stat(lv_split_jpeg_cache_stat_t * stat);
+
+/**
+ * Reset the statistics of the fragment cache to zero
+ */
+void lv_split_jpeg_reset_cache_stat(void);
+
 /**********************
  *      MACROS
  **********************/
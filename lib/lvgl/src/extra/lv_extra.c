@@ -62,6 +62,10 @@ void lv_extra_init(void)
     lv_fs_win32_init();
 #endif
 
+#if LV_USE_FS_MMAP != '\0'
+    lv_fs_mmap_init();
+#endif
+
 #if LV_USE_FFMPEG
     lv_ffmpeg_init();
 #endif
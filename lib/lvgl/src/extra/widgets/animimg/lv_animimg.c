@@ -43,6 +43,7 @@ static void lv_animimg_constructor(const lv_obj_class_t * class_p, lv_obj_t * ob
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_animimg_class = {
+    .name = "lv_animimg",
     .constructor_cb = lv_animimg_constructor,
     .instance_size = sizeof(lv_animimg_t),
     .base_class = &lv_img_class
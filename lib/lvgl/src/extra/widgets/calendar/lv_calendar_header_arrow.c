@@ -33,6 +33,7 @@ static void value_changed_event_cb(lv_event_t * e);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_calendar_header_arrow_class = {
+    .name = "lv_calendar_header_arrow",
     .base_class = &lv_obj_class,
     .constructor_cb = my_constructor,
     .width_def = LV_PCT(100),
@@ -11,6 +11,7 @@
 #if LV_USE_COLORWHEEL
 
 #include "../../../misc/lv_assert.h"
+#include "../../../misc/lv_thread.h"
 
 /*********************
  *      DEFINES
@@ -52,6 +53,7 @@ static uint16_t get_angle(lv_obj_t * obj);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_colorwheel_class = {.instance_size = sizeof(lv_colorwheel_t), .base_class = &lv_obj_class,
+                                            .name = "lv_colorwheel",
                                             .constructor_cb = lv_colorwheel_constructor,
                                             .event_cb = lv_colorwheel_event,
                                             .width_def = LV_DPI_DEF * 2,
@@ -650,8 +652,8 @@ static lv_color_t angle_to_mode_color_fast(lv_obj_t * obj, uint16_t angle)
 {
     lv_colorwheel_t * ext = (lv_colorwheel_t *)obj;
     uint8_t r = 0, g = 0, b = 0;
-    static uint16_t h = 0;
-    static uint8_t s = 0, v = 0, m = 255;
+    static LV_THREAD_LOCAL uint16_t h = 0;
+    static LV_THREAD_LOCAL uint8_t s = 0, v = 0, m = 255;
 
     switch(ext->mode) {
         default:
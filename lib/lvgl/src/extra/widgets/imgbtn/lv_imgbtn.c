@@ -34,6 +34,7 @@ lv_imgbtn_state_t get_state(const lv_obj_t * imgbtn);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_imgbtn_class = {
+    .name = "lv_imgbtn",
     .base_class = &lv_obj_class,
     .instance_size = sizeof(lv_imgbtn_t),
     .constructor_cb = lv_imgbtn_constructor,
@@ -32,6 +32,7 @@ static void lv_spinbox_updatevalue(lv_obj_t * obj);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_spinbox_class = {
+    .name = "lv_spinbox",
     .constructor_cb = lv_spinbox_constructor,
     .event_cb = lv_spinbox_event,
     .width_def = LV_DPI_DEF,
@@ -28,6 +28,7 @@ static void arc_anim_end_angle(void * obj, int32_t v);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_spinner_class = {
+    .name = "lv_spinner",
     .base_class = &lv_arc_class,
     .constructor_cb = lv_spinner_constructor
 };
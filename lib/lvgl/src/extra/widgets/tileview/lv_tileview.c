@@ -9,9 +9,14 @@
 #include "lv_tileview.h"
 #if LV_USE_TILEVIEW
 
+#include "../../others/snapshot/lv_snapshot.h"
+#include "../../../widgets/lv_img.h"
+#include "../../../draw/lv_img_cache.h"
+
 /*********************
  *      DEFINES
  *********************/
+#define MY_CLASS &lv_tileview_class
 
 /**********************
  *      TYPEDEFS
@@ -22,18 +27,34 @@
  **********************/
 static void lv_tileview_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_tileview_tile_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_tileview_tile_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void tileview_event_cb(lv_event_t * e);
+static void update_loaded(lv_obj_t * obj, bool unload);
+static void load_visible(lv_obj_t * obj);
+static void tile_load(lv_obj_t * tile_obj, bool load);
+#if LV_USE_SNAPSHOT
+    static void lv_tileview_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+    static void snapshot_anim_start(lv_obj_t * obj, lv_obj_t * tile_old, lv_obj_t * tile_new);
+    static void snapshot_anim_end(lv_obj_t * obj);
+    static bool is_child(lv_obj_t * obj, lv_obj_t * child);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 
 const lv_obj_class_t lv_tileview_class = {.constructor_cb = lv_tileview_constructor,
+#if LV_USE_SNAPSHOT
+                                          .destructor_cb = lv_tileview_destructor,
+#endif
+                                          .name = "lv_tileview",
                                           .base_class = &lv_obj_class,
                                           .instance_size = sizeof(lv_tileview_t)
                                          };
 
 const lv_obj_class_t lv_tileview_tile_class = {.constructor_cb = lv_tileview_tile_constructor,
+                                               .event_cb = lv_tileview_tile_event,
+                                               .name = "lv_tileview_tile",
                                                .base_class = &lv_obj_class,
                                                .instance_size = sizeof(lv_tileview_tile_t)
                                               };
@@ -81,9 +102,32 @@ void lv_obj_set_tile(lv_obj_t * obj, lv_obj_t * tile_obj, lv_anim_enable_t anim_
 
     lv_tileview_tile_t * tile = (lv_tileview_tile_t *)tile_obj;
     lv_tileview_t * tv = (lv_tileview_t *) obj;
+
+#if LV_USE_SNAPSHOT
+    /*Draw the tiles normally again if a previous animation is interrupted*/
+    snapshot_anim_end(obj);
+    lv_obj_t * tile_old = tv->tile_act;
+#endif
+
     tv->tile_act = (lv_obj_t *)tile;
 
+    /*The new tile needs its content before it's shown (or its snapshot is taken).
+     *The old ones are unloaded when the scrolling ends.*/
+    update_loaded(obj, false);
+
     lv_obj_set_scroll_dir(obj, tile->dir);
+
+#if LV_USE_SNAPSHOT
+    if(tv->snapshot_anim && anim_en == LV_ANIM_ON && tile_old && tile_old != tile_obj) {
+        snapshot_anim_start(obj, tile_old, tile_obj);
+        lv_obj_scroll_to(obj, tx, ty, anim_en);
+
+        /*E.g. the tile is already in place*/
+        if(lv_anim_get(obj, NULL) == NULL) snapshot_anim_end(obj);
+        return;
+    }
+#endif
+
     lv_obj_scroll_to(obj, tx, ty, anim_en);
 }
 
@@ -117,6 +161,55 @@ lv_obj_t * lv_tileview_get_tile_act(lv_obj_t * obj)
     return tv->tile_act;
 }
 
+void lv_tileview_tile_set_load_cb(lv_obj_t * tile_obj, lv_tileview_load_cb_t load_cb)
+{
+    LV_ASSERT_OBJ(tile_obj, &lv_tileview_tile_class);
+    lv_tileview_tile_t * tile = (lv_tileview_tile_t *)tile_obj;
+
+    if(tile->loaded && tile->load_cb) tile_load(tile_obj, false);
+    tile->load_cb = load_cb;
+    if(load_cb) update_loaded(lv_obj_get_parent(tile_obj), false);
+}
+
+bool lv_tileview_tile_is_loaded(lv_obj_t * tile_obj)
+{
+    LV_ASSERT_OBJ(tile_obj, &lv_tileview_tile_class);
+    lv_tileview_tile_t * tile = (lv_tileview_tile_t *)tile_obj;
+    return tile->load_cb == NULL || tile->loaded;
+}
+
+void lv_tileview_set_load_dist(lv_obj_t * obj, uint8_t dist)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_tileview_t * tv = (lv_tileview_t *) obj;
+    tv->load_dist = dist;
+    update_loaded(obj, true);
+}
+
+uint8_t lv_tileview_get_load_dist(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_tileview_t * tv = (lv_tileview_t *) obj;
+    return tv->load_dist;
+}
+
+#if LV_USE_SNAPSHOT
+void lv_tileview_set_snapshot_anim(lv_obj_t * obj, bool en)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_tileview_t * tv = (lv_tileview_t *) obj;
+    tv->snapshot_anim = en;
+    if(!en) snapshot_anim_end(obj);
+}
+
+bool lv_tileview_get_snapshot_anim(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_tileview_t * tv = (lv_tileview_t *) obj;
+    return tv->snapshot_anim;
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -130,6 +223,8 @@ static void lv_tileview_constructor(const lv_obj_class_t * class_p, lv_obj_t * o
     lv_obj_set_scroll_snap_x(obj, LV_SCROLL_SNAP_CENTER);
     lv_obj_set_scroll_snap_y(obj, LV_SCROLL_SNAP_CENTER);
 
+    lv_tileview_t * tv = (lv_tileview_t *) obj;
+    tv->load_dist = 1;
 }
 
 static void lv_tileview_tile_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
@@ -144,9 +239,15 @@ static void lv_tileview_tile_constructor(const lv_obj_class_t * class_p, lv_obj_
 
     lv_tileview_tile_t * tile = (lv_tileview_tile_t *)obj;
     tile->dir = create_dir;
+    tile->col_id = create_col_id;
+    tile->row_id = create_row_id;
 
     if(create_col_id == 0 && create_row_id == 0) {
         lv_obj_set_scroll_dir(parent, create_dir);
+
+        /*It's the visible tile until an other is set*/
+        lv_tileview_t * tv = (lv_tileview_t *)parent;
+        if(tv->tile_act == NULL) tv->tile_act = obj;
     }
 }
 
@@ -156,7 +257,14 @@ static void tileview_event_cb(lv_event_t * e)
     lv_obj_t * obj = lv_event_get_target(e);
     lv_tileview_t * tv = (lv_tileview_t *) obj;
 
-    if(code == LV_EVENT_SCROLL_END) {
+    if(code == LV_EVENT_SCROLL) {
+        load_visible(obj);
+    }
+    else if(code == LV_EVENT_SCROLL_END) {
+#if LV_USE_SNAPSHOT
+        snapshot_anim_end(obj);
+#endif
+
         lv_coord_t w = lv_obj_get_content_width(obj);
         lv_coord_t h = lv_obj_get_content_height(obj);
 
@@ -183,6 +291,186 @@ static void tileview_event_cb(lv_event_t * e)
             }
         }
         lv_obj_set_scroll_dir(obj, dir);
+
+        update_loaded(obj, true);
+    }
+}
+
+static void lv_tileview_tile_event(const lv_obj_class_t * class_p, lv_event_t * e)
+{
+    LV_UNUSED(class_p);
+
+    lv_res_t res = lv_obj_event_base(&lv_tileview_tile_class, e);
+    if(res != LV_RES_OK) return;
+
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_tileview_tile_t * tile = (lv_tileview_tile_t *)obj;
+
+    /*Let the user forget the references to the content*/
+    if(code == LV_EVENT_DELETE && tile->loaded && tile->load_cb) {
+        tile->loaded = 0;
+        tile->load_cb(obj, false);
+    }
+}
+
+/**
+ * Load the tiles close to the active tile and optionally unload the others.
+ * @param obj       pointer to a tileview
+ * @param unload    true: delete the content of the distant tiles too
+ */
+static void update_loaded(lv_obj_t * obj, bool unload)
+{
+    lv_tileview_t * tv = (lv_tileview_t *) obj;
+    lv_tileview_tile_t * act = (lv_tileview_tile_t *)tv->tile_act;
+
+    uint32_t i;
+    for(i = 0; i < lv_obj_get_child_cnt(obj); i++) {
+        lv_obj_t * tile_obj = lv_obj_get_child(obj, i);
+        if(!lv_obj_check_type(tile_obj, &lv_tileview_tile_class)) continue;
+
+        lv_tileview_tile_t * tile = (lv_tileview_tile_t *)tile_obj;
+        if(tile->load_cb == NULL) continue;
+
+        bool close = false;
+        if(act) {
+            uint32_t dist = LV_MAX(LV_ABS(tile->col_id - act->col_id), LV_ABS(tile->row_id - act->row_id));
+            close = dist <= tv->load_dist;
+        }
+
+        if(close && !tile->loaded) tile_load(tile_obj, true);
+        else if(!close && tile->loaded && unload) tile_load(tile_obj, false);
+    }
+
+    /*E.g. there is no active tile yet*/
+    load_visible(obj);
+}
+
+/**
+ * Load the tiles which are scrolled into the tileview.
+ * @param obj       pointer to a tileview
+ */
+static void load_visible(lv_obj_t * obj)
+{
+    /*The coordinates of the new tiles are set by the layout*/
+    lv_obj_update_layout(obj);
+
+    uint32_t i;
+    for(i = 0; i < lv_obj_get_child_cnt(obj); i++) {
+        lv_obj_t * tile_obj = lv_obj_get_child(obj, i);
+        if(!lv_obj_check_type(tile_obj, &lv_tileview_tile_class)) continue;
+
+        lv_tileview_tile_t * tile = (lv_tileview_tile_t *)tile_obj;
+        if(tile->load_cb == NULL || tile->loaded) continue;
+
+        lv_area_t common;
+        if(_lv_area_intersect(&common, &tile_obj->coords, &obj->coords)) tile_load(tile_obj, true);
+    }
+}
+
+/**
+ * Create or delete the content of a tile.
+ * @param tile_obj  pointer to a tile with `load_cb`
+ * @param load      true: create the content; false: delete it
+ */
+static void tile_load(lv_obj_t * tile_obj, bool load)
+{
+    lv_tileview_tile_t * tile = (lv_tileview_tile_t *)tile_obj;
+    tile->loaded = load;
+    tile->load_cb(tile_obj, load);
+    if(!load) lv_obj_clean(tile_obj);
+}
+
+#if LV_USE_SNAPSHOT
+static void lv_tileview_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    lv_tileview_t * tv = (lv_tileview_t *) obj;
+
+    /*The images and the tiles are already deleted with the children*/
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        if(tv->snapshots[i]) {
+            lv_img_cache_invalidate_src(tv->snapshots[i]);
+            lv_snapshot_free(tv->snapshots[i]);
+            tv->snapshots[i] = NULL;
+        }
+    }
+}
+
+/**
+ * Replace the tiles with images of their snapshots to move only the images while scrolling.
+ * @param obj       pointer to a tileview
+ * @param tile_old  the tile to scroll out
+ * @param tile_new  the tile to scroll in
+ */
+static void snapshot_anim_start(lv_obj_t * obj, lv_obj_t * tile_old, lv_obj_t * tile_new)
+{
+    lv_tileview_t * tv = (lv_tileview_t *) obj;
+
+    lv_obj_t * tiles[2] = {tile_old, tile_new};
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        tv->snapshots[i] = lv_snapshot_take(tiles[i], LV_IMG_CF_TRUE_COLOR_ALPHA);
+        if(tv->snapshots[i] == NULL) {
+            LV_LOG_WARN("couldn't take a snapshot of the tile. Animate it normally.");
+            snapshot_anim_end(obj);
+            return;
+        }
+    }
+
+    for(i = 0; i < 2; i++) {
+        /*The snapshot also contains the extra draw size of the tile*/
+        lv_coord_t ext_size = _lv_obj_get_ext_draw_size(tiles[i]);
+        lv_obj_t * img = lv_img_create(obj);
+        lv_obj_remove_style_all(img);
+        lv_obj_clear_flag(img, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+        lv_img_set_src(img, tv->snapshots[i]);
+        lv_obj_set_pos(img, lv_obj_get_x(tiles[i]) - ext_size, lv_obj_get_y(tiles[i]) - ext_size);
+
+        lv_obj_add_flag(tiles[i], LV_OBJ_FLAG_HIDDEN);
+        tv->snapshot_tiles[i] = tiles[i];
+        tv->snapshot_imgs[i] = img;
+    }
+}
+
+/**
+ * Delete the snapshots and show the tiles again.
+ * @param obj       pointer to a tileview
+ */
+static void snapshot_anim_end(lv_obj_t * obj)
+{
+    lv_tileview_t * tv = (lv_tileview_t *) obj;
+
+    /*The children might be deleted in the meantime*/
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        if(tv->snapshot_imgs[i] && is_child(obj, tv->snapshot_imgs[i])) lv_obj_del(tv->snapshot_imgs[i]);
+        tv->snapshot_imgs[i] = NULL;
+
+        if(tv->snapshot_tiles[i] && is_child(obj, tv->snapshot_tiles[i])) {
+            lv_obj_clear_flag(tv->snapshot_tiles[i], LV_OBJ_FLAG_HIDDEN);
+        }
+        tv->snapshot_tiles[i] = NULL;
+
+        if(tv->snapshots[i]) {
+            /*An other image might be allocated to the same address later*/
+            lv_img_cache_invalidate_src(tv->snapshots[i]);
+            lv_snapshot_free(tv->snapshots[i]);
+            tv->snapshots[i] = NULL;
+        }
     }
 }
+
+static bool is_child(lv_obj_t * obj, lv_obj_t * child)
+{
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+    for(i = 0; i < child_cnt; i++) {
+        if(lv_obj_get_child(obj, i) == child) return true;
+    }
+    return false;
+}
+#endif /*LV_USE_SNAPSHOT*/
+
 #endif /*LV_USE_TILEVIEW*/
@@ -20,18 +20,41 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+/*The snapshots of the tiles are shown by images while animating*/
+#if LV_USE_SNAPSHOT && LV_USE_IMG == 0
+#error "lv_tileview: lv_img is required with LV_USE_SNAPSHOT. Enable it in lv_conf.h (LV_USE_IMG 1)"
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
+/**
+ * Create or delete the content of a tile.
+ * @param tile      pointer to the tile
+ * @param load      true: create the content in the tile;
+ *                  false: the content will be deleted. Forget the references to it, stop its timers, etc.
+ */
+typedef void (*lv_tileview_load_cb_t)(lv_obj_t * tile, bool load);
+
 typedef struct {
     lv_obj_t obj;
     lv_obj_t * tile_act;
+    uint8_t load_dist;                  /*Keep the content of the tiles this far from the active tile*/
+#if LV_USE_SNAPSHOT
+    lv_obj_t * snapshot_tiles[2];       /*The tiles replaced by their snapshots while the animation runs*/
+    lv_obj_t * snapshot_imgs[2];        /*The images showing the snapshots*/
+    lv_img_dsc_t * snapshots[2];
+    uint8_t snapshot_anim : 1;
+#endif
 } lv_tileview_t;
 
 typedef struct {
     lv_obj_t obj;
     lv_dir_t dir;
+    lv_tileview_load_cb_t load_cb;
+    uint8_t col_id;
+    uint8_t row_id;
+    uint8_t loaded : 1;
 } lv_tileview_tile_t;
 
 extern const lv_obj_class_t lv_tileview_class;
@@ -55,6 +78,55 @@ void lv_obj_set_tile_id(lv_obj_t * tv, uint32_t col_id, uint32_t row_id, lv_anim
 
 lv_obj_t * lv_tileview_get_tile_act(lv_obj_t * obj);
 
+/**
+ * Create the content of the tile only when it gets close to the active tile and delete it when it gets far.
+ * The content is created when the tile is within `lv_tileview_set_load_dist()` tiles of the active tile
+ * or becomes visible while scrolling, and deleted when the scrolling ends farther from it.
+ * @param tile      pointer to an empty tile
+ * @param load_cb   create the content of the tile or forget the references to it. NULL to keep the content.
+ */
+void lv_tileview_tile_set_load_cb(lv_obj_t * tile, lv_tileview_load_cb_t load_cb);
+
+/**
+ * Tell whether the content of a tile with `load_cb` is created.
+ * @param tile      pointer to a tile
+ * @return          true: the content is created or the tile has no `load_cb`
+ */
+bool lv_tileview_tile_is_loaded(lv_obj_t * tile);
+
+/**
+ * Set how many tiles around the active tile keep their content. (1 by default)
+ * Only the tiles with `lv_tileview_tile_set_load_cb()` are affected.
+ * @param obj       pointer to a tileview
+ * @param dist      0: only the active tile; 1: its neighbors too (diagonally too), etc.
+ */
+void lv_tileview_set_load_dist(lv_obj_t * obj, uint8_t dist);
+
+/**
+ * Get how many tiles around the active tile keep their content.
+ * @param obj       pointer to a tileview
+ * @return          the distance in tiles
+ */
+uint8_t lv_tileview_get_load_dist(lv_obj_t * obj);
+
+#if LV_USE_SNAPSHOT
+/**
+ * Animate the tile changes of `lv_obj_set_tile()` by moving the snapshots of the old and new tiles
+ * instead of redrawing their content in every frame. The tiles are drawn normally again when the animation ends.
+ * It needs memory for the snapshots of 2 tiles with alpha channel. Without enough memory the tiles are animated normally.
+ * @param obj   pointer to a tileview
+ * @param en    true: enable the snapshot animations; false: disable
+ */
+void lv_tileview_set_snapshot_anim(lv_obj_t * obj, bool en);
+
+/**
+ * Tell whether the tile changes are animated with snapshots.
+ * @param obj   pointer to a tileview
+ * @return      true: the snapshot animations are enabled
+ */
+bool lv_tileview_get_snapshot_anim(lv_obj_t * obj);
+#endif
+
 /*=====================
  * Other functions
  *====================*/
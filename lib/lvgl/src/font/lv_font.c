@@ -11,6 +11,7 @@
 #include "../misc/lv_utils.h"
 #include "../misc/lv_log.h"
 #include "../misc/lv_assert.h"
+#include "../misc/lv_thread.h"
 
 /*********************
  *      DEFINES
@@ -49,7 +50,14 @@
 const uint8_t * lv_font_get_glyph_bitmap(const lv_font_t * font_p, uint32_t letter)
 {
     LV_ASSERT_NULL(font_p);
-    return font_p->get_glyph_bitmap(font_p, letter);
+
+    /*The fonts might use caches which are shared by the rendering threads.
+     *Note that the returned bitmap might be overwritten in the cache once the lock is released.*/
+    _lv_render_lock();
+    const uint8_t * bitmap = font_p->get_glyph_bitmap(font_p, letter);
+    _lv_render_unlock();
+
+    return bitmap;
 }
 
 /**
@@ -74,7 +82,10 @@ bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_o
     dsc_out->resolved_font = NULL;
 
     while(f) {
+        /*The fonts might use caches which are shared by the rendering threads*/
+        _lv_render_lock();
         bool found = f->get_glyph_dsc(f, dsc_out, letter, letter_next);
+        _lv_render_unlock();
         if(found) {
             if(!dsc_out->is_placeholder) {
                 dsc_out->resolved_font = f;
@@ -88,7 +99,9 @@ bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_o
     }
 
     if(placeholder_font != NULL) {
+        _lv_render_lock();
         placeholder_font->get_glyph_dsc(placeholder_font, dsc_out, letter, letter_next);
+        _lv_render_unlock();
         dsc_out->resolved_font = placeholder_font;
         return true;
     }
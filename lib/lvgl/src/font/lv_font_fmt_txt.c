@@ -18,6 +18,10 @@
 /*********************
  *      DEFINES
  *********************/
+#if LV_USE_FONT_COMPRESSED
+    /*With 0 still one bitmap is needed to decompress into, but it's freed after every refresh*/
+    #define DECOMPR_CACHE_CNT LV_MAX(LV_FONT_COMPRESSED_CACHE_CNT, 1)
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -28,34 +32,42 @@ typedef enum {
     RLE_STATE_COUNTER,
 } rle_state_t;
 
+/*State of the decompression of one glyph, to not depend on global variables*/
+typedef struct {
+    const uint8_t * in;
+    uint32_t rdp;
+    uint8_t bpp;
+    uint8_t prev_v;
+    uint8_t count;
+    rle_state_t state;
+} rle_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static const lv_font_fmt_txt_glyph_dsc_t * get_glyph_data(const lv_font_t * font, uint32_t gid,
+                                                          const uint8_t ** bitmap);
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
 static int32_t unicode_list_compare(const void * ref, const void * element);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
 static int32_t kern_pair_16_compare(const void * ref, const void * element);
 
 #if LV_USE_FONT_COMPRESSED
+    static _lv_font_decompr_entry_t * decompr_cache_get(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid);
     static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord_t h, uint8_t bpp, bool prefilter);
-    static inline void decompress_line(uint8_t * out, lv_coord_t w);
+    static inline void decompress_line(rle_t * rle, uint8_t * out, lv_coord_t w);
     static inline uint8_t get_bits(const uint8_t * in, uint32_t bit_pos, uint8_t len);
     static inline void bits_write(uint8_t * out, uint32_t bit_pos, uint8_t val, uint8_t len);
-    static inline void rle_init(const uint8_t * in,  uint8_t bpp);
-    static inline uint8_t rle_next(void);
+    static inline void rle_init(rle_t * rle, const uint8_t * in,  uint8_t bpp);
+    static inline uint8_t rle_next(rle_t * rle);
 #endif /*LV_USE_FONT_COMPRESSED*/
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 #if LV_USE_FONT_COMPRESSED
-    static uint32_t rle_rdp;
-    static const uint8_t * rle_in;
-    static uint8_t rle_bpp;
-    static uint8_t rle_prev_v;
-    static uint8_t rle_cnt;
-    static rle_state_t rle_state;
+    static uint32_t decompr_cache_life;
 #endif /*LV_USE_FONT_COMPRESSED*/
 
 /**********************
@@ -84,16 +96,19 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
     uint32_t gid = get_glyph_dsc_id(font, unicode_letter);
     if(!gid) return NULL;
 
-    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+    const uint8_t * bitmap;
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = get_glyph_data(font, gid, &bitmap);
+    if(gdsc == NULL) return NULL;
 
     if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
-        return &fdsc->glyph_bitmap[gdsc->bitmap_index];
+        return bitmap;
     }
     /*Handle compressed bitmap*/
     else {
 #if LV_USE_FONT_COMPRESSED
-        static size_t last_buf_size = 0;
-        if(LV_GC_ROOT(_lv_font_decompr_buf) == NULL) last_buf_size = 0;
+        _lv_font_decompr_entry_t * entry = decompr_cache_get(fdsc, gid);
+        if(entry == NULL) return NULL;
+        if(entry->fdsc == fdsc && entry->gid == gid) return entry->buf;
 
         uint32_t gsize = gdsc->box_w * gdsc->box_h;
         if(gsize == 0) return NULL;
@@ -115,18 +130,21 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
                 break;
         }
 
-        if(last_buf_size < buf_size) {
-            uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
+        /*Reuse the buffer of the evicted glyph if it's large enough*/
+        if(entry->buf_size < buf_size) {
+            uint8_t * tmp = lv_mem_realloc(entry->buf, buf_size);
             LV_ASSERT_MALLOC(tmp);
             if(tmp == NULL) return NULL;
-            LV_GC_ROOT(_lv_font_decompr_buf) = tmp;
-            last_buf_size = buf_size;
+            entry->buf = tmp;
+            entry->buf_size = buf_size;
         }
 
         bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
-        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], LV_GC_ROOT(_lv_font_decompr_buf), gdsc->box_w, gdsc->box_h,
+        decompress(bitmap, entry->buf, gdsc->box_w, gdsc->box_h,
                    (uint8_t)fdsc->bpp, prefilter);
-        return LV_GC_ROOT(_lv_font_decompr_buf);
+        entry->fdsc = fdsc;
+        entry->gid = gid;
+        return entry->buf;
 #else /*!LV_USE_FONT_COMPRESSED*/
         LV_LOG_WARN("Compressed fonts is used but LV_USE_FONT_COMPRESSED is not enabled in lv_conf.h");
         return NULL;
@@ -166,7 +184,8 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     }
 
     /*Put together a glyph dsc*/
-    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = get_glyph_data(font, gid, NULL);
+    if(gdsc == NULL) return false;
 
     int32_t kv = ((int32_t)((int32_t)kvalue * fdsc->kern_scale) >> 4);
 
@@ -194,11 +213,35 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
  */
 void _lv_font_clean_up_fmt_txt(void)
 {
+#if LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_CNT == 0
+    _lv_font_decompr_entry_t * cache = LV_GC_ROOT(_lv_font_decompr_cache);
+    if(cache) {
+        uint32_t i;
+        for(i = 0; i < DECOMPR_CACHE_CNT; i++) {
+            if(cache[i].buf) lv_mem_free(cache[i].buf);
+        }
+        lv_mem_free(cache);
+        LV_GC_ROOT(_lv_font_decompr_cache) = NULL;
+    }
+#endif
+}
+
+void _lv_font_clean_up_fmt_txt_font(const lv_font_t * font)
+{
 #if LV_USE_FONT_COMPRESSED
-    if(LV_GC_ROOT(_lv_font_decompr_buf)) {
-        lv_mem_free(LV_GC_ROOT(_lv_font_decompr_buf));
-        LV_GC_ROOT(_lv_font_decompr_buf) = NULL;
+    _lv_font_decompr_entry_t * cache = LV_GC_ROOT(_lv_font_decompr_cache);
+    if(cache == NULL) return;
+
+    /*Keep the buffers for the other glyphs*/
+    uint32_t i;
+    for(i = 0; i < DECOMPR_CACHE_CNT; i++) {
+        if(cache[i].fdsc == font->dsc) {
+            cache[i].fdsc = NULL;
+            cache[i].last_used = 0;
+        }
     }
+#else
+    LV_UNUSED(font);
 #endif
 }
 
@@ -206,6 +249,27 @@ void _lv_font_clean_up_fmt_txt(void)
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get the descriptor and the bitmap of a glyph from the arrays or from the font's `get_glyph` callback
+ * @param font pointer to font
+ * @param gid glyph id in the font
+ * @param bitmap store the pointer to the bitmap here. Can be NULL.
+ * @return the descriptor of the glyph or NULL if it can't be loaded
+ */
+static const lv_font_fmt_txt_glyph_dsc_t * get_glyph_data(const lv_font_t * font, uint32_t gid,
+                                                          const uint8_t ** bitmap)
+{
+    const lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    if(fdsc->get_glyph) {
+        const uint8_t * bitmap_tmp;
+        return fdsc->get_glyph(font, gid, bitmap ? bitmap : &bitmap_tmp);
+    }
+
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+    if(bitmap) *bitmap = &fdsc->glyph_bitmap[gdsc->bitmap_index];
+    return gdsc;
+}
+
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 {
     if(letter == '\0') return 0;
@@ -215,6 +279,18 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
     /*Check the cache first*/
     if(fdsc->cache && letter == fdsc->cache->last_letter) return fdsc->cache->last_glyph_id;
 
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+    lv_font_fmt_txt_glyph_cache_entry_t * entry = NULL;
+    if(fdsc->cache) {
+        entry = &fdsc->cache->glyph[letter & (LV_FONT_FMT_TXT_CACHE_SIZE - 1)];
+        if(entry->letter == letter) {
+            fdsc->cache->last_letter = letter;
+            fdsc->cache->last_glyph_id = entry->glyph_id;
+            return entry->glyph_id;
+        }
+    }
+#endif
+
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
 
@@ -255,13 +331,22 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
         if(fdsc->cache) {
             fdsc->cache->last_letter = letter;
             fdsc->cache->last_glyph_id = glyph_id;
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+            entry->letter = letter;
+            entry->glyph_id = glyph_id;
+#endif
         }
         return glyph_id;
     }
 
+    /*Cache the misses too as fallback fonts are asked for letters they don't have*/
     if(fdsc->cache) {
         fdsc->cache->last_letter = letter;
         fdsc->cache->last_glyph_id = 0;
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+        entry->letter = letter;
+        entry->glyph_id = 0;
+#endif
     }
     return 0;
 
@@ -275,6 +360,15 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
 
     if(fdsc->kern_classes == 0) {
         /*Kern pairs*/
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+        /*The pairs are binary searched so remember the recent results*/
+        lv_font_fmt_txt_kern_cache_entry_t * entry = NULL;
+        if(fdsc->cache && gid_left <= UINT16_MAX && gid_right <= UINT16_MAX) {
+            entry = &fdsc->cache->kern[(gid_left * 31 + gid_right) & (LV_FONT_FMT_TXT_CACHE_SIZE - 1)];
+            if(entry->gid_left == gid_left && entry->gid_right == gid_right) return entry->value;
+        }
+#endif
+
         const lv_font_fmt_txt_kern_pair_t * kdsc = fdsc->kern_dsc;
         if(kdsc->glyph_ids_size == 0) {
             /*Use binary search to find the kern value.
@@ -306,6 +400,14 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
         else {
             /*Invalid value*/
         }
+
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+        if(entry) {
+            entry->gid_left = (uint16_t)gid_left;
+            entry->gid_right = (uint16_t)gid_right;
+            entry->value = value;
+        }
+#endif
     }
     else {
         /*Kern classes*/
@@ -345,6 +447,42 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element)
 }
 
 #if LV_USE_FONT_COMPRESSED
+/**
+ * Find a glyph in the cache of decompressed bitmaps.
+ * @param fdsc descriptor of the font
+ * @param gid glyph id in the font
+ * @return the entry of the glyph if it's cached (`fdsc` and `gid` are matching),
+ *         else an empty or the least recently used entry to decompress into. NULL on out of memory.
+ */
+static _lv_font_decompr_entry_t * decompr_cache_get(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid)
+{
+    _lv_font_decompr_entry_t * cache = LV_GC_ROOT(_lv_font_decompr_cache);
+    if(cache == NULL) {
+        cache = lv_mem_alloc(sizeof(_lv_font_decompr_entry_t) * DECOMPR_CACHE_CNT);
+        LV_ASSERT_MALLOC(cache);
+        if(cache == NULL) return NULL;
+        lv_memset_00(cache, sizeof(_lv_font_decompr_entry_t) * DECOMPR_CACHE_CNT);
+        LV_GC_ROOT(_lv_font_decompr_cache) = cache;
+        decompr_cache_life = 0;
+    }
+
+    decompr_cache_life++;
+
+    _lv_font_decompr_entry_t * lru = &cache[0];
+    uint32_t i;
+    for(i = 0; i < DECOMPR_CACHE_CNT; i++) {
+        if(cache[i].fdsc == fdsc && cache[i].gid == gid) {
+            cache[i].last_used = decompr_cache_life;
+            return &cache[i];
+        }
+        if(cache[i].last_used < lru->last_used) lru = &cache[i];
+    }
+
+    /*Empty entries have `last_used == 0` so they are used first*/
+    lru->last_used = decompr_cache_life;
+    return lru;
+}
+
 /**
  * The compress a glyph's bitmap
  * @param in the compressed bitmap
@@ -359,7 +497,8 @@ static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord
     uint8_t wr_size = bpp;
     if(bpp == 3) wr_size = 4;
 
-    rle_init(in, bpp);
+    rle_t rle;
+    rle_init(&rle, in, bpp);
 
     uint8_t * line_buf1 = lv_mem_buf_get(w);
 
@@ -369,7 +508,7 @@ static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord
         line_buf2 = lv_mem_buf_get(w);
     }
 
-    decompress_line(line_buf1, w);
+    decompress_line(&rle, line_buf1, w);
 
     lv_coord_t y;
     lv_coord_t x;
@@ -381,7 +520,7 @@ static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord
 
     for(y = 1; y < h; y++) {
         if(prefilter) {
-            decompress_line(line_buf2, w);
+            decompress_line(&rle, line_buf2, w);
 
             for(x = 0; x < w; x++) {
                 line_buf1[x] = line_buf2[x] ^ line_buf1[x];
@@ -390,7 +529,7 @@ static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord
             }
         }
         else {
-            decompress_line(line_buf1, w);
+            decompress_line(&rle, line_buf1, w);
 
             for(x = 0; x < w; x++) {
                 bits_write(out, wrp, line_buf1[x], bpp);
@@ -405,14 +544,15 @@ static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord
 
 /**
  * Decompress one line. Store one pixel per byte
+ * @param rle state of the decompression
  * @param out output buffer
  * @param w width of the line in pixel count
  */
-static inline void decompress_line(uint8_t * out, lv_coord_t w)
+static inline void decompress_line(rle_t * rle, uint8_t * out, lv_coord_t w)
 {
     lv_coord_t i;
     for(i = 0; i < w; i++) {
-        out[i] = rle_next();
+        out[i] = rle_next(rle);
     }
 }
 
@@ -507,67 +647,67 @@ static inline void bits_write(uint8_t * out, uint32_t bit_pos, uint8_t val, uint
     out[byte_pos] |= (val << bit_pos);
 }
 
-static inline void rle_init(const uint8_t * in,  uint8_t bpp)
+static inline void rle_init(rle_t * rle, const uint8_t * in,  uint8_t bpp)
 {
-    rle_in = in;
-    rle_bpp = bpp;
-    rle_state = RLE_STATE_SINGLE;
-    rle_rdp = 0;
-    rle_prev_v = 0;
-    rle_cnt = 0;
+    rle->in = in;
+    rle->bpp = bpp;
+    rle->state = RLE_STATE_SINGLE;
+    rle->rdp = 0;
+    rle->prev_v = 0;
+    rle->count = 0;
 }
 
-static inline uint8_t rle_next(void)
+static inline uint8_t rle_next(rle_t * rle)
 {
     uint8_t v = 0;
     uint8_t ret = 0;
 
-    if(rle_state == RLE_STATE_SINGLE) {
-        ret = get_bits(rle_in, rle_rdp, rle_bpp);
-        if(rle_rdp != 0 && rle_prev_v == ret) {
-            rle_cnt = 0;
-            rle_state = RLE_STATE_REPEATE;
+    if(rle->state == RLE_STATE_SINGLE) {
+        ret = get_bits(rle->in, rle->rdp, rle->bpp);
+        if(rle->rdp != 0 && rle->prev_v == ret) {
+            rle->count = 0;
+            rle->state = RLE_STATE_REPEATE;
         }
 
-        rle_prev_v = ret;
-        rle_rdp += rle_bpp;
+        rle->prev_v = ret;
+        rle->rdp += rle->bpp;
     }
-    else if(rle_state == RLE_STATE_REPEATE) {
-        v = get_bits(rle_in, rle_rdp, 1);
-        rle_cnt++;
-        rle_rdp += 1;
+    else if(rle->state == RLE_STATE_REPEATE) {
+        v = get_bits(rle->in, rle->rdp, 1);
+        rle->count++;
+        rle->rdp += 1;
         if(v == 1) {
-            ret = rle_prev_v;
-            if(rle_cnt == 11) {
-                rle_cnt = get_bits(rle_in, rle_rdp, 6);
-                rle_rdp += 6;
-                if(rle_cnt != 0) {
-                    rle_state = RLE_STATE_COUNTER;
+            ret = rle->prev_v;
+            if(rle->count == 11) {
+                rle->count = get_bits(rle->in, rle->rdp, 6);
+                rle->rdp += 6;
+                if(rle->count != 0) {
+                    rle->state = RLE_STATE_COUNTER;
                 }
                 else {
-                    ret = get_bits(rle_in, rle_rdp, rle_bpp);
-                    rle_prev_v = ret;
-                    rle_rdp += rle_bpp;
-                    rle_state = RLE_STATE_SINGLE;
+                    ret = get_bits(rle->in, rle->rdp, rle->bpp);
+                    rle->prev_v = ret;
+                    rle->rdp += rle->bpp;
+                    rle->state = RLE_STATE_SINGLE;
                 }
             }
         }
         else {
-            ret = get_bits(rle_in, rle_rdp, rle_bpp);
-            rle_prev_v = ret;
-            rle_rdp += rle_bpp;
-            rle_state = RLE_STATE_SINGLE;
+            ret = get_bits(rle->in, rle->rdp, rle->bpp);
+            rle->prev_v = ret;
+            rle->rdp += rle->bpp;
+            rle->state = RLE_STATE_SINGLE;
         }
 
     }
-    else if(rle_state == RLE_STATE_COUNTER) {
-        ret = rle_prev_v;
-        rle_cnt--;
-        if(rle_cnt == 0) {
-            ret = get_bits(rle_in, rle_rdp, rle_bpp);
-            rle_prev_v = ret;
-            rle_rdp += rle_bpp;
-            rle_state = RLE_STATE_SINGLE;
+    else if(rle->state == RLE_STATE_COUNTER) {
+        ret = rle->prev_v;
+        rle->count--;
+        if(rle->count == 0) {
+            ret = get_bits(rle->in, rle->rdp, rle->bpp);
+            rle->prev_v = ret;
+            rle->rdp += rle->bpp;
+            rle->state = RLE_STATE_SINGLE;
         }
     }
 
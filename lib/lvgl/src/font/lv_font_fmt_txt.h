@@ -151,9 +151,33 @@ typedef enum {
     LV_FONT_FMT_TXT_COMPRESSED_NO_PREFILTER = 1,
 } lv_font_fmt_txt_bitmap_format_t;
 
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+#if LV_FONT_FMT_TXT_CACHE_SIZE & (LV_FONT_FMT_TXT_CACHE_SIZE - 1)
+#error "LV_FONT_FMT_TXT_CACHE_SIZE must be a power of 2"
+#endif
+
+/** A slot of the glyph id cache. `letter == 0` marks an empty slot*/
+typedef struct {
+    uint32_t letter;
+    uint32_t glyph_id;
+} lv_font_fmt_txt_glyph_cache_entry_t;
+
+/** A slot of the kerning cache. `gid_left == 0` marks an empty slot*/
+typedef struct {
+    uint16_t gid_left;
+    uint16_t gid_right;
+    int8_t value;
+} lv_font_fmt_txt_kern_cache_entry_t;
+#endif
+
 typedef struct {
     uint32_t last_letter;
     uint32_t last_glyph_id;
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+    /*Direct mapped caches to skip searching the cmaps and the kerning pairs*/
+    lv_font_fmt_txt_glyph_cache_entry_t glyph[LV_FONT_FMT_TXT_CACHE_SIZE];
+    lv_font_fmt_txt_kern_cache_entry_t kern[LV_FONT_FMT_TXT_CACHE_SIZE];
+#endif
 } lv_font_fmt_txt_glyph_cache_t;
 
 /*Describe store additional data for fonts*/
@@ -195,8 +219,24 @@ typedef struct {
 
     /*Cache the last letter and is glyph id*/
     lv_font_fmt_txt_glyph_cache_t * cache;
+
+    /*Optional. Give the descriptor and the bitmap of a glyph instead of `glyph_dsc` and `glyph_bitmap`
+     *(e.g. to load them from a file on demand). Return NULL if the glyph can't be loaded.
+     *The returned data needs to be valid until the next call.*/
+    const lv_font_fmt_txt_glyph_dsc_t * (*get_glyph)(const lv_font_t * font, uint32_t gid, const uint8_t ** bitmap);
 } lv_font_fmt_txt_dsc_t;
 
+#if LV_USE_FONT_COMPRESSED
+/** A decompressed glyph bitmap kept in the cache*/
+typedef struct {
+    const lv_font_fmt_txt_dsc_t * fdsc; /*NULL if the entry is unused*/
+    uint32_t gid;
+    uint32_t last_used;
+    uint32_t buf_size;
+    uint8_t * buf;
+} _lv_font_decompr_entry_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -225,6 +265,13 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
  */
 void _lv_font_clean_up_fmt_txt(void);
 
+/**
+ * Drop the decompressed bitmaps of a font from the cache.
+ * Needs to be called before the descriptor of a font is freed.
+ * @param font pointer to a font
+ */
+void _lv_font_clean_up_fmt_txt_font(const lv_font_t * font);
+
 /**********************
  *      MACROS
  **********************/
@@ -12,6 +12,7 @@
 
 #include "../lvgl.h"
 #include "../misc/lv_fs.h"
+#include "../misc/lv_lru.h"
 #include "lv_font_loader.h"
 
 /**********************
@@ -60,11 +61,37 @@ typedef struct cmap_table_bin {
     uint8_t padding;
 } cmap_table_bin_t;
 
+typedef struct {
+    lv_font_fmt_txt_dsc_t dsc;  /*Must be the first to use it as `lv_font_fmt_txt_dsc_t`*/
+    lv_fs_file_t file;          /*Kept open while the glyphs are used from its memory map or loaded from it*/
+    bool mapped;
+    bool lazy;
+
+    /*To load the glyphs on demand*/
+    lv_lru_t * lru;             /*The loaded glyphs by glyph id*/
+    uint32_t * glyph_offset;    /*Offset of the glyphs in the "glyf" table and its length at the end*/
+    uint32_t glyph_start;
+    uint32_t glyph_cnt;
+    font_header_bin_t header;
+} font_bin_dsc_t;
+
+/*A glyph loaded on demand*/
+typedef struct {
+    lv_font_fmt_txt_glyph_dsc_t dsc;
+    uint8_t bitmap[];
+} lazy_glyph_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static lv_font_t * load_font_file(const char * font_name, uint32_t cache_size);
 static bit_iterator_t init_bit_iterator(lv_fs_file_t * fp);
-static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font);
+static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font, uint32_t cache_size);
+static bool read_glyph_dsc(bit_iterator_t * bit_it, const font_header_bin_t * header,
+                           lv_font_fmt_txt_glyph_dsc_t * gdsc);
+static bool read_glyph_bitmap(bit_iterator_t * bit_it, int nbits, uint8_t * bmp, int bmp_size);
+static const lv_font_fmt_txt_glyph_dsc_t * get_lazy_glyph(const lv_font_t * font, uint32_t gid,
+                                                          const uint8_t ** bitmap);
 int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t format, uint32_t start);
 
 static int read_bits_signed(bit_iterator_t * it, int n_bits, lv_fs_res_t * res);
@@ -85,29 +112,26 @@ static unsigned int read_bits(bit_iterator_t * it, int n_bits, lv_fs_res_t * res
  */
 lv_font_t * lv_font_load(const char * font_name)
 {
-    lv_fs_file_t file;
-    lv_fs_res_t res = lv_fs_open(&file, font_name, LV_FS_MODE_RD);
-    if(res != LV_FS_RES_OK)
-        return NULL;
+    return load_font_file(font_name, 0);
+}
 
-    lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
-    if(font) {
-        memset(font, 0, sizeof(lv_font_t));
-        if(!lvgl_load_font(&file, font)) {
-            LV_LOG_WARN("Error loading font file: %s\n", font_name);
-            /*
-            * When `lvgl_load_font` fails it can leak some pointers.
-            * All non-null pointers can be assumed as allocated and
-            * `lv_font_free` should free them correctly.
-            */
-            lv_font_free(font);
-            font = NULL;
-        }
+/**
+ * Loads a `lv_font_t` object from a binary font file but loads the glyphs only when they are used.
+ * Only the character maps, the kerning and the offsets of the glyphs are kept in the memory
+ * so large fonts (e.g. CJK) are loaded quickly and use memory only for the displayed glyphs.
+ * The file is kept open until `lv_font_free()`.
+ * @param font_name filename where the font file is located
+ * @param cache_size max. size of the loaded glyphs in bytes. The least recently used glyphs are dropped over it.
+ * @return a pointer to the font or NULL in case of error
+ */
+lv_font_t * lv_font_load_lazy(const char * font_name, uint32_t cache_size)
+{
+    if(cache_size == 0) {
+        LV_LOG_WARN("cache_size must be > 0");
+        return NULL;
     }
 
-    lv_fs_close(&file);
-
-    return font;
+    return load_font_file(font_name, cache_size);
 }
 
 /**
@@ -120,6 +144,7 @@ void lv_font_free(lv_font_t * font)
         lv_font_fmt_txt_dsc_t * dsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
         if(NULL != dsc) {
+            _lv_font_clean_up_fmt_txt_font(font);
 
             if(dsc->kern_classes == 0) {
                 lv_font_fmt_txt_kern_pair_t * kern_dsc =
@@ -166,12 +191,25 @@ void lv_font_free(lv_font_t * font)
                 lv_mem_free(cmaps);
             }
 
-            if(NULL != dsc->glyph_bitmap) {
+            font_bin_dsc_t * bin_dsc = (font_bin_dsc_t *)dsc;
+            if(bin_dsc->lru) {
+                lv_lru_del(bin_dsc->lru);
+            }
+            if(bin_dsc->glyph_offset) {
+                lv_mem_free(bin_dsc->glyph_offset);
+            }
+            if(bin_dsc->mapped || bin_dsc->lazy) {
+                lv_fs_close(&bin_dsc->file);
+            }
+            if(!bin_dsc->mapped && NULL != dsc->glyph_bitmap) {
                 lv_mem_free((void *)dsc->glyph_bitmap);
             }
             if(NULL != dsc->glyph_dsc) {
                 lv_mem_free((void *)dsc->glyph_dsc);
             }
+            if(NULL != dsc->cache) {
+                lv_mem_free(dsc->cache);
+            }
             lv_mem_free(dsc);
         }
         lv_mem_free(font);
@@ -182,6 +220,45 @@ void lv_font_free(lv_font_t * font)
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Load a font from a file
+ * @param font_name filename where the font file is located
+ * @param cache_size >0: load the glyphs on demand and keep at most this many bytes of them
+ * @return a pointer to the font or NULL in case of error
+ */
+static lv_font_t * load_font_file(const char * font_name, uint32_t cache_size)
+{
+    lv_fs_file_t file;
+    lv_fs_res_t res = lv_fs_open(&file, font_name, LV_FS_MODE_RD);
+    if(res != LV_FS_RES_OK)
+        return NULL;
+
+    lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
+    bool kept_open = false;
+    if(font) {
+        memset(font, 0, sizeof(lv_font_t));
+        bool ok = lvgl_load_font(&file, font, cache_size);
+
+        /*If the glyphs are used from the file the font closes it in `lv_font_free()`*/
+        font_bin_dsc_t * bin_dsc = (font_bin_dsc_t *)font->dsc;
+        kept_open = bin_dsc && (bin_dsc->mapped || bin_dsc->lazy);
+        if(!ok) {
+            LV_LOG_WARN("Error loading font file: %s\n", font_name);
+            /*
+            * When `lvgl_load_font` fails it can leak some pointers.
+            * All non-null pointers can be assumed as allocated and
+            * `lv_font_free` should free them correctly.
+            */
+            lv_font_free(font);
+            font = NULL;
+        }
+    }
+
+    if(!kept_open) lv_fs_close(&file);
+
+    return font;
+}
+
 static bit_iterator_t init_bit_iterator(lv_fs_file_t * fp)
 {
     bit_iterator_t it;
@@ -335,6 +412,87 @@ static int32_t load_cmaps(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, u
     return success ? cmaps_length : -1;
 }
 
+/**
+ * Read the descriptor of a glyph
+ * @param bit_it    a bit iterator at the start of the glyph
+ * @param header    the header of the font
+ * @param gdsc      store the descriptor here
+ * @return          true: the descriptor is read; false: error
+ */
+static bool read_glyph_dsc(bit_iterator_t * bit_it, const font_header_bin_t * header,
+                           lv_font_fmt_txt_glyph_dsc_t * gdsc)
+{
+    lv_fs_res_t res = LV_FS_RES_OK;
+
+    if(header->advance_width_bits == 0) {
+        gdsc->adv_w = header->default_advance_width;
+    }
+    else {
+        gdsc->adv_w = read_bits(bit_it, header->advance_width_bits, &res);
+        if(res != LV_FS_RES_OK) {
+            return false;
+        }
+    }
+
+    if(header->advance_width_format == 0) {
+        gdsc->adv_w *= 16;
+    }
+
+    gdsc->ofs_x = read_bits_signed(bit_it, header->xy_bits, &res);
+    if(res != LV_FS_RES_OK) {
+        return false;
+    }
+
+    gdsc->ofs_y = read_bits_signed(bit_it, header->xy_bits, &res);
+    if(res != LV_FS_RES_OK) {
+        return false;
+    }
+
+    gdsc->box_w = read_bits(bit_it, header->wh_bits, &res);
+    if(res != LV_FS_RES_OK) {
+        return false;
+    }
+
+    gdsc->box_h = read_bits(bit_it, header->wh_bits, &res);
+    if(res != LV_FS_RES_OK) {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Read the bitmap of a glyph following its descriptor
+ * @param bit_it    a bit iterator right after the descriptor
+ * @param nbits     bit length of the descriptor
+ * @param bmp       store the bitmap here
+ * @param bmp_size  size of the bitmap in bytes
+ * @return          true: the bitmap is read; false: error
+ */
+static bool read_glyph_bitmap(bit_iterator_t * bit_it, int nbits, uint8_t * bmp, int bmp_size)
+{
+    if(nbits % 8 == 0) {  /*Fast path*/
+        return lv_fs_read(bit_it->fp, bmp, bmp_size, NULL) == LV_FS_RES_OK;
+    }
+
+    lv_fs_res_t res = LV_FS_RES_OK;
+    for(int k = 0; k < bmp_size - 1; ++k) {
+        bmp[k] = read_bits(bit_it, 8, &res);
+        if(res != LV_FS_RES_OK) {
+            return false;
+        }
+    }
+    bmp[bmp_size - 1] = read_bits(bit_it, 8 - nbits % 8, &res);
+    if(res != LV_FS_RES_OK) {
+        return false;
+    }
+
+    /*The last fragment should be on the MSB but read_bits() will place it to the LSB*/
+    bmp[bmp_size - 1] = bmp[bmp_size - 1] << (nbits % 8);
+
+    return true;
+}
+
 static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
                           uint32_t start, uint32_t * glyph_offset, uint32_t loca_count, font_header_bin_t * header)
 {
@@ -351,6 +509,16 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
     font_dsc->glyph_dsc = glyph_dsc;
 
     int cur_bmp_size = 0;
+    int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
+
+    /*Use the glyph bitmaps directly from a memory mapped file if they are byte aligned
+     *and the bitmap indices fit into `bitmap_index`*/
+    const void * map;
+    uint32_t map_size;
+    lv_font_fmt_txt_glyph_dsc_t index_test;
+    index_test.bitmap_index = glyph_length;
+    bool map_bmp = nbits % 8 == 0 && index_test.bitmap_index == (uint32_t)glyph_length &&
+                   lv_fs_map(fp, &map, &map_size) == LV_FS_RES_OK && start + glyph_length <= map_size;
 
     for(unsigned int i = 0; i < loca_count; ++i) {
         lv_font_fmt_txt_glyph_dsc_t * gdsc = &glyph_dsc[i];
@@ -362,41 +530,10 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
 
         bit_iterator_t bit_it = init_bit_iterator(fp);
 
-        if(header->advance_width_bits == 0) {
-            gdsc->adv_w = header->default_advance_width;
-        }
-        else {
-            gdsc->adv_w = read_bits(&bit_it, header->advance_width_bits, &res);
-            if(res != LV_FS_RES_OK) {
-                return -1;
-            }
-        }
-
-        if(header->advance_width_format == 0) {
-            gdsc->adv_w *= 16;
-        }
-
-        gdsc->ofs_x = read_bits_signed(&bit_it, header->xy_bits, &res);
-        if(res != LV_FS_RES_OK) {
-            return -1;
-        }
-
-        gdsc->ofs_y = read_bits_signed(&bit_it, header->xy_bits, &res);
-        if(res != LV_FS_RES_OK) {
-            return -1;
-        }
-
-        gdsc->box_w = read_bits(&bit_it, header->wh_bits, &res);
-        if(res != LV_FS_RES_OK) {
+        if(!read_glyph_dsc(&bit_it, header, gdsc)) {
             return -1;
         }
 
-        gdsc->box_h = read_bits(&bit_it, header->wh_bits, &res);
-        if(res != LV_FS_RES_OK) {
-            return -1;
-        }
-
-        int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
         int next_offset = (i < loca_count - 1) ? glyph_offset[i + 1] : (uint32_t)glyph_length;
         int bmp_size = next_offset - glyph_offset[i] - nbits / 8;
 
@@ -408,12 +545,20 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
             gdsc->ofs_y = 0;
         }
 
-        gdsc->bitmap_index = cur_bmp_size;
+        gdsc->bitmap_index = map_bmp ? glyph_offset[i] + nbits / 8 : (uint32_t)cur_bmp_size;
         if(gdsc->box_w * gdsc->box_h != 0) {
             cur_bmp_size += bmp_size;
         }
     }
 
+    if(map_bmp) {
+        font_bin_dsc_t * bin_dsc = (font_bin_dsc_t *)font_dsc;
+        font_dsc->glyph_bitmap = (const uint8_t *)map + start;
+        lv_memcpy_small(&bin_dsc->file, fp, sizeof(lv_fs_file_t));
+        bin_dsc->mapped = true;
+        return glyph_length;
+    }
+
     uint8_t * glyph_bmp = (uint8_t *)lv_mem_alloc(sizeof(uint8_t) * cur_bmp_size);
 
     font_dsc->glyph_bitmap = glyph_bmp;
@@ -427,8 +572,6 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
         }
         bit_iterator_t bit_it = init_bit_iterator(fp);
 
-        int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
-
         read_bits(&bit_it, nbits, &res);
         if(res != LV_FS_RES_OK) {
             return -1;
@@ -441,33 +584,137 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
         int next_offset = (i < loca_count - 1) ? glyph_offset[i + 1] : (uint32_t)glyph_length;
         int bmp_size = next_offset - glyph_offset[i] - nbits / 8;
 
-        if(nbits % 8 == 0) {  /*Fast path*/
-            if(lv_fs_read(fp, &glyph_bmp[cur_bmp_size], bmp_size, NULL) != LV_FS_RES_OK) {
-                return -1;
-            }
+        if(!read_glyph_bitmap(&bit_it, nbits, &glyph_bmp[cur_bmp_size], bmp_size)) {
+            return -1;
         }
-        else {
-            for(int k = 0; k < bmp_size - 1; ++k) {
-                glyph_bmp[cur_bmp_size + k] = read_bits(&bit_it, 8, &res);
-                if(res != LV_FS_RES_OK) {
-                    return -1;
-                }
-            }
-            glyph_bmp[cur_bmp_size + bmp_size - 1] = read_bits(&bit_it, 8 - nbits % 8, &res);
-            if(res != LV_FS_RES_OK) {
-                return -1;
-            }
 
-            /*The last fragment should be on the MSB but read_bits() will place it to the LSB*/
-            glyph_bmp[cur_bmp_size + bmp_size - 1] = glyph_bmp[cur_bmp_size + bmp_size - 1] << (nbits % 8);
+        cur_bmp_size += bmp_size;
+    }
+    return glyph_length;
+}
 
-        }
+/**
+ * Prepare a font to load its glyphs on demand. Only the offsets of the glyphs are kept in the memory.
+ * @param fp            the font file. It's kept open by the font.
+ * @param bin_dsc       the descriptor of the font
+ * @param start         start of the "glyf" table in the file
+ * @param glyph_offset  offset of the glyphs. It's freed by `lv_font_free()`, even if this function fails.
+ * @param loca_count    number of glyphs
+ * @param header        the header of the font
+ * @param cache_size    max. size of the loaded glyphs in bytes
+ * @return              length of the "glyf" table or -1 on error
+ */
+static int32_t init_lazy_glyphs(lv_fs_file_t * fp, font_bin_dsc_t * bin_dsc, uint32_t start,
+                                uint32_t * glyph_offset, uint32_t loca_count, const font_header_bin_t * header,
+                                uint32_t cache_size)
+{
+    bin_dsc->glyph_offset = glyph_offset;
 
-        cur_bmp_size += bmp_size;
+    int32_t glyph_length = read_label(fp, start, "glyf");
+    if(glyph_length < 0) {
+        return -1;
     }
+
+    /*The end of the last glyph*/
+    glyph_offset[loca_count] = glyph_length;
+
+    bin_dsc->glyph_start = start;
+    bin_dsc->glyph_cnt = loca_count;
+    lv_memcpy_small(&bin_dsc->header, header, sizeof(font_header_bin_t));
+
+    uint32_t average_length = (loca_count ? glyph_length / loca_count : 0) + sizeof(lazy_glyph_t);
+    bin_dsc->lru = lv_lru_create(cache_size, average_length, NULL, NULL);
+    if(bin_dsc->lru == NULL) {
+        return -1;
+    }
+
+    lv_memcpy_small(&bin_dsc->file, fp, sizeof(lv_fs_file_t));
+    bin_dsc->lazy = true;
+    bin_dsc->dsc.get_glyph = get_lazy_glyph;
+
     return glyph_length;
 }
 
+/**
+ * Load a glyph from the font file and add it to the cache
+ * @param bin_dsc   the descriptor of the font
+ * @param gid       the glyph id
+ * @return          the loaded glyph or NULL on error
+ */
+static lazy_glyph_t * load_lazy_glyph(font_bin_dsc_t * bin_dsc, uint32_t gid)
+{
+    if(gid >= bin_dsc->glyph_cnt) {
+        return NULL;
+    }
+
+    const font_header_bin_t * header = &bin_dsc->header;
+    uint32_t ofs = bin_dsc->glyph_offset[gid];
+    if(lv_fs_seek(&bin_dsc->file, bin_dsc->glyph_start + ofs, LV_FS_SEEK_SET) != LV_FS_RES_OK) {
+        return NULL;
+    }
+
+    bit_iterator_t bit_it = init_bit_iterator(&bin_dsc->file);
+    lv_font_fmt_txt_glyph_dsc_t gdsc;
+    if(!read_glyph_dsc(&bit_it, header, &gdsc)) {
+        return NULL;
+    }
+
+    int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
+    int bmp_size = 0;
+    if(gid == 0) {
+        lv_memset_00(&gdsc, sizeof(gdsc));
+    }
+    else if(gdsc.box_w * gdsc.box_h != 0) {
+        bmp_size = (int)(bin_dsc->glyph_offset[gid + 1] - ofs) - nbits / 8;
+        if(bmp_size <= 0) {
+            return NULL;
+        }
+    }
+    gdsc.bitmap_index = 0;
+
+    uint32_t glyph_size = sizeof(lazy_glyph_t) + bmp_size;
+    lazy_glyph_t * glyph = lv_mem_alloc(glyph_size);
+    if(glyph == NULL) {
+        return NULL;
+    }
+    glyph->dsc = gdsc;
+
+    if(bmp_size && !read_glyph_bitmap(&bit_it, nbits, glyph->bitmap, bmp_size)) {
+        lv_mem_free(glyph);
+        return NULL;
+    }
+
+    if(lv_lru_set(bin_dsc->lru, &gid, sizeof(gid), glyph, glyph_size) != LV_LRU_OK) {
+        LV_LOG_WARN("Glyph %"LV_PRIu32" doesn't fit into the cache", gid);
+        lv_mem_free(glyph);
+        return NULL;
+    }
+
+    return glyph;
+}
+
+/**
+ * Used as `get_glyph` callback of the fonts whose glyphs are loaded on demand.
+ * The glyphs are valid until the next call as it might drop them from the cache.
+ */
+static const lv_font_fmt_txt_glyph_dsc_t * get_lazy_glyph(const lv_font_t * font, uint32_t gid,
+                                                          const uint8_t ** bitmap)
+{
+    font_bin_dsc_t * bin_dsc = (font_bin_dsc_t *)font->dsc;
+
+    lazy_glyph_t * glyph = NULL;
+    lv_lru_get(bin_dsc->lru, &gid, sizeof(gid), (void **)&glyph);
+    if(glyph == NULL) {
+        glyph = load_lazy_glyph(bin_dsc, gid);
+        if(glyph == NULL) {
+            return NULL;
+        }
+    }
+
+    *bitmap = glyph->bitmap;
+    return &glyph->dsc;
+}
+
 /*
  * Loads a `lv_font_t` from a binary file, given a `lv_fs_file_t`.
  *
@@ -480,15 +727,21 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
  * `lv_font_free` will assume that all non-null pointers are allocated and
  * should be freed.
  */
-static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
+static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font, uint32_t cache_size)
 {
     lv_font_fmt_txt_dsc_t * font_dsc = (lv_font_fmt_txt_dsc_t *)
-                                       lv_mem_alloc(sizeof(lv_font_fmt_txt_dsc_t));
+                                       lv_mem_alloc(sizeof(font_bin_dsc_t));
 
-    memset(font_dsc, 0, sizeof(lv_font_fmt_txt_dsc_t));
+    memset(font_dsc, 0, sizeof(font_bin_dsc_t));
 
     font->dsc = font_dsc;
 
+    /*The glyph cache is optional so the font works without it too*/
+    font_dsc->cache = lv_mem_alloc(sizeof(lv_font_fmt_txt_glyph_cache_t));
+    if(font_dsc->cache) {
+        memset(font_dsc->cache, 0, sizeof(lv_font_fmt_txt_glyph_cache_t));
+    }
+
     /*header*/
     int32_t header_length = read_label(fp, 0, "head");
     if(header_length < 0) {
@@ -561,10 +814,15 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
 
     /*glyph*/
     uint32_t glyph_start = loca_start + loca_length;
-    int32_t glyph_length = load_glyph(
-                               fp, font_dsc, glyph_start, glyph_offset, loca_count, &font_header);
-
-    lv_mem_free(glyph_offset);
+    int32_t glyph_length;
+    if(cache_size) {
+        glyph_length = init_lazy_glyphs(fp, (font_bin_dsc_t *)font_dsc, glyph_start, glyph_offset, loca_count,
+                                        &font_header, cache_size);
+    }
+    else {
+        glyph_length = load_glyph(fp, font_dsc, glyph_start, glyph_offset, loca_count, &font_header);
+        lv_mem_free(glyph_offset);
+    }
 
     if(glyph_length < 0) {
         return false;
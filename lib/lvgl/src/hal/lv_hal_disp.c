@@ -117,6 +117,9 @@ void lv_disp_drv_init(lv_disp_drv_t * driver)
     driver->draw_ctx_init = lv_draw_sw_init_ctx;
     driver->draw_ctx_deinit = lv_draw_sw_init_ctx;
     driver->draw_ctx_size = sizeof(lv_draw_sw_ctx_t);
+#if LV_USE_PARALLEL_RENDER
+    driver->parallel_render = 1;
+#endif
 #endif
 
 }
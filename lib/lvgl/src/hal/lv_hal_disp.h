@@ -101,6 +101,10 @@ typedef struct _lv_disp_drv_t {
 
     uint32_t dpi : 10;              /** DPI (dot per inch) of the display. Default value is `LV_DPI_DEF`.*/
 
+#if LV_USE_PARALLEL_RENDER
+    uint32_t parallel_render : 1;    /**< 1: render the areas in horizontal bands on more threads. Only for the SW renderer.*/
+#endif
+
     /** MANDATORY: Write the internal buffer (draw_buf) to the display. 'lv_disp_flush_ready()' has to be
      * called when finished*/
     void (*flush_cb)(struct _lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
@@ -313,6 +313,52 @@
     #endif
 #endif
 
+/*Size of the buffer (in bytes) to read several lines at once from the images which are not decoded entirely,
+ *e.g. the images from files. Fewer, bigger reads are faster, especially with the decoders supporting `read_area_cb`.
+ *The lines are read one by one if a line is bigger. 0: to read line by line*/
+#ifndef LV_IMG_READ_AREA_BUF_SIZE
+    #ifdef CONFIG_LV_IMG_READ_AREA_BUF_SIZE
+        #define LV_IMG_READ_AREA_BUF_SIZE CONFIG_LV_IMG_READ_AREA_BUF_SIZE
+    #else
+        #define LV_IMG_READ_AREA_BUF_SIZE 4096
+    #endif
+#endif
+
+/*Size of the cache (in bytes) of the rotated and zoomed variants of the images
+ *which are drawn with `lv_img_set_transform_cache()` enabled.
+ *0: to disable the transformation cache*/
+#ifndef LV_IMG_TRANSFORM_CACHE_SIZE
+    #ifdef CONFIG_LV_IMG_TRANSFORM_CACHE_SIZE
+        #define LV_IMG_TRANSFORM_CACHE_SIZE CONFIG_LV_IMG_TRANSFORM_CACHE_SIZE
+    #else
+        #define LV_IMG_TRANSFORM_CACHE_SIZE 0
+    #endif
+#endif
+#if LV_IMG_TRANSFORM_CACHE_SIZE
+    /*Allocate the cached variants with these functions, e.g. to store them in external RAM*/
+    #ifndef LV_IMG_TRANSFORM_CACHE_INCLUDE
+        #ifdef CONFIG_LV_IMG_TRANSFORM_CACHE_INCLUDE
+            #define LV_IMG_TRANSFORM_CACHE_INCLUDE CONFIG_LV_IMG_TRANSFORM_CACHE_INCLUDE
+        #else
+            #define LV_IMG_TRANSFORM_CACHE_INCLUDE "../misc/lv_mem.h"
+        #endif
+    #endif
+    #ifndef LV_IMG_TRANSFORM_CACHE_ALLOC
+        #ifdef CONFIG_LV_IMG_TRANSFORM_CACHE_ALLOC
+            #define LV_IMG_TRANSFORM_CACHE_ALLOC CONFIG_LV_IMG_TRANSFORM_CACHE_ALLOC
+        #else
+            #define LV_IMG_TRANSFORM_CACHE_ALLOC lv_mem_alloc
+        #endif
+    #endif
+    #ifndef LV_IMG_TRANSFORM_CACHE_FREE
+        #ifdef CONFIG_LV_IMG_TRANSFORM_CACHE_FREE
+            #define LV_IMG_TRANSFORM_CACHE_FREE CONFIG_LV_IMG_TRANSFORM_CACHE_FREE
+        #else
+            #define LV_IMG_TRANSFORM_CACHE_FREE lv_mem_free
+        #endif
+    #endif
+#endif
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #ifndef LV_GRADIENT_MAX_STOPS
@@ -369,6 +415,65 @@
     #endif
 #endif
 
+/*Use the PIE (SIMD) instructions of the ESP32-S3 to fill and copy opaque areas.
+ *Only used with LV_COLOR_DEPTH 16.*/
+#ifndef LV_DRAW_SW_ESP32S3_PIE
+    #ifdef CONFIG_LV_DRAW_SW_ESP32S3_PIE
+        #define LV_DRAW_SW_ESP32S3_PIE CONFIG_LV_DRAW_SW_ESP32S3_PIE
+    #else
+        #define LV_DRAW_SW_ESP32S3_PIE 0
+    #endif
+#endif
+
+/*Render the large refreshed areas in horizontal bands on more threads in parallel.
+ *E.g. the second core of a dual core MCU can render the lower half of the area while the first renders the upper half.
+ *It requires thread local storage support (`__thread`) from the compiler.
+ *Can be disabled per display with `disp_drv.parallel_render = 0`*/
+#ifndef LV_USE_PARALLEL_RENDER
+    #ifdef CONFIG_LV_USE_PARALLEL_RENDER
+        #define LV_USE_PARALLEL_RENDER CONFIG_LV_USE_PARALLEL_RENDER
+    #else
+        #define LV_USE_PARALLEL_RENDER 0
+    #endif
+#endif
+#if LV_USE_PARALLEL_RENDER
+    /*Number of worker threads besides the thread calling `lv_timer_handler()`*/
+    #ifndef LV_PARALLEL_RENDER_WORKERS
+        #ifdef CONFIG_LV_PARALLEL_RENDER_WORKERS
+            #define LV_PARALLEL_RENDER_WORKERS CONFIG_LV_PARALLEL_RENDER_WORKERS
+        #else
+            #define LV_PARALLEL_RENDER_WORKERS 1
+        #endif
+    #endif
+
+    /*1: Create FreeRTOS tasks; 0: Create POSIX threads*/
+    #ifndef LV_PARALLEL_RENDER_FREERTOS
+        #ifdef CONFIG_LV_PARALLEL_RENDER_FREERTOS
+            #define LV_PARALLEL_RENDER_FREERTOS CONFIG_LV_PARALLEL_RENDER_FREERTOS
+        #else
+            #define LV_PARALLEL_RENDER_FREERTOS 0
+        #endif
+    #endif
+
+    /*Stack size of the FreeRTOS tasks in bytes*/
+    #ifndef LV_PARALLEL_RENDER_STACK_SIZE
+        #ifdef CONFIG_LV_PARALLEL_RENDER_STACK_SIZE
+            #define LV_PARALLEL_RENDER_STACK_SIZE CONFIG_LV_PARALLEL_RENDER_STACK_SIZE
+        #else
+            #define LV_PARALLEL_RENDER_STACK_SIZE (8 * 1024)
+        #endif
+    #endif
+
+    /*Pin the FreeRTOS tasks to this core on ESP32. -1: no affinity*/
+    #ifndef LV_PARALLEL_RENDER_CORE
+        #ifdef CONFIG_LV_PARALLEL_RENDER_CORE
+            #define LV_PARALLEL_RENDER_CORE CONFIG_LV_PARALLEL_RENDER_CORE
+        #else
+            #define LV_PARALLEL_RENDER_CORE -1
+        #endif
+    #endif
+#endif
+
 /*-------------
  * GPU
  *-----------*/
@@ -715,6 +820,87 @@
     #endif
 #endif
 
+/*1: Tag the allocations of `lv_mem` with the class of the object being created or else their call site,
+ *and measure the live size, peak size and allocation rate per tag. Print them with `lv_mem_track_dump()`.
+ *Works with `LV_MEM_CUSTOM` too. Adds a small header to every allocation.*/
+#ifndef LV_USE_MEM_TRACK
+    #ifdef CONFIG_LV_USE_MEM_TRACK
+        #define LV_USE_MEM_TRACK CONFIG_LV_USE_MEM_TRACK
+    #else
+        #define LV_USE_MEM_TRACK 0
+    #endif
+#endif
+#if LV_USE_MEM_TRACK
+    /*Max number of different tags. The rest is counted as "other"*/
+    #ifndef LV_MEM_TRACK_TAG_MAX
+        #ifdef CONFIG_LV_MEM_TRACK_TAG_MAX
+            #define LV_MEM_TRACK_TAG_MAX CONFIG_LV_MEM_TRACK_TAG_MAX
+        #else
+            #define LV_MEM_TRACK_TAG_MAX 128
+        #endif
+    #endif
+
+    /*Header and expression to tell if a memory is in the external RAM (e.g. PSRAM). 0: no external RAM*/
+    #ifndef LV_MEM_TRACK_EXT_INCLUDE
+        #ifdef CONFIG_LV_MEM_TRACK_EXT_INCLUDE
+            #define LV_MEM_TRACK_EXT_INCLUDE CONFIG_LV_MEM_TRACK_EXT_INCLUDE
+        #else
+            #define LV_MEM_TRACK_EXT_INCLUDE <stdint.h>
+        #endif
+    #endif
+    #ifndef LV_MEM_TRACK_IS_EXT
+        #define LV_MEM_TRACK_IS_EXT(p) 0
+    #endif
+#endif
+
+/*1: Record the drawing time of the objects and the flushing, and dump them with `lv_profiler_dump()`
+ *in Chrome's trace event format. Open the result in `chrome://tracing` or https://ui.perfetto.dev*/
+#ifndef LV_USE_PROFILER
+    #ifdef CONFIG_LV_USE_PROFILER
+        #define LV_USE_PROFILER CONFIG_LV_USE_PROFILER
+    #else
+        #define LV_USE_PROFILER 0
+    #endif
+#endif
+#if LV_USE_PROFILER
+    /*Number of events to keep. The oldest events are overwritten*/
+    #ifndef LV_PROFILER_BUF_SIZE
+        #ifdef CONFIG_LV_PROFILER_BUF_SIZE
+            #define LV_PROFILER_BUF_SIZE CONFIG_LV_PROFILER_BUF_SIZE
+        #else
+            #define LV_PROFILER_BUF_SIZE 4096
+        #endif
+    #endif
+
+    /*Header and expression for the current time in microseconds*/
+    #ifndef LV_PROFILER_TIME_INCLUDE
+        #ifdef CONFIG_LV_PROFILER_TIME_INCLUDE
+            #define LV_PROFILER_TIME_INCLUDE CONFIG_LV_PROFILER_TIME_INCLUDE
+        #else
+            #define LV_PROFILER_TIME_INCLUDE <stdint.h>
+        #endif
+    #endif
+    #ifndef LV_PROFILER_TIME_US_EXPR
+        #ifdef CONFIG_LV_PROFILER_TIME_US_EXPR
+            #define LV_PROFILER_TIME_US_EXPR CONFIG_LV_PROFILER_TIME_US_EXPR
+        #else
+            #define LV_PROFILER_TIME_US_EXPR (lv_tick_get() * 1000)
+        #endif
+    #endif
+#endif
+
+/*1: Prefetch the next part of the files in the background after the decoders tell how they read them with
+ *`lv_fs_set_read_ahead()`. It needs drivers with `cache_size > 0` and doubles their cache memory.
+ *With `LV_USE_PARALLEL_RENDER` a thread reads ahead (so the driver needs to be thread safe),
+ *else it's done by a timer in `lv_timer_handler()`.*/
+#ifndef LV_USE_FS_READ_AHEAD
+    #ifdef CONFIG_LV_USE_FS_READ_AHEAD
+        #define LV_USE_FS_READ_AHEAD CONFIG_LV_USE_FS_READ_AHEAD
+    #else
+        #define LV_USE_FS_READ_AHEAD 0
+    #endif
+#endif
+
 /*Change the built in (v)snprintf functions*/
 #ifndef LV_SPRINTF_CUSTOM
     #ifdef CONFIG_LV_SPRINTF_CUSTOM
@@ -1139,6 +1325,16 @@
     #endif
 #endif
 
+/*Number of slots in the per-font glyph id and kerning caches (power of 2, 0 to disable).
+ *Saves searching the sparse character maps and kerning pairs for every letter.*/
+#ifndef LV_FONT_FMT_TXT_CACHE_SIZE
+    #ifdef CONFIG_LV_FONT_FMT_TXT_CACHE_SIZE
+        #define LV_FONT_FMT_TXT_CACHE_SIZE CONFIG_LV_FONT_FMT_TXT_CACHE_SIZE
+    #else
+        #define LV_FONT_FMT_TXT_CACHE_SIZE 32
+    #endif
+#endif
+
 /*Enables/disables support for compressed fonts.*/
 #ifndef LV_USE_FONT_COMPRESSED
     #ifdef CONFIG_LV_USE_FONT_COMPRESSED
@@ -1147,6 +1343,16 @@
         #define LV_USE_FONT_COMPRESSED 0
     #endif
 #endif
+#if LV_USE_FONT_COMPRESSED
+    /*Number of decompressed glyph bitmaps kept between refreshes (0: decompress the letters on every refresh)*/
+    #ifndef LV_FONT_COMPRESSED_CACHE_CNT
+        #ifdef CONFIG_LV_FONT_COMPRESSED_CACHE_CNT
+            #define LV_FONT_COMPRESSED_CACHE_CNT CONFIG_LV_FONT_COMPRESSED_CACHE_CNT
+        #else
+            #define LV_FONT_COMPRESSED_CACHE_CNT 32
+        #endif
+    #endif
+#endif
 
 /*Enable subpixel rendering*/
 #ifndef LV_USE_FONT_SUBPX
@@ -1415,6 +1621,17 @@
             #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
         #endif
     #endif
+    #ifndef LV_LABEL_LAYOUT_CACHE
+        #ifdef _LV_KCONFIG_PRESENT
+            #ifdef CONFIG_LV_LABEL_LAYOUT_CACHE
+                #define LV_LABEL_LAYOUT_CACHE CONFIG_LV_LABEL_LAYOUT_CACHE
+            #else
+                #define LV_LABEL_LAYOUT_CACHE 0
+            #endif
+        #else
+            #define LV_LABEL_LAYOUT_CACHE 1   /*Cache the line breaks of the labels to speed up drawing and hit-testing of multi-line texts*/
+        #endif
+    #endif
 #endif
 
 #ifndef LV_USE_LINE
@@ -2005,6 +2222,32 @@
     #endif
 #endif
 
+/*Read only, memory mapped files. Uses `mmap()` or `esp_partition_mmap()` on ESP32 where a file is a data partition.
+ *The decoders and the font loader use the content of these files directly instead of copying it to RAM.*/
+#ifndef LV_USE_FS_MMAP
+    #ifdef CONFIG_LV_USE_FS_MMAP
+        #define LV_USE_FS_MMAP CONFIG_LV_USE_FS_MMAP
+    #else
+        #define LV_USE_FS_MMAP 0
+    #endif
+#endif
+#if LV_USE_FS_MMAP
+    #ifndef LV_FS_MMAP_LETTER
+        #ifdef CONFIG_LV_FS_MMAP_LETTER
+            #define LV_FS_MMAP_LETTER CONFIG_LV_FS_MMAP_LETTER
+        #else
+            #define LV_FS_MMAP_LETTER '\0'      /*Set an upper cased letter on which the drive will accessible (e.g. 'A')*/
+        #endif
+    #endif
+    #ifndef LV_FS_MMAP_PATH
+        #ifdef CONFIG_LV_FS_MMAP_PATH
+            #define LV_FS_MMAP_PATH CONFIG_LV_FS_MMAP_PATH
+        #else
+            #define LV_FS_MMAP_PATH ""          /*Set the working directory. File/directory paths will be appended to it.*/
+        #endif
+    #endif
+#endif
+
 /*PNG decoder library*/
 #ifndef LV_USE_PNG
     #ifdef CONFIG_LV_USE_PNG
@@ -2013,6 +2256,27 @@
         #define LV_USE_PNG 0
     #endif
 #endif
+#if LV_USE_PNG
+    /*Decode the images row by row while they are drawn if their decoded size is at least this many bytes.
+     *It needs only the inflate window (32 kB at most) and the cached rows instead of the whole image,
+     *but the image is decoded again when it's redrawn and it can't be zoomed or rotated.
+     *Interlaced images are always decoded at once. 0: disable*/
+    #ifndef LV_PNG_STREAM_MIN_SIZE
+        #ifdef CONFIG_LV_PNG_STREAM_MIN_SIZE
+            #define LV_PNG_STREAM_MIN_SIZE CONFIG_LV_PNG_STREAM_MIN_SIZE
+        #else
+            #define LV_PNG_STREAM_MIN_SIZE 0
+        #endif
+    #endif
+    /*Number of decoded rows to keep for the streamed images*/
+    #ifndef LV_PNG_STREAM_CACHE_ROWS
+        #ifdef CONFIG_LV_PNG_STREAM_CACHE_ROWS
+            #define LV_PNG_STREAM_CACHE_ROWS CONFIG_LV_PNG_STREAM_CACHE_ROWS
+        #else
+            #define LV_PNG_STREAM_CACHE_ROWS 8
+        #endif
+    #endif
+#endif
 
 /*BMP decoder library*/
 #ifndef LV_USE_BMP
@@ -2032,6 +2296,25 @@
         #define LV_USE_SJPG 0
     #endif
 #endif
+#if LV_USE_SJPG
+    /*Number of decoded fragments of an SJPG image to keep. Each needs `width x fragment height x 3` bytes*/
+    #ifndef LV_SJPG_CACHE_FRAGMENTS
+        #ifdef CONFIG_LV_SJPG_CACHE_FRAGMENTS
+            #define LV_SJPG_CACHE_FRAGMENTS CONFIG_LV_SJPG_CACHE_FRAGMENTS
+        #else
+            #define LV_SJPG_CACHE_FRAGMENTS 2
+        #endif
+    #endif
+    /*1: Decode the next fragment in the scroll direction in the next `lv_timer_handler()`.
+     *The decoders need to be kept open between the refreshes with `LV_IMG_CACHE_DEF_SIZE > 0`*/
+    #ifndef LV_SJPG_DECODE_AHEAD
+        #ifdef CONFIG_LV_SJPG_DECODE_AHEAD
+            #define LV_SJPG_DECODE_AHEAD CONFIG_LV_SJPG_DECODE_AHEAD
+        #else
+            #define LV_SJPG_DECODE_AHEAD 0
+        #endif
+    #endif
+#endif
 
 /*GIF decoder library*/
 #ifndef LV_USE_GIF
@@ -12,23 +12,62 @@
 #include "lv_ll.h"
 #include <string.h>
 #include "lv_gc.h"
+#include "lv_timer.h"
+#include "lv_thread.h"
 
 /*********************
  *      DEFINES
  *********************/
+#if LV_USE_FS_READ_AHEAD
+    #define AHEAD_IDLE      0   /*Nothing is prefetched*/
+    #define AHEAD_PENDING   1   /*The data is being prefetched*/
+    #define AHEAD_READY     2   /*The prefetched data is in `ahead_buffer`*/
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_FS_READ_AHEAD
+/*Everything to prefetch without the `lv_fs_file_t` because the callers might copy it*/
+typedef struct {
+    lv_fs_drv_t * drv;
+    void * file_d;
+    lv_fs_file_cache_t * cache;     /*NULL: no job*/
+} ahead_job_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static const char * lv_fs_get_real_path(const char * path);
+#if LV_USE_FS_READ_AHEAD
+    static void ahead_request(lv_fs_file_t * file_p);
+    static void ahead_wait(lv_fs_file_t * file_p);
+    static lv_fs_res_t ahead_drop(lv_fs_file_t * file_p);
+    static void ahead_finish(void);
+    static void ahead_fill(const ahead_job_t * job);
+    static void ahead_timer_cb(lv_timer_t * t);
+    #if LV_USE_PARALLEL_RENDER
+        static bool ahead_thread_init(void);
+        static void ahead_thread_cb(void * user_data);
+    #endif
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_USE_FS_READ_AHEAD
+static ahead_job_t ahead_job;       /*Only one file is prefetched at a time*/
+static lv_timer_t * ahead_timer;    /*Prefetch in `lv_timer_handler()` if there is no thread*/
+
+#if LV_USE_PARALLEL_RENDER
+/*The thread runs forever so these are kept after `lv_deinit()` too*/
+static lv_thread_sync_t * ahead_start_sync;
+static lv_thread_sync_t * ahead_done_sync;
+static bool ahead_thread_inited;
+static bool ahead_thread_ok;
+#endif
+#endif
 
 /**********************
  *      MACROS
@@ -41,6 +80,12 @@ static const char * lv_fs_get_real_path(const char * path);
 void _lv_fs_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_fsdrv_ll), sizeof(lv_fs_drv_t *));
+
+#if LV_USE_FS_READ_AHEAD
+    /*The timer was freed by `lv_deinit()`*/
+    lv_memset_00(&ahead_job, sizeof(ahead_job));
+    ahead_timer = NULL;
+#endif
 }
 
 bool lv_fs_is_ready(char letter)
@@ -112,12 +157,23 @@ lv_fs_res_t lv_fs_close(lv_fs_file_t * file_p)
         return LV_FS_RES_NOT_IMP;
     }
 
+#if LV_USE_FS_READ_AHEAD
+    if(file_p->drv->cache_size && file_p->cache) {
+        ahead_wait(file_p);
+    }
+#endif
+
     lv_fs_res_t res = file_p->drv->close_cb(file_p->drv, file_p->file_d);
 
     if(file_p->drv->cache_size && file_p->cache) {
         if(file_p->cache->buffer) {
             lv_mem_free(file_p->cache->buffer);
         }
+#if LV_USE_FS_READ_AHEAD
+        if(file_p->cache->ahead_buffer) {
+            lv_mem_free(file_p->cache->ahead_buffer);
+        }
+#endif
 
         lv_mem_free(file_p->cache);
     }
@@ -132,6 +188,40 @@ lv_fs_res_t lv_fs_close(lv_fs_file_t * file_p)
 static lv_fs_res_t lv_fs_read_cached(lv_fs_file_t * file_p, char * buf, uint32_t btr, uint32_t * br)
 {
     lv_fs_res_t res = LV_FS_RES_OK;
+
+#if LV_USE_FS_READ_AHEAD
+    lv_fs_file_cache_t * cache = file_p->cache;
+    if(cache->ahead_state != AHEAD_IDLE &&
+       (cache->file_position < cache->start || cache->file_position + btr > cache->end)) {
+        /*Read the rest of the cache buffer and continue in the prefetched data*/
+        uint32_t cache_br = 0;
+        if(cache->start <= cache->file_position && cache->file_position < cache->end) {
+            cache_br = cache->end - cache->file_position;
+            lv_memcpy(buf, (char *)cache->buffer + (cache->file_position - cache->start), cache_br);
+            cache->file_position += cache_br;
+        }
+
+        ahead_wait(file_p);
+        if(cache->ahead_start <= cache->file_position && cache->file_position < cache->ahead_end) {
+            /*Swap the buffers. The driver is already at the end of the prefetched data.*/
+            void * tmp = cache->buffer;
+            cache->buffer = cache->ahead_buffer;
+            cache->ahead_buffer = tmp;
+            cache->start = cache->ahead_start;
+            cache->end = cache->ahead_end;
+            cache->ahead_state = AHEAD_IDLE;
+        }
+        else {
+            res = ahead_drop(file_p);
+        }
+
+        *br = 0;
+        if(res == LV_FS_RES_OK) res = lv_fs_read_cached(file_p, buf + cache_br, btr - cache_br, br);
+        *br += cache_br;
+        return res;
+    }
+#endif
+
     uint32_t file_position = file_p->cache->file_position;
     uint32_t start = file_p->cache->start;
     uint32_t end = file_p->cache->end;
@@ -197,6 +287,9 @@ static lv_fs_res_t lv_fs_read_cached(lv_fs_file_t * file_p, char * buf, uint32_t
 
     if(res == LV_FS_RES_OK) {
         file_p->cache->file_position += *br;
+#if LV_USE_FS_READ_AHEAD
+        ahead_request(file_p);
+#endif
     }
 
     return res;
@@ -254,12 +347,19 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
 
     lv_fs_res_t res = LV_FS_RES_OK;
     if(file_p->drv->cache_size) {
+#if LV_USE_FS_READ_AHEAD
+        /*If there is prefetched data the driver is moved only by the next read*/
+        bool drv_seek = file_p->cache->ahead_state == AHEAD_IDLE;
+#else
+        bool drv_seek = true;
+#endif
         switch(whence) {
             case LV_FS_SEEK_SET: {
                     file_p->cache->file_position = pos;
 
                     /*FS seek if new position is outside cache buffer*/
-                    if(file_p->cache->file_position < file_p->cache->start || file_p->cache->file_position > file_p->cache->end) {
+                    if(drv_seek && (file_p->cache->file_position < file_p->cache->start ||
+                                    file_p->cache->file_position > file_p->cache->end)) {
                         res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, file_p->cache->file_position, LV_FS_SEEK_SET);
                     }
 
@@ -269,13 +369,17 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
                     file_p->cache->file_position += pos;
 
                     /*FS seek if new position is outside cache buffer*/
-                    if(file_p->cache->file_position < file_p->cache->start || file_p->cache->file_position > file_p->cache->end) {
+                    if(drv_seek && (file_p->cache->file_position < file_p->cache->start ||
+                                    file_p->cache->file_position > file_p->cache->end)) {
                         res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, file_p->cache->file_position, LV_FS_SEEK_SET);
                     }
 
                     break;
                 }
             case LV_FS_SEEK_END: {
+#if LV_USE_FS_READ_AHEAD
+                    ahead_drop(file_p);
+#endif
                     /*Because we don't know the file size, we do a little trick: do a FS seek, then get new file position from FS*/
                     res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, pos, whence);
                     if(res == LV_FS_RES_OK) {
@@ -321,6 +425,42 @@ lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos)
     return res;
 }
 
+lv_fs_res_t lv_fs_map(lv_fs_file_t * file_p, const void ** ptr, uint32_t * size)
+{
+    *ptr = NULL;
+    *size = 0;
+
+    if(file_p->drv == NULL) {
+        return LV_FS_RES_INV_PARAM;
+    }
+
+    if(file_p->drv->map_cb == NULL) {
+        return LV_FS_RES_NOT_IMP;
+    }
+
+    return file_p->drv->map_cb(file_p->drv, file_p->file_d, ptr, size);
+}
+
+lv_fs_res_t lv_fs_set_read_ahead(lv_fs_file_t * file_p, lv_fs_read_ahead_t dir)
+{
+    if(file_p->drv == NULL) {
+        return LV_FS_RES_INV_PARAM;
+    }
+
+#if LV_USE_FS_READ_AHEAD
+    if(file_p->drv->cache_size == 0 || file_p->drv->seek_cb == NULL) {
+        return LV_FS_RES_NOT_IMP;
+    }
+
+    lv_fs_res_t res = ahead_drop(file_p);
+    file_p->cache->ahead_dir = dir;
+    return res;
+#else
+    LV_UNUSED(dir);
+    return LV_FS_RES_NOT_IMP;
+#endif
+}
+
 lv_fs_res_t lv_fs_dir_open(lv_fs_dir_t * rddir_p, const char * path)
 {
     if(path == NULL) return LV_FS_RES_INV_PARAM;
@@ -516,3 +656,167 @@ static const char * lv_fs_get_real_path(const char * path)
 
     return path;
 }
+
+#if LV_USE_FS_READ_AHEAD
+
+/**
+ * Start prefetching the part of the file next to the cache buffer according to the read ahead hint
+ * @param file_p pointer to a file whose cache was just used
+ */
+static void ahead_request(lv_fs_file_t * file_p)
+{
+    lv_fs_file_cache_t * cache = file_p->cache;
+    if(cache->ahead_dir == LV_FS_READ_AHEAD_NONE || cache->ahead_state != AHEAD_IDLE) return;
+    if(cache->file_position < cache->start || cache->file_position > cache->end) return;  /*Not read from the cache*/
+
+    uint32_t size = file_p->drv->cache_size;
+    if(cache->ahead_dir == LV_FS_READ_AHEAD_FORWARD) {
+        if(cache->end - cache->start < size) return;    /*The end of the file is in the cache*/
+        cache->ahead_start = cache->end;
+        cache->ahead_end = cache->end + size;
+    }
+    else {
+        if(cache->start == 0) return;
+        cache->ahead_start = cache->start > size ? cache->start - size : 0;
+        cache->ahead_end = cache->start;
+    }
+
+    if(cache->ahead_buffer == NULL) {
+        cache->ahead_buffer = lv_mem_alloc(size);
+        LV_ASSERT_MALLOC(cache->ahead_buffer);
+        if(cache->ahead_buffer == NULL) return;
+    }
+
+    /*Only one file is prefetched at a time so the previous one needs to be finished*/
+    if(ahead_job.cache) ahead_finish();
+
+    cache->ahead_state = AHEAD_PENDING;
+    ahead_job.drv = file_p->drv;
+    ahead_job.file_d = file_p->file_d;
+    ahead_job.cache = cache;
+
+#if LV_USE_PARALLEL_RENDER
+    if(ahead_thread_init()) {
+        _lv_thread_sync_signal(ahead_start_sync);
+        return;
+    }
+#endif
+
+    if(ahead_timer == NULL) {
+        ahead_timer = lv_timer_create(ahead_timer_cb, 0, NULL);
+        LV_ASSERT_MALLOC(ahead_timer);
+        if(ahead_timer == NULL) return;     /*It will be read in `ahead_wait()`*/
+    }
+    lv_timer_resume(ahead_timer);
+}
+
+/**
+ * Wait until the prefetching of a file finishes
+ * @param file_p pointer to a file
+ */
+static void ahead_wait(lv_fs_file_t * file_p)
+{
+    if(file_p->cache->ahead_state == AHEAD_PENDING) ahead_finish();
+}
+
+/**
+ * Forget the prefetched data of a file and move the driver to where the cache expects it
+ * @param file_p pointer to a file
+ * @return LV_FS_RES_OK or any error from the driver's `seek_cb`
+ */
+static lv_fs_res_t ahead_drop(lv_fs_file_t * file_p)
+{
+    lv_fs_file_cache_t * cache = file_p->cache;
+    ahead_wait(file_p);
+    if(cache->ahead_state == AHEAD_IDLE) return LV_FS_RES_OK;
+
+    cache->ahead_state = AHEAD_IDLE;
+
+    /*The next read continues from the end of the cache buffer or reads directly from the position*/
+    uint32_t pos = cache->file_position;
+    if(cache->start <= pos && pos <= cache->end) pos = cache->end;
+    return file_p->drv->seek_cb(file_p->drv, file_p->file_d, pos, LV_FS_SEEK_SET);
+}
+
+/**
+ * Wait for the current job or do it now if the timer hasn't done it yet
+ */
+static void ahead_finish(void)
+{
+#if LV_USE_PARALLEL_RENDER
+    if(ahead_thread_ok) _lv_thread_sync_wait(ahead_done_sync);
+    else ahead_fill(&ahead_job);
+#else
+    ahead_fill(&ahead_job);
+#endif
+
+    ahead_job.cache->ahead_state = AHEAD_READY;
+    ahead_job.cache = NULL;
+}
+
+/**
+ * Read the requested range to the `ahead_buffer`.
+ * It might run in an other thread so it can use only the driver and the already allocated buffer.
+ * @param job the file to prefetch
+ */
+static void ahead_fill(const ahead_job_t * job)
+{
+    lv_fs_file_cache_t * cache = job->cache;
+
+    /*Seek anyway because reading more than the cache size moves the driver*/
+    uint32_t br = 0;
+    lv_fs_res_t res = job->drv->seek_cb(job->drv, job->file_d, cache->ahead_start, LV_FS_SEEK_SET);
+    if(res == LV_FS_RES_OK) {
+        res = job->drv->read_cb(job->drv, job->file_d, cache->ahead_buffer, cache->ahead_end - cache->ahead_start, &br);
+    }
+
+    /*On error the range will be empty so the data will be read again*/
+    cache->ahead_end = cache->ahead_start + (res == LV_FS_RES_OK ? br : 0);
+}
+
+static void ahead_timer_cb(lv_timer_t * t)
+{
+    lv_timer_pause(t);
+    if(ahead_job.cache == NULL) return;     /*Already finished by `ahead_wait()`*/
+
+    ahead_fill(&ahead_job);
+    ahead_job.cache->ahead_state = AHEAD_READY;
+    ahead_job.cache = NULL;
+}
+
+#if LV_USE_PARALLEL_RENDER
+
+/**
+ * Start the prefetching thread on the first call.
+ * @return true: the thread is running
+ */
+static bool ahead_thread_init(void)
+{
+    if(ahead_thread_inited) return ahead_thread_ok;
+    ahead_thread_inited = true;
+
+    ahead_start_sync = _lv_thread_sync_create();
+    ahead_done_sync = _lv_thread_sync_create();
+    if(ahead_start_sync == NULL || ahead_done_sync == NULL || _lv_thread_create(ahead_thread_cb, NULL) == NULL) {
+        LV_LOG_WARN("couldn't start the read ahead thread. Read ahead in lv_timer_handler().");
+        return false;
+    }
+
+    ahead_thread_ok = true;
+    return true;
+}
+
+static void ahead_thread_cb(void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    while(1) {
+        _lv_thread_sync_wait(ahead_start_sync);
+        ahead_fill(&ahead_job);
+        _lv_thread_sync_signal(ahead_done_sync);
+    }
+}
+
+#endif /*LV_USE_PARALLEL_RENDER*/
+
+#endif /*LV_USE_FS_READ_AHEAD*/
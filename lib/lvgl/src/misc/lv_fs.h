@@ -67,6 +67,15 @@ typedef enum {
     LV_FS_SEEK_END = 0x02,      /**< Set the position from the end of the file*/
 } lv_fs_whence_t;
 
+/**
+ * Read ahead hints.
+ */
+typedef enum {
+    LV_FS_READ_AHEAD_NONE = 0,      /**< Don't prefetch*/
+    LV_FS_READ_AHEAD_FORWARD,       /**< Prefetch the data after the cached part of the file*/
+    LV_FS_READ_AHEAD_BACKWARD,      /**< Prefetch the data before the cached part of the file*/
+} lv_fs_read_ahead_t;
+
 typedef struct _lv_fs_drv_t {
     char letter;
     uint16_t cache_size;
@@ -78,6 +87,8 @@ typedef struct _lv_fs_drv_t {
     lv_fs_res_t (*write_cb)(struct _lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw);
     lv_fs_res_t (*seek_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
     lv_fs_res_t (*tell_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+    /*Optional. Give a pointer to the whole content of the file if it's directly addressable*/
+    lv_fs_res_t (*map_cb)(struct _lv_fs_drv_t * drv, void * file_p, const void ** ptr, uint32_t * size);
 
     void * (*dir_open_cb)(struct _lv_fs_drv_t * drv, const char * path);
     lv_fs_res_t (*dir_read_cb)(struct _lv_fs_drv_t * drv, void * rddir_p, char * fn);
@@ -93,6 +104,14 @@ typedef struct {
     uint32_t end;
     uint32_t file_position;
     void * buffer;
+#if LV_USE_FS_READ_AHEAD
+    /*A second buffer filled in the background with the data next to the cache*/
+    uint32_t ahead_start;
+    uint32_t ahead_end;
+    void * ahead_buffer;
+    uint8_t ahead_dir;      /*lv_fs_read_ahead_t*/
+    uint8_t ahead_state;
+#endif
 } lv_fs_file_cache_t;
 
 typedef struct {
@@ -199,6 +218,27 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
  */
 lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos);
 
+/**
+ * Get a pointer to the whole content of a file if the driver can address it directly (e.g. it's memory mapped).
+ * The data can be used without reading it to a buffer. The read write pointer is not changed.
+ * @param file_p    pointer to a lv_fs_file_t variable
+ * @param ptr       store the pointer to the content of the file here. It's valid until the file is closed.
+ * @param size      store the size of the file here
+ * @return          LV_FS_RES_OK or LV_FS_RES_NOT_IMP if the driver can't map the file
+ */
+lv_fs_res_t lv_fs_map(lv_fs_file_t * file_p, const void ** ptr, uint32_t * size);
+
+/**
+ * Tell how the file will be read to prefetch the next part of it in the background while the current part is processed.
+ * Works only with `LV_USE_FS_READ_AHEAD` and drivers having `cache_size > 0`. The prefetched data is `cache_size` long.
+ * @param file_p    pointer to a lv_fs_file_t variable
+ * @param dir       LV_FS_READ_AHEAD_FORWARD: the file is read sequentially,
+ *                  LV_FS_READ_AHEAD_BACKWARD: the file is read backward in small chunks (e.g. the rows of a BMP),
+ *                  LV_FS_READ_AHEAD_NONE: stop prefetching
+ * @return          LV_FS_RES_OK or LV_FS_RES_NOT_IMP if read ahead is not possible with this file
+ */
+lv_fs_res_t lv_fs_set_read_ahead(lv_fs_file_t * file_p, lv_fs_read_ahead_t dir);
+
 /**
  * Initialize a 'fs_dir_t' variable for directory reading
  * @param rddir_p   pointer to a 'lv_fs_dir_t' variable
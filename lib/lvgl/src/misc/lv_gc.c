@@ -40,6 +40,10 @@ void _lv_gc_clear_roots(void)
 {
 #define LV_CLEAR_ROOT(root_type, root_name) lv_memset_00(&LV_GC_ROOT(root_name), sizeof(LV_GC_ROOT(root_name)));
     LV_ITERATE_ROOTS(LV_CLEAR_ROOT)
+#if LV_USE_PARALLEL_RENDER
+    /*Only the copies of the calling thread*/
+    LV_ITERATE_RENDER_ROOTS(LV_CLEAR_ROOT)
+#endif
 }
 
 /**********************
@@ -19,8 +19,10 @@ extern "C" {
 #include "lv_ll.h"
 #include "lv_timer.h"
 #include "lv_types.h"
+#include "lv_thread.h"
 #include "../draw/lv_img_cache.h"
 #include "../draw/lv_draw_mask.h"
+#include "../font/lv_font_fmt_txt.h"
 #include "../core/lv_obj_pos.h"
 
 /*********************
@@ -48,22 +50,39 @@ extern "C" {
     LV_DISPATCH(f, lv_ll_t, _lv_anim_ll)                                                               \
     LV_DISPATCH(f, lv_ll_t, _lv_group_ll)                                                              \
     LV_DISPATCH(f, lv_ll_t, _lv_img_decoder_ll)                                                        \
+    LV_DISPATCH(f, lv_ll_t, _lv_img_transform_cache_ll)                                                \
     LV_DISPATCH(f, lv_ll_t, _lv_obj_style_trans_ll)                                                    \
     LV_DISPATCH(f, lv_layout_dsc_t *, _lv_layout_list)                                                 \
     LV_DISPATCH_COND(f, _lv_img_cache_entry_t*, _lv_img_cache_array, LV_IMG_CACHE_DEF, 1)              \
-    LV_DISPATCH_COND(f, _lv_img_cache_entry_t, _lv_img_cache_single, LV_IMG_CACHE_DEF, 0)              \
     LV_DISPATCH(f, lv_timer_t*, _lv_timer_act)                                                         \
-    LV_DISPATCH(f, lv_mem_buf_arr_t , lv_mem_buf)                                                      \
+    LV_DISPATCH(f, lv_timer_t**, _lv_timer_heap) /*Timers ordered by their deadline*/                  \
     LV_DISPATCH_COND(f, _lv_draw_mask_radius_circle_dsc_arr_t , _lv_circle_cache, LV_DRAW_COMPLEX, 1)  \
-    LV_DISPATCH_COND(f, _lv_draw_mask_saved_arr_t , _lv_draw_mask_list, LV_DRAW_COMPLEX, 1)            \
     LV_DISPATCH(f, void * , _lv_theme_default_styles)                                                  \
     LV_DISPATCH(f, void * , _lv_theme_basic_styles)                                                  \
-    LV_DISPATCH_COND(f, uint8_t *, _lv_font_decompr_buf, LV_USE_FONT_COMPRESSED, 1)                    \
+    LV_DISPATCH_COND(f, _lv_font_decompr_entry_t *, _lv_font_decompr_cache, LV_USE_FONT_COMPRESSED, 1) \
     LV_DISPATCH(f, uint8_t * , _lv_grad_cache_mem)                                                     \
-    LV_DISPATCH(f, uint8_t * , _lv_style_custom_prop_flag_lookup_table)
+    LV_DISPATCH(f, uint8_t * , _lv_style_custom_prop_flag_lookup_table)                                \
+    LV_ITERATE_SHARED_RENDER_ROOTS(f)
+
+/*The roots used while rendering. With parallel rendering every rendering thread has its own copy of them.*/
+#define LV_ITERATE_RENDER_ROOTS(f)                                                                     \
+    LV_DISPATCH_COND(f, _lv_img_cache_entry_t, _lv_img_cache_single, LV_IMG_CACHE_DEF, 0)              \
+    LV_DISPATCH(f, lv_mem_buf_arr_t , lv_mem_buf)                                                      \
+    LV_DISPATCH_COND(f, _lv_draw_mask_saved_arr_t , _lv_draw_mask_list, LV_DRAW_COMPLEX, 1)
+
+#if LV_USE_PARALLEL_RENDER
+#define LV_ITERATE_SHARED_RENDER_ROOTS(f)
+#else
+#define LV_ITERATE_SHARED_RENDER_ROOTS(f) LV_ITERATE_RENDER_ROOTS(f)
+#endif
 
 #define LV_DEFINE_ROOT(root_type, root_name) root_type root_name;
+#if LV_USE_PARALLEL_RENDER
+#define LV_DEFINE_RENDER_ROOT(root_type, root_name) LV_THREAD_LOCAL root_type root_name;
+#define LV_ROOTS LV_ITERATE_ROOTS(LV_DEFINE_ROOT) LV_ITERATE_RENDER_ROOTS(LV_DEFINE_RENDER_ROOT)
+#else
 #define LV_ROOTS LV_ITERATE_ROOTS(LV_DEFINE_ROOT)
+#endif
 
 #if LV_ENABLE_GC == 1
 #if LV_MEM_CUSTOM != 1
@@ -74,6 +93,10 @@ extern "C" {
 #define LV_GC_ROOT(x) x
 #define LV_EXTERN_ROOT(root_type, root_name) extern root_type root_name;
 LV_ITERATE_ROOTS(LV_EXTERN_ROOT)
+#if LV_USE_PARALLEL_RENDER
+#define LV_EXTERN_RENDER_ROOT(root_type, root_name) extern LV_THREAD_LOCAL root_type root_name;
+LV_ITERATE_RENDER_ROOTS(LV_EXTERN_RENDER_ROOT)
+#endif
 #endif /*LV_ENABLE_GC*/
 
 /**********************
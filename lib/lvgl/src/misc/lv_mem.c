@@ -12,6 +12,7 @@
 #include "lv_gc.h"
 #include "lv_assert.h"
 #include "lv_log.h"
+#include "lv_thread.h"
 
 #if LV_MEM_CUSTOM != 0
     #include LV_MEM_CUSTOM_INCLUDE
@@ -21,6 +22,16 @@
     #include LV_MEM_POOL_INCLUDE
 #endif
 
+#if LV_USE_MEM_TRACK
+    #include "lv_printf.h"
+    #include "../hal/lv_hal_tick.h"
+    #include LV_MEM_TRACK_EXT_INCLUDE
+
+    /*Define the functions themselves here. The macros only pass the call site to them.*/
+    #undef lv_mem_alloc
+    #undef lv_mem_realloc
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -39,9 +50,29 @@
 
 #define ZERO_MEM_SENTINEL  0xa1b2c3d4
 
+#if LV_USE_MEM_TRACK
+    #if LV_ENABLE_GC
+        #error "lv_mem: LV_USE_MEM_TRACK can't be used with LV_ENABLE_GC"
+    #endif
+
+    /*The tag and the size are stored before the memories. Use 2 units to keep the alignment.*/
+    #define TRACK_HDR_SIZE   (2 * sizeof(MEM_UNIT))
+
+    /*The allocations are tagged with this when all the tags are used*/
+    #define TRACK_TAG_OTHER  (LV_MEM_TRACK_TAG_MAX - 1)
+#else
+    #define TRACK_HDR_SIZE   0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_MEM_TRACK
+typedef struct {
+    uint32_t size;
+    uint16_t tag;
+} track_hdr_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -50,6 +81,13 @@
     static void lv_mem_walker(void * ptr, size_t size, int used, void * user);
 #endif
 
+#if LV_USE_MEM_TRACK
+    static void * track_add(void * block, size_t size);
+    static void * track_remove(void * data);
+    static void track_update(void * block, bool add);
+    static uint16_t track_get_tag(void);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -59,6 +97,16 @@
 
 static uint32_t zero_mem = ZERO_MEM_SENTINEL; /*Give the address of this variable if 0 byte should be allocated*/
 
+#if LV_USE_MEM_TRACK
+    static lv_mem_track_tag_t track_tags[LV_MEM_TRACK_TAG_MAX];
+    static uint32_t track_tag_cnt;
+    static lv_mem_track_tag_t track_total;
+    static uint32_t track_start;
+    static LV_THREAD_LOCAL const char * track_class;
+    static LV_THREAD_LOCAL const char * track_file;
+    static LV_THREAD_LOCAL uint32_t track_line;
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -112,6 +160,10 @@ void lv_mem_deinit(void)
 #if LV_MEM_CUSTOM == 0
     lv_tlsf_destroy(tlsf);
     lv_mem_init();
+#if LV_USE_MEM_TRACK
+    track_tag_cnt = 0;
+    lv_memset_00(&track_total, sizeof(track_total));
+#endif
 #endif
 }
 
@@ -129,9 +181,12 @@ void * lv_mem_alloc(size_t size)
     }
 
 #if LV_MEM_CUSTOM == 0
-    void * alloc = lv_tlsf_malloc(tlsf, size);
+    /*The rendering threads might allocate at the same time*/
+    _lv_render_lock();
+    void * alloc = lv_tlsf_malloc(tlsf, size + TRACK_HDR_SIZE);
+    _lv_render_unlock();
 #else
-    void * alloc = LV_MEM_CUSTOM_ALLOC(size);
+    void * alloc = LV_MEM_CUSTOM_ALLOC(size + TRACK_HDR_SIZE);
 #endif
 
     if(alloc == NULL) {
@@ -144,10 +199,14 @@ void * lv_mem_alloc(size_t size)
     }
 #if LV_MEM_ADD_JUNK
     else {
-        lv_memset(alloc, 0xaa, size);
+        lv_memset(alloc, 0xaa, size + TRACK_HDR_SIZE);
     }
 #endif
 
+#if LV_USE_MEM_TRACK
+    if(alloc) alloc = track_add(alloc, size);
+#endif
+
     MEM_TRACE("allocated at %p", alloc);
     return alloc;
 }
@@ -162,11 +221,17 @@ void lv_mem_free(void * data)
     if(data == &zero_mem) return;
     if(data == NULL) return;
 
+#if LV_USE_MEM_TRACK
+    data = track_remove(data);
+#endif
+
 #if LV_MEM_CUSTOM == 0
 #  if LV_MEM_ADD_JUNK
     lv_memset(data, 0xbb, lv_tlsf_block_size(data));
 #  endif
+    _lv_render_lock();
     lv_tlsf_free(tlsf, data);
+    _lv_render_unlock();
 #else
     LV_MEM_CUSTOM_FREE(data);
 #endif
@@ -190,16 +255,31 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
 
     if(data_p == &zero_mem) return lv_mem_alloc(new_size);
 
+#if LV_USE_MEM_TRACK
+    /*Remove the old memory from the statistics as the reallocation might free it*/
+    if(data_p) data_p = track_remove(data_p);
+#endif
+
 #if LV_MEM_CUSTOM == 0
-    void * new_p = lv_tlsf_realloc(tlsf, data_p, new_size);
+    _lv_render_lock();
+    void * new_p = lv_tlsf_realloc(tlsf, data_p, new_size + TRACK_HDR_SIZE);
+    _lv_render_unlock();
 #else
-    void * new_p = LV_MEM_CUSTOM_REALLOC(data_p, new_size);
+    void * new_p = LV_MEM_CUSTOM_REALLOC(data_p, new_size + TRACK_HDR_SIZE);
 #endif
     if(new_p == NULL) {
+#if LV_USE_MEM_TRACK
+        /*The old memory is kept*/
+        if(data_p) track_update(data_p, true);
+#endif
         LV_LOG_ERROR("couldn't allocate memory");
         return NULL;
     }
 
+#if LV_USE_MEM_TRACK
+    new_p = track_add(new_p, new_size);
+#endif
+
     MEM_TRACE("allocated at %p", new_p);
     return new_p;
 }
@@ -238,7 +318,9 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 #if LV_MEM_CUSTOM == 0
     MEM_TRACE("begin");
 
+    _lv_render_lock();
     lv_tlsf_walk_pool(lv_tlsf_get_pool(tlsf), lv_mem_walker, mon_p);
+    _lv_render_unlock();
 
     mon_p->total_size = LV_MEM_SIZE;
     mon_p->used_pct = 100 - (100U * mon_p->free_size) / mon_p->total_size;
@@ -294,7 +376,11 @@ void * lv_mem_buf_get(uint32_t size)
     for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
         if(LV_GC_ROOT(lv_mem_buf[i]).used == 0) {
             /*if this fails you probably need to increase your LV_MEM_SIZE/heap size*/
+#if LV_USE_MEM_TRACK
+            void * buf = _lv_mem_realloc_track(LV_GC_ROOT(lv_mem_buf[i]).p, size, __FILE__, __LINE__);
+#else
             void * buf = lv_mem_realloc(LV_GC_ROOT(lv_mem_buf[i]).p, size);
+#endif
             LV_ASSERT_MSG(buf != NULL, "Out of memory, can't allocate a new buffer (increase your LV_MEM_SIZE/heap size)");
             if(buf == NULL) return NULL;
 
@@ -344,6 +430,120 @@ void lv_mem_buf_free_all(void)
     }
 }
 
+#if LV_USE_MEM_TRACK
+
+void lv_mem_track_reset(void)
+{
+    _lv_render_lock();
+    uint32_t i;
+    for(i = 0; i < track_tag_cnt; i++) {
+        track_tags[i].peak_size = track_tags[i].live_size;
+        track_tags[i].alloc_cnt = 0;
+    }
+    track_total.peak_size = track_total.live_size;
+    track_total.alloc_cnt = 0;
+    track_start = lv_tick_get();
+    _lv_render_unlock();
+}
+
+uint32_t lv_mem_track_get_tag_cnt(void)
+{
+    return track_tag_cnt;
+}
+
+const lv_mem_track_tag_t * lv_mem_track_get_tag(uint32_t idx)
+{
+    if(idx >= track_tag_cnt) return NULL;
+    return &track_tags[idx];
+}
+
+const lv_mem_track_tag_t * lv_mem_track_get_total(void)
+{
+    return &track_total;
+}
+
+void lv_mem_track_dump(lv_mem_track_print_cb_t print_cb)
+{
+    char buf[128];
+    uint32_t elaps = lv_tick_elaps(track_start);
+    if(elaps == 0) elaps = 1;
+
+    lv_snprintf(buf, sizeof(buf), "live: %"LV_PRIu32" B (ext: %"LV_PRIu32" B) in %"LV_PRIu32" blocks, peak: %"LV_PRIu32
+                " B, %"LV_PRIu32" allocs/s\n", track_total.live_size, track_total.live_ext_size, track_total.live_cnt,
+                track_total.peak_size, (uint32_t)((uint64_t)track_total.alloc_cnt * 1000 / elaps));
+    print_cb(buf);
+
+#if LV_MEM_CUSTOM == 0
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    lv_snprintf(buf, sizeof(buf), "pool: %"LV_PRIu32" B free, biggest free: %"LV_PRIu32" B, frag: %d %%\n",
+                mon.free_size, mon.free_biggest_size, mon.frag_pct);
+    print_cb(buf);
+#endif
+
+    /*Order the tags by their live size*/
+    uint16_t order[LV_MEM_TRACK_TAG_MAX];
+    uint32_t i;
+    for(i = 0; i < track_tag_cnt; i++) {
+        uint32_t j = i;
+        while(j > 0 && track_tags[order[j - 1]].live_size < track_tags[i].live_size) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = (uint16_t)i;
+    }
+
+    print_cb("    live B     ext B    peak B  blocks  allocs/s  tag\n");
+    for(i = 0; i < track_tag_cnt; i++) {
+        const lv_mem_track_tag_t * t = &track_tags[order[i]];
+        /*Skip the tags which are not interesting anymore*/
+        if(t->live_size == 0 && t->alloc_cnt == 0) continue;
+
+        /*Show only the file names of the call sites*/
+        const char * name = t->name;
+        if(t->line) {
+            const char * s = strrchr(name, '/');
+            if(s) name = s + 1;
+        }
+
+        int len = lv_snprintf(buf, sizeof(buf), "%10"LV_PRIu32"%10"LV_PRIu32"%10"LV_PRIu32"%8"LV_PRIu32"%10"LV_PRIu32"  %s",
+                              t->live_size, t->live_ext_size, t->peak_size, t->live_cnt,
+                              (uint32_t)((uint64_t)t->alloc_cnt * 1000 / elaps), name);
+        if(len > 0 && len < (int)sizeof(buf)) {
+            if(t->line) lv_snprintf(buf + len, sizeof(buf) - len, ":%"LV_PRIu32"\n", t->line);
+            else lv_snprintf(buf + len, sizeof(buf) - len, "\n");
+        }
+        print_cb(buf);
+    }
+}
+
+const char * _lv_mem_track_set_class(const char * name)
+{
+    const char * prev = track_class;
+    track_class = name;
+    return prev;
+}
+
+void * _lv_mem_alloc_track(size_t size, const char * file, uint32_t line)
+{
+    track_file = file;
+    track_line = line;
+    void * alloc = lv_mem_alloc(size);
+    track_file = NULL;
+    return alloc;
+}
+
+void * _lv_mem_realloc_track(void * data_p, size_t new_size, const char * file, uint32_t line)
+{
+    track_file = file;
+    track_line = line;
+    void * new_p = lv_mem_realloc(data_p, new_size);
+    track_file = NULL;
+    return new_p;
+}
+
+#endif /*LV_USE_MEM_TRACK*/
+
 #if LV_MEMCPY_MEMSET_STD == 0
 /**
  * Same as `memcpy` but optimized for 4 byte operation.
@@ -550,3 +750,96 @@ static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
     }
 }
 #endif
+
+#if LV_USE_MEM_TRACK
+/**
+ * Store the tag and the size of a new memory and add it to the statistics.
+ * @param block     the memory returned by the allocator
+ * @param size      the size requested by the caller
+ * @return          the memory to return to the caller
+ */
+static void * track_add(void * block, size_t size)
+{
+    track_hdr_t * hdr = block;
+
+    _lv_render_lock();
+    hdr->tag = track_get_tag();
+    hdr->size = (uint32_t)size;
+    track_update(block, true);
+    track_tags[hdr->tag].alloc_cnt++;
+    track_total.alloc_cnt++;
+    _lv_render_unlock();
+
+    return (uint8_t *)block + TRACK_HDR_SIZE;
+}
+
+/**
+ * Remove a memory from the statistics.
+ * @param data      the memory given to the caller
+ * @return          the memory to give back to the allocator
+ */
+static void * track_remove(void * data)
+{
+    void * block = (uint8_t *)data - TRACK_HDR_SIZE;
+    track_update(block, false);
+    return block;
+}
+
+static void track_update(void * block, bool add)
+{
+    const track_hdr_t * hdr = block;
+    bool ext = LV_MEM_TRACK_IS_EXT(block);
+
+    _lv_render_lock();
+    lv_mem_track_tag_t * stats[2] = {&track_tags[hdr->tag], &track_total};
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        lv_mem_track_tag_t * t = stats[i];
+        if(add) {
+            t->live_size += hdr->size;
+            if(ext) t->live_ext_size += hdr->size;
+            t->live_cnt++;
+            if(t->live_size > t->peak_size) t->peak_size = t->live_size;
+        }
+        else {
+            t->live_size -= hdr->size;
+            if(ext) t->live_ext_size -= hdr->size;
+            t->live_cnt--;
+        }
+    }
+    _lv_render_unlock();
+}
+
+/**
+ * Find or add the tag of the current allocation: the class of the object being created or else the call site.
+ * @return the index of the tag
+ */
+static uint16_t track_get_tag(void)
+{
+    const char * name = track_class;
+    uint32_t line = 0;
+    if(name == NULL) {
+        name = track_file ? track_file : "unknown";
+        line = track_line;
+    }
+
+    uint32_t i;
+    for(i = 0; i < track_tag_cnt; i++) {
+        const lv_mem_track_tag_t * t = &track_tags[i];
+        /*The same file name can be at different addresses in different translation units*/
+        if(t->line == line && (t->name == name || strcmp(t->name, name) == 0)) return (uint16_t)i;
+    }
+
+    if(track_tag_cnt >= LV_MEM_TRACK_TAG_MAX) return TRACK_TAG_OTHER;
+    if(track_tag_cnt == TRACK_TAG_OTHER) {
+        name = "other";
+        line = 0;
+    }
+
+    lv_mem_track_tag_t * t = &track_tags[track_tag_cnt];
+    lv_memset_00(t, sizeof(lv_mem_track_tag_t));
+    t->name = name;
+    t->line = line;
+    return (uint16_t)track_tag_cnt++;
+}
+#endif
@@ -51,6 +51,27 @@ typedef struct {
 
 typedef lv_mem_buf_t lv_mem_buf_arr_t[LV_MEM_BUF_MAX_NUM];
 
+#if LV_USE_MEM_TRACK
+/**
+ * Statistics of the allocations with the same tag.
+ * The tag is the class of the object being created or else the call site of the allocation.
+ */
+typedef struct {
+    const char * name;      /**< Name of the object class or the file of the call site*/
+    uint32_t line;          /**< Line of the call site or 0 for the object classes*/
+    uint32_t live_size;     /**< Size of the not freed memories in bytes*/
+    uint32_t live_ext_size; /**< The part of `live_size` in the external RAM (see `LV_MEM_TRACK_IS_EXT`)*/
+    uint32_t peak_size;     /**< The largest `live_size` since `lv_mem_track_reset()`*/
+    uint32_t live_cnt;      /**< Number of the not freed memories*/
+    uint32_t alloc_cnt;     /**< Number of allocations and reallocations since `lv_mem_track_reset()`*/
+} lv_mem_track_tag_t;
+
+/**
+ * Called by `lv_mem_track_dump()` with the next line of the report.
+ */
+typedef void (*lv_mem_track_print_cb_t)(const char * buf);
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -119,6 +140,61 @@ void lv_mem_buf_release(void * p);
  */
 void lv_mem_buf_free_all(void);
 
+#if LV_USE_MEM_TRACK
+
+/**
+ * Restart measuring the peak sizes and the allocation rate. The live sizes are kept.
+ */
+void lv_mem_track_reset(void);
+
+/**
+ * Get the number of different tags seen so far.
+ * @return the number of tags
+ */
+uint32_t lv_mem_track_get_tag_cnt(void);
+
+/**
+ * Get the statistics of a tag.
+ * @param idx   index of the tag `[0 .. lv_mem_track_get_tag_cnt() - 1]`
+ * @return      pointer to the statistics or NULL if `idx` is invalid
+ */
+const lv_mem_track_tag_t * lv_mem_track_get_tag(uint32_t idx);
+
+/**
+ * Get the sum of the statistics of all tags.
+ * @return      pointer to the total statistics
+ */
+const lv_mem_track_tag_t * lv_mem_track_get_total(void);
+
+/**
+ * Print the totals and the tags ordered by their live size.
+ * The allocation rate is measured since `lv_mem_track_reset()`.
+ * @param print_cb  called with the lines of the report
+ */
+void lv_mem_track_dump(lv_mem_track_print_cb_t print_cb);
+
+/**
+ * Tag the following allocations of the calling thread with the class of an object.
+ * Used while an object is created.
+ * @param name  name of the object's class or NULL to tag by the call site again
+ * @return      the previous class name to restore it later
+ */
+const char * _lv_mem_track_set_class(const char * name);
+
+/**
+ * Same as `lv_mem_alloc()` but also pass the call site to tag the allocation.
+ * Used by the `lv_mem_alloc()` macro.
+ */
+void * _lv_mem_alloc_track(size_t size, const char * file, uint32_t line);
+
+/**
+ * Same as `lv_mem_realloc()` but also pass the call site to tag the allocation.
+ * Used by the `lv_mem_realloc()` macro.
+ */
+void * _lv_mem_realloc_track(void * data_p, size_t new_size, const char * file, uint32_t line);
+
+#endif /*LV_USE_MEM_TRACK*/
+
 //! @cond Doxygen_Suppress
 
 #if LV_MEMCPY_MEMSET_STD
@@ -236,6 +312,12 @@ LV_ATTRIBUTE_FAST_MEM void lv_memset_ff(void * dst, size_t len);
  *      MACROS
  **********************/
 
+/*Pass the call sites to the tracker. The functions can still be used as pointers but those calls are not tagged.*/
+#if LV_USE_MEM_TRACK
+#define lv_mem_alloc(size)              _lv_mem_alloc_track(size, __FILE__, __LINE__)
+#define lv_mem_realloc(data_p, size)    _lv_mem_realloc_track(data_p, size, __FILE__, __LINE__)
+#endif
+
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
@@ -12,9 +12,11 @@ CSRCS += lv_lru.c
 CSRCS += lv_math.c
 CSRCS += lv_mem.c
 CSRCS += lv_printf.c
+CSRCS += lv_profiler.c
 CSRCS += lv_style.c
 CSRCS += lv_style_gen.c
 CSRCS += lv_timer.c
+CSRCS += lv_thread.c
 CSRCS += lv_tlsf.c
 CSRCS += lv_txt.c
 CSRCS += lv_txt_ap.c
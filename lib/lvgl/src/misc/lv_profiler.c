@@ -0,0 +1,129 @@
+/**
+ * @file lv_profiler.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_profiler.h"
+
+#if LV_USE_PROFILER
+
+#include "lv_printf.h"
+#include "lv_thread.h"
+#include "lv_math.h"
+#include "../hal/lv_hal_tick.h"
+#include LV_PROFILER_TIME_INCLUDE
+
+/*********************
+ *      DEFINES
+ *********************/
+/*The nesting is tracked separately for this many threads when dumping*/
+#define TID_MAX     8
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    const char * name;
+    const char * cat;
+    uint32_t ts;
+    lv_area_t area;
+    uint8_t begin : 1;
+    uint8_t has_area : 1;
+    uint8_t tid;
+} event_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static event_t events[LV_PROFILER_BUF_SIZE];
+static uint32_t event_cnt;  /*All the events since the reset, only the last `LV_PROFILER_BUF_SIZE` are kept*/
+static LV_THREAD_LOCAL uint8_t thread_tid;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_profiler_reset(void)
+{
+    event_cnt = 0;
+}
+
+void lv_profiler_dump(lv_profiler_print_cb_t print_cb)
+{
+    uint32_t cnt = event_cnt;
+    uint32_t i = cnt > LV_PROFILER_BUF_SIZE ? cnt - LV_PROFILER_BUF_SIZE : 0;
+
+    /*The oldest events might be overwritten so skip the ends whose begin is lost*/
+    uint32_t depth[TID_MAX] = {0};
+    bool first = true;
+    char buf[160];
+
+    print_cb("{\"traceEvents\":[\n");
+    for(; i < cnt; i++) {
+        const event_t * e = &events[i % LV_PROFILER_BUF_SIZE];
+        uint32_t t = LV_MIN(e->tid, TID_MAX - 1);
+        if(e->begin) depth[t]++;
+        else if(depth[t] == 0) continue;
+        else depth[t]--;
+
+        int len = lv_snprintf(buf, sizeof(buf), "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%"LV_PRIu32
+                              ",\"pid\":0,\"tid\":%d", first ? "" : ",\n", e->name ? e->name : "unnamed", e->cat,
+                              e->begin ? 'B' : 'E', e->ts, e->tid);
+        if(len > 0 && len < (int)sizeof(buf) && e->has_area) {
+            lv_snprintf(buf + len, sizeof(buf) - len, ",\"args\":{\"x\":%d,\"y\":%d,\"w\":%d,\"h\":%d}}",
+                        (int)e->area.x1, (int)e->area.y1, (int)lv_area_get_width(&e->area),
+                        (int)lv_area_get_height(&e->area));
+        }
+        else if(len > 0 && len < (int)sizeof(buf) - 1) {
+            buf[len] = '}';
+            buf[len + 1] = '\0';
+        }
+
+        print_cb(buf);
+        first = false;
+    }
+    print_cb("\n],\"displayTimeUnit\":\"ms\"}\n");
+}
+
+void _lv_profiler_add(const char * name, const char * cat, const lv_area_t * area, bool begin)
+{
+    uint32_t ts = LV_PROFILER_TIME_US_EXPR;
+
+    /*Reserve a slot atomically because the rendering threads might add events at the same time*/
+#if defined(__GNUC__)
+    uint32_t i = __atomic_fetch_add(&event_cnt, 1, __ATOMIC_RELAXED);
+#else
+    uint32_t i = event_cnt++;
+#endif
+
+    event_t * e = &events[i % LV_PROFILER_BUF_SIZE];
+    e->name = name;
+    e->cat = cat;
+    e->ts = ts;
+    e->begin = begin;
+    e->tid = thread_tid;
+    e->has_area = area != NULL;
+    if(area) lv_area_copy(&e->area, area);
+}
+
+void _lv_profiler_set_tid(uint8_t tid)
+{
+    thread_tid = tid;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#endif /*LV_USE_PROFILER*/
@@ -0,0 +1,86 @@
+/**
+ * @file lv_profiler.h
+ * Record the begin and end of the rendering steps and dump them as Chrome trace events.
+ */
+
+#ifndef LV_PROFILER_H
+#define LV_PROFILER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "lv_area.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Called by `lv_profiler_dump()` with the next piece of the JSON output.
+ * E.g. `Serial.print(buf)` or `fputs(buf, f)`
+ */
+typedef void (*lv_profiler_print_cb_t)(const char * buf);
+
+#if LV_USE_PROFILER
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Drop the recorded events.
+ */
+void lv_profiler_reset(void);
+
+/**
+ * Print the recorded events in Chrome's trace event format.
+ * The result can be opened in `chrome://tracing` or https://ui.perfetto.dev.
+ * Call it from the thread calling `lv_timer_handler()` when no refresh is in progress.
+ * @param print_cb      called with the chunks of the JSON text
+ */
+void lv_profiler_dump(lv_profiler_print_cb_t print_cb);
+
+/**
+ * Record an event. Use the `LV_PROFILER_BEGIN/END` macros instead.
+ * It can be called from any rendering thread at the same time without locking.
+ * @param name      name of the step, e.g. the name of an object's class. Must be a static string.
+ * @param cat       category of the step, e.g. "obj" or "draw". Must be a static string.
+ * @param area      the area related to the step or NULL
+ * @param begin     true: the step begins; false: the step ends
+ */
+void _lv_profiler_add(const char * name, const char * cat, const lv_area_t * area, bool begin);
+
+/**
+ * Set the thread ID of the events recorded from the calling thread.
+ * @param tid       ID of the thread. The thread calling `lv_timer_handler()` is 0.
+ */
+void _lv_profiler_set_tid(uint8_t tid);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#define LV_PROFILER_BEGIN(name, cat, area)  _lv_profiler_add(name, cat, area, true)
+#define LV_PROFILER_END(name, cat)          _lv_profiler_add(name, cat, NULL, false)
+
+#else
+
+#define LV_PROFILER_BEGIN(name, cat, area)  do {} while(0)
+#define LV_PROFILER_END(name, cat)          do {} while(0)
+
+#endif /*LV_USE_PROFILER*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_PROFILER_H*/
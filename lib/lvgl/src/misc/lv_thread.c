@@ -0,0 +1,250 @@
+/**
+ * @file lv_thread.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_thread.h"
+
+#if LV_USE_PARALLEL_RENDER
+
+#include "lv_assert.h"
+#include "lv_log.h"
+
+#if LV_PARALLEL_RENDER_FREERTOS
+    #ifdef ESP_PLATFORM
+        #include "freertos/FreeRTOS.h"
+        #include "freertos/task.h"
+        #include "freertos/semphr.h"
+    #else
+        #include "FreeRTOS.h"
+        #include "task.h"
+        #include "semphr.h"
+    #endif
+#else
+    #include <pthread.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Every rendering worker has a thread and 2 sync objects (start and done). The same for the read ahead in `lv_fs`.*/
+#define THREAD_CNT  (LV_PARALLEL_RENDER_WORKERS + LV_USE_FS_READ_AHEAD)
+#define SYNC_CNT    (2 * (LV_PARALLEL_RENDER_WORKERS + LV_USE_FS_READ_AHEAD))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+struct _lv_thread_t {
+#if LV_PARALLEL_RENDER_FREERTOS
+    TaskHandle_t task;
+#else
+    pthread_t thread;
+#endif
+    lv_thread_cb_t cb;
+    void * user_data;
+};
+
+struct _lv_thread_sync_t {
+#if LV_PARALLEL_RENDER_FREERTOS
+    SemaphoreHandle_t sem;
+#else
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    bool signaled;
+#endif
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_PARALLEL_RENDER_FREERTOS
+    static void thread_entry(void * param);
+#else
+    static void * thread_entry(void * param);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static bool parallel;   /*Written only by the thread calling `lv_timer_handler()` while the workers are idle*/
+
+/*The threads run forever so they are allocated statically and never freed (not even by `lv_deinit()`)*/
+static lv_thread_t threads[THREAD_CNT];
+static uint32_t thread_cnt;
+static lv_thread_sync_t syncs[SYNC_CNT];
+static uint32_t sync_cnt;
+
+/*The lock is recursive by counting the nesting in every thread separately*/
+static LV_THREAD_LOCAL uint32_t render_lock_depth;
+
+#if LV_PARALLEL_RENDER_FREERTOS
+    static SemaphoreHandle_t render_mutex;
+#else
+    static pthread_mutex_t render_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_thread_t * _lv_thread_create(lv_thread_cb_t cb, void * user_data)
+{
+    if(thread_cnt >= THREAD_CNT) {
+        LV_LOG_WARN("all the threads are used");
+        return NULL;
+    }
+
+    lv_thread_t * thread = &threads[thread_cnt];
+
+    thread->cb = cb;
+    thread->user_data = user_data;
+
+#if LV_PARALLEL_RENDER_FREERTOS
+    UBaseType_t prio = uxTaskPriorityGet(NULL);
+#ifdef ESP_PLATFORM
+    BaseType_t core = LV_PARALLEL_RENDER_CORE < 0 ? tskNO_AFFINITY : LV_PARALLEL_RENDER_CORE;
+    BaseType_t res = xTaskCreatePinnedToCore(thread_entry, "lv_render", LV_PARALLEL_RENDER_STACK_SIZE, thread, prio,
+                                             &thread->task, core);
+#else
+    BaseType_t res = xTaskCreate(thread_entry, "lv_render", LV_PARALLEL_RENDER_STACK_SIZE / sizeof(StackType_t),
+                                 thread, prio, &thread->task);
+#endif
+    bool ok = res == pdPASS;
+#else
+    bool ok = pthread_create(&thread->thread, NULL, thread_entry, thread) == 0;
+    if(ok) pthread_detach(thread->thread);
+#endif
+
+    if(!ok) {
+        LV_LOG_WARN("couldn't create a thread");
+        return NULL;
+    }
+
+    thread_cnt++;
+    return thread;
+}
+
+lv_thread_sync_t * _lv_thread_sync_create(void)
+{
+    if(sync_cnt >= SYNC_CNT) {
+        LV_LOG_WARN("all the sync objects are used");
+        return NULL;
+    }
+
+    lv_thread_sync_t * sync = &syncs[sync_cnt];
+#if LV_PARALLEL_RENDER_FREERTOS
+    sync->sem = xSemaphoreCreateBinary();
+    if(sync->sem == NULL) return NULL;
+#else
+    if(pthread_mutex_init(&sync->mutex, NULL) != 0) return NULL;
+    if(pthread_cond_init(&sync->cond, NULL) != 0) {
+        pthread_mutex_destroy(&sync->mutex);
+        return NULL;
+    }
+    sync->signaled = false;
+#endif
+
+    sync_cnt++;
+    return sync;
+}
+
+void _lv_thread_sync_wait(lv_thread_sync_t * sync)
+{
+#if LV_PARALLEL_RENDER_FREERTOS
+    xSemaphoreTake(sync->sem, portMAX_DELAY);
+#else
+    pthread_mutex_lock(&sync->mutex);
+    while(!sync->signaled) {
+        pthread_cond_wait(&sync->cond, &sync->mutex);
+    }
+    sync->signaled = false;
+    pthread_mutex_unlock(&sync->mutex);
+#endif
+}
+
+void _lv_thread_sync_signal(lv_thread_sync_t * sync)
+{
+#if LV_PARALLEL_RENDER_FREERTOS
+    xSemaphoreGive(sync->sem);
+#else
+    pthread_mutex_lock(&sync->mutex);
+    sync->signaled = true;
+    pthread_cond_signal(&sync->cond);
+    pthread_mutex_unlock(&sync->mutex);
+#endif
+}
+
+void _lv_render_set_parallel(bool en)
+{
+#if LV_PARALLEL_RENDER_FREERTOS
+    if(render_mutex == NULL) {
+        render_mutex = xSemaphoreCreateMutex();
+        LV_ASSERT_MALLOC(render_mutex);
+        if(render_mutex == NULL) return;
+    }
+#endif
+
+    parallel = en;
+}
+
+bool _lv_render_is_parallel(void)
+{
+    return parallel;
+}
+
+void _lv_render_lock(void)
+{
+    if(!parallel) return;
+
+    render_lock_depth++;
+    if(render_lock_depth > 1) return;
+
+#if LV_PARALLEL_RENDER_FREERTOS
+    xSemaphoreTake(render_mutex, portMAX_DELAY);
+#else
+    pthread_mutex_lock(&render_mutex);
+#endif
+}
+
+void _lv_render_unlock(void)
+{
+    if(!parallel) return;
+
+    render_lock_depth--;
+    if(render_lock_depth > 0) return;
+
+#if LV_PARALLEL_RENDER_FREERTOS
+    xSemaphoreGive(render_mutex);
+#else
+    pthread_mutex_unlock(&render_mutex);
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_PARALLEL_RENDER_FREERTOS
+static void thread_entry(void * param)
+{
+    lv_thread_t * thread = param;
+    thread->cb(thread->user_data);
+    vTaskDelete(NULL);
+}
+#else
+static void * thread_entry(void * param)
+{
+    lv_thread_t * thread = param;
+    thread->cb(thread->user_data);
+    return NULL;
+}
+#endif
+
+#endif /*LV_USE_PARALLEL_RENDER*/
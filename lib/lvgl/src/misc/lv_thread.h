@@ -0,0 +1,123 @@
+/**
+ * @file lv_thread.h
+ * Minimal thread, synchronization and locking wrappers for the parallel rendering.
+ */
+
+#ifndef LV_THREAD_H
+#define LV_THREAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#if LV_USE_PARALLEL_RENDER && LV_ENABLE_GC
+#error "lv_thread: the parallel rendering can't be used with LV_ENABLE_GC"
+#endif
+
+/*Variables which are used while rendering and therefore every rendering thread needs its own copy*/
+#if LV_USE_PARALLEL_RENDER
+#  if defined(_MSC_VER)
+#    define LV_THREAD_LOCAL __declspec(thread)
+#  else
+#    define LV_THREAD_LOCAL __thread
+#  endif
+#else
+#  define LV_THREAD_LOCAL
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+#if LV_USE_PARALLEL_RENDER
+
+typedef struct _lv_thread_t lv_thread_t;
+
+typedef struct _lv_thread_sync_t lv_thread_sync_t;
+
+typedef void (*lv_thread_cb_t)(void * user_data);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a thread which runs forever. It has the priority of the calling thread.
+ * With FreeRTOS it's pinned to `LV_PARALLEL_RENDER_CORE`.
+ * At most `LV_PARALLEL_RENDER_WORKERS` threads can be created (+1 with `LV_USE_FS_READ_AHEAD`).
+ * @param cb            the function to run on the new thread
+ * @param user_data     parameter of `cb`
+ * @return              the new thread or NULL on error
+ */
+lv_thread_t * _lv_thread_create(lv_thread_cb_t cb, void * user_data);
+
+/**
+ * Create a binary semaphore to signal an other thread.
+ * At most `2 * LV_PARALLEL_RENDER_WORKERS` sync objects can be created (+2 with `LV_USE_FS_READ_AHEAD`).
+ * @return the new object or NULL on error
+ */
+lv_thread_sync_t * _lv_thread_sync_create(void);
+
+/**
+ * Block until `_lv_thread_sync_signal()` is called on a sync object.
+ * @param sync  pointer to a sync object
+ */
+void _lv_thread_sync_wait(lv_thread_sync_t * sync);
+
+/**
+ * Wake up the thread waiting on a sync object (or the next one waiting on it).
+ * @param sync  pointer to a sync object
+ */
+void _lv_thread_sync_signal(lv_thread_sync_t * sync);
+
+/**
+ * Mark that the rendering threads are running in parallel.
+ * Called by the refresh before and after rendering the bands of an area.
+ * @param en    true: the rendering threads are working; false: only the caller thread is running
+ */
+void _lv_render_set_parallel(bool en);
+
+/**
+ * Tell if more threads are rendering right now.
+ * @return true: the data shared by the rendering threads needs to be protected
+ */
+bool _lv_render_is_parallel(void);
+
+/**
+ * Lock the data shared by the rendering threads (e.g. the caches).
+ * It's recursive and does nothing if the rendering threads are not running in parallel.
+ */
+void _lv_render_lock(void);
+
+/**
+ * Unlock the data locked by `_lv_render_lock()`.
+ */
+void _lv_render_unlock(void);
+
+#else
+
+#define _lv_render_is_parallel()    false
+#define _lv_render_lock()           do {} while(0)
+#define _lv_render_unlock()         do {} while(0)
+
+#endif /*LV_USE_PARALLEL_RENDER*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_THREAD_H*/
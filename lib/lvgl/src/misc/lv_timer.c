@@ -17,6 +17,7 @@
  *********************/
 #define IDLE_MEAS_PERIOD 500 /*[ms]*/
 #define DEF_PERIOD 500
+#define HEAP_IDX_NONE 0xFFFFFFFF
 
 /**********************
  *      TYPEDEFS
@@ -27,6 +28,15 @@
  **********************/
 static bool lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
+static bool timer_heap_reserve(uint32_t cnt);
+static bool timer_heap_less(lv_timer_t * a, lv_timer_t * b);
+static void timer_heap_swap(uint32_t i, uint32_t j);
+static void timer_heap_sift_up(uint32_t idx);
+static void timer_heap_sift_down(uint32_t idx);
+static void timer_heap_push(lv_timer_t * timer);
+static void timer_heap_remove(lv_timer_t * timer);
+static void timer_heap_update(lv_timer_t * timer);
+static void timer_pending_remove(lv_timer_t * timer);
 
 /**********************
  *  STATIC VARIABLES
@@ -34,7 +44,9 @@ static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
 static bool lv_timer_run = false;
 static uint8_t idle_last = 0;
 static bool timer_deleted;
-static bool timer_created;
+static uint32_t timer_heap_cnt;
+static uint32_t timer_heap_size;
+static lv_timer_t * timer_pending_head; /*Timers which have already run in the current `lv_timer_handler` call*/
 
 /**********************
  *      MACROS
@@ -55,6 +67,10 @@ static bool timer_created;
 void _lv_timer_core_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_timer_ll), sizeof(lv_timer_t));
+    LV_GC_ROOT(_lv_timer_heap) = NULL;
+    timer_heap_cnt = 0;
+    timer_heap_size = 0;
+    timer_pending_head = NULL;
 
     /*Initially enable the lv_timer handling*/
     lv_timer_enable(true);
@@ -95,40 +111,35 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    do {
-        timer_deleted             = false;
-        timer_created             = false;
-        LV_GC_ROOT(_lv_timer_act) = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-        while(LV_GC_ROOT(_lv_timer_act)) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), LV_GC_ROOT(_lv_timer_act));
-
-            if(lv_timer_exec(LV_GC_ROOT(_lv_timer_act))) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(timer_created || timer_deleted) {
-                    TIMER_TRACE("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
-            }
-
-            LV_GC_ROOT(_lv_timer_act) = next; /*Load the next timer*/
-        }
-    } while(LV_GC_ROOT(_lv_timer_act));
-
-    uint32_t time_till_next = LV_NO_TIMER_READY;
-    next = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_till_next)
-                time_till_next = delay;
-        }
-
-        next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), next); /*Find the next timer*/
+    /*Run the due timers in the order of their deadline.
+     *A timer which has run is parked on the pending list until the end of this call
+     *so every timer runs at most once per call, even with 0 period.*/
+    lv_timer_t * timer;
+    while(timer_heap_cnt > 0) {
+        timer = LV_GC_ROOT(_lv_timer_heap)[0];
+        if(timer->repeat_count != 0 && lv_timer_time_remaining(timer) != 0) break;
+
+        timer_heap_remove(timer);
+        timer->pending = 1;
+        timer->pending_next = timer_pending_head;
+        timer_pending_head = timer;
+
+        LV_GC_ROOT(_lv_timer_act) = timer;
+        timer_deleted = false;
+        lv_timer_exec(timer);
     }
+    LV_GC_ROOT(_lv_timer_act) = NULL;
+
+    /*Give the timers which have run (and still exist) back to the scheduler*/
+    while(timer_pending_head) {
+        timer = timer_pending_head;
+        timer_pending_head = timer->pending_next;
+        timer->pending = 0;
+        timer->pending_next = NULL;
+        if(!timer->paused) timer_heap_push(timer);
+    }
+
+    uint32_t time_till_next = lv_timer_get_time_until_next();
 
     busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(idle_period_start);
@@ -168,6 +179,9 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
 {
     lv_timer_t * new_timer = NULL;
 
+    /*Be sure the scheduler can hold every timer so resuming or re-scheduling can't fail later*/
+    if(!timer_heap_reserve(_lv_ll_get_len(&LV_GC_ROOT(_lv_timer_ll)) + 1)) return NULL;
+
     new_timer = _lv_ll_ins_head(&LV_GC_ROOT(_lv_timer_ll));
     LV_ASSERT_MALLOC(new_timer);
     if(new_timer == NULL) return NULL;
@@ -178,8 +192,11 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->paused = 0;
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
+    new_timer->pending = 0;
+    new_timer->pending_next = NULL;
+    new_timer->heap_idx = HEAP_IDX_NONE;
 
-    timer_created = true;
+    timer_heap_push(new_timer);
 
     return new_timer;
 }
@@ -200,6 +217,9 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
  */
 void lv_timer_del(lv_timer_t * timer)
 {
+    if(timer->heap_idx != HEAP_IDX_NONE) timer_heap_remove(timer);
+    else if(timer->pending) timer_pending_remove(timer);
+
     _lv_ll_remove(&LV_GC_ROOT(_lv_timer_ll), timer);
     timer_deleted = true;
 
@@ -212,12 +232,19 @@ void lv_timer_del(lv_timer_t * timer)
  */
 void lv_timer_pause(lv_timer_t * timer)
 {
+    if(timer->paused) return;
+
     timer->paused = true;
+    if(timer->heap_idx != HEAP_IDX_NONE) timer_heap_remove(timer);
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
+    if(!timer->paused) return;
+
     timer->paused = false;
+    /*A pending timer will be scheduled again at the end of `lv_timer_handler`*/
+    if(!timer->pending) timer_heap_push(timer);
 }
 
 /**
@@ -228,6 +255,7 @@ void lv_timer_resume(lv_timer_t * timer)
 void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     timer->period = period;
+    timer_heap_update(timer);
 }
 
 /**
@@ -237,6 +265,7 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 void lv_timer_ready(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get() - timer->period - 1;
+    timer_heap_update(timer);
 }
 
 /**
@@ -247,6 +276,7 @@ void lv_timer_ready(lv_timer_t * timer)
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 {
     timer->repeat_count = repeat_count;
+    timer_heap_update(timer);
 }
 
 /**
@@ -257,6 +287,7 @@ void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 void lv_timer_reset(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get();
+    timer_heap_update(timer);
 }
 
 /**
@@ -277,6 +308,21 @@ uint8_t lv_timer_get_idle(void)
     return idle_last;
 }
 
+/**
+ * Get the time remaining until the next timer will run
+ * @return the time remaining in ms or `LV_NO_TIMER_READY` if there is no active timer
+ */
+uint32_t lv_timer_get_time_until_next(void)
+{
+    if(timer_heap_cnt == 0) return LV_NO_TIMER_READY;
+
+    lv_timer_t * timer = LV_GC_ROOT(_lv_timer_heap)[0];
+    /*A timer with 0 repeat count is due to be deleted*/
+    if(timer->repeat_count == 0) return 0;
+
+    return lv_timer_time_remaining(timer);
+}
+
 /**
  * Iterate through the timers
  * @param timer NULL to start iteration or the previous return value to get the next timer
@@ -339,3 +385,138 @@ static uint32_t lv_timer_time_remaining(lv_timer_t * timer)
         return 0;
     return timer->period - elp;
 }
+
+/**
+ * Make sure the scheduler's heap can hold a given number of timers
+ * @param cnt the number of timers to hold
+ * @return true: success; false: out of memory
+ */
+static bool timer_heap_reserve(uint32_t cnt)
+{
+    if(cnt <= timer_heap_size) return true;
+
+    uint32_t new_size = timer_heap_size ? timer_heap_size * 2 : 8;
+    while(new_size < cnt) new_size *= 2;
+
+    lv_timer_t ** new_heap = lv_mem_realloc(LV_GC_ROOT(_lv_timer_heap), new_size * sizeof(lv_timer_t *));
+    LV_ASSERT_MALLOC(new_heap);
+    if(new_heap == NULL) return false;
+
+    LV_GC_ROOT(_lv_timer_heap) = new_heap;
+    timer_heap_size = new_size;
+    return true;
+}
+
+/**
+ * Tell whether a timer is due earlier than an other.
+ * The remaining time of every timer decreases at the same rate (and saturates at 0)
+ * so an ordering made earlier remains valid later too.
+ * @param a pointer to a timer
+ * @param b pointer to an other timer
+ * @return true: `a` is due earlier than `b`
+ */
+static bool timer_heap_less(lv_timer_t * a, lv_timer_t * b)
+{
+    if(b->repeat_count == 0) return false;
+    if(a->repeat_count == 0) return true;
+
+    return lv_timer_time_remaining(a) < lv_timer_time_remaining(b);
+}
+
+static void timer_heap_swap(uint32_t i, uint32_t j)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    lv_timer_t * tmp = heap[i];
+    heap[i] = heap[j];
+    heap[j] = tmp;
+    heap[i]->heap_idx = i;
+    heap[j]->heap_idx = j;
+}
+
+static void timer_heap_sift_up(uint32_t idx)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    while(idx > 0) {
+        uint32_t parent = (idx - 1) / 2;
+        if(!timer_heap_less(heap[idx], heap[parent])) break;
+        timer_heap_swap(idx, parent);
+        idx = parent;
+    }
+}
+
+static void timer_heap_sift_down(uint32_t idx)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    while(1) {
+        uint32_t min = idx;
+        uint32_t left = 2 * idx + 1;
+        uint32_t right = left + 1;
+        if(left < timer_heap_cnt && timer_heap_less(heap[left], heap[min])) min = left;
+        if(right < timer_heap_cnt && timer_heap_less(heap[right], heap[min])) min = right;
+        if(min == idx) break;
+        timer_heap_swap(idx, min);
+        idx = min;
+    }
+}
+
+/**
+ * Add a timer to the scheduler. The heap has already been reserved in `lv_timer_create`.
+ * @param timer pointer to a timer which is not in the heap
+ */
+static void timer_heap_push(lv_timer_t * timer)
+{
+    LV_ASSERT(timer_heap_cnt < timer_heap_size);
+
+    LV_GC_ROOT(_lv_timer_heap)[timer_heap_cnt] = timer;
+    timer->heap_idx = timer_heap_cnt;
+    timer_heap_cnt++;
+    timer_heap_sift_up(timer->heap_idx);
+}
+
+/**
+ * Remove a timer from the scheduler
+ * @param timer pointer to a timer which is in the heap
+ */
+static void timer_heap_remove(lv_timer_t * timer)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    uint32_t idx = timer->heap_idx;
+    timer->heap_idx = HEAP_IDX_NONE;
+    timer_heap_cnt--;
+    if(idx == timer_heap_cnt) return;
+
+    heap[idx] = heap[timer_heap_cnt];
+    heap[idx]->heap_idx = idx;
+    timer_heap_sift_up(idx);
+    timer_heap_sift_down(heap[idx]->heap_idx);
+}
+
+/**
+ * Restore the order of the heap after the deadline of a timer has changed
+ * @param timer pointer to a timer
+ */
+static void timer_heap_update(lv_timer_t * timer)
+{
+    if(timer->heap_idx == HEAP_IDX_NONE) return;
+
+    timer_heap_sift_up(timer->heap_idx);
+    timer_heap_sift_down(timer->heap_idx);
+}
+
+/**
+ * Remove a timer from the list of timers which have run in the current `lv_timer_handler` call
+ * @param timer pointer to a pending timer
+ */
+static void timer_pending_remove(lv_timer_t * timer)
+{
+    lv_timer_t ** p = &timer_pending_head;
+    while(*p) {
+        if(*p == timer) {
+            *p = timer->pending_next;
+            break;
+        }
+        p = &(*p)->pending_next;
+    }
+    timer->pending = 0;
+    timer->pending_next = NULL;
+}
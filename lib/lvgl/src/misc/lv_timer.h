@@ -47,7 +47,10 @@ typedef struct _lv_timer_t {
     lv_timer_cb_t timer_cb; /**< Timer function*/
     void * user_data; /**< Custom user data*/
     int32_t repeat_count; /**< 1: One time;  -1 : infinity;  n>0: residual times*/
+    uint32_t heap_idx; /**< Position in the scheduler's deadline heap (internal)*/
+    struct _lv_timer_t * pending_next; /**< Next timer in the list of timers which have just run (internal)*/
     uint32_t paused : 1;
+    uint32_t pending : 1; /**< The timer has run in the current `lv_timer_handler` call (internal)*/
 } lv_timer_t;
 
 /**********************
@@ -165,6 +168,13 @@ void lv_timer_enable(bool en);
  */
 uint8_t lv_timer_get_idle(void);
 
+/**
+ * Get the time remaining until the next timer will run.
+ * It can be used to sleep (e.g. in a tickless idle) until `lv_timer_handler()` has work to do.
+ * @return the time remaining in ms or `LV_NO_TIMER_READY` if there is no active timer
+ */
+uint32_t lv_timer_get_time_until_next(void);
+
 /**
  * Iterate through the timers
  * @param timer NULL to start iteration or the previous return value to get the next timer
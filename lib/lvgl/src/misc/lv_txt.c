@@ -379,6 +379,101 @@ lv_coord_t lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t *
     return width;
 }
 
+void _lv_txt_layout_init(lv_txt_layout_t * layout)
+{
+    lv_memset_00(layout, sizeof(lv_txt_layout_t));
+}
+
+void _lv_txt_layout_invalidate(lv_txt_layout_t * layout)
+{
+    layout->valid = 0;
+}
+
+void _lv_txt_layout_free(lv_txt_layout_t * layout)
+{
+    lv_mem_free(layout->line_start);
+    lv_mem_free(layout->line_width);
+    _lv_txt_layout_init(layout);
+}
+
+bool _lv_txt_layout_match(const lv_txt_layout_t * layout, const char * txt, const lv_font_t * font,
+                          lv_coord_t letter_space, lv_coord_t max_width, lv_text_flag_t flag)
+{
+    /*The max width doesn't matter with these flags*/
+    if((flag & LV_TEXT_FLAG_EXPAND) || (flag & LV_TEXT_FLAG_FIT)) max_width = LV_COORD_MAX;
+
+    return layout->valid && layout->txt == txt && layout->font == font && layout->letter_space == letter_space &&
+           layout->max_width == max_width && layout->flag == flag;
+}
+
+bool _lv_txt_layout_update(lv_txt_layout_t * layout, const char * txt, const lv_font_t * font,
+                           lv_coord_t letter_space, lv_coord_t max_width, lv_text_flag_t flag)
+{
+    if(txt == NULL || font == NULL) return false;
+    if(_lv_txt_layout_match(layout, txt, font, letter_space, max_width, flag)) return true;
+
+    if((flag & LV_TEXT_FLAG_EXPAND) || (flag & LV_TEXT_FLAG_FIT)) max_width = LV_COORD_MAX;
+
+    layout->valid = 0;
+    layout->line_cnt = 0;
+    layout->width = 0;
+
+    uint32_t line_start = 0;
+    while(1) {
+        /*Always keep a free slot for the end of the text*/
+        if(layout->line_cnt >= layout->line_cap) {
+            uint32_t new_cap = layout->line_cap ? layout->line_cap * 2 : 8;
+            uint32_t * new_start = lv_mem_realloc(layout->line_start, (new_cap + 1) * sizeof(uint32_t));
+            if(new_start == NULL) return false;
+            layout->line_start = new_start;
+
+            lv_coord_t * new_width = lv_mem_realloc(layout->line_width, new_cap * sizeof(lv_coord_t));
+            if(new_width == NULL) return false;
+            layout->line_width = new_width;
+
+            layout->line_cap = new_cap;
+        }
+
+        layout->line_start[layout->line_cnt] = line_start;
+        if(txt[line_start] == '\0') break;
+
+        uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_width, NULL, flag);
+        lv_coord_t line_w = lv_txt_get_width(&txt[line_start], line_end - line_start, font, letter_space, flag);
+        layout->line_width[layout->line_cnt] = line_w;
+        layout->width = LV_MAX(layout->width, line_w);
+        layout->line_cnt++;
+        line_start = line_end;
+    }
+
+    layout->txt = txt;
+    layout->font = font;
+    layout->letter_space = letter_space;
+    layout->max_width = max_width;
+    layout->flag = flag;
+    layout->valid = 1;
+
+    return true;
+}
+
+void _lv_txt_layout_get_size(const lv_txt_layout_t * layout, lv_coord_t line_space, lv_point_t * size_res)
+{
+    const char * txt = layout->txt;
+    int32_t letter_height = lv_font_get_line_height(layout->font);
+    int32_t line_cnt = layout->line_cnt;
+    uint32_t end = layout->line_start[layout->line_cnt];
+
+    /*Make the text one line taller if the last character is '\n' or '\r'*/
+    if(end != 0 && (txt[end - 1] == '\n' || txt[end - 1] == '\r')) line_cnt++;
+
+    /*Correction with the last line space or set the height manually if the text is empty*/
+    int32_t h = line_cnt * (letter_height + line_space);
+    if(h == 0) h = letter_height;
+    else h -= line_space;
+
+    size_res->x = layout->width;
+    size_res->y = LV_MIN(h, (int32_t)LV_MAX_OF(lv_coord_t));
+}
+
 bool _lv_txt_is_cmd(lv_text_cmd_state_t * state, uint32_t c)
 {
     bool ret = false;
@@ -65,6 +65,23 @@ enum {
 };
 typedef uint8_t lv_text_align_t;
 
+/**
+ * Cached line breaks and line widths of a text.
+ * It's recalculated only if the text or a parameter of the line breaking changes.*/
+typedef struct {
+    const char * txt;           /**< The text of the layout*/
+    const lv_font_t * font;     /**< Font used to break the lines*/
+    lv_coord_t max_width;       /**< Max width of the lines (LV_COORD_MAX if it doesn't matter due to `flag`)*/
+    lv_coord_t letter_space;    /**< Letter space used to break the lines*/
+    lv_coord_t width;           /**< Width of the longest line*/
+    lv_text_flag_t flag;        /**< Text flags used to break the lines*/
+    uint8_t valid : 1;          /**< 1: the other fields are up to date*/
+    uint32_t line_cnt;          /**< Number of lines*/
+    uint32_t line_cap;          /**< Number of lines `line_start` and `line_width` can store*/
+    uint32_t * line_start;      /**< Byte index of the start of each line, `line_start[line_cnt]` is the end of the text*/
+    lv_coord_t * line_width;    /**< Width of each line*/
+} lv_txt_layout_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -112,6 +129,59 @@ uint32_t _lv_txt_get_next_line(const char * txt, const lv_font_t * font, lv_coor
 lv_coord_t lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t * font, lv_coord_t letter_space,
                             lv_text_flag_t flag);
 
+/**
+ * Initialize a text layout cache
+ * @param layout pointer to a layout cache
+ */
+void _lv_txt_layout_init(lv_txt_layout_t * layout);
+
+/**
+ * Mark a text layout cache as outdated, e.g. because the text has been modified in place.
+ * @param layout pointer to a layout cache
+ */
+void _lv_txt_layout_invalidate(lv_txt_layout_t * layout);
+
+/**
+ * Free the memory allocated by a text layout cache
+ * @param layout pointer to a layout cache
+ */
+void _lv_txt_layout_free(lv_txt_layout_t * layout);
+
+/**
+ * Check if a layout cache was made with the given parameters
+ * @param layout pointer to a layout cache
+ * @param txt a '\0' terminated string
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param max_width max width of the lines
+ * @param flag settings for the text from ::lv_text_flag_t
+ * @return true: the layout can be used for the given parameters
+ */
+bool _lv_txt_layout_match(const lv_txt_layout_t * layout, const char * txt, const lv_font_t * font,
+                          lv_coord_t letter_space, lv_coord_t max_width, lv_text_flag_t flag);
+
+/**
+ * Make a layout cache up to date with the given parameters.
+ * The line breaks are calculated only if a parameter is different from the cached ones.
+ * @param layout pointer to a layout cache
+ * @param txt a '\0' terminated string
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param max_width max width of the lines
+ * @param flag settings for the text from ::lv_text_flag_t
+ * @return true: the layout is valid; false: out of memory, the layout can't be used
+ */
+bool _lv_txt_layout_update(lv_txt_layout_t * layout, const char * txt, const lv_font_t * font,
+                           lv_coord_t letter_space, lv_coord_t max_width, lv_text_flag_t flag);
+
+/**
+ * Get the size of the text of a valid layout cache. Same as `lv_txt_get_size()`.
+ * @param layout pointer to a valid layout cache
+ * @param line_space line space of the text
+ * @param size_res pointer to a 'point_t' variable to store the result
+ */
+void _lv_txt_layout_get_size(const lv_txt_layout_t * layout, lv_coord_t line_space, lv_point_t * size_res);
+
 /**
  * Check next character in a string and decide if the character is part of the command or not
  * @param state pointer to a txt_cmd_state_t variable which stores the current state of command
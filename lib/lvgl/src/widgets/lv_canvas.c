@@ -37,6 +37,7 @@ static void deinit_fake_disp(lv_obj_t * canvas, lv_disp_t * disp);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_canvas_class = {
+    .name = "lv_canvas",
     .constructor_cb = lv_canvas_constructor,
     .destructor_cb = lv_canvas_destructor,
     .instance_size = sizeof(lv_canvas_t),
@@ -60,6 +60,7 @@ static lv_obj_t * get_label(const lv_obj_t * obj);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_dropdown_class = {
+    .name = "lv_dropdown",
     .constructor_cb = lv_dropdown_constructor,
     .destructor_cb = lv_dropdown_destructor,
     .event_cb = lv_dropdown_event,
@@ -72,6 +73,7 @@ const lv_obj_class_t lv_dropdown_class = {
 };
 
 const lv_obj_class_t lv_dropdownlist_class = {
+    .name = "lv_dropdownlist",
     .constructor_cb = lv_dropdownlist_constructor,
     .destructor_cb = lv_dropdownlist_destructor,
     .event_cb = lv_dropdown_list_event,
@@ -926,12 +928,8 @@ static void draw_box(lv_obj_t * dropdown_obj, lv_draw_ctx_t * draw_ctx, uint16_t
 
     lv_dropdown_t * dropdown = (lv_dropdown_t *)dropdown_obj;
     lv_obj_t * list_obj = dropdown->list;
-    lv_state_t state_ori = list_obj->state;
 
-    if(state != list_obj->state) {
-        list_obj->state = state;
-        list_obj->skip_trans = 1;
-    }
+    if(state != list_obj->state) _lv_obj_style_set_draw_state(list_obj, state);
 
     /*Draw a rectangle under the selected item*/
     const lv_font_t * font    = lv_obj_get_style_text_font(list_obj, LV_PART_SELECTED);
@@ -954,8 +952,7 @@ static void draw_box(lv_obj_t * dropdown_obj, lv_draw_ctx_t * draw_ctx, uint16_t
     lv_obj_init_draw_rect_dsc(list_obj,  LV_PART_SELECTED, &sel_rect);
     lv_draw_rect(draw_ctx, &sel_rect, &rect_area);
 
-    list_obj->state = state_ori;
-    list_obj->skip_trans = 0;
+    _lv_obj_style_reset_draw_state();
 }
 
 static void draw_box_label(lv_obj_t * dropdown_obj, lv_draw_ctx_t * draw_ctx, uint16_t id, lv_state_t state)
@@ -964,12 +961,8 @@ static void draw_box_label(lv_obj_t * dropdown_obj, lv_draw_ctx_t * draw_ctx, ui
 
     lv_dropdown_t * dropdown = (lv_dropdown_t *)dropdown_obj;
     lv_obj_t * list_obj = dropdown->list;
-    lv_state_t state_orig = list_obj->state;
 
-    if(state != list_obj->state) {
-        list_obj->state = state;
-        list_obj->skip_trans = 1;
-    }
+    if(state != list_obj->state) _lv_obj_style_set_draw_state(list_obj, state);
 
     lv_draw_label_dsc_t label_dsc;
     lv_draw_label_dsc_init(&label_dsc);
@@ -977,6 +970,7 @@ static void draw_box_label(lv_obj_t * dropdown_obj, lv_draw_ctx_t * draw_ctx, ui
 
     label_dsc.line_space = lv_obj_get_style_text_line_space(list_obj,
                                                             LV_PART_SELECTED);  /*Line space should come from the list*/
+    _lv_obj_style_reset_draw_state();
 
     lv_obj_t * label = get_label(dropdown_obj);
     if(label == NULL) return;
@@ -1000,8 +994,6 @@ static void draw_box_label(lv_obj_t * dropdown_obj, lv_draw_ctx_t * draw_ctx, ui
         lv_draw_label(draw_ctx, &label_dsc, &label->coords, lv_label_get_text(label), NULL);
         draw_ctx->clip_area = clip_area_ori;
     }
-    list_obj->state = state_orig;
-    list_obj->skip_trans = 0;
 }
 
 
@@ -37,6 +37,7 @@ static void draw_img(lv_event_t * e);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_img_class = {
+    .name = "lv_img",
     .constructor_cb = lv_img_constructor,
     .destructor_cb = lv_img_destructor,
     .event_cb = lv_img_event,
@@ -188,6 +189,13 @@ void lv_img_set_angle(lv_obj_t * obj, int16_t angle)
     if(angle < 0 || angle >= 3600) angle = angle % 3600;
 
     lv_img_t * img = (lv_img_t *)obj;
+#if LV_IMG_TRANSFORM_CACHE_SIZE
+    /*Use only the cached angles*/
+    if(img->angle_step) {
+        if(angle < 0) angle += 3600;
+        angle = (((angle + img->angle_step / 2) / img->angle_step) * img->angle_step) % 3600;
+    }
+#endif
     if(angle == img->angle) return;
 
     lv_coord_t transf_zoom = lv_obj_get_style_transform_zoom(obj, LV_PART_MAIN);
@@ -254,6 +262,12 @@ void lv_img_set_pivot(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
 void lv_img_set_zoom(lv_obj_t * obj, uint16_t zoom)
 {
     lv_img_t * img = (lv_img_t *)obj;
+#if LV_IMG_TRANSFORM_CACHE_SIZE
+    /*Use only the cached zoom factors*/
+    if(img->angle_step && img->zoom_step) {
+        zoom = ((zoom + img->zoom_step / 2) / img->zoom_step) * img->zoom_step;
+    }
+#endif
     if(zoom == img->zoom) return;
 
     if(zoom == 0) zoom = 1;
@@ -304,6 +318,22 @@ void lv_img_set_size_mode(lv_obj_t * obj, lv_img_size_mode_t mode)
     lv_obj_invalidate(obj);
 }
 
+#if LV_IMG_TRANSFORM_CACHE_SIZE
+void lv_img_set_transform_cache(lv_obj_t * obj, uint16_t angle_step, uint16_t zoom_step)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_img_t * img = (lv_img_t *)obj;
+
+    img->angle_step = angle_step;
+    img->zoom_step = zoom_step;
+
+    /*Round the current transformation too*/
+    lv_img_set_angle(obj, img->angle);
+    lv_img_set_zoom(obj, img->zoom);
+    lv_obj_invalidate(obj);
+}
+#endif
+
 /*=====================
  * Getter functions
  *====================*/
@@ -625,15 +655,12 @@ static void draw_img(lv_event_t * e)
             bg_coords.y2 += obj->coords.y1;
         }
 
-        lv_area_t ori_coords;
-        lv_area_copy(&ori_coords, &obj->coords);
-        lv_area_copy(&obj->coords, &bg_coords);
-
+        /*Don't modify `obj->coords` because the other rendering threads might read it*/
+        _lv_obj_set_draw_coords(obj, &bg_coords);
         lv_res_t res = lv_obj_event_base(MY_CLASS, e);
+        _lv_obj_reset_draw_coords();
         if(res != LV_RES_OK) return;
 
-        lv_area_copy(&obj->coords, &ori_coords);
-
         if(code == LV_EVENT_DRAW_MAIN) {
             if(img->h == 0 || img->w == 0) return;
             if(zoom_final == 0) return;
@@ -682,6 +709,21 @@ static void draw_img(lv_event_t * e)
                 if(!_lv_area_intersect(&img_clip_area, draw_ctx->clip_area, &img_clip_area)) return;
                 draw_ctx->clip_area = &img_clip_area;
 
+#if LV_IMG_TRANSFORM_CACHE_SIZE
+                /*Draw the cached transformed variant as a plain image*/
+                const lv_img_dsc_t * variant = NULL;
+                lv_area_t variant_area;
+                lv_draw_img_dsc_t variant_dsc;
+                if(img->angle_step && (img_dsc.angle || img_dsc.zoom != LV_IMG_ZOOM_NONE)) {
+                    /*The variant stays in the cache until it's released, also if other rendering threads fill the cache*/
+                    variant = _lv_img_transform_cache_get(img->src, &img_dsc, &variant_area);
+                    variant_dsc = img_dsc;
+                    variant_dsc.angle = 0;
+                    variant_dsc.zoom = LV_IMG_ZOOM_NONE;
+                    variant_dsc.frame_id = 0;
+                }
+#endif
+
                 lv_area_t coords_tmp;
                 coords_tmp.y1 = img_max_area.y1 + img->offset.y;
                 if(coords_tmp.y1 > img_max_area.y1) coords_tmp.y1 -= img->h;
@@ -693,9 +735,21 @@ static void draw_img(lv_event_t * e)
                     coords_tmp.x2 = coords_tmp.x1 + img->w - 1;
 
                     for(; coords_tmp.x1 < img_max_area.x2; coords_tmp.x1 += img_size_final.x, coords_tmp.x2 += img_size_final.x) {
+#if LV_IMG_TRANSFORM_CACHE_SIZE
+                        if(variant) {
+                            lv_area_t variant_coords;
+                            lv_area_copy(&variant_coords, &variant_area);
+                            lv_area_move(&variant_coords, coords_tmp.x1, coords_tmp.y1);
+                            lv_draw_img(draw_ctx, &variant_dsc, &variant_coords, variant);
+                            continue;
+                        }
+#endif
                         lv_draw_img(draw_ctx, &img_dsc, &coords_tmp, img->src);
                     }
                 }
+#if LV_IMG_TRANSFORM_CACHE_SIZE
+                if(variant) _lv_img_transform_cache_release(variant);
+#endif
                 draw_ctx->clip_area = clip_area_ori;
             }
             else if(img->src_type == LV_IMG_SRC_SYMBOL) {
@@ -46,6 +46,10 @@ typedef struct {
     uint16_t angle;    /*rotation angle of the image*/
     lv_point_t pivot;     /*rotation center of the image*/
     uint16_t zoom;         /*256 means no zoom, 512 double size, 128 half size*/
+#if LV_IMG_TRANSFORM_CACHE_SIZE
+    uint16_t angle_step;   /*Round the angle to this and cache the transformed image. 0: no caching*/
+    uint16_t zoom_step;    /*Round the zoom to this if the transformed image is cached. 0: no rounding*/
+#endif
     uint8_t src_type : 2;  /*See: lv_img_src_t*/
     uint8_t cf : 5;        /*Color format from `lv_img_color_format_t`*/
     uint8_t antialias : 1; /*Apply anti-aliasing in transformations (rotate, zoom)*/
@@ -156,6 +160,20 @@ void lv_img_set_antialias(lv_obj_t * obj, bool antialias);
  * @param mode      the new size mode.
  */
 void lv_img_set_size_mode(lv_obj_t * obj, lv_img_size_mode_t mode);
+
+#if LV_IMG_TRANSFORM_CACHE_SIZE
+/**
+ * Cache the rotated and zoomed variants of the image and later draw them without transformation.
+ * Useful for small images rotated to a few angles again and again, e.g. the hands of a clock.
+ * The angle and zoom are rounded to the given steps to limit the number of variants.
+ * Only images with `LV_IMG_SRC_VARIABLE` source are cached.
+ * @param obj           pointer to an image object
+ * @param angle_step    round the angle to the multiple of this (0.1 degree unit, e.g. 60 for 6 degrees).
+ *                      0: disable the caching
+ * @param zoom_step     round the zoom to the multiple of this. 0: don't round the zoom
+ */
+void lv_img_set_transform_cache(lv_obj_t * obj, uint16_t angle_step, uint16_t zoom_step);
+#endif
 /*=====================
  * Getter functions
  *====================*/
@@ -17,6 +17,7 @@
 #include "../misc/lv_bidi.h"
 #include "../misc/lv_txt_ap.h"
 #include "../misc/lv_printf.h"
+#include "../misc/lv_thread.h"
 
 /*********************
  *      DEFINES
@@ -48,11 +49,16 @@ static char * lv_label_get_dot_tmp(lv_obj_t * label);
 static void lv_label_dot_tmp_free(lv_obj_t * label);
 static void set_ofs_x_anim(void * obj, int32_t v);
 static void set_ofs_y_anim(void * obj, int32_t v);
+static const lv_txt_layout_t * get_layout(const lv_obj_t * obj, const lv_font_t * font, lv_coord_t letter_space,
+                                          lv_coord_t max_w, lv_text_flag_t flag);
+static void get_txt_size(const lv_obj_t * obj, lv_point_t * size_res, const lv_font_t * font, lv_coord_t letter_space,
+                         lv_coord_t line_space, lv_coord_t max_w, lv_text_flag_t flag);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_label_class = {
+    .name = "lv_label",
     .constructor_cb = lv_label_constructor,
     .destructor_cb = lv_label_destructor,
     .event_cb = lv_label_event,
@@ -326,15 +332,29 @@ void lv_label_get_letter_pos(const lv_obj_t * obj, uint32_t char_id, lv_point_t
     if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
 
     uint32_t byte_id = _lv_txt_encoded_get_byte_id(txt, char_id);
+    const lv_txt_layout_t * layout = get_layout(obj, font, letter_space, max_w, flag);
 
     /*Search the line of the index letter*/;
-    while(txt[new_line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
-        if(byte_id < new_line_start || txt[new_line_start] == '\0')
-            break; /*The line of 'index' letter begins at 'line_start'*/
+    if(layout) {
+        uint32_t i;
+        for(i = 0; i < layout->line_cnt; i++) {
+            line_start = layout->line_start[i];
+            new_line_start = layout->line_start[i + 1];
+            if(byte_id < new_line_start || txt[new_line_start] == '\0')
+                break; /*The line of 'index' letter begins at 'line_start'*/
 
-        y += letter_height + line_space;
-        line_start = new_line_start;
+            y += letter_height + line_space;
+        }
+    }
+    else {
+        while(txt[new_line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
+            if(byte_id < new_line_start || txt[new_line_start] == '\0')
+                break; /*The line of 'index' letter begins at 'line_start'*/
+
+            y += letter_height + line_space;
+            line_start = new_line_start;
+        }
     }
 
     /*If the last character is line break then go to the next line*/
@@ -427,23 +447,44 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * obj, lv_point_t * pos_in)
     if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
 
     lv_text_align_t align = lv_obj_calculate_style_text_align(obj, LV_PART_MAIN, label->text);
+    const lv_txt_layout_t * layout = get_layout(obj, font, letter_space, max_w, flag);
 
     /*Search the line of the index letter*/;
-    while(txt[line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
+    bool found = false;
+    if(layout) {
+        uint32_t i;
+        for(i = 0; i < layout->line_cnt; i++) {
+            line_start = layout->line_start[i];
+            new_line_start = layout->line_start[i + 1];
+            if(pos.y <= y + letter_height) {
+                found = true;
+                break;
+            }
+            y += letter_height + line_space;
+        }
+        if(!found) line_start = new_line_start = layout->line_start[layout->line_cnt];
+    }
+    else {
+        while(txt[line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
 
-        if(pos.y <= y + letter_height) {
-            /*The line is found (stored in 'line_start')*/
-            /*Include the NULL terminator in the last line*/
-            uint32_t tmp = new_line_start;
-            uint32_t letter;
-            letter = _lv_txt_encoded_prev(txt, &tmp);
-            if(letter != '\n' && txt[new_line_start] == '\0') new_line_start++;
-            break;
+            if(pos.y <= y + letter_height) {
+                found = true;
+                break;
+            }
+            y += letter_height + line_space;
+
+            line_start = new_line_start;
         }
-        y += letter_height + line_space;
+    }
 
-        line_start = new_line_start;
+    if(found) {
+        /*The line is found (stored in 'line_start')*/
+        /*Include the NULL terminator in the last line*/
+        uint32_t tmp = new_line_start;
+        uint32_t letter;
+        letter = _lv_txt_encoded_prev(txt, &tmp);
+        if(letter != '\n' && txt[new_line_start] == '\0') new_line_start++;
     }
 
 #if LV_USE_BIDI
@@ -546,27 +587,46 @@ bool lv_label_is_char_under_pos(const lv_obj_t * obj, lv_point_t * pos)
     if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
     if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
 
+    const lv_txt_layout_t * layout = get_layout(obj, font, letter_space, max_w, flag);
+    lv_coord_t line_w = 0;
+
     /*Search the line of the index letter*/;
-    while(txt[line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
+    if(layout) {
+        uint32_t i;
+        for(i = 0; i < layout->line_cnt; i++) {
+            line_start = layout->line_start[i];
+            new_line_start = layout->line_start[i + 1];
+            line_w = layout->line_width[i];
+            if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
+            y += letter_height + line_space;
+        }
+        if(i == layout->line_cnt) {
+            line_start = new_line_start = layout->line_start[layout->line_cnt];
+            line_w = 0;
+        }
+    }
+    else {
+        while(txt[line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
 
-        if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
-        y += letter_height + line_space;
+            if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
+            y += letter_height + line_space;
 
-        line_start = new_line_start;
+            line_start = new_line_start;
+        }
+
+        if(align == LV_TEXT_ALIGN_CENTER || align == LV_TEXT_ALIGN_RIGHT) {
+            line_w = lv_txt_get_width(&txt[line_start], new_line_start - line_start, font, letter_space, flag);
+        }
     }
 
     /*Calculate the x coordinate*/
     lv_coord_t x      = 0;
     lv_coord_t last_x = 0;
     if(align == LV_TEXT_ALIGN_CENTER) {
-        lv_coord_t line_w;
-        line_w = lv_txt_get_width(&txt[line_start], new_line_start - line_start, font, letter_space, flag);
         x += lv_area_get_width(&txt_coords) / 2 - line_w / 2;
     }
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        lv_coord_t line_w;
-        line_w = lv_txt_get_width(&txt[line_start], new_line_start - line_start, font, letter_space, flag);
         x += lv_area_get_width(&txt_coords) - line_w;
     }
 
@@ -704,6 +764,11 @@ static void lv_label_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     label->hint.line_start = -1;
     label->hint.coord_y    = 0;
     label->hint.y          = 0;
+    label->hint.layout     = NULL;
+#endif
+
+#if LV_LABEL_LAYOUT_CACHE
+    _lv_txt_layout_init(&label->layout);
 #endif
 
 #if LV_LABEL_TEXT_SELECTION
@@ -729,6 +794,10 @@ static void lv_label_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_label_dot_tmp_free(obj);
     if(!label->static_txt) lv_mem_free(label->text);
     label->text = NULL;
+
+#if LV_LABEL_LAYOUT_CACHE
+    _lv_txt_layout_free(&label->layout);
+#endif
 }
 
 static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
@@ -776,7 +845,7 @@ static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
         if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) w = LV_COORD_MAX;
         else w = lv_obj_get_content_width(obj);
 
-        lv_txt_get_size(&size, label->text, font, letter_space, line_space, w, flag);
+        get_txt_size(obj, &size, font, letter_space, line_space, w, flag);
 
         lv_point_t * self_size = lv_event_get_param(e);
         self_size->x = LV_MAX(self_size->x, size.x);
@@ -824,8 +893,8 @@ static void draw_main(lv_event_t * e)
     if((label->long_mode == LV_LABEL_LONG_SCROLL || label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR) &&
        (label_draw_dsc.align == LV_TEXT_ALIGN_CENTER || label_draw_dsc.align == LV_TEXT_ALIGN_RIGHT)) {
         lv_point_t size;
-        lv_txt_get_size(&size, label->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
-                        LV_COORD_MAX, flag);
+        get_txt_size(obj, &size, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
+                     LV_COORD_MAX, flag);
         if(size.x > lv_area_get_width(&txt_coords)) {
             label_draw_dsc.align = LV_TEXT_ALIGN_LEFT;
         }
@@ -835,11 +904,27 @@ static void draw_main(lv_event_t * e)
     if(label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR || lv_area_get_height(&txt_coords) < LV_LABEL_HINT_HEIGHT_LIMIT)
         hint = NULL;
 
+    /*The draw updates the hint so it can't be shared by the rendering threads*/
+    if(_lv_render_is_parallel()) hint = NULL;
+
 #else
     /*Just for compatibility*/
     lv_draw_label_hint_t * hint = NULL;
 #endif
 
+#if LV_LABEL_LAYOUT_CACHE
+    /*Pass the cached line breaks to the draw in the hint*/
+    lv_draw_label_hint_t layout_hint;
+    if(hint == NULL) {
+        layout_hint.line_start = -1;
+        layout_hint.coord_y = 0;
+        layout_hint.y = 0;
+        hint = &layout_hint;
+    }
+    hint->layout = get_layout(obj, label_draw_dsc.font, label_draw_dsc.letter_space, lv_area_get_width(&txt_coords),
+                              flag);
+#endif
+
     lv_area_t txt_clip;
     bool is_common = _lv_area_intersect(&txt_clip, &txt_coords, draw_ctx->clip_area);
     if(!is_common) return;
@@ -864,8 +949,8 @@ static void draw_main(lv_event_t * e)
 
     if(label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR) {
         lv_point_t size;
-        lv_txt_get_size(&size, label->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
-                        LV_COORD_MAX, flag);
+        get_txt_size(obj, &size, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
+                     LV_COORD_MAX, flag);
 
         /*Draw the text again on label to the original to make a circular effect */
         if(size.x > lv_area_get_width(&txt_coords)) {
@@ -899,6 +984,9 @@ static void lv_label_refr_text(lv_obj_t * obj)
 #if LV_LABEL_LONG_TXT_HINT
     label->hint.line_start = -1; /*The hint is invalid if the text changes*/
 #endif
+#if LV_LABEL_LAYOUT_CACHE
+    _lv_txt_layout_invalidate(&label->layout); /*The text might be changed in place*/
+#endif
 
     lv_area_t txt_coords;
     lv_obj_get_content_coords(obj, &txt_coords);
@@ -914,7 +1002,9 @@ static void lv_label_refr_text(lv_obj_t * obj)
     if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
     if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
 
-    lv_txt_get_size(&size, label->text, font, letter_space, line_space, max_w, flag);
+    /*Break the lines with the parameters of the drawing so that the draw can reuse them*/
+    get_layout(obj, font, letter_space, max_w, flag);
+    get_txt_size(obj, &size, font, letter_space, line_space, max_w, flag);
 
     lv_obj_refresh_self_size(obj);
 
@@ -1158,6 +1248,9 @@ static void lv_label_refr_text(lv_obj_t * obj)
                 }
                 label->text[byte_id_ori + LV_LABEL_DOT_NUM] = '\0';
                 label->dot_end                              = letter_id + LV_LABEL_DOT_NUM;
+#if LV_LABEL_LAYOUT_CACHE
+                _lv_txt_layout_invalidate(&label->layout);
+#endif
             }
         }
     }
@@ -1189,6 +1282,10 @@ static void lv_label_revert_dots(lv_obj_t * obj)
     label->text[byte_i + i] = dot_tmp[i];
     lv_label_dot_tmp_free(obj);
 
+#if LV_LABEL_LAYOUT_CACHE
+    _lv_txt_layout_invalidate(&label->layout);
+#endif
+
     label->dot_end = LV_LABEL_DOT_END_INV;
 }
 
@@ -1271,4 +1368,52 @@ static void set_ofs_y_anim(void * obj, int32_t v)
 }
 
 
+/**
+ * Get the cached line breaks of the label's text. Break the lines again only if a parameter has changed.
+ * @param obj pointer to a label object
+ * @param font font of the text
+ * @param letter_space letter space of the text
+ * @param max_w max width of the lines
+ * @param flag settings of the text
+ * @return the layout or NULL if the cache is disabled or out of memory
+ */
+static const lv_txt_layout_t * get_layout(const lv_obj_t * obj, const lv_font_t * font, lv_coord_t letter_space,
+                                          lv_coord_t max_w, lv_text_flag_t flag)
+{
+#if LV_LABEL_LAYOUT_CACHE
+    /*The cache is not part of the label's logical state so it can be updated on a const label too*/
+    /*The rendering threads might draw the same label in different bands. Once updated, the layout is only read.*/
+    lv_label_t * label = (lv_label_t *)obj;
+    _lv_render_lock();
+    bool ok = _lv_txt_layout_update(&label->layout, label->text, font, letter_space, max_w, flag);
+    _lv_render_unlock();
+    return ok ? &label->layout : NULL;
+#else
+    LV_UNUSED(obj);
+    LV_UNUSED(font);
+    LV_UNUSED(letter_space);
+    LV_UNUSED(max_w);
+    LV_UNUSED(flag);
+    return NULL;
+#endif
+}
+
+/**
+ * Get the size of the label's text. Use the layout cache if it was made with the same parameters.
+ * Unlike `get_layout` it doesn't replace the cache to not thrash it with the parameters of the size queries.
+ */
+static void get_txt_size(const lv_obj_t * obj, lv_point_t * size_res, const lv_font_t * font, lv_coord_t letter_space,
+                         lv_coord_t line_space, lv_coord_t max_w, lv_text_flag_t flag)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+#if LV_LABEL_LAYOUT_CACHE
+    _lv_render_lock();
+    bool match = _lv_txt_layout_match(&label->layout, label->text, font, letter_space, max_w, flag);
+    if(match) _lv_txt_layout_get_size(&label->layout, line_space, size_res);
+    _lv_render_unlock();
+    if(match) return;
+#endif
+    lv_txt_get_size(size_res, label->text, font, letter_space, line_space, max_w, flag);
+}
+
 #endif
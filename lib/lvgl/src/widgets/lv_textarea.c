@@ -65,6 +65,7 @@ static inline bool is_valid_but_non_printable_char(const uint32_t letter);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_textarea_class = {
+    .name = "lv_textarea",
     .constructor_cb = lv_textarea_constructor,
     .destructor_cb = lv_textarea_destructor,
     .event_cb = lv_textarea_event,
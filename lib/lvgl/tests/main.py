@@ -22,6 +22,10 @@ build_only_options = {
 test_options = {
     'OPTIONS_TEST_SYSHEAP': 'Test config, system heap, 32 bit color depth',
     'OPTIONS_TEST_DEFHEAP': 'Test config, LVGL heap, 32 bit color depth',
+    'OPTIONS_TEST_16BIT': 'Test config, system heap, 16 bit color depth',
+    'OPTIONS_TEST_16BIT_SWAP': 'Test config, system heap, 16 bit color depth swapped',
+    'OPTIONS_BENCHMARK': 'Benchmark config, 128x128, 16 bit color depth',
+    'OPTIONS_BENCHMARK_SWAP': 'Benchmark config, 128x128, 16 bit color depth swapped',
 }
 
 
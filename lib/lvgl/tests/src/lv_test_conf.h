@@ -15,6 +15,7 @@ extern "C" {
 /*********************
  *      INCLUDES
  *********************/
+#include <stddef.h>
 
 /*********************
  *      DEFINES
@@ -27,8 +28,16 @@ extern "C" {
 uint32_t custom_tick_get(void);
 #define LV_TICK_CUSTOM_SYS_TIME_EXPR custom_tick_get()
 
+/*`lv_tick_get()` is not thread safe but the profiler is called by the rendering threads too*/
+uint32_t lv_test_get_time_us(void);
+#define LV_PROFILER_TIME_US_EXPR lv_test_get_time_us()
+
 typedef void * lv_user_data_t;
 
+/*Can be used as LV_MEM_CUSTOM_ALLOC and LV_MEM_CUSTOM_REALLOC to count the allocations*/
+void * lv_test_malloc(size_t size);
+void * lv_test_realloc(void * p, size_t new_size);
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
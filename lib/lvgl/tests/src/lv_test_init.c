@@ -19,6 +19,8 @@ lv_indev_t * lv_test_encoder_indev;
 lv_color_t test_fb[HOR_RES * VER_RES];
 static lv_color_t disp_buf1[HOR_RES * VER_RES];
 
+static uint32_t alloc_cnt;
+
 void lv_test_init(void)
 {
     lv_init();
@@ -73,6 +75,30 @@ static void dummy_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_
     lv_disp_flush_ready(disp_drv);
 }
 
+void * lv_test_malloc(size_t size)
+{
+    alloc_cnt++;
+    return malloc(size);
+}
+
+void * lv_test_realloc(void * p, size_t new_size)
+{
+    alloc_cnt++;
+    return realloc(p, new_size);
+}
+
+uint32_t lv_test_get_alloc_cnt(void)
+{
+    return alloc_cnt;
+}
+
+uint32_t lv_test_get_time_us(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint32_t)(tv.tv_sec * 1000000 + tv.tv_usec);
+}
+
 uint32_t custom_tick_get(void)
 {
     static uint64_t start_ms = 0;
@@ -12,6 +12,9 @@ extern "C" {
 void lv_test_init(void);
 void lv_test_deinit(void);
 
+/*Number of `LV_MEM_CUSTOM_ALLOC/REALLOC` calls if they are set to `lv_test_malloc/realloc`*/
+uint32_t lv_test_get_alloc_cnt(void);
+
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
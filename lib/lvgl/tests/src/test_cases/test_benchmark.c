@@ -0,0 +1,425 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../demos/lv_demos.h"
+
+#include "unity/unity.h"
+#include "lv_test_init.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#if LV_USE_DEMO_BENCHMARK
+
+/*The display of the T-QT with a partial draw buffer*/
+#define HOR_RES         128
+#define VER_RES         128
+#define BUF_LINES       10
+
+/*The tick is advanced only by the test so the flushed pixels and the allocations are repeatable*/
+#define FRAME_CNT       32
+#define FRAME_TIME      30      /*[ms]*/
+#define REPEAT_CNT      3       /*Render every scene more times and keep the fastest to reduce the noise*/
+
+#define SCENE_MAX       128
+#define SCENE_NAME_MAX  64
+
+/*The flushed pixels and the allocations are always compared to this file. The render time depends on the machine
+ *so it's compared only to a result of the same machine, set in the `LV_BENCHMARK_BASELINE` environment variable*/
+#if LV_COLOR_16_SWAP
+#define BASELINE_DEF    "src/test_files/benchmark_128x128_rgb565_swap.json"
+#else
+#define BASELINE_DEF    "src/test_files/benchmark_128x128_rgb565.json"
+#endif
+
+#define THRESHOLD_DEF   10      /*[%], can be changed in the `LV_BENCHMARK_THRESHOLD` environment variable*/
+#define TIME_SLACK_US   500     /*Ignore the noise of the very fast scenes*/
+
+/*The GIFs are decoded without drawing them. Every repeat opens the GIF and plays it this many times.*/
+#define GIF_LOOP_CNT    4
+
+/*The opaque fill and copy of the blend are measured on a canvas, without a display refresh.
+ *The width is odd to start every other row unaligned.*/
+#define BLEND_W         127
+#define BLEND_H         128
+#define BLEND_CNT       500
+
+typedef struct {
+    char name[SCENE_NAME_MAX];
+    uint32_t time_us;
+    uint32_t flushed_px;
+    uint32_t allocs;
+} scene_res_t;
+
+static lv_color_t buf[HOR_RES * BUF_LINES];
+#if LV_COLOR_16_SWAP == 0
+uint16_t spi_buf[HOR_RES * BUF_LINES];  /*Not static to keep the copy of the flush*/
+#endif
+static lv_color_t blend_buf[(BLEND_W + 1) * BLEND_H];
+static lv_color_t blend_src[BLEND_W * BLEND_H];
+static lv_disp_t * disp;
+static uint32_t flushed_px;
+static scene_res_t res[SCENE_MAX];
+static scene_res_t baseline[SCENE_MAX];
+
+extern const lv_img_dsc_t duck_gif;       /*The GIF of the factory demo*/
+extern const lv_img_dsc_t img_bulb_gif;
+
+static void flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static uint32_t benchmark_gifs(scene_res_t * r, uint32_t max);
+static void benchmark_gif(scene_res_t * r, const void * data, bool indexed);
+static uint32_t benchmark_blends(scene_res_t * r, uint32_t max);
+static uint32_t time_us(void);
+static void write_json(const char * path, const scene_res_t * scenes, uint32_t cnt);
+static uint32_t read_json(const char * path, scene_res_t * scenes, uint32_t max);
+static uint32_t check_regressions(uint32_t cnt, uint32_t base_cnt, bool check_time);
+static bool is_worse(uint32_t act, uint32_t base, uint32_t slack);
+
+void setUp(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, HOR_RES * BUF_LINES);
+
+    static lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.flush_cb = flush_cb;
+    disp_drv.hor_res = HOR_RES;
+    disp_drv.ver_res = VER_RES;
+    disp = lv_disp_drv_register(&disp_drv);
+    lv_disp_set_default(disp);
+}
+
+void tearDown(void)
+{
+    lv_disp_remove(disp);
+}
+
+void test_benchmark_scenes(void)
+{
+    uint32_t cnt = 0;
+    uint32_t time_sum = 0;
+    const char * name;
+    while(cnt < SCENE_MAX && (name = lv_demo_benchmark_load_scene(cnt)) != NULL) {
+        scene_res_t * r = &res[cnt];
+        snprintf(r->name, sizeof(r->name), "%s%s", name, cnt & 1 ? " + opa" : "");
+        r->time_us = UINT32_MAX;
+
+        uint32_t rep;
+        for(rep = 0; rep < REPEAT_CNT; rep++) {
+            if(rep > 0) lv_demo_benchmark_load_scene(cnt);
+
+            flushed_px = 0;
+            uint32_t alloc_start = lv_test_get_alloc_cnt();
+            uint32_t time = 0;
+            uint32_t i;
+            for(i = 0; i < FRAME_CNT; i++) {
+                /*The first frame renders the new scene*/
+                if(i > 0) lv_tick_inc(FRAME_TIME);
+
+                uint32_t t = time_us();
+                lv_refr_now(disp);
+                time += time_us() - t;
+            }
+            r->time_us = LV_MIN(r->time_us, time);
+            r->flushed_px = flushed_px;
+            r->allocs = lv_test_get_alloc_cnt() - alloc_start;
+        }
+
+        time_sum += r->time_us;
+        cnt++;
+    }
+
+    TEST_ASSERT_GREATER_THAN(0, cnt);
+
+    uint32_t gif_cnt = benchmark_gifs(&res[cnt], SCENE_MAX - cnt);
+    for(; gif_cnt > 0; gif_cnt--) time_sum += res[cnt++].time_us;
+
+    uint32_t blend_cnt = benchmark_blends(&res[cnt], SCENE_MAX - cnt);
+    for(; blend_cnt > 0; blend_cnt--) time_sum += res[cnt++].time_us;
+
+    write_json(LV_TEST_BENCHMARK_RESULT, res, cnt);
+    TEST_PRINTF("%"PRIu32" scenes in %"PRIu32" us, result: %s", cnt, time_sum, LV_TEST_BENCHMARK_RESULT);
+
+    const char * baseline_path = getenv("LV_BENCHMARK_BASELINE");
+    bool check_time = baseline_path != NULL;
+    if(baseline_path == NULL) baseline_path = BASELINE_DEF;
+
+    uint32_t base_cnt = read_json(baseline_path, baseline, SCENE_MAX);
+    if(base_cnt == 0) {
+        TEST_PRINTF("no baseline in %s", baseline_path);
+        return;
+    }
+
+    uint32_t regression_cnt = check_regressions(cnt, base_cnt, check_time);
+    TEST_ASSERT_EQUAL_MESSAGE(0, regression_cnt, "Some scenes are slower than the baseline");
+}
+
+/**
+ * Decode some GIFs like `lv_gif` does.
+ * @param r     store the results here
+ * @param max   the max number of results
+ * @return      the number of results
+ */
+static uint32_t benchmark_gifs(scene_res_t * r, uint32_t max)
+{
+    /*A bigger GIF with full frames, 12 bit LZW codes and local palettes*/
+    static uint8_t * plasma_data;
+    if(plasma_data == NULL) {
+        FILE * f = fopen("src/test_files/plasma_240x240.gif", "rb");
+        TEST_ASSERT_NOT_NULL(f);
+        fseek(f, 0, SEEK_END);
+        long size = ftell(f);
+        fseek(f, 0, SEEK_SET);
+        plasma_data = malloc(size);
+        TEST_ASSERT_NOT_NULL(plasma_data);
+        TEST_ASSERT_EQUAL(size, fread(plasma_data, 1, size, f));
+        fclose(f);
+    }
+
+    const struct {
+        const char * name;
+        const void * data;
+        bool indexed;
+    } gifs[] = {
+        {"gif duck 128x128", duck_gif.data, false},
+        {"gif bulb 60x80", img_bulb_gif.data, false},
+        {"gif plasma 240x240", plasma_data, false},
+        {"gif duck 128x128 indexed", duck_gif.data, true},
+    };
+
+    uint32_t cnt = 0;
+    uint32_t i;
+    for(i = 0; i < sizeof(gifs) / sizeof(gifs[0]) && cnt < max; i++) {
+        snprintf(r[cnt].name, sizeof(r[cnt].name), "%s", gifs[i].name);
+        benchmark_gif(&r[cnt], gifs[i].data, gifs[i].indexed);
+        cnt++;
+    }
+
+    return cnt;
+}
+
+static void benchmark_gif(scene_res_t * r, const void * data, bool indexed)
+{
+    r->time_us = UINT32_MAX;
+    r->flushed_px = 0;
+
+    uint32_t rep;
+    for(rep = 0; rep < REPEAT_CNT; rep++) {
+        uint32_t alloc_start = lv_test_get_alloc_cnt();
+        gd_GIF * gif = indexed ? gd_open_gif_data_indexed(data) : gd_open_gif_data(data);
+        TEST_ASSERT_NOT_NULL(gif);
+        uint32_t alloc_open = lv_test_get_alloc_cnt() - alloc_start;
+
+        uint32_t frame_cnt = 0;
+        uint32_t loop = 0;
+        uint32_t t = time_us();
+        while(loop < GIF_LOOP_CNT) {
+            int ret = gd_get_frame(gif);
+            TEST_ASSERT_NOT_EQUAL(-1, ret);
+            if(ret == 0) {
+                gd_rewind(gif);
+                loop++;
+                continue;
+            }
+            gd_render_frame(gif, gif->canvas);
+            frame_cnt++;
+        }
+        t = time_us() - t;
+
+        gd_close_gif(gif);
+
+        r->time_us = LV_MIN(r->time_us, t);
+        r->allocs = lv_test_get_alloc_cnt() - alloc_start;
+        if(rep == REPEAT_CNT - 1) {
+            TEST_PRINTF("%s: %"PRIu32" frames/s, %"PRIu32" allocs to open, %"PRIu32" allocs in %"PRIu32" frames",
+                        r->name, (uint32_t)((uint64_t)frame_cnt * 1000000 / LV_MAX(r->time_us, 1)), alloc_open,
+                        r->allocs - alloc_open, frame_cnt);
+        }
+    }
+}
+
+/**
+ * Fill and copy an area of a canvas many times, alternating between an aligned and an unaligned start.
+ * @param r     store the results here
+ * @param max   the max number of results
+ * @return      the number of results
+ */
+static uint32_t benchmark_blends(scene_res_t * r, uint32_t max)
+{
+    if(max < 2) return 0;
+
+    lv_obj_t * canvas = lv_canvas_create(lv_scr_act());
+    lv_canvas_set_buffer(canvas, blend_buf, BLEND_W + 1, BLEND_H, LV_IMG_CF_TRUE_COLOR);
+
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.bg_color = lv_color_hex(0xf0e0d0);
+
+    lv_img_dsc_t img;
+    lv_memset_00(&img, sizeof(img));
+    img.header.cf = LV_IMG_CF_TRUE_COLOR;
+    img.header.w = BLEND_W;
+    img.header.h = BLEND_H;
+    img.data_size = sizeof(blend_src);
+    img.data = (const uint8_t *)blend_src;
+
+    lv_draw_img_dsc_t img_dsc;
+    lv_draw_img_dsc_init(&img_dsc);
+
+    snprintf(r[0].name, sizeof(r[0].name), "blend fill %dx%d", BLEND_W, BLEND_H);
+    snprintf(r[1].name, sizeof(r[1].name), "blend copy %dx%d", BLEND_W, BLEND_H);
+    r[0].time_us = UINT32_MAX;
+    r[1].time_us = UINT32_MAX;
+    r[0].flushed_px = 0;
+    r[1].flushed_px = 0;
+
+    uint32_t rep;
+    for(rep = 0; rep < REPEAT_CNT; rep++) {
+        uint32_t alloc_start = lv_test_get_alloc_cnt();
+        uint32_t t = time_us();
+        uint32_t i;
+        for(i = 0; i < BLEND_CNT; i++) lv_canvas_draw_rect(canvas, i & 1, 0, BLEND_W, BLEND_H, &rect_dsc);
+        r[0].time_us = LV_MIN(r[0].time_us, time_us() - t);
+        r[0].allocs = lv_test_get_alloc_cnt() - alloc_start;
+
+        alloc_start = lv_test_get_alloc_cnt();
+        t = time_us();
+        for(i = 0; i < BLEND_CNT; i++) lv_canvas_draw_img(canvas, i & 1, 0, &img, &img_dsc);
+        r[1].time_us = LV_MIN(r[1].time_us, time_us() - t);
+        r[1].allocs = lv_test_get_alloc_cnt() - alloc_start;
+        lv_img_cache_invalidate_src(&img);
+    }
+
+    TEST_PRINTF("%s: %"PRIu32" us, %s: %"PRIu32" us for %d draws", r[0].name, r[0].time_us, r[1].name, r[1].time_us,
+                BLEND_CNT);
+
+    lv_obj_del(canvas);
+    return 2;
+}
+
+static void flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    uint32_t px_cnt = lv_area_get_size(area);
+
+#if LV_COLOR_16_SWAP == 0
+    /*The firmware swaps the bytes while sending them (`pushColors(..., swap = true)` of TFT_eSPI).
+     *Do the same to compare it fairly with the swapped rendering.*/
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) spi_buf[i] = (uint16_t)((color_p[i].full >> 8) | (color_p[i].full << 8));
+#else
+    LV_UNUSED(color_p);
+#endif
+
+    flushed_px += px_cnt;
+    lv_disp_flush_ready(disp_drv);
+}
+
+static uint32_t time_us(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint32_t)(tv.tv_sec * 1000000 + tv.tv_usec);
+}
+
+static void write_json(const char * path, const scene_res_t * scenes, uint32_t cnt)
+{
+    FILE * f = fopen(path, "w");
+    TEST_ASSERT_NOT_NULL(f);
+
+    fprintf(f, "{\n");
+    fprintf(f, "  \"hor_res\": %d,\n", HOR_RES);
+    fprintf(f, "  \"ver_res\": %d,\n", VER_RES);
+    fprintf(f, "  \"color_depth\": %d,\n", LV_COLOR_DEPTH);
+    fprintf(f, "  \"color_16_swap\": %d,\n", LV_COLOR_16_SWAP);
+    fprintf(f, "  \"buf_lines\": %d,\n", BUF_LINES);
+    fprintf(f, "  \"frames\": %d,\n", FRAME_CNT);
+    fprintf(f, "  \"scenes\": [\n");
+
+    /*Keep every scene in one line to read it back easily*/
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        fprintf(f, "    {\"name\": \"%s\", \"time_us\": %"PRIu32", \"flushed_px\": %"PRIu32", \"allocs\": %"PRIu32"}%s\n",
+                scenes[i].name, scenes[i].time_us, scenes[i].flushed_px, scenes[i].allocs, i + 1 < cnt ? "," : "");
+    }
+
+    fprintf(f, "  ]\n");
+    fprintf(f, "}\n");
+    fclose(f);
+}
+
+static uint32_t read_json(const char * path, scene_res_t * scenes, uint32_t max)
+{
+    FILE * f = fopen(path, "r");
+    if(f == NULL) return 0;
+
+    char line[256];
+    uint32_t cnt = 0;
+    while(cnt < max && fgets(line, sizeof(line), f)) {
+        char * name = strstr(line, "\"name\": \"");
+        if(name == NULL) continue;
+        name += strlen("\"name\": \"");
+
+        char * name_end = strchr(name, '"');
+        if(name_end == NULL) continue;
+        *name_end = '\0';
+
+        scene_res_t * s = &scenes[cnt];
+        if(sscanf(name_end + 1, ", \"time_us\": %"SCNu32", \"flushed_px\": %"SCNu32", \"allocs\": %"SCNu32,
+                  &s->time_us, &s->flushed_px, &s->allocs) != 3) continue;
+        snprintf(s->name, sizeof(s->name), "%s", name);
+        cnt++;
+    }
+
+    fclose(f);
+    return cnt;
+}
+
+static uint32_t check_regressions(uint32_t cnt, uint32_t base_cnt, bool check_time)
+{
+    uint32_t regression_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        const scene_res_t * r = &res[i];
+
+        /*New scenes have no baseline yet*/
+        const scene_res_t * b = NULL;
+        uint32_t j;
+        for(j = 0; j < base_cnt; j++) {
+            if(strcmp(baseline[j].name, r->name) == 0) {
+                b = &baseline[j];
+                break;
+            }
+        }
+        if(b == NULL) continue;
+
+        bool worse = false;
+        if(check_time && is_worse(r->time_us, b->time_us, TIME_SLACK_US)) worse = true;
+        if(is_worse(r->flushed_px, b->flushed_px, 0)) worse = true;
+        if(is_worse(r->allocs, b->allocs, 0)) worse = true;
+
+        if(worse) {
+            TEST_PRINTF("regression in \"%s\": %"PRIu32" us, %"PRIu32" px, %"PRIu32" allocs (baseline: %"PRIu32" us, %"PRIu32
+                        " px, %"PRIu32" allocs)", r->name, r->time_us, r->flushed_px, r->allocs,
+                        b->time_us, b->flushed_px, b->allocs);
+            regression_cnt++;
+        }
+    }
+
+    return regression_cnt;
+}
+
+static bool is_worse(uint32_t act, uint32_t base, uint32_t slack)
+{
+    uint32_t threshold = THRESHOLD_DEF;
+    const char * env = getenv("LV_BENCHMARK_THRESHOLD");
+    if(env) threshold = atoi(env);
+
+    return (uint64_t)act * 100 > (uint64_t)base * (100 + threshold) + (uint64_t)slack * 100;
+}
+
+#endif
+
+#endif
@@ -7,6 +7,22 @@
 #include "lv_test_helpers.h"
 #include "lv_test_indev.h"
 
+void setUp(void)
+{
+#if LV_USE_PARALLEL_RENDER
+    /*The rendering workers use the heap in a scheduling dependent order
+     *so render on one thread to compare the free memory exactly*/
+    lv_disp_get_default()->driver->parallel_render = 0;
+#endif
+}
+
+void tearDown(void)
+{
+#if LV_USE_PARALLEL_RENDER
+    lv_disp_get_default()->driver->parallel_render = 1;
+#endif
+}
+
 static void loop_through_stress_test(void)
 {
 #if LV_USE_DEMO_STRESS
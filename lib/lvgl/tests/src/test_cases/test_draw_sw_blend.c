@@ -0,0 +1,157 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+/*Odd width to have rows starting with different alignments*/
+#define CANVAS_W    37
+#define CANVAS_H    5
+#define SRC_H       3
+
+/*The canvas and the image are also shifted by 1 pixel to start them with every 32 bit alignment*/
+static lv_color_t canvas_mem[CANVAS_W * CANVAS_H + 1];
+static lv_color_t src_mem[CANVAS_W * SRC_H + 1];
+static lv_color_t ref_buf[CANVAS_W * CANVAS_H];
+
+static lv_obj_t * canvas;
+static lv_color_t * canvas_buf;
+static lv_color_t * src_buf;
+static lv_color_t bg_color;
+static lv_color_t fg_color;
+
+static void set_buf_ofs(uint32_t canvas_ofs, uint32_t src_ofs)
+{
+    canvas_buf = &canvas_mem[canvas_ofs];
+    src_buf = &src_mem[src_ofs];
+    lv_canvas_set_buffer(canvas, canvas_buf, CANVAS_W, CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+
+    uint32_t i;
+    for(i = 0; i < CANVAS_W * SRC_H; i++) {
+        src_buf[i] = lv_color_make((i * 7) & 0xff, (i * 3) & 0xff, 255 - (i & 0xff));
+    }
+}
+
+void setUp(void)
+{
+    canvas = lv_canvas_create(lv_scr_act());
+    bg_color = lv_color_hex(0x102030);
+    fg_color = lv_color_hex(0xf0e0d0);
+    set_buf_ofs(0, 0);
+}
+
+void tearDown(void)
+{
+    lv_obj_del(canvas);
+}
+
+static void clear_canvas(void)
+{
+    lv_coord_t i;
+    for(i = 0; i < CANVAS_W * CANVAS_H; i++) {
+        canvas_buf[i] = bg_color;
+        ref_buf[i] = bg_color;
+    }
+}
+
+/*The reference blend: set the pixels one by one as `lv_color_fill()` and `lv_memcpy()` did*/
+static void ref_fill(lv_coord_t x1, lv_coord_t y1, lv_coord_t w, lv_coord_t h)
+{
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = y1; y < y1 + h; y++) {
+        for(x = x1; x < x1 + w; x++) ref_buf[y * CANVAS_W + x] = fg_color;
+    }
+}
+
+static void ref_copy(lv_coord_t x1, lv_coord_t y1, lv_coord_t src_w)
+{
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = LV_MAX(y1, 0); y < LV_MIN(y1 + SRC_H, CANVAS_H); y++) {
+        for(x = LV_MAX(x1, 0); x < LV_MIN(x1 + src_w, CANVAS_W); x++) {
+            ref_buf[y * CANVAS_W + x] = src_buf[(y - y1) * src_w + (x - x1)];
+        }
+    }
+}
+
+/*Compare the raw pixels to see the byte order of `LV_COLOR_16_SWAP` too*/
+static void assert_ref(void)
+{
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, canvas_buf, sizeof(ref_buf));
+}
+
+static void init_img(lv_img_dsc_t * img, lv_coord_t w)
+{
+    lv_memset_00(img, sizeof(lv_img_dsc_t));
+    img->header.cf = LV_IMG_CF_TRUE_COLOR;
+    img->header.w = w;
+    img->header.h = SRC_H;
+    img->data_size = w * SRC_H * sizeof(lv_color_t);
+    img->data = (const uint8_t *)src_buf;
+}
+
+void test_draw_sw_blend_opaque_fill(void)
+{
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = fg_color;
+
+    uint32_t ofs;
+    for(ofs = 0; ofs < 2; ofs++) {
+        set_buf_ofs(ofs, 0);
+
+        /*Every start and length to cover the aligned and unaligned heads and tails*/
+        lv_coord_t x1;
+        lv_coord_t w;
+        for(x1 = 0; x1 < 4; x1++) {
+            for(w = 1; x1 + w <= CANVAS_W; w++) {
+                clear_canvas();
+                lv_canvas_draw_rect(canvas, x1, 1, w, SRC_H, &dsc);
+                ref_fill(x1, 1, w, SRC_H);
+                assert_ref();
+            }
+        }
+
+        /*Full width area which is filled in one step*/
+        clear_canvas();
+        lv_canvas_draw_rect(canvas, 0, 0, CANVAS_W, CANVAS_H, &dsc);
+        ref_fill(0, 0, CANVAS_W, CANVAS_H);
+        assert_ref();
+    }
+}
+
+void test_draw_sw_blend_opaque_copy(void)
+{
+    lv_draw_img_dsc_t dsc;
+    lv_draw_img_dsc_init(&dsc);
+
+    /*Odd source width, and the full canvas width which is copied in one step*/
+    static const lv_coord_t src_w_list[] = {21, CANVAS_W};
+
+    uint32_t ofs;
+    for(ofs = 0; ofs < 4; ofs++) {
+        set_buf_ofs(ofs & 1, ofs >> 1);
+
+        uint32_t i;
+        for(i = 0; i < sizeof(src_w_list) / sizeof(src_w_list[0]); i++) {
+            lv_coord_t src_w = src_w_list[i];
+            lv_img_dsc_t img;
+            init_img(&img, src_w);
+
+            /*Clipped on the left and right too, to start from every source alignment*/
+            lv_coord_t x1;
+            for(x1 = -4; x1 < CANVAS_W; x1++) {
+                lv_coord_t y1 = src_w == CANVAS_W ? 0 : 1;
+                if(src_w == CANVAS_W && x1 != 0) continue;
+
+                clear_canvas();
+                lv_canvas_draw_img(canvas, x1, y1, &img, &dsc);
+                lv_img_cache_invalidate_src(&img);
+                ref_copy(x1, y1, src_w);
+                assert_ref();
+            }
+        }
+    }
+}
+
+#endif
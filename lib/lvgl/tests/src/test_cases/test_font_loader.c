@@ -25,7 +25,11 @@
  **********************/
 
 static int compare_fonts(lv_font_t * f1, lv_font_t * f2);
+static void compare_glyphs(lv_font_t * f1, lv_font_t * f2);
 void test_font_loader(void);
+void test_font_loader_glyph_cache(void);
+void test_font_loader_compressed_bitmap_cache(void);
+void test_font_loader_lazy(void);
 
 /**********************
  *  STATIC VARIABLES
@@ -72,6 +76,107 @@ void test_font_loader(void)
     lv_font_free(font_3_bin);
 }
 
+void test_font_loader_glyph_cache(void)
+{
+    /*The loaded font has a glyph cache but `font_1` doesn't, so they should give the same result
+     *even when the same and the colliding letters are asked again*/
+    lv_font_t * font_1_bin = lv_font_load("A:src/test_fonts/font_1.fnt");
+    TEST_ASSERT_NOT_NULL(((lv_font_fmt_txt_dsc_t *)font_1_bin->dsc)->cache);
+
+    uint32_t pass;
+    for(pass = 0; pass < 3; pass++) {
+        uint32_t i;
+        for(i = 0; i < 512; i++) {
+            /*Jump around to hit the same cache slots with different letters*/
+            uint32_t letter = 0x20 + ((i * 37) & 0x1FF);
+            uint32_t letter_next = 0x20 + ((i * 53) & 0x7F);
+
+            lv_font_glyph_dsc_t g1;
+            lv_font_glyph_dsc_t g2;
+            bool found1 = lv_font_get_glyph_dsc(&font_1, &g1, letter, letter_next);
+            bool found2 = lv_font_get_glyph_dsc(font_1_bin, &g2, letter, letter_next);
+            TEST_ASSERT_EQUAL(found1, found2);
+            if(!found1) continue;
+
+            TEST_ASSERT_EQUAL_INT(g1.adv_w, g2.adv_w);
+            TEST_ASSERT_EQUAL_INT(g1.box_w, g2.box_w);
+            TEST_ASSERT_EQUAL_INT(g1.box_h, g2.box_h);
+            TEST_ASSERT_EQUAL_INT(g1.ofs_x, g2.ofs_x);
+            TEST_ASSERT_EQUAL_INT(g1.ofs_y, g2.ofs_y);
+        }
+    }
+
+    lv_font_free(font_1_bin);
+}
+
+void test_font_loader_compressed_bitmap_cache(void)
+{
+    /*`font_3` is compressed. Ask for more letters than the cache can hold to evict and decompress them again*/
+    lv_font_t * font_3_bin = lv_font_load("A:src/test_fonts/font_3.fnt");
+
+    uint32_t pass;
+    for(pass = 0; pass < 2; pass++) {
+        uint32_t letter;
+        for(letter = 0x21; letter < 0x7F; letter++) {
+            lv_font_glyph_dsc_t g;
+            TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(&font_3, &g, letter, 0));
+
+            const uint8_t * bmp1 = lv_font_get_glyph_bitmap(&font_3, letter);
+            const uint8_t * bmp2 = lv_font_get_glyph_bitmap(font_3_bin, letter);
+            TEST_ASSERT_NOT_NULL(bmp1);
+            TEST_ASSERT_NOT_NULL(bmp2);
+
+            /*Still cached so it's not decompressed again*/
+            TEST_ASSERT_EQUAL_PTR(bmp1, lv_font_get_glyph_bitmap(&font_3, letter));
+
+            uint8_t bpp = g.bpp == 3 ? 4 : g.bpp;
+            uint32_t size = (g.box_w * g.box_h * bpp + 7) >> 3;
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(bmp1, bmp2, size);
+        }
+    }
+
+    lv_font_free(font_3_bin);
+}
+
+void test_font_loader_lazy(void)
+{
+    /*Only the used glyphs are loaded*/
+    uint32_t live_ori = lv_mem_track_get_total()->live_size;
+    lv_font_t * font_1_bin = lv_font_load("A:src/test_fonts/font_1.fnt");
+    uint32_t bin_size = lv_mem_track_get_total()->live_size - live_ori;
+    lv_font_free(font_1_bin);
+
+    lv_font_t * font_1_lazy = lv_font_load_lazy("A:src/test_fonts/font_1.fnt", 2048);
+    TEST_ASSERT_NOT_NULL(font_1_lazy);
+    uint32_t lazy_size = lv_mem_track_get_total()->live_size - live_ori;
+    TEST_ASSERT_LESS_THAN(bin_size - 2000, lazy_size);
+
+    /*The glyphs are the same even if they are dropped from the small cache and loaded again*/
+    compare_glyphs(&font_1, font_1_lazy);
+    uint32_t used_size = lv_mem_track_get_total()->live_size - live_ori;
+    compare_glyphs(&font_1, font_1_lazy);
+    compare_glyphs(&font_1, font_1_lazy);
+
+    /*The cache doesn't grow*/
+    TEST_ASSERT_LESS_THAN(used_size + 512, lv_mem_track_get_total()->live_size - live_ori);
+    lv_font_free(font_1_lazy);
+    TEST_ASSERT_EQUAL(live_ori, lv_mem_track_get_total()->live_size);
+
+    /*Not byte aligned glyphs*/
+    lv_font_t * font_2_lazy = lv_font_load_lazy("B:src/test_fonts/font_2.fnt", 1024);
+    TEST_ASSERT_NOT_NULL(font_2_lazy);
+    compare_glyphs(&font_2, font_2_lazy);
+    lv_font_free(font_2_lazy);
+
+    /*Compressed glyphs*/
+    lv_font_t * font_3_lazy = lv_font_load_lazy("A:src/test_fonts/font_3.fnt", 1024);
+    TEST_ASSERT_NOT_NULL(font_3_lazy);
+    compare_glyphs(&font_3, font_3_lazy);
+    lv_font_free(font_3_lazy);
+
+    TEST_ASSERT_NULL(lv_font_load_lazy("A:src/test_fonts/font_1.fnt", 0));
+}
+
 static int compare_fonts(lv_font_t * f1, lv_font_t * f2)
 {
     TEST_ASSERT_NOT_NULL_MESSAGE(f1, "font not null");
@@ -216,5 +321,30 @@ static int compare_fonts(lv_font_t * f1, lv_font_t * f2)
  *   STATIC FUNCTIONS
  **********************/
 
+static void compare_glyphs(lv_font_t * f1, lv_font_t * f2)
+{
+    uint32_t letter;
+    for(letter = 0x21; letter < 0x7F; letter++) {
+        /*The next letter is used for kerning*/
+        lv_font_glyph_dsc_t g1;
+        lv_font_glyph_dsc_t g2;
+        bool found = lv_font_get_glyph_dsc(f1, &g1, letter, letter + 1);
+        TEST_ASSERT_EQUAL(found, lv_font_get_glyph_dsc(f2, &g2, letter, letter + 1));
+        if(!found) continue;
+
+        TEST_ASSERT_EQUAL_INT(g1.adv_w, g2.adv_w);
+        TEST_ASSERT_EQUAL_INT(g1.box_w, g2.box_w);
+        TEST_ASSERT_EQUAL_INT(g1.box_h, g2.box_h);
+        TEST_ASSERT_EQUAL_INT(g1.ofs_x, g2.ofs_x);
+        TEST_ASSERT_EQUAL_INT(g1.ofs_y, g2.ofs_y);
+
+        uint8_t bpp = g1.bpp == 3 ? 4 : g1.bpp;
+        uint32_t size = (g1.box_w * g1.box_h * bpp + 7) >> 3;
+        const uint8_t * bmp1 = lv_font_get_glyph_bitmap(f1, letter);
+        const uint8_t * bmp2 = lv_font_get_glyph_bitmap(f2, letter);
+        if(size) TEST_ASSERT_EQUAL_UINT8_ARRAY(bmp1, bmp2, size);
+    }
+}
+
 #endif // LV_BUILD_TEST
 
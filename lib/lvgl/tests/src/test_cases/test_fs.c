@@ -50,4 +50,126 @@ void test_read(void)
     lv_fs_close(&fb);
 }
 
+#if LV_USE_FS_READ_AHEAD && LV_USE_PARALLEL_RENDER
+
+#include <pthread.h>
+
+#define READ_SIZE   745     /*`read_exp` with the closing '\0'*/
+
+static lv_fs_res_t (*read_cb_ori)(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br);
+static pthread_t main_thread;
+static uint32_t bg_read_cnt;
+
+static lv_fs_res_t read_count_cb(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    if(!pthread_equal(pthread_self(), main_thread)) bg_read_cnt++;
+    return read_cb_ori(drv, file_p, buf, btr, br);
+}
+
+/*Count the reads of the 'A' driver done by the read ahead thread*/
+static void open_counted(lv_fs_file_t * f, lv_fs_read_ahead_t dir)
+{
+    lv_fs_drv_t * drv = lv_fs_get_drv('A');
+    if(drv->read_cb != read_count_cb) {
+        read_cb_ori = drv->read_cb;
+        drv->read_cb = read_count_cb;
+    }
+    main_thread = pthread_self();
+    bg_read_cnt = 0;
+
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(f, "A:src/test_files/readtest.txt", LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_set_read_ahead(f, dir));
+}
+
+static void assert_read(lv_fs_file_t * f, uint32_t pos, uint32_t len)
+{
+    uint8_t buf[64];
+    uint32_t br;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(f, pos, LV_FS_SEEK_SET));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(f, buf, len, &br));
+    TEST_ASSERT_EQUAL(LV_MIN(len, READ_SIZE - pos), br);
+    TEST_ASSERT_EQUAL_MEMORY(read_exp + pos, buf, br);
+}
+
+void test_read_ahead_forward(void)
+{
+    lv_fs_file_t f;
+    open_counted(&f, LV_FS_READ_AHEAD_FORWARD);
+
+    uint8_t buf[7];
+    uint32_t cnt = 0;
+    uint32_t br = 1;
+    while(br) {
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf, sizeof(buf), &br));
+        if(br) TEST_ASSERT_EQUAL_MEMORY(read_exp + cnt, buf, br);
+        cnt += br;
+    }
+    TEST_ASSERT_EQUAL(READ_SIZE, cnt);
+
+    /*All but the first cache buffer were prefetched*/
+    TEST_ASSERT_EQUAL(READ_SIZE / LV_FS_STDIO_CACHE_SIZE, bg_read_cnt);
+
+    lv_fs_close(&f);
+}
+
+void test_read_ahead_backward(void)
+{
+    lv_fs_file_t f;
+    open_counted(&f, LV_FS_READ_AHEAD_BACKWARD);
+
+    /*E.g. the rows of a BMP image from the bottom*/
+    int32_t pos;
+    for(pos = READ_SIZE - 13; pos >= 0; pos -= 13) {
+        assert_read(&f, pos, 13);
+    }
+    TEST_ASSERT_GREATER_THAN(5, bg_read_cnt);
+
+    lv_fs_close(&f);
+}
+
+void test_read_ahead_seek(void)
+{
+    lv_fs_file_t f;
+    open_counted(&f, LV_FS_READ_AHEAD_FORWARD);
+
+    /*Jump around while the next part is being prefetched*/
+    assert_read(&f, 0, 10);
+    assert_read(&f, 500, 20);
+    assert_read(&f, 105, 30);
+    assert_read(&f, 95, 60);
+    assert_read(&f, 3, 5);
+
+    uint32_t pos;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, (uint32_t) -5, LV_FS_SEEK_END));
+    lv_fs_tell(&f, &pos);
+    TEST_ASSERT_EQUAL(READ_SIZE - 5, pos);
+    assert_read(&f, pos, 5);
+
+    /*Stopping and closing waits for the pending read*/
+    assert_read(&f, 200, 10);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_set_read_ahead(&f, LV_FS_READ_AHEAD_NONE));
+    assert_read(&f, 300, 10);
+    assert_read(&f, 400, 10);
+    assert_read(&f, 50, 10);
+    lv_fs_close(&f);
+}
+
+void test_read_ahead_not_used(void)
+{
+    lv_fs_file_t f;
+    open_counted(&f, LV_FS_READ_AHEAD_NONE);
+    assert_read(&f, 0, 50);
+    assert_read(&f, 100, 50);
+    assert_read(&f, 600, 50);
+    TEST_ASSERT_EQUAL(0, bg_read_cnt);
+    lv_fs_close(&f);
+
+    /*Only the drivers with cache can read ahead*/
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "B:src/test_files/readtest.txt", LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_NOT_IMP, lv_fs_set_read_ahead(&f, LV_FS_READ_AHEAD_FORWARD));
+    lv_fs_close(&f);
+}
+
+#endif
+
 #endif
@@ -0,0 +1,221 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_FS_MMAP
+
+#include <stdio.h>
+
+#define BIN_PATH    "/tmp/lv_test_fs_mmap.bin"
+#define BIN_W       7
+#define BIN_H       5
+
+extern lv_font_t font_1;
+extern lv_font_t font_2;
+extern lv_font_t font_3;
+
+static uint32_t read_all(const char * path, char * buf, uint32_t buf_size);
+static void write_bin(void);
+static void assert_same_bitmaps(lv_font_t * f1, lv_font_t * f2);
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_fs_mmap_read(void)
+{
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "M:src/test_files/readtest.txt", LV_FS_MODE_RD));
+
+    const void * ptr;
+    uint32_t size;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_map(&f, &ptr, &size));
+
+    static char exp[1024];
+    TEST_ASSERT_EQUAL(read_all("B:src/test_files/readtest.txt", exp, sizeof(exp)), size);
+    TEST_ASSERT_EQUAL_MEMORY(exp, ptr, size);
+
+    /*The usual read functions work too*/
+    char buf[16];
+    uint32_t br;
+    uint32_t pos;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, 6, LV_FS_SEEK_SET));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf, 5, &br));
+    TEST_ASSERT_EQUAL(5, br);
+    TEST_ASSERT_EQUAL_MEMORY("ipsum", buf, 5);
+    lv_fs_tell(&f, &pos);
+    TEST_ASSERT_EQUAL(11, pos);
+
+    /*Read only the rest at the end of the file*/
+    lv_fs_seek(&f, 0, LV_FS_SEEK_END);
+    lv_fs_tell(&f, &pos);
+    TEST_ASSERT_EQUAL(size, pos);
+    lv_fs_seek(&f, (uint32_t) -3, LV_FS_SEEK_CUR);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf, sizeof(buf), &br));
+    TEST_ASSERT_EQUAL(3, br);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf, sizeof(buf), &br));
+    TEST_ASSERT_EQUAL(0, br);
+
+    lv_fs_close(&f);
+
+    /*Writing is not supported*/
+    TEST_ASSERT_NOT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "M:src/test_files/readtest.txt", LV_FS_MODE_WR));
+    TEST_ASSERT_NOT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "M:src/test_files/not_exists.txt", LV_FS_MODE_RD));
+}
+
+void test_fs_mmap_not_supported(void)
+{
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "B:src/test_files/readtest.txt", LV_FS_MODE_RD));
+
+    const void * ptr = &f;
+    uint32_t size = 1;
+    TEST_ASSERT_EQUAL(LV_FS_RES_NOT_IMP, lv_fs_map(&f, &ptr, &size));
+    TEST_ASSERT_NULL(ptr);
+    TEST_ASSERT_EQUAL(0, size);
+
+    lv_fs_close(&f);
+}
+
+void test_fs_mmap_img_decoder(void)
+{
+    write_bin();
+
+    /*The pixels are used directly from the mapped file*/
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, "M:" BIN_PATH, lv_color_black(), 0));
+    TEST_ASSERT_NOT_NULL(dsc.img_data);
+    uint32_t i;
+    for(i = 0; i < BIN_W * BIN_H * LV_IMG_PX_SIZE_ALPHA_BYTE; i++) {
+        TEST_ASSERT_EQUAL_HEX8(i & 0xff, dsc.img_data[i]);
+    }
+    lv_img_decoder_close(&dsc);
+
+    /*It's read line by line from the other drivers*/
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, "B:" BIN_PATH, lv_color_black(), 0));
+    TEST_ASSERT_NULL(dsc.img_data);
+    lv_img_decoder_close(&dsc);
+
+    remove(BIN_PATH);
+}
+
+void test_fs_mmap_gif(void)
+{
+    gd_GIF * g1 = gd_open_gif_file("A:src/test_files/plasma_240x240.gif");
+    gd_GIF * g2 = gd_open_gif_file("M:src/test_files/plasma_240x240.gif");
+    TEST_ASSERT_NOT_NULL(g1);
+    TEST_ASSERT_NOT_NULL(g2);
+
+    /*The mapped file is read like a C array*/
+    TEST_ASSERT_TRUE(g1->is_file);
+    TEST_ASSERT_FALSE(g2->is_file);
+
+    uint32_t frame_cnt = 0;
+    while(gd_get_frame(g1) == 1) {
+        TEST_ASSERT_EQUAL(1, gd_get_frame(g2));
+        gd_render_frame(g1, g1->canvas);
+        gd_render_frame(g2, g2->canvas);
+        TEST_ASSERT_EQUAL_MEMORY(g1->canvas, g2->canvas, g1->width * g1->height * 4);
+        frame_cnt++;
+    }
+    TEST_ASSERT_EQUAL(0, gd_get_frame(g2));
+    TEST_ASSERT_EQUAL(8, frame_cnt);
+
+    gd_close_gif(g1);
+    gd_close_gif(g2);
+}
+
+void test_fs_mmap_font(void)
+{
+    /*Same as `font_2.fnt` but the glyph headers are 32 bit so the bitmaps are byte aligned*/
+    uint32_t live_ori = lv_mem_track_get_total()->live_size;
+    lv_font_t * font_b = lv_font_load("B:src/test_fonts/font_2_aligned.fnt");
+    uint32_t b_size = lv_mem_track_get_total()->live_size - live_ori;
+    lv_font_t * font_m = lv_font_load("M:src/test_fonts/font_2_aligned.fnt");
+    uint32_t m_size = lv_mem_track_get_total()->live_size - live_ori - b_size;
+
+    /*The glyph bitmaps are not copied to the RAM*/
+    TEST_ASSERT_NOT_NULL(font_b);
+    TEST_ASSERT_NOT_NULL(font_m);
+    TEST_ASSERT_LESS_THAN(b_size - 2000, m_size);
+    assert_same_bitmaps(&font_2, font_b);
+    assert_same_bitmaps(&font_2, font_m);
+
+    lv_font_free(font_b);
+    lv_font_free(font_m);
+    TEST_ASSERT_EQUAL(live_ori, lv_mem_track_get_total()->live_size);
+
+    /*The not byte aligned bitmaps are still copied*/
+    font_m = lv_font_load("M:src/test_fonts/font_1.fnt");
+    assert_same_bitmaps(&font_1, font_m);
+    lv_font_free(font_m);
+
+    font_m = lv_font_load("M:src/test_fonts/font_3.fnt");
+    assert_same_bitmaps(&font_3, font_m);
+    lv_font_free(font_m);
+}
+
+static uint32_t read_all(const char * path, char * buf, uint32_t buf_size)
+{
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_RD));
+    uint32_t br;
+    lv_fs_read(&f, buf, buf_size, &br);
+    lv_fs_close(&f);
+    TEST_ASSERT_LESS_THAN(buf_size, br);
+    return br;
+}
+
+/*A 7x5 true color image with alpha whose bytes are 0, 1, 2...*/
+static void write_bin(void)
+{
+    lv_img_header_t header;
+    lv_memset_00(&header, sizeof(header));
+    header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    header.w = BIN_W;
+    header.h = BIN_H;
+
+    FILE * f = fopen(BIN_PATH, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    fwrite(&header, sizeof(header), 1, f);
+    uint32_t i;
+    for(i = 0; i < BIN_W * BIN_H * LV_IMG_PX_SIZE_ALPHA_BYTE; i++) fputc(i & 0xff, f);
+    fclose(f);
+}
+
+static void assert_same_bitmaps(lv_font_t * f1, lv_font_t * f2)
+{
+    TEST_ASSERT_NOT_NULL(f2);
+
+    uint32_t letter;
+    for(letter = 0x21; letter < 0x7F; letter++) {
+        lv_font_glyph_dsc_t g1;
+        lv_font_glyph_dsc_t g2;
+        bool found = lv_font_get_glyph_dsc(f1, &g1, letter, 0);
+        TEST_ASSERT_EQUAL(found, lv_font_get_glyph_dsc(f2, &g2, letter, 0));
+        if(!found) continue;
+
+        TEST_ASSERT_EQUAL(g1.adv_w, g2.adv_w);
+        TEST_ASSERT_EQUAL(g1.box_w, g2.box_w);
+        TEST_ASSERT_EQUAL(g1.box_h, g2.box_h);
+        TEST_ASSERT_EQUAL(g1.ofs_x, g2.ofs_x);
+        TEST_ASSERT_EQUAL(g1.ofs_y, g2.ofs_y);
+
+        uint8_t bpp = g1.bpp == 3 ? 4 : g1.bpp;
+        uint32_t size = (g1.box_w * g1.box_h * bpp + 7) >> 3;
+        const uint8_t * bmp1 = lv_font_get_glyph_bitmap(f1, letter);
+        const uint8_t * bmp2 = lv_font_get_glyph_bitmap(f2, letter);
+        if(size) TEST_ASSERT_EQUAL_UINT8_ARRAY(bmp1, bmp2, size);
+    }
+}
+
+#endif
+
+#endif
@@ -0,0 +1,316 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_GIF
+
+#define HOR_RES     800
+#define VER_RES     480
+
+/*The flushed areas are copied to their place because only the changed areas are refreshed*/
+static lv_color_t fb[HOR_RES * VER_RES];
+static void (*flush_cb_ori)(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+
+/*8x8 GIF with 3 frames: a black background,
+ *a red pixel at (2;2) restored to the background later (disposal 2),
+ *a green and a blue pixel at (5;5) and (6;5)*/
+static const uint8_t small_gif_data[] = {
+    0x47, 0x49, 0x46, 0x38, 0x39, 0x61, 0x08, 0x00, 0x08, 0x00, 0x81, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00,
+    0xff, 0x21, 0xff, 0x0b, 0x4e, 0x45, 0x54, 0x53, 0x43, 0x41, 0x50, 0x45,
+    0x32, 0x2e, 0x30, 0x03, 0x01, 0x00, 0x00, 0x00, 0x21, 0xf9, 0x04, 0x04,
+    0x0a, 0x00, 0x00, 0x00, 0x2c, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x08,
+    0x00, 0x00, 0x08, 0x0f, 0x00, 0x01, 0x08, 0x1c, 0x48, 0xb0, 0xa0, 0xc1,
+    0x83, 0x08, 0x13, 0x2a, 0x4c, 0x18, 0x10, 0x00, 0x21, 0xf9, 0x04, 0x08,
+    0x0a, 0x00, 0x00, 0x00, 0x2c, 0x02, 0x00, 0x02, 0x00, 0x01, 0x00, 0x01,
+    0x00, 0x00, 0x08, 0x04, 0x00, 0x03, 0x04, 0x04, 0x00, 0x21, 0xf9, 0x04,
+    0x04, 0x0a, 0x00, 0x00, 0x00, 0x2c, 0x05, 0x00, 0x05, 0x00, 0x02, 0x00,
+    0x01, 0x00, 0x00, 0x08, 0x05, 0x00, 0x05, 0x0c, 0x08, 0x08, 0x00, 0x3b
+};
+
+static const lv_img_dsc_t small_gif = {
+    .header.cf = LV_IMG_CF_RAW,
+    .data_size = sizeof(small_gif_data),
+    .data = small_gif_data,
+};
+
+extern const lv_img_dsc_t img_bulb_gif;
+
+static lv_obj_t * gif;
+
+static void flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static uint32_t hash(const uint8_t * buf, uint32_t len);
+static void next_frame(void);
+static void assert_inv_area(lv_coord_t x1, lv_coord_t y1, lv_coord_t x2, lv_coord_t y2);
+static void assert_same_as_full_redraw(void);
+static void assert_same_as_true_color(const void * data, uint32_t frame_cnt);
+
+void setUp(void)
+{
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    flush_cb_ori = drv->flush_cb;
+    drv->flush_cb = flush_cb;
+
+    gif = lv_gif_create(lv_scr_act());
+    lv_obj_set_pos(gif, 100, 50);
+}
+
+void tearDown(void)
+{
+    lv_disp_get_default()->driver->flush_cb = flush_cb_ori;
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_gif_invalidate_frame_area(void)
+{
+    lv_gif_set_src(gif, &small_gif);
+    lv_refr_now(NULL);
+
+    /*Only the new pixel*/
+    next_frame();
+    assert_inv_area(102, 52, 102, 52);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_HEX32(lv_color_hex(0xff0000).full, fb[52 * HOR_RES + 102].full);
+
+    /*The disposed red pixel and the new pixels*/
+    next_frame();
+    assert_inv_area(102, 52, 106, 55);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_HEX32(lv_color_hex(0x000000).full, fb[52 * HOR_RES + 102].full);
+    TEST_ASSERT_EQUAL_HEX32(lv_color_hex(0x00ff00).full, fb[55 * HOR_RES + 105].full);
+    TEST_ASSERT_EQUAL_HEX32(lv_color_hex(0x0000ff).full, fb[55 * HOR_RES + 106].full);
+
+    assert_same_as_full_redraw();
+}
+
+void test_gif_invalidate_transformed(void)
+{
+    lv_gif_set_src(gif, &small_gif);
+    lv_img_set_zoom(gif, 512);
+    lv_refr_now(NULL);
+
+    /*The whole object is invalidated because the frame area can't be mapped simply*/
+    next_frame();
+    TEST_ASSERT_EQUAL(1, lv_disp_get_default()->inv_p);
+    lv_area_t coords;
+    lv_obj_get_coords(gif, &coords);
+    TEST_ASSERT_TRUE(_lv_area_is_in(&coords, &lv_disp_get_default()->inv_areas[0], 0));
+}
+
+void test_gif_partial_redraws(void)
+{
+    lv_gif_set_src(gif, &img_bulb_gif);
+    lv_refr_now(NULL);
+
+    /*Play it more than once with only the frame areas redrawn*/
+    uint32_t i;
+    for(i = 0; i < 250; i++) {
+        next_frame();
+        lv_refr_now(NULL);
+    }
+
+    assert_same_as_full_redraw();
+}
+
+void test_gif_decode_file(void)
+{
+    /*The hashes of the frames decoded by an other decoder. The frames use the full 12 bit LZW codes and local palettes.*/
+    static const uint32_t frame_hashes[] = {
+        0x177782cc, 0x0090ab59, 0xcabd4d80, 0x5d0fd9f6, 0x8b8241cd, 0x221261cb, 0x542970a5, 0xbe53f110
+    };
+
+    gd_GIF * g = gd_open_gif_file("A:src/test_files/plasma_240x240.gif");
+    TEST_ASSERT_NOT_NULL(g);
+
+    /*Play it twice to use the LZW table of the previous frames*/
+    uint32_t i;
+    for(i = 0; i < 2 * sizeof(frame_hashes) / sizeof(frame_hashes[0]); i++) {
+        if(i == sizeof(frame_hashes) / sizeof(frame_hashes[0])) {
+            TEST_ASSERT_EQUAL(0, gd_get_frame(g));
+            gd_rewind(g);
+        }
+        TEST_ASSERT_EQUAL(1, gd_get_frame(g));
+        gd_render_frame(g, g->canvas);
+        TEST_ASSERT_EQUAL_HEX32(frame_hashes[i % 8], hash(g->canvas, g->width * g->height * 4));
+    }
+
+    gd_close_gif(g);
+}
+
+void test_gif_indexed(void)
+{
+    lv_gif_set_indexed(gif, true);
+    lv_gif_set_src(gif, &img_bulb_gif);
+    TEST_ASSERT_TRUE(lv_gif_is_indexed(gif));
+    TEST_ASSERT_EQUAL(LV_IMG_CF_INDEXED_8BIT, ((lv_gif_t *)gif)->imgdsc.header.cf);
+    lv_refr_now(NULL);
+
+    uint32_t i;
+    for(i = 0; i < 100; i++) {
+        next_frame();
+        lv_refr_now(NULL);
+    }
+    assert_same_as_full_redraw();
+
+    /*The same frame drawn from a true color canvas*/
+    lv_area_t coords;
+    lv_obj_get_coords(gif, &coords);
+    static lv_color_t ref[60 * 80];
+    lv_coord_t y;
+    for(y = coords.y1; y <= coords.y2; y++) {
+        lv_memcpy(&ref[(y - coords.y1) * 60], &fb[y * HOR_RES + coords.x1], 60 * sizeof(lv_color_t));
+    }
+
+    lv_gif_set_indexed(gif, false);
+    lv_gif_set_src(gif, &img_bulb_gif);
+    TEST_ASSERT_FALSE(lv_gif_is_indexed(gif));
+    for(i = 0; i < 100; i++) next_frame();
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    for(y = coords.y1; y <= coords.y2; y++) {
+        TEST_ASSERT_EQUAL_MEMORY(&ref[(y - coords.y1) * 60], &fb[y * HOR_RES + coords.x1], 60 * sizeof(lv_color_t));
+    }
+}
+
+void test_gif_indexed_frames(void)
+{
+    assert_same_as_true_color(img_bulb_gif.data, 120);
+    assert_same_as_true_color(small_gif_data, 3);
+
+    /*Restore the red pixel to a transparent background. It needs a transparent palette entry.*/
+    static uint8_t transp_gif_data[sizeof(small_gif_data)];
+    lv_memcpy(transp_gif_data, small_gif_data, sizeof(small_gif_data));
+    transp_gif_data[83] = 0x09;
+    assert_same_as_true_color(transp_gif_data, 3);
+
+    gd_GIF * g = gd_open_gif_data_indexed(transp_gif_data);
+    uint32_t i;
+    for(i = 0; i < 3; i++) gd_get_frame(g);
+    const lv_color32_t * palette = (const lv_color32_t *)g->canvas;
+    TEST_ASSERT_EQUAL(0, palette[g->frame[2 * 8 + 2]].ch.alpha);
+    TEST_ASSERT_EQUAL(0xff, palette[g->frame[0]].ch.alpha);
+    gd_close_gif(g);
+}
+
+void test_gif_indexed_fallback(void)
+{
+    /*It has local palettes so it's decoded to a true color canvas*/
+    lv_gif_set_indexed(gif, true);
+    lv_gif_set_src(gif, "A:src/test_files/plasma_240x240.gif");
+    TEST_ASSERT_FALSE(lv_gif_is_indexed(gif));
+    TEST_ASSERT_EQUAL(LV_IMG_CF_TRUE_COLOR_ALPHA, ((lv_gif_t *)gif)->imgdsc.header.cf);
+    TEST_ASSERT_NULL(gd_open_gif_file_indexed("A:src/test_files/plasma_240x240.gif"));
+}
+
+static void flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(&fb[y * HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+
+    lv_disp_flush_ready(disp_drv);
+}
+
+static uint32_t hash(const uint8_t * buf, uint32_t len)
+{
+    /*FNV-1a*/
+    uint32_t h = 0x811c9dc5;
+    uint32_t i;
+    for(i = 0; i < len; i++) {
+        h ^= buf[i];
+        h *= 0x01000193;
+    }
+    return h;
+}
+
+/**
+ * Let the GIF read its next frame but don't refresh the display.
+ */
+static void next_frame(void)
+{
+    lv_gif_t * gifobj = (lv_gif_t *) gif;
+    lv_tick_inc(gifobj->gif->gce.delay * 10);
+    gifobj->timer->timer_cb(gifobj->timer);
+}
+
+static void assert_inv_area(lv_coord_t x1, lv_coord_t y1, lv_coord_t x2, lv_coord_t y2)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    TEST_ASSERT_EQUAL(1, disp->inv_p);
+    TEST_ASSERT_EQUAL(x1, disp->inv_areas[0].x1);
+    TEST_ASSERT_EQUAL(y1, disp->inv_areas[0].y1);
+    TEST_ASSERT_EQUAL(x2, disp->inv_areas[0].x2);
+    TEST_ASSERT_EQUAL(y2, disp->inv_areas[0].y2);
+}
+
+static void assert_same_as_full_redraw(void)
+{
+    lv_area_t coords;
+    lv_obj_get_coords(gif, &coords);
+
+    static lv_color_t ref[200 * 200];
+    lv_coord_t w = lv_area_get_width(&coords);
+    lv_coord_t h = lv_area_get_height(&coords);
+    TEST_ASSERT_LESS_OR_EQUAL(200 * 200, w * h);
+
+    lv_coord_t y;
+    for(y = 0; y < h; y++) {
+        lv_memcpy(&ref[y * w], &fb[(coords.y1 + y) * HOR_RES + coords.x1], w * sizeof(lv_color_t));
+    }
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    for(y = 0; y < h; y++) {
+        TEST_ASSERT_EQUAL_MEMORY(&ref[y * w], &fb[(coords.y1 + y) * HOR_RES + coords.x1], w * sizeof(lv_color_t));
+    }
+}
+
+/**
+ * Decode a GIF into an indexed and a true color canvas and compare all the frames.
+ */
+static void assert_same_as_true_color(const void * data, uint32_t frame_cnt)
+{
+    gd_GIF * ref = gd_open_gif_data(data);
+    gd_GIF * g = gd_open_gif_data_indexed(data);
+    TEST_ASSERT_NOT_NULL(ref);
+    TEST_ASSERT_NOT_NULL(g);
+    TEST_ASSERT_TRUE(g->indexed);
+
+    const lv_color32_t * palette = (const lv_color32_t *)g->canvas;
+    uint32_t px_cnt = g->width * g->height;
+    uint32_t i;
+    for(i = 0; i < frame_cnt; i++) {
+        int res = gd_get_frame(ref);
+        TEST_ASSERT_EQUAL(res, gd_get_frame(g));
+        if(res == 0) {
+            gd_rewind(ref);
+            gd_rewind(g);
+            continue;
+        }
+        gd_render_frame(ref, ref->canvas);
+        gd_render_frame(g, g->canvas);
+
+        uint32_t p;
+        for(p = 0; p < px_cnt; p++) {
+            const lv_color32_t * c = &palette[g->frame[p]];
+            const uint8_t * ref_c = &ref->canvas[p * 4];
+            TEST_ASSERT_EQUAL(ref_c[3], c->ch.alpha);
+            if(c->ch.alpha == 0) continue;
+            TEST_ASSERT_EQUAL(ref_c[0], c->ch.blue);
+            TEST_ASSERT_EQUAL(ref_c[1], c->ch.green);
+            TEST_ASSERT_EQUAL(ref_c[2], c->ch.red);
+        }
+    }
+
+    gd_close_gif(ref);
+    gd_close_gif(g);
+}
+
+#endif
+
+#endif
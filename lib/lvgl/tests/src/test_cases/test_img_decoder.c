@@ -0,0 +1,200 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <stdio.h>
+
+#define BIN_PATH    "/tmp/lv_test_img_decoder.bin"
+#define BIN_W       37
+#define BIN_H       23
+#define MAX_SIZE    (100 * 100 * LV_IMG_PX_SIZE_ALPHA_BYTE)
+
+extern lv_color_t test_fb[];
+
+static uint8_t area_buf[MAX_SIZE];
+static uint8_t line_buf[MAX_SIZE];
+static uint32_t read_area_cnt;
+static lv_img_decoder_read_area_f_t read_area_cb_ori;
+
+static void write_bin(lv_img_cf_t cf);
+static void assert_same_as_lines(lv_img_decoder_dsc_t * dsc, lv_coord_t x1, lv_coord_t y1, lv_coord_t x2,
+                                 lv_coord_t y2);
+static lv_res_t read_area_count_cb(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, const lv_area_t * area,
+                                   uint8_t * buf);
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    remove(BIN_PATH);
+}
+
+void test_img_decoder_read_area_bin(void)
+{
+    write_bin(LV_IMG_CF_TRUE_COLOR_ALPHA);
+
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, "B:" BIN_PATH, lv_color_black(), 0));
+    TEST_ASSERT_NULL(dsc.img_data);
+
+    /*Whole lines are read at once*/
+    lv_area_t area = {0, 3, BIN_W - 1, 10};
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_area(&dsc, &area, area_buf));
+    uint32_t i;
+    for(i = 0; i < lv_area_get_size(&area) * LV_IMG_PX_SIZE_ALPHA_BYTE; i++) {
+        TEST_ASSERT_EQUAL_HEX8((3 * BIN_W * LV_IMG_PX_SIZE_ALPHA_BYTE + i) & 0xff, area_buf[i]);
+    }
+
+    /*Parts of the lines*/
+    assert_same_as_lines(&dsc, 5, 0, 20, BIN_H - 1);
+    assert_same_as_lines(&dsc, BIN_W - 1, 7, BIN_W - 1, 7);
+
+    /*Reading a line is the same as reading a one line high area*/
+    assert_same_as_lines(&dsc, 0, BIN_H - 1, BIN_W - 1, BIN_H - 1);
+
+    lv_img_decoder_close(&dsc);
+}
+
+void test_img_decoder_read_area_indexed(void)
+{
+    write_bin(LV_IMG_CF_INDEXED_4BIT);
+
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, "B:" BIN_PATH, lv_color_black(), 0));
+    assert_same_as_lines(&dsc, 0, 0, BIN_W - 1, BIN_H - 1);
+    assert_same_as_lines(&dsc, 3, 4, 11, 5);
+    lv_img_decoder_close(&dsc);
+}
+
+void test_img_decoder_read_area_fallback(void)
+{
+    write_bin(LV_IMG_CF_TRUE_COLOR);
+
+    /*Without `read_area_cb` the lines are read one by one*/
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, "B:" BIN_PATH, lv_color_black(), 0));
+    lv_img_decoder_read_area_f_t cb = dsc.decoder->read_area_cb;
+    dsc.decoder->read_area_cb = NULL;
+    assert_same_as_lines(&dsc, 0, 0, BIN_W - 1, BIN_H - 1);
+    assert_same_as_lines(&dsc, 2, 20, 30, 22);
+    dsc.decoder->read_area_cb = cb;
+    lv_img_decoder_close(&dsc);
+}
+
+void test_img_decoder_draw_strips(void)
+{
+    write_bin(LV_IMG_CF_TRUE_COLOR);
+
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, "B:" BIN_PATH, lv_color_black(), 0));
+    lv_img_decoder_t * decoder = dsc.decoder;
+    lv_img_decoder_close(&dsc);
+
+    read_area_cb_ori = decoder->read_area_cb;
+    lv_img_decoder_set_read_area_cb(decoder, read_area_count_cb);
+    read_area_cnt = 0;
+
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, "B:" BIN_PATH);
+    lv_obj_set_pos(img, 10, 20);
+    lv_refr_now(NULL);
+
+    /*The lines are read in strips and drawn the same*/
+    TEST_ASSERT_GREATER_THAN(0, read_area_cnt);
+    TEST_ASSERT_LESS_THAN(BIN_H, read_area_cnt);
+
+    uint32_t x;
+    uint32_t y;
+    for(y = 0; y < BIN_H; y++) {
+        for(x = 0; x < BIN_W; x++) {
+            uint32_t i = (y * BIN_W + x) * sizeof(lv_color_t);
+            lv_color_t exp;
+            exp.full = ((i & 0xff) | ((i + 1) & 0xff) << 8 | ((i + 2) & 0xff) << 16) | 0xff000000;
+            lv_color_t act = test_fb[(y + 20) * LV_HOR_RES + x + 10];
+            act.ch.alpha = 0xff;
+            TEST_ASSERT_EQUAL_HEX32(exp.full, act.full);
+        }
+    }
+
+    lv_obj_del(img);
+    lv_img_cache_invalidate_src(NULL);
+    lv_img_decoder_set_read_area_cb(decoder, read_area_cb_ori);
+}
+
+#if LV_USE_BMP
+
+void test_img_decoder_read_area_bmp(void)
+{
+    static const char * paths[] = {"A:../examples/libs/bmp/example_32bit.bmp", "A:../examples/libs/bmp/example_24bit.bmp"};
+    uint32_t i;
+    for(i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        lv_img_decoder_dsc_t dsc;
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, paths[i], lv_color_black(), 0));
+        TEST_ASSERT_EQUAL(100, dsc.header.w);
+        TEST_ASSERT_EQUAL(100, dsc.header.h);
+
+        /*The lines are read from the bottom of the file to the top*/
+        assert_same_as_lines(&dsc, 0, 0, 99, 99);
+        assert_same_as_lines(&dsc, 0, 40, 99, 59);
+        assert_same_as_lines(&dsc, 17, 3, 62, 98);
+        assert_same_as_lines(&dsc, 99, 0, 99, 0);
+        lv_img_decoder_close(&dsc);
+    }
+}
+
+#endif
+
+/*A `BIN_W x BIN_H` image whose bytes after the header and the palette are 0, 1, 2...*/
+static void write_bin(lv_img_cf_t cf)
+{
+    lv_img_header_t header;
+    lv_memset_00(&header, sizeof(header));
+    header.cf = cf;
+    header.w = BIN_W;
+    header.h = BIN_H;
+
+    FILE * f = fopen(BIN_PATH, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    fwrite(&header, sizeof(header), 1, f);
+    uint32_t i;
+    if(cf == LV_IMG_CF_INDEXED_4BIT) {
+        for(i = 0; i < 16; i++) {
+            lv_color32_t c;
+            c.full = 0xff000000 | (i * 0x0f0f0f);
+            fwrite(&c, sizeof(c), 1, f);
+        }
+    }
+    uint32_t size = lv_img_buf_get_img_size(BIN_W, BIN_H, cf) - (cf == LV_IMG_CF_INDEXED_4BIT ? 64 : 0);
+    for(i = 0; i < size; i++) fputc(i & 0xff, f);
+    fclose(f);
+}
+
+static void assert_same_as_lines(lv_img_decoder_dsc_t * dsc, lv_coord_t x1, lv_coord_t y1, lv_coord_t x2,
+                                 lv_coord_t y2)
+{
+    lv_area_t area = {x1, y1, x2, y2};
+    lv_coord_t len = lv_area_get_width(&area);
+    uint32_t px_size = lv_img_cf_has_alpha(dsc->header.cf) ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+
+    lv_memset_00(area_buf, sizeof(area_buf));
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_area(dsc, &area, area_buf));
+
+    lv_coord_t y;
+    for(y = y1; y <= y2; y++) {
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(dsc, x1, y, len, line_buf));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(line_buf, &area_buf[(y - y1) * len * px_size], len * px_size);
+    }
+}
+
+static lv_res_t read_area_count_cb(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, const lv_area_t * area,
+                                   uint8_t * buf)
+{
+    read_area_cnt++;
+    return read_area_cb_ori(decoder, dsc, area, buf);
+}
+
+#endif
@@ -0,0 +1,218 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+/*A clock hand like image: an opaque bar with anti-aliased edges and transparent sides*/
+#define IMG_W       11
+#define IMG_H       40
+#define PIVOT_X     5
+#define PIVOT_Y     33
+
+#define BENCH_CNT   200
+
+static uint8_t img_buf[IMG_W * IMG_H * LV_IMG_PX_SIZE_ALPHA_BYTE];
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+static lv_opa_t get_opa(lv_coord_t x, lv_coord_t y)
+{
+    lv_coord_t d = LV_ABS(x - IMG_W / 2);
+    if(y < 2 || d > 3) return LV_OPA_TRANSP;
+    if(d == 3) return LV_OPA_40;
+    return LV_OPA_COVER;
+}
+
+static void init_img(lv_img_cf_t cf)
+{
+    lv_memset_00(img_buf, sizeof(img_buf));
+    uint8_t * p = img_buf;
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < IMG_H; y++) {
+        for(x = 0; x < IMG_W; x++) {
+            lv_color_t c = lv_color_make(x * 20, y * 6, 255 - y * 3);
+            lv_opa_t opa = get_opa(x, y);
+            if(cf == LV_IMG_CF_ALPHA_8BIT) {
+                *p = opa;
+                p++;
+                continue;
+            }
+            if(cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED && opa == LV_OPA_TRANSP) c = LV_COLOR_CHROMA_KEY;
+
+            if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+                /*With 32 bit colors the alpha byte of the color is replaced*/
+                lv_memcpy_small(p, &c, LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+                p[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = opa;
+                p += LV_IMG_PX_SIZE_ALPHA_BYTE;
+            }
+            else {
+                lv_memcpy_small(p, &c, LV_COLOR_SIZE / 8);
+                p += LV_COLOR_SIZE / 8;
+            }
+        }
+    }
+}
+
+static void init_dsc(lv_img_transform_dsc_t * dsc, lv_img_cf_t cf, int16_t angle, uint16_t zoom, bool antialias)
+{
+    lv_memset_00(dsc, sizeof(lv_img_transform_dsc_t));
+    dsc->cfg.angle = angle;
+    dsc->cfg.zoom = zoom;
+    dsc->cfg.src = img_buf;
+    dsc->cfg.src_w = IMG_W;
+    dsc->cfg.src_h = IMG_H;
+    dsc->cfg.cf = cf;
+    dsc->cfg.pivot_x = PIVOT_X;
+    dsc->cfg.pivot_y = PIVOT_Y;
+    dsc->cfg.color = lv_color_hex(0x3050f0);
+    dsc->cfg.antialias = antialias;
+    _lv_img_buf_transform_init(dsc);
+}
+
+static void get_area(lv_area_t * area, int16_t angle, uint16_t zoom)
+{
+    lv_point_t pivot = {PIVOT_X, PIVOT_Y};
+    _lv_img_buf_get_transformed_area(area, IMG_W, IMG_H, angle, zoom, &pivot);
+    /*Have some pixels around the image too*/
+    lv_area_increase(area, 4, 4);
+}
+
+static void compare_rows(lv_img_cf_t cf, int16_t angle, uint16_t zoom, bool antialias)
+{
+    lv_img_transform_dsc_t dsc_px;
+    lv_img_transform_dsc_t dsc_row;
+    init_dsc(&dsc_px, cf, angle, zoom, antialias);
+    init_dsc(&dsc_row, cf, angle, zoom, antialias);
+
+    lv_area_t area;
+    get_area(&area, angle, zoom);
+    lv_coord_t w = lv_area_get_width(&area);
+    lv_color_t * cbuf = lv_mem_alloc(w * sizeof(lv_color_t));
+    lv_opa_t * abuf = lv_mem_alloc(w);
+    TEST_ASSERT_NOT_NULL(cbuf);
+    TEST_ASSERT_NOT_NULL(abuf);
+
+    char msg[64];
+    uint32_t visible_cnt = 0;
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = area.y1; y <= area.y2; y++) {
+        _lv_img_buf_transform_row(&dsc_row, area.x1, y, w, cbuf, abuf);
+        for(x = area.x1; x <= area.x2; x++) {
+            lv_opa_t opa_px = LV_OPA_TRANSP;
+            if(_lv_img_buf_transform(&dsc_px, x, y)) opa_px = dsc_px.res.opa;
+
+            lv_snprintf(msg, sizeof(msg), "cf %d angle %d zoom %d aa %d at %d;%d", cf, angle, zoom, antialias, x, y);
+            TEST_ASSERT_EQUAL_UINT8_MESSAGE(opa_px, abuf[x - area.x1], msg);
+            if(opa_px == LV_OPA_TRANSP) continue;
+
+            visible_cnt++;
+            TEST_ASSERT_EQUAL_HEX32_MESSAGE(lv_color_to32(dsc_px.res.color) & 0xFFFFFF,
+                                            lv_color_to32(cbuf[x - area.x1]) & 0xFFFFFF, msg);
+        }
+    }
+
+    /*Be sure the image was really found*/
+    TEST_ASSERT_GREATER_THAN_UINT32(0, visible_cnt);
+
+    lv_mem_free(cbuf);
+    lv_mem_free(abuf);
+}
+
+static void compare_all(lv_img_cf_t cf)
+{
+    static const int16_t angles[] = {0, 1, 27, 450, 899, 900, 1234, 1800, 2255, 2700, 3333, 3599};
+    static const uint16_t zooms[] = {LV_IMG_ZOOM_NONE, 128, 300, 40};
+
+    init_img(cf);
+
+    uint32_t a;
+    uint32_t z;
+    for(a = 0; a < sizeof(angles) / sizeof(angles[0]); a++) {
+        for(z = 0; z < sizeof(zooms) / sizeof(zooms[0]); z++) {
+            /*Not a transformation*/
+            if(angles[a] == 0 && zooms[z] == LV_IMG_ZOOM_NONE) continue;
+
+            compare_rows(cf, angles[a], zooms[z], false);
+            compare_rows(cf, angles[a], zooms[z], true);
+        }
+    }
+}
+
+void test_img_transform_row_true_color_alpha(void)
+{
+    compare_all(LV_IMG_CF_TRUE_COLOR_ALPHA);
+}
+
+void test_img_transform_row_true_color(void)
+{
+    compare_all(LV_IMG_CF_TRUE_COLOR);
+}
+
+void test_img_transform_row_chroma_keyed(void)
+{
+    compare_all(LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED);
+}
+
+void test_img_transform_row_alpha_8bit(void)
+{
+    compare_all(LV_IMG_CF_ALPHA_8BIT);
+}
+
+void test_img_transform_row_benchmark(void)
+{
+    /*Not an assertion, just print how fast rotating a clock hand is on this machine*/
+    init_img(LV_IMG_CF_TRUE_COLOR_ALPHA);
+
+    lv_area_t area;
+    get_area(&area, 1234, LV_IMG_ZOOM_NONE);
+    lv_coord_t w = lv_area_get_width(&area);
+    lv_color_t * cbuf = lv_mem_alloc(w * sizeof(lv_color_t));
+    lv_opa_t * abuf = lv_mem_alloc(w);
+    TEST_ASSERT_NOT_NULL(cbuf);
+    TEST_ASSERT_NOT_NULL(abuf);
+
+    lv_img_transform_dsc_t dsc;
+    uint32_t i;
+    lv_coord_t x;
+    lv_coord_t y;
+
+    /*The LVGL tick is not running in the tests so measure the real time*/
+    uint32_t t = custom_tick_get();
+    for(i = 0; i < BENCH_CNT; i++) {
+        init_dsc(&dsc, LV_IMG_CF_TRUE_COLOR_ALPHA, (i * 18) % 3600, LV_IMG_ZOOM_NONE, true);
+        for(y = area.y1; y <= area.y2; y++) {
+            for(x = area.x1; x <= area.x2; x++) {
+                abuf[x - area.x1] = _lv_img_buf_transform(&dsc, x, y) ? dsc.res.opa : LV_OPA_TRANSP;
+                cbuf[x - area.x1] = dsc.res.color;
+            }
+        }
+    }
+    uint32_t px_time = custom_tick_get() - t;
+
+    t = custom_tick_get();
+    for(i = 0; i < BENCH_CNT; i++) {
+        init_dsc(&dsc, LV_IMG_CF_TRUE_COLOR_ALPHA, (i * 18) % 3600, LV_IMG_ZOOM_NONE, true);
+        for(y = area.y1; y <= area.y2; y++) {
+            _lv_img_buf_transform_row(&dsc, area.x1, y, w, cbuf, abuf);
+        }
+    }
+    uint32_t row_time = custom_tick_get() - t;
+
+    TEST_PRINTF("%d x %dx%d px, per pixel: %d ms, per row: %d ms", BENCH_CNT, w, lv_area_get_height(&area),
+                px_time, row_time);
+
+    lv_mem_free(cbuf);
+    lv_mem_free(abuf);
+}
+
+#endif
@@ -0,0 +1,350 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../src/misc/lv_gc.h"
+
+#include "unity/unity.h"
+
+#if LV_IMG_TRANSFORM_CACHE_SIZE
+
+/*A clock hand like image: an opaque bar with anti-aliased edges and transparent sides*/
+#define IMG_W       11
+#define IMG_H       40
+#define PIVOT_X     5
+#define PIVOT_Y     33
+
+/*The area of the screen where the image is drawn*/
+#define AREA_X      20
+#define AREA_Y      20
+#define AREA_SIZE   100
+
+#define BENCH_CNT   200
+
+extern lv_color_t test_fb[];
+
+static uint8_t img_buf[IMG_W * IMG_H * LV_IMG_PX_SIZE_ALPHA_BYTE];
+static lv_img_dsc_t img_dsc;
+static lv_obj_t * img;
+static lv_color_t ref_buf[AREA_SIZE * AREA_SIZE];
+static lv_color_t res_buf[AREA_SIZE * AREA_SIZE];
+
+static void init_img(lv_img_cf_t cf);
+
+void setUp(void)
+{
+    init_img(LV_IMG_CF_TRUE_COLOR_ALPHA);
+
+    lv_obj_t * scr = lv_scr_act();
+    lv_obj_set_style_bg_color(scr, lv_color_white(), 0);
+    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+
+    img = lv_img_create(scr);
+    lv_img_set_src(img, &img_dsc);
+    lv_img_set_pivot(img, PIVOT_X, PIVOT_Y);
+    lv_obj_set_pos(img, AREA_X + AREA_SIZE / 2 - PIVOT_X, AREA_Y + AREA_SIZE / 2 - PIVOT_Y);
+}
+
+void tearDown(void)
+{
+    lv_obj_del(img);
+    lv_img_transform_cache_invalidate_src(NULL);
+    lv_img_cache_invalidate_src(&img_dsc);
+}
+
+static void init_img(lv_img_cf_t cf)
+{
+    lv_memset_00(img_buf, sizeof(img_buf));
+    uint8_t * p = img_buf;
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < IMG_H; y++) {
+        for(x = 0; x < IMG_W; x++) {
+            lv_color_t c = lv_color_make(x * 20, y * 6, 255 - y * 3);
+            lv_coord_t d = LV_ABS(x - IMG_W / 2);
+            lv_opa_t opa = LV_OPA_COVER;
+            if(y < 2 || d > 3) opa = LV_OPA_TRANSP;
+            else if(d == 3) opa = LV_OPA_40;
+
+            if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+                /*With 32 bit colors the alpha byte of the color is replaced*/
+                lv_memcpy_small(p, &c, LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+                p[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = opa;
+                p += LV_IMG_PX_SIZE_ALPHA_BYTE;
+            }
+            else {
+                lv_memcpy_small(p, &c, LV_COLOR_SIZE / 8);
+                p += LV_COLOR_SIZE / 8;
+            }
+        }
+    }
+
+    lv_memset_00(&img_dsc, sizeof(img_dsc));
+    img_dsc.header.cf = cf;
+    img_dsc.header.w = IMG_W;
+    img_dsc.header.h = IMG_H;
+    img_dsc.data_size = cf == LV_IMG_CF_TRUE_COLOR_ALPHA ? IMG_W * IMG_H * LV_IMG_PX_SIZE_ALPHA_BYTE :
+                        IMG_W * IMG_H * LV_COLOR_SIZE / 8;
+    img_dsc.data = img_buf;
+}
+
+static void render(lv_color_t * buf)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    /*The whole screen is flushed at once to `test_fb`*/
+    lv_coord_t hor_res = lv_disp_get_hor_res(NULL);
+    lv_coord_t y;
+    for(y = 0; y < AREA_SIZE; y++) {
+        lv_memcpy(&buf[y * AREA_SIZE], &test_fb[(AREA_Y + y) * hor_res + AREA_X], AREA_SIZE * sizeof(lv_color_t));
+    }
+}
+
+static uint32_t get_cache_size(void)
+{
+    uint32_t size = 0;
+    _lv_img_transform_cache_entry_t * entry;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_img_transform_cache_ll), entry) {
+        size += entry->img.data_size;
+    }
+    return size;
+}
+
+/*Get a variant without keeping it*/
+static const lv_img_dsc_t * get_variant(const lv_draw_img_dsc_t * draw_dsc, lv_area_t * area)
+{
+    const lv_img_dsc_t * variant = _lv_img_transform_cache_get(&img_dsc, draw_dsc, area);
+    if(variant) _lv_img_transform_cache_release(variant);
+    return variant;
+}
+
+static void compare_with_cache(int16_t angle, uint16_t zoom)
+{
+    lv_img_set_transform_cache(img, 0, 0);
+    lv_img_set_angle(img, angle);
+    lv_img_set_zoom(img, zoom);
+    render(ref_buf);
+
+    lv_img_set_transform_cache(img, 60, 0);
+    TEST_ASSERT_EQUAL_INT16(angle, lv_img_get_angle(img));
+
+    /*First the variant is rendered into the cache then it's taken from the cache*/
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        render(res_buf);
+        char msg[64];
+        lv_snprintf(msg, sizeof(msg), "angle %d zoom %d, pass %d", angle, zoom, i);
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(ref_buf, res_buf, sizeof(ref_buf), msg);
+    }
+}
+
+void test_img_transform_cache_draws_the_same_as_the_transformation(void)
+{
+    static const int16_t angles[] = {60, 420, 900, 1320, 1800, 2460, 3540};
+    static const lv_img_cf_t cfs[] = {LV_IMG_CF_TRUE_COLOR_ALPHA, LV_IMG_CF_TRUE_COLOR};
+
+    uint32_t c;
+    uint32_t a;
+    for(c = 0; c < sizeof(cfs) / sizeof(cfs[0]); c++) {
+        init_img(cfs[c]);
+        lv_img_set_src(img, &img_dsc);
+        for(a = 0; a < sizeof(angles) / sizeof(angles[0]); a++) {
+            compare_with_cache(angles[a], LV_IMG_ZOOM_NONE);
+        }
+
+        compare_with_cache(0, 384);
+        compare_with_cache(2100, 200);
+        lv_img_cache_invalidate_src(&img_dsc);
+    }
+}
+
+void test_img_transform_cache_rounds_the_angle_and_zoom(void)
+{
+    lv_img_set_transform_cache(img, 60, 0);
+    lv_img_set_angle(img, 1234);
+    TEST_ASSERT_EQUAL_UINT16(1260, lv_img_get_angle(img));
+    lv_img_set_angle(img, 3590);
+    TEST_ASSERT_EQUAL_UINT16(0, lv_img_get_angle(img));
+    lv_img_set_zoom(img, 300);
+    TEST_ASSERT_EQUAL_UINT16(300, lv_img_get_zoom(img));
+
+    /*The current transformation is rounded too*/
+    lv_img_set_angle(img, 1234);
+    lv_img_set_transform_cache(img, 900, 64);
+    TEST_ASSERT_EQUAL_UINT16(900, lv_img_get_angle(img));
+    TEST_ASSERT_EQUAL_UINT16(320, lv_img_get_zoom(img));
+
+    lv_img_set_transform_cache(img, 0, 0);
+    lv_img_set_angle(img, 1234);
+    TEST_ASSERT_EQUAL_UINT16(1234, lv_img_get_angle(img));
+}
+
+void test_img_transform_cache_hit_and_invalidate(void)
+{
+    lv_draw_img_dsc_t draw_dsc;
+    lv_draw_img_dsc_init(&draw_dsc);
+    draw_dsc.angle = 450;
+    draw_dsc.pivot.x = PIVOT_X;
+    draw_dsc.pivot.y = PIVOT_Y;
+
+    lv_area_t area1;
+    lv_area_t area2;
+    const lv_img_dsc_t * variant1 = get_variant(&draw_dsc, &area1);
+    TEST_ASSERT_NOT_NULL(variant1);
+    TEST_ASSERT_EQUAL(LV_IMG_CF_TRUE_COLOR_ALPHA, variant1->header.cf);
+    TEST_ASSERT_EQUAL(lv_area_get_width(&area1), variant1->header.w);
+    TEST_ASSERT_EQUAL(lv_area_get_height(&area1), variant1->header.h);
+
+    const lv_img_dsc_t * variant2 = get_variant(&draw_dsc, &area2);
+    TEST_ASSERT_EQUAL_PTR(variant1, variant2);
+    TEST_ASSERT_EQUAL_MEMORY(&area1, &area2, sizeof(lv_area_t));
+    TEST_ASSERT_EQUAL_UINT32(1, _lv_ll_get_len(&LV_GC_ROOT(_lv_img_transform_cache_ll)));
+
+    /*Other transformations are other variants*/
+    draw_dsc.angle = 460;
+    TEST_ASSERT_NOT_EQUAL(variant1, get_variant(&draw_dsc, &area2));
+    draw_dsc.antialias = !draw_dsc.antialias;
+    get_variant(&draw_dsc, &area2);
+    TEST_ASSERT_EQUAL_UINT32(3, _lv_ll_get_len(&LV_GC_ROOT(_lv_img_transform_cache_ll)));
+
+    /*Only variable images are cached*/
+    TEST_ASSERT_NULL(_lv_img_transform_cache_get("A:img.bin", &draw_dsc, &area2));
+
+    /*Updating the image drops its variants*/
+    lv_img_cache_invalidate_src(&img_dsc);
+    TEST_ASSERT_EQUAL_UINT32(0, _lv_ll_get_len(&LV_GC_ROOT(_lv_img_transform_cache_ll)));
+    TEST_ASSERT_EQUAL_UINT32(0, get_cache_size());
+}
+
+void test_img_transform_cache_drops_the_least_recently_used(void)
+{
+    lv_draw_img_dsc_t draw_dsc;
+    lv_draw_img_dsc_init(&draw_dsc);
+    draw_dsc.pivot.x = PIVOT_X;
+    draw_dsc.pivot.y = PIVOT_Y;
+    draw_dsc.zoom = 512;
+
+    /*Much more variants than fit in the cache*/
+    lv_area_t area;
+    int16_t angle;
+    for(angle = 0; angle < 3600; angle += 60) {
+        draw_dsc.angle = angle;
+        TEST_ASSERT_NOT_NULL(get_variant(&draw_dsc, &area));
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_IMG_TRANSFORM_CACHE_SIZE, get_cache_size());
+
+        /*Keep using the first variant*/
+        draw_dsc.angle = 0;
+        get_variant(&draw_dsc, &area);
+    }
+
+    uint32_t len = _lv_ll_get_len(&LV_GC_ROOT(_lv_img_transform_cache_ll));
+    TEST_ASSERT_GREATER_THAN_UINT32(1, len);
+    TEST_ASSERT_LESS_THAN_UINT32(60, len);
+
+    /*The most recently used ones are kept*/
+    _lv_img_transform_cache_entry_t * entry = _lv_ll_get_head(&LV_GC_ROOT(_lv_img_transform_cache_ll));
+    TEST_ASSERT_EQUAL_INT16(0, entry->angle);
+    entry = _lv_ll_get_next(&LV_GC_ROOT(_lv_img_transform_cache_ll), entry);
+    TEST_ASSERT_EQUAL_INT16(3540, entry->angle);
+
+    /*Too large to cache*/
+    draw_dsc.zoom = 256 * 20;
+    TEST_ASSERT_NULL(get_variant(&draw_dsc, &area));
+}
+
+void test_img_transform_cache_keeps_the_variants_being_drawn(void)
+{
+    lv_draw_img_dsc_t draw_dsc;
+    lv_draw_img_dsc_init(&draw_dsc);
+    draw_dsc.pivot.x = PIVOT_X;
+    draw_dsc.pivot.y = PIVOT_Y;
+    draw_dsc.zoom = 512;
+
+    /*Drawn by an other rendering thread while the cache is filled*/
+    lv_area_t area;
+    draw_dsc.angle = 60;
+    const lv_img_dsc_t * drawn = _lv_img_transform_cache_get(&img_dsc, &draw_dsc, &area);
+    TEST_ASSERT_NOT_NULL(drawn);
+    lv_img_dsc_t drawn_copy = *drawn;
+
+    int16_t angle;
+    for(angle = 120; angle < 3600; angle += 60) {
+        draw_dsc.angle = angle;
+        TEST_ASSERT_NOT_NULL(get_variant(&draw_dsc, &area));
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_IMG_TRANSFORM_CACHE_SIZE, get_cache_size());
+    }
+
+    /*It's the least recently used but it's still there*/
+    _lv_img_transform_cache_entry_t * entry = _lv_ll_get_tail(&LV_GC_ROOT(_lv_img_transform_cache_ll));
+    TEST_ASSERT_EQUAL_PTR(drawn, &entry->img);
+    TEST_ASSERT_EQUAL_MEMORY(&drawn_copy, drawn, sizeof(lv_img_dsc_t));
+
+    /*After releasing it, it can be dropped*/
+    _lv_img_transform_cache_release(drawn);
+    for(angle = 30; angle < 3600; angle += 60) {
+        draw_dsc.angle = angle;
+        get_variant(&draw_dsc, &area);
+    }
+    _LV_LL_READ(&LV_GC_ROOT(_lv_img_transform_cache_ll), entry) {
+        TEST_ASSERT_NOT_EQUAL_INT16(60, entry->angle);
+    }
+
+    /*Invalidated while drawn: not found anymore but freed only when released*/
+    drawn = _lv_img_transform_cache_get(&img_dsc, &draw_dsc, &area);
+    lv_img_cache_invalidate_src(&img_dsc);
+    TEST_ASSERT_EQUAL_UINT32(1, _lv_ll_get_len(&LV_GC_ROOT(_lv_img_transform_cache_ll)));
+    const lv_img_dsc_t * redrawn = _lv_img_transform_cache_get(&img_dsc, &draw_dsc, &area);
+    TEST_ASSERT_NOT_EQUAL(drawn, redrawn);
+    _lv_img_transform_cache_release(redrawn);
+    _lv_img_transform_cache_release(drawn);
+    TEST_ASSERT_EQUAL_UINT32(1, _lv_ll_get_len(&LV_GC_ROOT(_lv_img_transform_cache_ll)));
+}
+
+void test_img_transform_cache_benchmark(void)
+{
+    /*Not an assertion, just print how fast moving a clock hand is on this machine*/
+    int16_t angle;
+    uint32_t i;
+    uint32_t t = custom_tick_get();
+    for(i = 0; i < BENCH_CNT; i++) {
+        lv_img_set_angle(img, (i * 60) % 3600);
+        lv_refr_now(NULL);
+    }
+    uint32_t transform_time = custom_tick_get() - t;
+
+    lv_img_set_transform_cache(img, 60, 0);
+    /*Warm up the cache*/
+    for(angle = 0; angle < 3600; angle += 60) {
+        lv_img_set_angle(img, angle);
+        lv_refr_now(NULL);
+    }
+
+    t = custom_tick_get();
+    for(i = 0; i < BENCH_CNT; i++) {
+        lv_img_set_angle(img, (i * 60) % 3600);
+        lv_refr_now(NULL);
+    }
+    uint32_t cache_time = custom_tick_get() - t;
+
+    TEST_PRINTF("%d hand moves, transform: %d ms, cached: %d ms", BENCH_CNT, transform_time, cache_time);
+}
+
+#else /*LV_IMG_TRANSFORM_CACHE_SIZE*/
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_img_transform_cache_draws_the_same_as_the_transformation(void)
+{
+
+}
+
+#endif /*LV_IMG_TRANSFORM_CACHE_SIZE*/
+
+#endif
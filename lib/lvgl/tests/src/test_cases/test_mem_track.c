@@ -0,0 +1,136 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_MEM_TRACK
+
+#include <string.h>
+
+static char out[16 * 1024];
+static uint32_t out_len;
+
+static const lv_mem_track_tag_t * find_tag(const char * name, bool call_site, uint32_t line);
+static void print_cb(const char * buf);
+
+void setUp(void)
+{
+    out_len = 0;
+    out[0] = '\0';
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_mem_track_call_site(void)
+{
+    uint32_t total_ori = lv_mem_track_get_total()->live_size;
+
+    uint8_t * p = lv_mem_alloc(100);
+    const lv_mem_track_tag_t * tag = find_tag("test_mem_track.c", true, __LINE__ - 1);
+    TEST_ASSERT_NOT_NULL(tag);
+    TEST_ASSERT_EQUAL(100, tag->live_size);
+    TEST_ASSERT_EQUAL(1, tag->live_cnt);
+    TEST_ASSERT_EQUAL(total_ori + 100, lv_mem_track_get_total()->live_size);
+
+    /*The memory is still usable and the content is kept*/
+    lv_memset(p, 0x55, 100);
+    p = lv_mem_realloc(p, 300);
+    TEST_ASSERT_EQUAL_HEX8(0x55, p[99]);
+    lv_memset(p, 0x55, 300);
+    TEST_ASSERT_EQUAL(total_ori + 300, lv_mem_track_get_total()->live_size);
+
+    lv_mem_free(p);
+    TEST_ASSERT_EQUAL(0, tag->live_size);
+    TEST_ASSERT_EQUAL(0, tag->live_cnt);
+    TEST_ASSERT_EQUAL(total_ori, lv_mem_track_get_total()->live_size);
+}
+
+void test_mem_track_object_class(void)
+{
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_label_set_text(label, "The allocations of the constructor are tagged by the class");
+
+    const lv_mem_track_tag_t * tag = find_tag("lv_label", false, 0);
+    TEST_ASSERT_NOT_NULL(tag);
+    TEST_ASSERT_GREATER_OR_EQUAL(sizeof(lv_label_t), tag->live_size);
+
+    /*The allocations after the creation are tagged by the call site*/
+    TEST_ASSERT_NOT_NULL(find_tag("lv_label.c", true, 0));
+
+    /*Nothing is left after deleting the object*/
+    lv_obj_del(label);
+    TEST_ASSERT_EQUAL(0, tag->live_size);
+    TEST_ASSERT_EQUAL(0, tag->live_cnt);
+}
+
+void test_mem_track_peak_and_total(void)
+{
+    lv_mem_track_reset();
+    uint32_t peak_ori = lv_mem_track_get_total()->peak_size;
+
+    void * p = lv_mem_alloc(1000);
+    const lv_mem_track_tag_t * tag = find_tag("test_mem_track.c", true, __LINE__ - 1);
+    lv_mem_free(p);
+    p = lv_mem_alloc(10);
+    lv_mem_free(p);
+
+    TEST_ASSERT_NOT_NULL(tag);
+    TEST_ASSERT_EQUAL(0, tag->live_size);
+    TEST_ASSERT_GREATER_OR_EQUAL(1000, tag->peak_size);
+    TEST_ASSERT_EQUAL(peak_ori + 1000, lv_mem_track_get_total()->peak_size);
+    TEST_ASSERT_GREATER_OR_EQUAL(2, lv_mem_track_get_total()->alloc_cnt);
+
+    /*The totals are the sum of the tags*/
+    uint32_t live_sum = 0;
+    uint32_t cnt_sum = 0;
+    uint32_t i;
+    for(i = 0; i < lv_mem_track_get_tag_cnt(); i++) {
+        live_sum += lv_mem_track_get_tag(i)->live_size;
+        cnt_sum += lv_mem_track_get_tag(i)->live_cnt;
+    }
+    TEST_ASSERT_EQUAL(lv_mem_track_get_total()->live_size, live_sum);
+    TEST_ASSERT_EQUAL(lv_mem_track_get_total()->live_cnt, cnt_sum);
+}
+
+void test_mem_track_dump(void)
+{
+    lv_obj_t * btn = lv_btn_create(lv_scr_act());
+    lv_mem_track_dump(print_cb);
+
+    TEST_ASSERT_EQUAL_STRING_LEN("live: ", out, strlen("live: "));
+    TEST_ASSERT_NOT_NULL(strstr(out, "  lv_btn\n"));
+    TEST_ASSERT_NOT_NULL(strstr(out, "  lv_obj_class.c:"));
+
+    lv_obj_del(btn);
+}
+
+static const lv_mem_track_tag_t * find_tag(const char * name, bool call_site, uint32_t line)
+{
+    uint32_t i;
+    for(i = 0; i < lv_mem_track_get_tag_cnt(); i++) {
+        const lv_mem_track_tag_t * tag = lv_mem_track_get_tag(i);
+        if(call_site) {
+            const char * file = strrchr(tag->name, '/');
+            if(tag->line && (line == 0 || tag->line == line) && file && strcmp(file + 1, name) == 0) return tag;
+        }
+        else if(tag->line == 0 && strcmp(tag->name, name) == 0) {
+            return tag;
+        }
+    }
+    return NULL;
+}
+
+static void print_cb(const char * buf)
+{
+    size_t len = strlen(buf);
+    TEST_ASSERT_LESS_THAN(sizeof(out), out_len + len);
+    lv_memcpy(out + out_len, buf, len + 1);
+    out_len += len;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,180 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_PARALLEL_RENDER
+
+#define HOR_RES     800
+#define VER_RES     480
+#define IMG_SIZE    32
+#define REPEAT_CNT  10
+
+extern lv_color_t test_fb[];
+
+static lv_color_t ref_fb[HOR_RES * VER_RES];
+static uint8_t img_buf[IMG_SIZE * IMG_SIZE * LV_IMG_PX_SIZE_ALPHA_BYTE];
+static lv_img_dsc_t img_dsc;
+
+static void create_scene(lv_obj_t * scr);
+static uint32_t render(bool parallel);
+
+void setUp(void)
+{
+    create_scene(lv_scr_act());
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_disp_get_default()->driver->parallel_render = 1;
+}
+
+void test_parallel_render_same_as_serial(void)
+{
+    uint32_t serial_time = render(false);
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    /*Render more times to have a better chance to catch a race between the threads*/
+    uint32_t parallel_time = 0;
+    uint32_t i;
+    for(i = 0; i < REPEAT_CNT; i++) {
+        parallel_time += render(true);
+        TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+    }
+
+    TEST_PRINTF("full screen, serial: %d ms, parallel with %d workers: %d ms", serial_time, LV_PARALLEL_RENDER_WORKERS,
+                parallel_time / REPEAT_CNT);
+}
+
+void test_parallel_render_area(void)
+{
+    /*Only the invalidated area is flushed to the beginning of the frame buffer*/
+    lv_area_t area;
+    lv_area_set(&area, 205, 165, 405, 325);
+    uint32_t size = lv_area_get_size(&area);
+    lv_refr_now(NULL);
+
+    lv_disp_get_default()->driver->parallel_render = 0;
+    lv_obj_invalidate_area(lv_scr_act(), &area);
+    lv_refr_now(NULL);
+    lv_memcpy(ref_fb, test_fb, size * sizeof(lv_color_t));
+
+    lv_disp_get_default()->driver->parallel_render = 1;
+    lv_obj_invalidate_area(lv_scr_act(), &area);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, size * sizeof(lv_color_t));
+}
+
+static uint32_t render(bool parallel)
+{
+    lv_disp_get_default()->driver->parallel_render = parallel;
+    lv_obj_invalidate(lv_scr_act());
+
+    uint32_t t = custom_tick_get();
+    lv_refr_now(NULL);
+    return custom_tick_get() - t;
+}
+
+static void create_scene(lv_obj_t * scr)
+{
+    lv_obj_set_style_bg_color(scr, lv_palette_lighten(LV_PALETTE_GREY, 4), 0);
+    lv_obj_set_style_bg_grad_color(scr, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_VER, 0);
+    /*The error diffusion depends on the previous rows so it's not the same if the bands are rendered separately*/
+    lv_obj_set_style_bg_dither_mode(scr, LV_DITHER_ORDERED, 0);
+
+    /*An image with an alpha gradient to draw normally and rotated*/
+    lv_coord_t x;
+    lv_coord_t y;
+    uint8_t * p = img_buf;
+    for(y = 0; y < IMG_SIZE; y++) {
+        for(x = 0; x < IMG_SIZE; x++) {
+            lv_color_t c = lv_color_make(x * 8, y * 8, 128);
+#if LV_COLOR_DEPTH == 32
+            *(lv_color_t *)p = c;
+            p[3] = (x + y) * 4;
+#else
+            lv_memcpy(p, &c, sizeof(lv_color_t));
+            p[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = (x + y) * 4;
+#endif
+            p += LV_IMG_PX_SIZE_ALPHA_BYTE;
+        }
+    }
+    img_dsc.header.always_zero = 0;
+    img_dsc.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    img_dsc.header.w = IMG_SIZE;
+    img_dsc.header.h = IMG_SIZE;
+    img_dsc.data_size = sizeof(img_buf);
+    img_dsc.data = img_buf;
+
+    uint32_t i;
+    for(i = 0; i < 12; i++) {
+        lv_obj_t * card = lv_obj_create(scr);
+        lv_obj_set_size(card, 180, 140);
+        lv_obj_set_pos(card, 10 + (i % 4) * 195, 10 + (i / 4) * 155);
+        lv_obj_set_style_radius(card, 5 + i * 3, 0);
+        lv_obj_set_style_shadow_width(card, 10 + i * 2, 0);
+        lv_obj_set_style_shadow_ofs_y(card, 5, 0);
+        lv_obj_set_style_bg_grad_color(card, lv_palette_main(i % 10), 0);
+        lv_obj_set_style_bg_grad_dir(card, i % 2 ? LV_GRAD_DIR_HOR : LV_GRAD_DIR_VER, 0);
+        lv_obj_set_style_clip_corner(card, i % 3 == 0, 0);
+        lv_obj_clear_flag(card, LV_OBJ_FLAG_SCROLLABLE);
+
+        lv_obj_t * label = lv_label_create(card);
+        lv_obj_set_width(label, 150);
+        lv_label_set_text(label, "Lorem ipsum dolor sit amet, consectetur adipiscing elit.");
+        if(i % 3 == 0) lv_obj_set_style_text_font(label, &lv_font_montserrat_28_compressed, 0);
+        else if(i % 3 == 1) lv_obj_set_style_text_font(label, &lv_font_montserrat_12_subpx, 0);
+
+        lv_obj_t * img = lv_img_create(card);
+        lv_img_set_src(img, &img_dsc);
+        lv_obj_align(img, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+        lv_img_set_angle(img, i * 150);
+        lv_img_set_zoom(img, 256 + i * 16);
+        if(i % 2) lv_img_set_transform_cache(img, 150, 16);
+
+        switch(i % 4) {
+            case 0: {
+                    lv_obj_t * arc = lv_arc_create(card);
+                    lv_obj_set_size(arc, 60, 60);
+                    lv_obj_align(arc, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+                    lv_arc_set_value(arc, 70);
+                    break;
+                }
+            case 1: {
+                    lv_obj_t * slider = lv_slider_create(card);
+                    lv_obj_set_width(slider, 100);
+                    lv_obj_align(slider, LV_ALIGN_BOTTOM_LEFT, 5, -10);
+                    lv_slider_set_mode(slider, LV_SLIDER_MODE_RANGE);
+                    lv_slider_set_left_value(slider, 20, LV_ANIM_OFF);
+                    lv_slider_set_value(slider, 60, LV_ANIM_OFF);
+                    break;
+                }
+            case 2: {
+                    static const char * map[] = {"A", "B", "\n", "C", "D", ""};
+                    lv_obj_t * btnm = lv_btnmatrix_create(card);
+                    lv_obj_set_size(btnm, 100, 70);
+                    lv_obj_align(btnm, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+                    lv_btnmatrix_set_map(btnm, map);
+                    lv_btnmatrix_set_btn_ctrl(btnm, 1, LV_BTNMATRIX_CTRL_CHECKED);
+                    break;
+                }
+            default: {
+                    lv_obj_t * table = lv_table_create(card);
+                    lv_obj_align(table, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+                    lv_table_set_col_width(table, 0, 50);
+                    lv_table_set_col_width(table, 1, 50);
+                    lv_table_set_cell_value(table, 0, 0, "1");
+                    lv_table_set_cell_value(table, 0, 1, "2");
+                    lv_table_set_cell_value(table, 1, 0, "3");
+                    lv_table_set_cell_value(table, 1, 1, "4");
+                    break;
+                }
+        }
+    }
+}
+
+#endif
+
+#endif
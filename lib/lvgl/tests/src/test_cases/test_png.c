@@ -0,0 +1,403 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_PNG
+
+#include "../src/extra/libs/png/lodepng.h"
+
+#include <stdio.h>
+
+#define IMG_W   37
+#define IMG_H   23
+
+/*Bigger than `LV_PNG_STREAM_MIN_SIZE` so decoded row by row*/
+#define BIG_W   300
+#define BIG_H   200
+#define BIG_PATH    "/tmp/lv_test_png_stream.png"
+
+extern lv_color_t test_fb[];
+
+static uint8_t rgba[BIG_W * BIG_H * 4];
+static lv_color_t line_buf[BIG_W];
+
+static void fill(uint32_t w, uint32_t h, uint32_t color_cnt, bool opaque);
+static void check_png(bool interlace, LodePNGColorType exp_colortype, bool exp_alpha);
+static uint8_t * encode_big(unsigned btype, bool interlace, LodePNGColorType exp_colortype, size_t * png_size);
+static void check_stream(const void * src, bool exp_alpha);
+static void check_row(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len, bool alpha);
+static void init_img_dsc(lv_img_dsc_t * img_dsc, const uint8_t * png, size_t png_size, uint32_t w, uint32_t h);
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_png_rgba(void)
+{
+    fill(IMG_W, IMG_H, 0, false);
+    check_png(false, LCT_RGBA, true);
+}
+
+void test_png_rgb(void)
+{
+    /*Opaque images are decoded without alpha channel*/
+    fill(IMG_W, IMG_H, 0, true);
+    check_png(false, LCT_RGB, false);
+}
+
+void test_png_palette(void)
+{
+    fill(IMG_W, IMG_H, 5, false);
+    check_png(false, LCT_PALETTE, true);
+
+    fill(IMG_W, IMG_H, 5, true);
+    check_png(false, LCT_PALETTE, false);
+}
+
+void test_png_grey_1bit(void)
+{
+    /*The rows are not byte aligned*/
+    fill(IMG_W, IMG_H, 2, true);
+    check_png(false, LCT_GREY, false);
+}
+
+void test_png_interlaced(void)
+{
+    fill(IMG_W, IMG_H, 0, false);
+    check_png(true, LCT_RGBA, true);
+
+    fill(IMG_W, IMG_H, 2, true);
+    check_png(true, LCT_GREY, false);
+}
+
+void test_png_invalid(void)
+{
+    fill(IMG_W, IMG_H, 0, false);
+    uint8_t * png;
+    size_t png_size;
+    TEST_ASSERT_EQUAL(0, lodepng_encode32(&png, &png_size, rgba, IMG_W, IMG_H));
+
+    /*Corrupt the compressed data*/
+    lv_memset_00(png + png_size / 2, 16);
+
+    lv_img_dsc_t img_dsc;
+    init_img_dsc(&img_dsc, png, png_size, IMG_W, IMG_H);
+
+    uint32_t live_ori = lv_mem_track_get_total()->live_size;
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_decoder_open(&dsc, &img_dsc, lv_color_black(), 0));
+    TEST_ASSERT_EQUAL(live_ori, lv_mem_track_get_total()->live_size);
+
+    lv_mem_free(png);
+}
+
+void test_png_stream(void)
+{
+    static const LodePNGColorType types[] = {LCT_RGBA, LCT_RGB, LCT_PALETTE, LCT_GREY};
+    static const uint32_t color_cnts[] = {0, 0, 5, 2};
+    static const bool opaques[] = {false, true, false, true};
+    uint32_t i;
+    unsigned btype;
+    for(i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+        fill(BIG_W, BIG_H, color_cnts[i], opaques[i]);
+        /*Uncompressed, fixed and dynamic Huffman blocks*/
+        for(btype = 0; btype <= 2; btype++) {
+            size_t png_size;
+            uint8_t * png = encode_big(btype, false, types[i], &png_size);
+            lv_img_dsc_t img_dsc;
+            init_img_dsc(&img_dsc, png, png_size, BIG_W, BIG_H);
+            check_stream(&img_dsc, !opaques[i]);
+            lv_mem_free(png);
+        }
+    }
+}
+
+void test_png_stream_file(void)
+{
+    fill(BIG_W, BIG_H, 0, false);
+    size_t png_size;
+    uint8_t * png = encode_big(2, false, LCT_RGBA, &png_size);
+    FILE * f = fopen(BIG_PATH, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    fwrite(png, 1, png_size, f);
+    fclose(f);
+    lv_mem_free(png);
+
+    /*Read through the cache of the driver and from the mapped file*/
+    check_stream("A:" BIG_PATH, true);
+    check_stream("M:" BIG_PATH, true);
+
+    remove(BIG_PATH);
+}
+
+void test_png_stream_interlaced(void)
+{
+    /*It's decoded at once*/
+    fill(BIG_W, BIG_H, 0, true);
+    size_t png_size;
+    uint8_t * png = encode_big(2, true, LCT_RGB, &png_size);
+    lv_img_dsc_t img_dsc;
+    init_img_dsc(&img_dsc, png, png_size, BIG_W, BIG_H);
+
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, &img_dsc, lv_color_black(), 0));
+    TEST_ASSERT_NOT_NULL(dsc.img_data);
+    TEST_ASSERT_EQUAL(LV_IMG_CF_TRUE_COLOR, dsc.header.cf);
+    lv_img_decoder_close(&dsc);
+    lv_mem_free(png);
+}
+
+void test_png_stream_invalid(void)
+{
+    fill(BIG_W, BIG_H, 0, false);
+    size_t png_size;
+    uint8_t * png = encode_big(2, false, LCT_RGBA, &png_size);
+
+    /*Corrupt the compressed data. The header is still valid so only reading the rows fails.*/
+    lv_memset_ff(png + png_size / 2, 64);
+
+    lv_img_dsc_t img_dsc;
+    init_img_dsc(&img_dsc, png, png_size, BIG_W, BIG_H);
+    uint32_t live_ori = lv_mem_track_get_total()->live_size;
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, &img_dsc, lv_color_black(), 0));
+
+    lv_coord_t y;
+    lv_res_t res = LV_RES_OK;
+    for(y = 0; y < BIG_H && res == LV_RES_OK; y++) {
+        res = lv_img_decoder_read_line(&dsc, 0, y, BIG_W, (uint8_t *)line_buf);
+    }
+    TEST_ASSERT_EQUAL(LV_RES_INV, res);
+
+    /*The first rows can be decoded again*/
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, 0, BIG_W, (uint8_t *)line_buf));
+
+    lv_img_decoder_close(&dsc);
+    TEST_ASSERT_EQUAL(live_ori, lv_mem_track_get_total()->live_size);
+    lv_mem_free(png);
+}
+
+void test_png_stream_draw(void)
+{
+    fill(BIG_W, BIG_H, 0, true);
+    size_t png_size;
+    uint8_t * png = encode_big(2, false, LCT_RGB, &png_size);
+    lv_img_dsc_t img_dsc;
+    init_img_dsc(&img_dsc, png, png_size, BIG_W, BIG_H);
+
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, &img_dsc);
+    lv_obj_set_pos(img, 10, 20);
+    lv_refr_now(NULL);
+
+    uint32_t x;
+    uint32_t y;
+    for(y = 0; y < BIG_H; y++) {
+        for(x = 0; x < BIG_W; x++) {
+            const uint8_t * px = &rgba[(y * BIG_W + x) * 4];
+            lv_color_t exp = lv_color_make(px[0], px[1], px[2]);
+            TEST_ASSERT_EQUAL_HEX32(exp.full, test_fb[(y + 20) * LV_HOR_RES + x + 10].full);
+        }
+    }
+
+    lv_obj_del(img);
+    lv_img_cache_invalidate_src(&img_dsc);
+    lv_mem_free(png);
+}
+
+/**
+ * Fill `rgba` with a pattern
+ * @param w             width of the image
+ * @param h             height of the image
+ * @param color_cnt     0: many colors; 2: black and white; else: use this many colors
+ * @param opaque        true: all pixels are opaque
+ */
+static void fill(uint32_t w, uint32_t h, uint32_t color_cnt, bool opaque)
+{
+    uint32_t x;
+    uint32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            uint8_t * px = &rgba[(y * w + x) * 4];
+            if(color_cnt == 0) {
+                px[0] = x * 7;
+                px[1] = y * 11;
+                px[2] = (x + y) * 5;
+                px[3] = (x * y) & 0xFF;
+            }
+            else if(color_cnt == 2) {
+                px[0] = px[1] = px[2] = ((x + y) % 3) ? 0xFF : 0x00;
+                px[3] = 0xFF;
+            }
+            else {
+                uint32_t c = (x / 3 + y) % color_cnt;
+                px[0] = c * 50;
+                px[1] = 0x80;
+                px[2] = 0xFF - c * 30;
+                px[3] = c * 60;
+            }
+            if(opaque) px[3] = 0xFF;
+        }
+    }
+}
+
+/**
+ * Encode `rgba` to PNG, decode it and compare the pixels
+ */
+static void check_png(bool interlace, LodePNGColorType exp_colortype, bool exp_alpha)
+{
+    LodePNGState state;
+    lodepng_state_init(&state);
+    state.info_png.interlace_method = interlace ? 1 : 0;
+    uint8_t * png;
+    size_t png_size;
+    TEST_ASSERT_EQUAL(0, lodepng_encode(&png, &png_size, rgba, IMG_W, IMG_H, &state));
+    lodepng_state_cleanup(&state);
+
+    /*The encoder chooses the color type automatically so check that the intended one is tested*/
+    unsigned w;
+    unsigned h;
+    lodepng_state_init(&state);
+    TEST_ASSERT_EQUAL(0, lodepng_inspect(&w, &h, &state, png, png_size));
+    TEST_ASSERT_EQUAL(exp_colortype, state.info_png.color.colortype);
+    TEST_ASSERT_EQUAL(interlace ? 1 : 0, state.info_png.interlace_method);
+    lodepng_state_cleanup(&state);
+
+    lv_img_dsc_t img_dsc;
+    init_img_dsc(&img_dsc, png, png_size, IMG_W, IMG_H);
+
+    uint32_t live_ori = lv_mem_track_get_total()->live_size;
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, &img_dsc, lv_color_black(), 0));
+    TEST_ASSERT_EQUAL(exp_alpha ? LV_IMG_CF_TRUE_COLOR_ALPHA : LV_IMG_CF_TRUE_COLOR, dsc.header.cf);
+
+    /*Only the decoded image remains allocated*/
+    TEST_ASSERT_EQUAL(lv_img_buf_get_img_size(IMG_W, IMG_H, dsc.header.cf),
+                      lv_mem_track_get_total()->live_size - live_ori);
+
+    const lv_color_t * px = (const lv_color_t *)dsc.img_data;
+    uint32_t i;
+    for(i = 0; i < IMG_W * IMG_H; i++) {
+        lv_color_t exp = lv_color_make(rgba[i * 4], rgba[i * 4 + 1], rgba[i * 4 + 2]);
+        exp.ch.alpha = exp_alpha ? rgba[i * 4 + 3] : 0xFF;
+        TEST_ASSERT_EQUAL_HEX32(exp.full, px[i].full);
+    }
+
+    lv_img_decoder_close(&dsc);
+    lv_mem_free(png);
+}
+
+/**
+ * Encode the `BIG_W` x `BIG_H` image in `rgba` to PNG whose image data is split to many IDAT chunks
+ * @param btype             type of the deflate blocks
+ * @param interlace         true: use Adam7 interlacing
+ * @param exp_colortype     the color type the encoder should choose
+ * @param png_size          store the size of the PNG here
+ * @return                  the PNG, free it with `lv_mem_free`
+ */
+static uint8_t * encode_big(unsigned btype, bool interlace, LodePNGColorType exp_colortype, size_t * png_size)
+{
+    LodePNGState state;
+    lodepng_state_init(&state);
+    state.info_png.interlace_method = interlace ? 1 : 0;
+    state.encoder.zlibsettings.btype = btype;
+    uint8_t * png;
+    size_t size;
+    TEST_ASSERT_EQUAL(0, lodepng_encode(&png, &size, rgba, BIG_W, BIG_H, &state));
+    lodepng_state_cleanup(&state);
+
+    unsigned w;
+    unsigned h;
+    lodepng_state_init(&state);
+    TEST_ASSERT_EQUAL(0, lodepng_inspect(&w, &h, &state, png, size));
+    TEST_ASSERT_EQUAL(exp_colortype, state.info_png.color.colortype);
+    lodepng_state_cleanup(&state);
+
+    /*Copy the chunks but split the image data to 1000 byte chunks*/
+    uint8_t * out = lv_mem_alloc(8);
+    size_t out_size = 8;
+    lv_memcpy(out, png, 8);
+    const uint8_t * chunk = png + 8;
+    const uint8_t * end = png + size;
+    while(chunk < end) {
+        if(lodepng_chunk_type_equals(chunk, "IDAT")) {
+            const uint8_t * data = lodepng_chunk_data_const(chunk);
+            unsigned len = lodepng_chunk_length(chunk);
+            unsigned ofs;
+            for(ofs = 0; ofs < len; ofs += 1000) {
+                TEST_ASSERT_EQUAL(0, lodepng_chunk_create(&out, &out_size, LV_MIN(1000, len - ofs), "IDAT", data + ofs));
+            }
+        }
+        else {
+            TEST_ASSERT_EQUAL(0, lodepng_chunk_append(&out, &out_size, chunk));
+        }
+        chunk = lodepng_chunk_next_const(chunk, end);
+    }
+    lv_mem_free(png);
+
+    *png_size = out_size;
+    return out;
+}
+
+/**
+ * Decode the `BIG_W` x `BIG_H` image row by row and compare it to `rgba`
+ */
+static void check_stream(const void * src, bool exp_alpha)
+{
+    lv_mem_track_reset();
+    uint32_t live_ori = lv_mem_track_get_total()->live_size;
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, src, lv_color_black(), 0));
+    TEST_ASSERT_NULL(dsc.img_data);
+    TEST_ASSERT_EQUAL(exp_alpha ? LV_IMG_CF_TRUE_COLOR_ALPHA : LV_IMG_CF_TRUE_COLOR, dsc.header.cf);
+
+    lv_coord_t y;
+    for(y = 0; y < BIG_H; y++) check_row(&dsc, 0, y, BIG_W, exp_alpha);
+
+    /*Parts of the rows in any order*/
+    for(y = BIG_H - 1; y >= 0; y -= 23) check_row(&dsc, y % 50, y, 100, exp_alpha);
+    check_row(&dsc, 10, 100, 5, exp_alpha);
+    check_row(&dsc, 20, 98, 5, exp_alpha);
+    check_row(&dsc, BIG_W - 1, 150, 1, exp_alpha);
+
+    /*Only a small part of the image is allocated*/
+    uint32_t img_size = lv_img_buf_get_img_size(BIG_W, BIG_H, dsc.header.cf);
+    TEST_ASSERT_LESS_THAN(img_size / 4, lv_mem_track_get_total()->peak_size - live_ori);
+
+    lv_img_decoder_close(&dsc);
+    TEST_ASSERT_EQUAL(live_ori, lv_mem_track_get_total()->live_size);
+}
+
+static void check_row(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len, bool alpha)
+{
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(dsc, x, y, len, (uint8_t *)line_buf));
+
+    lv_coord_t i;
+    for(i = 0; i < len; i++) {
+        const uint8_t * px = &rgba[(y * BIG_W + x + i) * 4];
+        lv_color_t exp = lv_color_make(px[0], px[1], px[2]);
+        exp.ch.alpha = alpha ? px[3] : 0xFF;
+        TEST_ASSERT_EQUAL_HEX32(exp.full, line_buf[i].full);
+    }
+}
+
+static void init_img_dsc(lv_img_dsc_t * img_dsc, const uint8_t * png, size_t png_size, uint32_t w, uint32_t h)
+{
+    lv_memset_00(img_dsc, sizeof(lv_img_dsc_t));
+    img_dsc->header.cf = LV_IMG_CF_RAW_ALPHA;
+    img_dsc->header.w = w;
+    img_dsc->header.h = h;
+    img_dsc->data_size = png_size;
+    img_dsc->data = png;
+}
+
+#endif
+
+#endif
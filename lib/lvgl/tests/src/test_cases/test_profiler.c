@@ -0,0 +1,92 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_PROFILER
+
+#include <string.h>
+
+static char out[1024 * 1024];
+static uint32_t out_len;
+
+static void print_cb(const char * buf);
+static uint32_t count(const char * pattern);
+
+void setUp(void)
+{
+    out_len = 0;
+    out[0] = '\0';
+    lv_profiler_reset();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_profiler_dump_objects(void)
+{
+    lv_obj_t * btn = lv_btn_create(lv_scr_act());
+    lv_obj_t * label = lv_label_create(btn);
+    lv_label_set_text(label, "Profiled");
+
+    lv_profiler_reset();
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_profiler_dump(print_cb);
+
+    TEST_ASSERT_EQUAL_STRING_LEN("{\"traceEvents\":[\n", out, strlen("{\"traceEvents\":[\n"));
+    TEST_ASSERT_EQUAL_STRING("\n],\"displayTimeUnit\":\"ms\"}\n", out + out_len - strlen("\n],\"displayTimeUnit\":\"ms\"}\n"));
+
+    TEST_ASSERT_GREATER_THAN(0, count("{\"name\":\"lv_obj\",\"cat\":\"obj\",\"ph\":\"B\""));
+    TEST_ASSERT_GREATER_THAN(0, count("{\"name\":\"lv_btn\",\"cat\":\"obj\",\"ph\":\"B\""));
+    TEST_ASSERT_GREATER_THAN(0, count("{\"name\":\"lv_label\",\"cat\":\"obj\",\"ph\":\"B\""));
+    TEST_ASSERT_GREATER_THAN(0, count("{\"name\":\"label\",\"cat\":\"draw\",\"ph\":\"B\""));
+    TEST_ASSERT_GREATER_THAN(0, count("{\"name\":\"flush_cb\",\"cat\":\"flush\",\"ph\":\"B\""));
+    TEST_ASSERT_GREATER_THAN(0, count("\"args\":{\"x\":"));
+
+    TEST_ASSERT_EQUAL(count("\"ph\":\"B\""), count("\"ph\":\"E\""));
+}
+
+void test_profiler_overwrite_oldest(void)
+{
+    uint32_t i;
+    for(i = 0; i < 20; i++) lv_label_create(lv_scr_act());
+
+    /*Record more events than the buffer can hold*/
+    for(i = 0; i < LV_PROFILER_BUF_SIZE / 20; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+    }
+    lv_profiler_dump(print_cb);
+
+    /*The ends whose begin was overwritten are skipped*/
+    uint32_t begin_cnt = count("\"ph\":\"B\"");
+    TEST_ASSERT_LESS_OR_EQUAL(LV_PROFILER_BUF_SIZE / 2, begin_cnt);
+    TEST_ASSERT_GREATER_THAN(LV_PROFILER_BUF_SIZE / 4, begin_cnt);
+    TEST_ASSERT_EQUAL(begin_cnt, count("\"ph\":\"E\""));
+}
+
+static void print_cb(const char * buf)
+{
+    size_t len = strlen(buf);
+    TEST_ASSERT_LESS_THAN(sizeof(out), out_len + len);
+    lv_memcpy(out + out_len, buf, len + 1);
+    out_len += len;
+}
+
+static uint32_t count(const char * pattern)
+{
+    uint32_t cnt = 0;
+    const char * p = out;
+    while((p = strstr(p, pattern)) != NULL) {
+        cnt++;
+        p++;
+    }
+    return cnt;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,312 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_SJPG
+
+#define SJPG_PATH   "A:../examples/libs/sjpg/small_image.sjpg"
+#define JPG_PATH    "A:src/test_files/gradient_200x120.jpg"
+#define MAX_W       320
+#define MAX_H       240
+#define FRAME_H     16
+#define FRAME_SIZE  (MAX_W * FRAME_H * 3)
+
+static lv_color_t full[MAX_W * MAX_H];
+static lv_color_t line_buf[MAX_W];
+static lv_color_t full_area[MAX_W * MAX_H];
+
+static void check_scaled(const void * src, lv_coord_t w, lv_coord_t h);
+static uint32_t decode(const void * src, lv_coord_t exp_w, lv_coord_t exp_h, lv_color_t * buf);
+static void assert_size(const void * src, lv_coord_t exp_w, lv_coord_t exp_h);
+static void read_line(lv_img_decoder_dsc_t * dsc, lv_coord_t y);
+static void assert_cache_stat(uint32_t hit, uint32_t miss, uint32_t ahead);
+
+void setUp(void)
+{
+    lv_split_jpeg_reset_cache_stat();
+}
+
+void tearDown(void)
+{
+    lv_split_jpeg_set_max_size(0, 0);
+}
+
+void test_sjpg_scaled(void)
+{
+    check_scaled(SJPG_PATH, 320, 240);
+}
+
+void test_sjpg_jpg_scaled(void)
+{
+    check_scaled(JPG_PATH, 200, 120);
+}
+
+void test_sjpg_jpg_c_array_scaled(void)
+{
+    static uint8_t data[8192];
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, JPG_PATH, LV_FS_MODE_RD));
+    uint32_t size;
+    lv_fs_read(&f, data, sizeof(data), &size);
+    lv_fs_close(&f);
+    TEST_ASSERT_LESS_THAN(sizeof(data), size);
+
+    lv_img_dsc_t img_dsc;
+    lv_memset_00(&img_dsc, sizeof(img_dsc));
+    img_dsc.header.cf = LV_IMG_CF_RAW;
+    img_dsc.data_size = size;
+    img_dsc.data = data;
+    check_scaled(&img_dsc, 200, 120);
+}
+
+void test_sjpg_fit(void)
+{
+    /*The smallest scale down which fits*/
+    lv_split_jpeg_set_max_size(128, 128);
+    assert_size(SJPG_PATH, 80, 60);
+    assert_size(JPG_PATH, 100, 60);
+
+    lv_split_jpeg_set_max_size(160, 0);
+    assert_size(SJPG_PATH, 160, 120);
+    assert_size(JPG_PATH, 100, 60);
+
+    /*At most 1/8*/
+    lv_split_jpeg_set_max_size(1, 1);
+    assert_size(SJPG_PATH, 40, 30);
+    assert_size(JPG_PATH, 25, 15);
+
+    lv_split_jpeg_set_max_size(0, 0);
+    assert_size(SJPG_PATH, 320, 240);
+}
+
+void test_sjpg_fragment_cache(void)
+{
+    uint32_t live_ori = lv_mem_track_get_total()->live_size;
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, SJPG_PATH, lv_color_black(), 0));
+
+    /*The whole first fragment is decoded once*/
+    lv_coord_t y;
+    for(y = 0; y < FRAME_H; y++) read_line(&dsc, y);
+    assert_cache_stat(FRAME_H - 1, 1, 0);
+    uint32_t live_1_frame = lv_mem_track_get_total()->live_size;
+
+    /*Strips crossing the fragment boundary back and forth don't decode them again*/
+    lv_split_jpeg_reset_cache_stat();
+    read_line(&dsc, FRAME_H);
+    read_line(&dsc, FRAME_H - 1);
+    read_line(&dsc, FRAME_H);
+    read_line(&dsc, 0);
+    assert_cache_stat(3, 1, 0);
+
+    /*3 fragments are cached, the least recently used one is dropped for the 4th*/
+    lv_split_jpeg_reset_cache_stat();
+    read_line(&dsc, 2 * FRAME_H);
+    read_line(&dsc, 3 * FRAME_H);
+    assert_cache_stat(0, 2, 0);
+    TEST_ASSERT_EQUAL(2 * FRAME_SIZE, lv_mem_track_get_total()->live_size - live_1_frame);
+
+    read_line(&dsc, 0);
+    read_line(&dsc, 2 * FRAME_H);
+    read_line(&dsc, 3 * FRAME_H);
+    assert_cache_stat(3, 2, 0);
+    read_line(&dsc, FRAME_H);
+    assert_cache_stat(3, 3, 0);
+
+    /*The lines are the same as without the cache*/
+    lv_img_decoder_close(&dsc);
+    decode(SJPG_PATH, MAX_W, MAX_H, full);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, SJPG_PATH, lv_color_black(), 0));
+    static const lv_coord_t ys[] = {100, 5, 239, 17, 64, 0, 101, 47, 48, 238};
+    uint32_t i;
+    for(i = 0; i < sizeof(ys) / sizeof(ys[0]); i++) {
+        read_line(&dsc, ys[i]);
+        TEST_ASSERT_EQUAL_MEMORY(&full[ys[i] * MAX_W], line_buf, MAX_W * sizeof(lv_color_t));
+    }
+    lv_img_decoder_close(&dsc);
+    TEST_ASSERT_EQUAL(live_ori, lv_mem_track_get_total()->live_size);
+}
+
+void test_sjpg_fragment_cache_jpg(void)
+{
+    /*A JPG is only one fragment*/
+    uint32_t live_ori = lv_mem_track_get_total()->live_size;
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, JPG_PATH, lv_color_black(), 0));
+    read_line(&dsc, 0);
+    uint32_t live_1_frame = lv_mem_track_get_total()->live_size;
+    read_line(&dsc, 119);
+    assert_cache_stat(1, 1, 0);
+    TEST_ASSERT_EQUAL(live_1_frame, lv_mem_track_get_total()->live_size);
+
+    /*Nothing to decode ahead*/
+    lv_timer_handler();
+    assert_cache_stat(1, 1, 0);
+    lv_img_decoder_close(&dsc);
+    TEST_ASSERT_EQUAL(live_ori, lv_mem_track_get_total()->live_size);
+}
+
+void test_sjpg_decode_ahead(void)
+{
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, SJPG_PATH, lv_color_black(), 0));
+
+    /*Scrolling down: the next fragment is decoded by the timer and it's ready when it's needed*/
+    read_line(&dsc, 0);
+    assert_cache_stat(0, 1, 0);
+    lv_timer_handler();
+    assert_cache_stat(0, 1, 1);
+    read_line(&dsc, FRAME_H);
+    assert_cache_stat(1, 1, 1);
+    lv_timer_handler();
+    read_line(&dsc, 2 * FRAME_H);
+    assert_cache_stat(2, 1, 2);
+
+    /*Scrolling up: the image appears from the top*/
+    lv_split_jpeg_reset_cache_stat();
+    read_line(&dsc, 12 * FRAME_H);
+    read_line(&dsc, 11 * FRAME_H);
+    assert_cache_stat(0, 2, 0);
+    lv_timer_handler();
+    read_line(&dsc, 10 * FRAME_H);
+    read_line(&dsc, 11 * FRAME_H);
+    assert_cache_stat(2, 2, 1);
+    lv_timer_handler();
+    read_line(&dsc, 9 * FRAME_H);
+    assert_cache_stat(3, 2, 2);
+
+    /*Nothing is decoded before the first fragment*/
+    lv_timer_handler();
+    read_line(&dsc, 0);
+    lv_timer_handler();
+    assert_cache_stat(3, 3, 3);
+
+    lv_img_decoder_close(&dsc);
+}
+
+void test_sjpg_read_area(void)
+{
+    decode(SJPG_PATH, MAX_W, MAX_H, full);
+
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, SJPG_PATH, lv_color_black(), 0));
+
+    /*Each fragment is decoded once and the other lines count as hits*/
+    lv_split_jpeg_reset_cache_stat();
+    lv_area_t area = {7, 10, 300, 40};
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_area(&dsc, &area, (uint8_t *)full_area));
+    assert_cache_stat(28, 3, 0);
+
+    lv_coord_t w = lv_area_get_width(&area);
+    lv_coord_t y;
+    for(y = area.y1; y <= area.y2; y++) {
+        TEST_ASSERT_EQUAL_MEMORY(&full[y * MAX_W + area.x1], &full_area[(y - area.y1) * w], w * sizeof(lv_color_t));
+    }
+
+    lv_img_decoder_close(&dsc);
+}
+
+/**
+ * Decode the image at 1/2, 1/4 and 1/8 scale and compare it to the average of the pixels at full size
+ */
+static void check_scaled(const void * src, lv_coord_t w, lv_coord_t h)
+{
+    lv_split_jpeg_set_max_size(0, 0);
+    uint32_t full_size = decode(src, w, h, full);
+
+    uint8_t scale;
+    for(scale = 1; scale <= 3; scale++) {
+        lv_coord_t sw = w >> scale;
+        lv_coord_t sh = h >> scale;
+        lv_split_jpeg_set_max_size(sw, sh);
+
+        lv_img_decoder_dsc_t dsc;
+        uint32_t live_ori = lv_mem_track_get_total()->live_size;
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, src, lv_color_black(), 0));
+        TEST_ASSERT_EQUAL(sw, dsc.header.w);
+        TEST_ASSERT_EQUAL(sh, dsc.header.h);
+
+        /*1/2 and 1/4 scales are the average of the pixels.
+         *1/8 scale uses only the DC values with one chroma per MCU so it's just similar.*/
+        uint32_t diff_sum = 0;
+        lv_coord_t x;
+        lv_coord_t y;
+        for(y = 0; y < sh; y++) {
+            TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, y, sw, (uint8_t *)line_buf));
+            for(x = 0; x < sw; x++) {
+                uint32_t r = 0;
+                uint32_t g = 0;
+                uint32_t b = 0;
+                lv_coord_t i;
+                lv_coord_t j;
+                for(i = 0; i < (1 << scale); i++) {
+                    for(j = 0; j < (1 << scale); j++) {
+                        lv_color_t c = full[((y << scale) + i) * w + (x << scale) + j];
+                        r += c.ch.red;
+                        g += c.ch.green;
+                        b += c.ch.blue;
+                    }
+                }
+                diff_sum += LV_ABS((int32_t)(r >> (scale * 2)) - line_buf[x].ch.red);
+                diff_sum += LV_ABS((int32_t)(g >> (scale * 2)) - line_buf[x].ch.green);
+                diff_sum += LV_ABS((int32_t)(b >> (scale * 2)) - line_buf[x].ch.blue);
+            }
+        }
+        if(scale < 3) TEST_ASSERT_EQUAL(0, diff_sum);
+        else TEST_ASSERT_LESS_THAN(sw * sh * 3 * 16, diff_sum);
+
+        /*The decoded fragments are smaller too*/
+        TEST_ASSERT_LESS_THAN(full_size, lv_mem_track_get_total()->live_size - live_ori);
+
+        lv_img_decoder_close(&dsc);
+    }
+}
+
+/**
+ * Decode the whole image to `buf`
+ * @return  the memory used by the opened image with its decoded fragments
+ */
+static uint32_t decode(const void * src, lv_coord_t exp_w, lv_coord_t exp_h, lv_color_t * buf)
+{
+    lv_img_decoder_dsc_t dsc;
+    uint32_t live_ori = lv_mem_track_get_total()->live_size;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, src, lv_color_black(), 0));
+    TEST_ASSERT_EQUAL(exp_w, dsc.header.w);
+    TEST_ASSERT_EQUAL(exp_h, dsc.header.h);
+
+    lv_coord_t y;
+    for(y = 0; y < exp_h; y++) {
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, y, exp_w, (uint8_t *)&buf[y * exp_w]));
+    }
+    uint32_t size = lv_mem_track_get_total()->live_size - live_ori;
+
+    lv_img_decoder_close(&dsc);
+    return size;
+}
+
+static void read_line(lv_img_decoder_dsc_t * dsc, lv_coord_t y)
+{
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(dsc, 0, y, dsc->header.w, (uint8_t *)line_buf));
+}
+
+static void assert_cache_stat(uint32_t hit, uint32_t miss, uint32_t ahead)
+{
+    lv_split_jpeg_cache_stat_t stat;
+    lv_split_jpeg_get_cache_stat(&stat);
+    TEST_ASSERT_EQUAL(hit, stat.hit);
+    TEST_ASSERT_EQUAL(miss, stat.miss);
+    TEST_ASSERT_EQUAL(ahead, stat.ahead);
+}
+
+static void assert_size(const void * src, lv_coord_t exp_w, lv_coord_t exp_h)
+{
+    lv_img_header_t header;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_get_info(src, &header));
+    TEST_ASSERT_EQUAL(exp_w, header.w);
+    TEST_ASSERT_EQUAL(exp_h, header.h);
+}
+
+#endif
+
+#endif
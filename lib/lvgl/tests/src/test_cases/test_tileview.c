@@ -0,0 +1,281 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_SNAPSHOT
+
+#define TILE_CNT    3
+#define LAZY_CNT    5
+#define HOR_RES     800
+#define VER_RES     480
+
+extern lv_color_t test_fb[];
+static lv_color_t ref_fb[HOR_RES * VER_RES];
+
+static lv_obj_t * tv;
+static lv_obj_t * tiles[TILE_CNT];
+static lv_obj_t * lazy_tiles[LAZY_CNT];
+static uint32_t load_cnt[LAZY_CNT];
+static uint32_t unload_cnt[LAZY_CNT];
+
+static void finish_anim(void);
+static lv_obj_t * create_lazy(uint8_t dist);
+static void load_cb(lv_obj_t * tile, bool load);
+static void assert_loaded(const char * exp);
+
+void setUp(void)
+{
+    tv = lv_tileview_create(lv_scr_act());
+    lv_obj_set_size(tv, 200, 150);
+
+    uint32_t i;
+    for(i = 0; i < TILE_CNT; i++) {
+        tiles[i] = lv_tileview_add_tile(tv, i, 0, LV_DIR_HOR);
+        lv_obj_t * label = lv_label_create(tiles[i]);
+        lv_label_set_text_fmt(label, "Tile %d", (int)i);
+        lv_obj_center(label);
+    }
+
+    lv_tileview_set_snapshot_anim(tv, true);
+    lv_refr_now(NULL);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_tileview_snapshot_anim(void)
+{
+    lv_obj_set_tile_id(tv, 1, 0, LV_ANIM_ON);
+
+    /*The tiles are replaced by the images of their snapshots*/
+    TEST_ASSERT_TRUE(lv_obj_has_flag(tiles[0], LV_OBJ_FLAG_HIDDEN));
+    TEST_ASSERT_TRUE(lv_obj_has_flag(tiles[1], LV_OBJ_FLAG_HIDDEN));
+    TEST_ASSERT_FALSE(lv_obj_has_flag(tiles[2], LV_OBJ_FLAG_HIDDEN));
+    TEST_ASSERT_EQUAL(TILE_CNT + 2, lv_obj_get_child_cnt(tv));
+    TEST_ASSERT_TRUE(lv_obj_check_type(lv_obj_get_child(tv, TILE_CNT), &lv_img_class));
+
+    finish_anim();
+
+    TEST_ASSERT_FALSE(lv_obj_has_flag(tiles[0], LV_OBJ_FLAG_HIDDEN));
+    TEST_ASSERT_FALSE(lv_obj_has_flag(tiles[1], LV_OBJ_FLAG_HIDDEN));
+    TEST_ASSERT_EQUAL(TILE_CNT, lv_obj_get_child_cnt(tv));
+    TEST_ASSERT_EQUAL_PTR(tiles[1], lv_tileview_get_tile_act(tv));
+    TEST_ASSERT_EQUAL(lv_obj_get_content_width(tv), lv_obj_get_scroll_x(tv));
+}
+
+void test_tileview_snapshot_anim_looks_the_same(void)
+{
+    /*Render the middle of the animation normally*/
+    lv_tileview_set_snapshot_anim(tv, false);
+    lv_obj_set_tile_id(tv, 1, 0, LV_ANIM_ON);
+    lv_tick_inc(100);
+    lv_timer_handler();
+    lv_refr_now(NULL);
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+    finish_anim();
+
+    /*The snapshots are blended with alpha so allow some rounding errors*/
+    lv_obj_set_tile_id(tv, 0, 0, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+    lv_tileview_set_snapshot_anim(tv, true);
+    lv_obj_set_tile_id(tv, 1, 0, LV_ANIM_ON);
+    lv_tick_inc(100);
+    lv_timer_handler();
+    lv_refr_now(NULL);
+
+    uint32_t max_diff = 0;
+    uint32_t i;
+    for(i = 0; i < HOR_RES * VER_RES; i++) {
+        max_diff = LV_MAX(max_diff, (uint32_t)LV_ABS(test_fb[i].ch.red - ref_fb[i].ch.red));
+        max_diff = LV_MAX(max_diff, (uint32_t)LV_ABS(test_fb[i].ch.green - ref_fb[i].ch.green));
+        max_diff = LV_MAX(max_diff, (uint32_t)LV_ABS(test_fb[i].ch.blue - ref_fb[i].ch.blue));
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(2, max_diff);
+}
+
+void test_tileview_snapshot_anim_interrupted(void)
+{
+    uint32_t live_ori = lv_mem_track_get_total()->live_size;
+
+    lv_obj_set_tile_id(tv, 1, 0, LV_ANIM_ON);
+    lv_tick_inc(50);
+    lv_timer_handler();
+
+    /*Only the tiles of the new animation are replaced*/
+    lv_obj_set_tile_id(tv, 2, 0, LV_ANIM_ON);
+    TEST_ASSERT_FALSE(lv_obj_has_flag(tiles[0], LV_OBJ_FLAG_HIDDEN));
+    TEST_ASSERT_TRUE(lv_obj_has_flag(tiles[1], LV_OBJ_FLAG_HIDDEN));
+    TEST_ASSERT_TRUE(lv_obj_has_flag(tiles[2], LV_OBJ_FLAG_HIDDEN));
+    TEST_ASSERT_EQUAL(TILE_CNT + 2, lv_obj_get_child_cnt(tv));
+
+    finish_anim();
+
+    TEST_ASSERT_FALSE(lv_obj_has_flag(tiles[2], LV_OBJ_FLAG_HIDDEN));
+    TEST_ASSERT_EQUAL(TILE_CNT, lv_obj_get_child_cnt(tv));
+    TEST_ASSERT_EQUAL_PTR(tiles[2], lv_tileview_get_tile_act(tv));
+
+    /*The snapshots are freed*/
+    TEST_ASSERT_EQUAL(live_ori, lv_mem_track_get_total()->live_size);
+}
+
+void test_tileview_snapshot_anim_off(void)
+{
+    lv_tileview_set_snapshot_anim(tv, false);
+    lv_obj_set_tile_id(tv, 1, 0, LV_ANIM_ON);
+
+    TEST_ASSERT_FALSE(lv_obj_has_flag(tiles[0], LV_OBJ_FLAG_HIDDEN));
+    TEST_ASSERT_EQUAL(TILE_CNT, lv_obj_get_child_cnt(tv));
+
+    finish_anim();
+    TEST_ASSERT_EQUAL_PTR(tiles[1], lv_tileview_get_tile_act(tv));
+}
+
+void test_tileview_delete_while_snapshot_anim(void)
+{
+    uint32_t live_ori = lv_mem_track_get_total()->live_size;
+
+    lv_obj_set_tile_id(tv, 1, 0, LV_ANIM_ON);
+    lv_tick_inc(50);
+    lv_timer_handler();
+    lv_obj_del(tv);
+
+    /*Only the tileview is deleted but the snapshots are freed too*/
+    TEST_ASSERT_LESS_THAN(live_ori, lv_mem_track_get_total()->live_size);
+    finish_anim();
+}
+
+void test_tileview_lazy_load_window(void)
+{
+    lv_obj_t * lazy = create_lazy(1);
+    assert_loaded("11000");
+    TEST_ASSERT_EQUAL(1, lv_obj_get_child_cnt(lazy_tiles[0]));
+    TEST_ASSERT_EQUAL(0, lv_obj_get_child_cnt(lazy_tiles[2]));
+
+    lv_obj_set_tile_id(lazy, 3, 0, LV_ANIM_OFF);
+    assert_loaded("00111");
+    TEST_ASSERT_EQUAL(1, unload_cnt[0]);
+    TEST_ASSERT_EQUAL(0, lv_obj_get_child_cnt(lazy_tiles[0]));
+
+    lv_tileview_set_load_dist(lazy, 0);
+    assert_loaded("00010");
+
+    /*Loaded again when it comes back*/
+    lv_obj_set_tile_id(lazy, 0, 0, LV_ANIM_OFF);
+    assert_loaded("10000");
+    TEST_ASSERT_EQUAL(2, load_cnt[0]);
+    TEST_ASSERT_EQUAL(1, lv_obj_get_child_cnt(lazy_tiles[0]));
+}
+
+void test_tileview_lazy_load_while_scrolling(void)
+{
+    lv_obj_t * lazy = create_lazy(0);
+    assert_loaded("10000");
+
+    /*The new tile is loaded at once, the passed tiles only when they are scrolled in*/
+    lv_obj_set_tile_id(lazy, 4, 0, LV_ANIM_ON);
+    assert_loaded("10001");
+    lv_tick_inc(100);
+    lv_timer_handler();
+    /*The first frame scrolls over the second tile*/
+    assert_loaded("10111");
+    TEST_ASSERT_EQUAL(0, load_cnt[1]);
+
+    /*The old tiles are unloaded only at the end*/
+    finish_anim();
+    assert_loaded("00001");
+    TEST_ASSERT_EQUAL(1, load_cnt[2]);
+    TEST_ASSERT_EQUAL(1, unload_cnt[2]);
+}
+
+void test_tileview_lazy_load_snapshot_anim(void)
+{
+    lv_obj_t * lazy = create_lazy(0);
+    lv_tileview_set_snapshot_anim(lazy, true);
+
+    /*The snapshot shows the content of the new tile*/
+    lv_obj_set_tile_id(lazy, 1, 0, LV_ANIM_ON);
+    assert_loaded("11000");
+    TEST_ASSERT_TRUE(lv_obj_has_flag(lazy_tiles[1], LV_OBJ_FLAG_HIDDEN));
+
+    finish_anim();
+    assert_loaded("01000");
+    TEST_ASSERT_FALSE(lv_obj_has_flag(lazy_tiles[1], LV_OBJ_FLAG_HIDDEN));
+}
+
+void test_tileview_lazy_load_delete(void)
+{
+    lv_obj_t * lazy = create_lazy(1);
+    lv_obj_del(lazy);
+
+    /*The loaded tiles are notified*/
+    TEST_ASSERT_EQUAL(1, unload_cnt[0]);
+    TEST_ASSERT_EQUAL(1, unload_cnt[1]);
+    TEST_ASSERT_EQUAL(0, unload_cnt[2]);
+}
+
+static void finish_anim(void)
+{
+    uint32_t i;
+    for(i = 0; i < 100 && lv_anim_count_running(); i++) {
+        lv_tick_inc(50);
+        lv_timer_handler();
+    }
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+}
+
+static lv_obj_t * create_lazy(uint8_t dist)
+{
+    lv_memset_00(load_cnt, sizeof(load_cnt));
+    lv_memset_00(unload_cnt, sizeof(unload_cnt));
+
+    lv_obj_t * lazy = lv_tileview_create(lv_scr_act());
+    lv_obj_set_size(lazy, 200, 150);
+    lv_tileview_set_load_dist(lazy, dist);
+
+    uint32_t i;
+    for(i = 0; i < LAZY_CNT; i++) {
+        lazy_tiles[i] = lv_tileview_add_tile(lazy, i, 0, LV_DIR_HOR);
+        lv_tileview_tile_set_load_cb(lazy_tiles[i], load_cb);
+    }
+
+    return lazy;
+}
+
+static void load_cb(lv_obj_t * tile, bool load)
+{
+    uint32_t i;
+    for(i = 0; i < LAZY_CNT; i++) {
+        if(lazy_tiles[i] == tile) break;
+    }
+    TEST_ASSERT_LESS_THAN(LAZY_CNT, i);
+
+    if(load) {
+        /*It's created empty*/
+        TEST_ASSERT_EQUAL(0, lv_obj_get_child_cnt(tile));
+        lv_obj_t * label = lv_label_create(tile);
+        lv_label_set_text_fmt(label, "Lazy %d", (int)i);
+        load_cnt[i]++;
+    }
+    else {
+        unload_cnt[i]++;
+    }
+}
+
+/**
+ * @param exp   e.g. "10100": only the first and third tiles are loaded
+ */
+static void assert_loaded(const char * exp)
+{
+    char act[LAZY_CNT + 1];
+    uint32_t i;
+    for(i = 0; i < LAZY_CNT; i++) act[i] = lv_tileview_tile_is_loaded(lazy_tiles[i]) ? '1' : '0';
+    act[LAZY_CNT] = '\0';
+    TEST_ASSERT_EQUAL_STRING(exp, act);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,150 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define MAX_SYS_TIMERS 16
+
+static lv_timer_t * sys_timers[MAX_SYS_TIMERS];
+static uint32_t sys_timer_cnt;
+static uint32_t run_cnt;
+static lv_timer_t * victim;
+
+void setUp(void)
+{
+    /*Pause the display, input device and animation timers to have only the test's timers*/
+    sys_timer_cnt = 0;
+    lv_timer_t * t = lv_timer_get_next(NULL);
+    while(t && sys_timer_cnt < MAX_SYS_TIMERS) {
+        if(!t->paused) {
+            sys_timers[sys_timer_cnt++] = t;
+            lv_timer_pause(t);
+        }
+        t = lv_timer_get_next(t);
+    }
+
+    run_cnt = 0;
+    victim = NULL;
+}
+
+void tearDown(void)
+{
+    uint32_t i;
+    for(i = 0; i < sys_timer_cnt; i++) lv_timer_resume(sys_timers[i]);
+}
+
+static void count_cb(lv_timer_t * t)
+{
+    LV_UNUSED(t);
+    run_cnt++;
+}
+
+static void create_cb(lv_timer_t * t)
+{
+    LV_UNUSED(t);
+    run_cnt++;
+    lv_timer_t * one_shot = lv_timer_create(count_cb, 0, NULL);
+    lv_timer_set_repeat_count(one_shot, 1);
+}
+
+static void del_victim_cb(lv_timer_t * t)
+{
+    LV_UNUSED(t);
+    run_cnt++;
+    if(victim) {
+        lv_timer_del(victim);
+        victim = NULL;
+    }
+}
+
+void test_timer_time_until_next_is_the_earliest_deadline(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(LV_NO_TIMER_READY, lv_timer_get_time_until_next());
+
+    lv_timer_t * t1 = lv_timer_create(count_cb, 100000, NULL);
+    lv_timer_t * t2 = lv_timer_create(count_cb, 50000, NULL);
+
+    uint32_t next = lv_timer_get_time_until_next();
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(50000, next);
+    TEST_ASSERT_GREATER_THAN_UINT32(40000, next);
+
+    lv_timer_pause(t2);
+    next = lv_timer_get_time_until_next();
+    TEST_ASSERT_GREATER_THAN_UINT32(50000, next);
+
+    lv_timer_ready(t1);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_timer_get_time_until_next());
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(50000, lv_timer_get_time_until_next());
+
+    lv_timer_resume(t2);
+    lv_timer_set_period(t2, 10000);
+    next = lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(10000, next);
+
+    lv_timer_del(t1);
+    lv_timer_del(t2);
+    TEST_ASSERT_EQUAL_UINT32(LV_NO_TIMER_READY, lv_timer_get_time_until_next());
+}
+
+void test_timer_with_zero_period_runs_once_per_call(void)
+{
+    lv_timer_t * t = lv_timer_create(count_cb, 0, NULL);
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2, run_cnt);
+
+    lv_timer_del(t);
+}
+
+void test_timer_created_in_callback_runs_in_the_same_call(void)
+{
+    lv_timer_t * t = lv_timer_create(create_cb, 100000, NULL);
+    lv_timer_ready(t);
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2, run_cnt);
+
+    /*The one shot timer has deleted itself*/
+    TEST_ASSERT_GREATER_THAN_UINT32(0, lv_timer_get_time_until_next());
+    lv_timer_del(t);
+    TEST_ASSERT_EQUAL_UINT32(LV_NO_TIMER_READY, lv_timer_get_time_until_next());
+}
+
+void test_timer_deleted_in_callback(void)
+{
+    lv_timer_t * t1 = lv_timer_create(del_victim_cb, 100000, NULL);
+    lv_timer_t * t2 = lv_timer_create(count_cb, 100000, NULL);
+    lv_timer_ready(t1);
+    lv_timer_ready(t2);
+
+    /*`t2` might have run already when `t1` deletes it*/
+    victim = t2;
+    lv_timer_handler();
+    TEST_ASSERT_NULL(victim);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(2, run_cnt);
+
+    lv_timer_handler();
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(2, run_cnt);
+
+    lv_timer_del(t1);
+    TEST_ASSERT_EQUAL_UINT32(LV_NO_TIMER_READY, lv_timer_get_time_until_next());
+}
+
+void test_timer_repeat_count(void)
+{
+    lv_timer_t * t = lv_timer_create(count_cb, 0, NULL);
+    lv_timer_set_repeat_count(t, 3);
+
+    uint32_t i;
+    for(i = 0; i < 5; i++) lv_timer_handler();
+
+    TEST_ASSERT_EQUAL_UINT32(3, run_cnt);
+    TEST_ASSERT_EQUAL_UINT32(LV_NO_TIMER_READY, lv_timer_get_time_until_next());
+}
+
+#endif
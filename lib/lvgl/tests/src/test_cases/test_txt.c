@@ -204,4 +204,91 @@ void test_txt_next_line_should_handle_empty_string(void)
     TEST_ASSERT_EQUAL_UINT32(0, next_line);
 }
 
+void test_txt_layout_should_match_txt_get_size(void)
+{
+    static const char * texts[] = {
+        "",
+        "a",
+        "Hello world",
+        "The quick brown fox jumps over the lazy dog and keeps running",
+        "first line\nsecond line\n",
+        "\n\n",
+    };
+    static const lv_coord_t widths[] = {20, 80, 200, LV_COORD_MAX};
+
+    lv_txt_layout_t layout;
+    _lv_txt_layout_init(&layout);
+
+    uint32_t t;
+    uint32_t w;
+    for(t = 0; t < sizeof(texts) / sizeof(texts[0]); t++) {
+        for(w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+            lv_point_t expected;
+            lv_point_t cached;
+            lv_txt_get_size(&expected, texts[t], &lv_font_montserrat_14, 2, 3, widths[w], LV_TEXT_FLAG_NONE);
+
+            TEST_ASSERT_TRUE(_lv_txt_layout_update(&layout, texts[t], &lv_font_montserrat_14, 2, widths[w], LV_TEXT_FLAG_NONE));
+            _lv_txt_layout_get_size(&layout, 3, &cached);
+
+            TEST_ASSERT_EQUAL_INT32(expected.x, cached.x);
+            TEST_ASSERT_EQUAL_INT32(expected.y, cached.y);
+            TEST_ASSERT_EQUAL_UINT32(strlen(texts[t]), layout.line_start[layout.line_cnt]);
+        }
+    }
+
+    _lv_txt_layout_free(&layout);
+}
+
+void test_txt_layout_should_be_recalculated_only_if_changed(void)
+{
+    char txt[] = "aaa bbb ccc ddd";
+
+    lv_txt_layout_t layout;
+    _lv_txt_layout_init(&layout);
+
+    TEST_ASSERT_TRUE(_lv_txt_layout_update(&layout, txt, &lv_font_montserrat_14, 0, 40, LV_TEXT_FLAG_NONE));
+    uint32_t line_cnt = layout.line_cnt;
+    TEST_ASSERT_GREATER_THAN_UINT32(1, line_cnt);
+
+    TEST_ASSERT_TRUE(_lv_txt_layout_match(&layout, txt, &lv_font_montserrat_14, 0, 40, LV_TEXT_FLAG_NONE));
+    TEST_ASSERT_FALSE(_lv_txt_layout_match(&layout, txt, &lv_font_montserrat_14, 1, 40, LV_TEXT_FLAG_NONE));
+    TEST_ASSERT_FALSE(_lv_txt_layout_match(&layout, txt, &lv_font_montserrat_14, 0, 41, LV_TEXT_FLAG_NONE));
+    TEST_ASSERT_FALSE(_lv_txt_layout_match(&layout, txt, &lv_font_montserrat_16, 0, 40, LV_TEXT_FLAG_NONE));
+
+    /*The width doesn't matter if the lines are not wrapped*/
+    TEST_ASSERT_TRUE(_lv_txt_layout_update(&layout, txt, &lv_font_montserrat_14, 0, 40, LV_TEXT_FLAG_EXPAND));
+    TEST_ASSERT_EQUAL_UINT32(1, layout.line_cnt);
+    TEST_ASSERT_TRUE(_lv_txt_layout_match(&layout, txt, &lv_font_montserrat_14, 0, 100, LV_TEXT_FLAG_EXPAND));
+
+    /*The text is modified in place*/
+    txt[3] = '\n';
+    _lv_txt_layout_invalidate(&layout);
+    TEST_ASSERT_FALSE(_lv_txt_layout_match(&layout, txt, &lv_font_montserrat_14, 0, 100, LV_TEXT_FLAG_EXPAND));
+    TEST_ASSERT_TRUE(_lv_txt_layout_update(&layout, txt, &lv_font_montserrat_14, 0, 100, LV_TEXT_FLAG_EXPAND));
+    TEST_ASSERT_EQUAL_UINT32(2, layout.line_cnt);
+
+    _lv_txt_layout_free(&layout);
+}
+
+void test_txt_label_hit_test_with_layout_cache(void)
+{
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_width(label, 60);
+    lv_label_set_text(label, "one two three four five six");
+    lv_obj_update_layout(label);
+
+    uint32_t cnt = _lv_txt_get_encoded_length(lv_label_get_text(label));
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_point_t p;
+        lv_label_get_letter_pos(label, i, &p);
+        /*Go inside the letter*/
+        p.x += 1;
+        p.y += 1;
+        TEST_ASSERT_EQUAL_UINT32(i, lv_label_get_letter_on(label, &p));
+    }
+
+    lv_obj_del(label);
+}
+
 #endif